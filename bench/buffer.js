@@ -0,0 +1,53 @@
+// Native byte work against the same work in interpreted JS.
+import { crc32, toHex, toBase64, fromBase64, layout } from "buffer";
+import { report, timeLoop } from "./harness.js";
+
+const FRAME_BYTES = 256;
+const CRC_ITERATIONS = 20;
+const PACK_ITERATIONS = 500;
+
+const frame = new Uint8Array(FRAME_BYTES);
+for (let i = 0; i < FRAME_BYTES; i++) {
+  frame[i] = (i * 37) & 0xff;
+}
+
+function crc32Js(data) {
+  let crc = 0xffffffff;
+  for (let i = 0; i < data.length; i++) {
+    crc ^= data[i];
+    for (let bit = 0; bit < 8; bit++) {
+      crc = crc & 1 ? (crc >>> 1) ^ 0xedb88320 : crc >>> 1;
+    }
+  }
+  return (crc ^ 0xffffffff) >>> 0;
+}
+
+export async function run() {
+  const jsUs = timeLoop(CRC_ITERATIONS, () => crc32Js(frame));
+  const nativeUs = timeLoop(CRC_ITERATIONS, () => crc32(frame));
+  report("buffer", "crc32_js", { bytes: FRAME_BYTES, usPerOp: jsUs });
+  report("buffer", "crc32_native", { bytes: FRAME_BYTES, usPerOp: nativeUs });
+
+  const hexUs = timeLoop(CRC_ITERATIONS, () => toHex(frame));
+  const base64 = toBase64(frame);
+  const decodeUs = timeLoop(CRC_ITERATIONS, () => fromBase64(base64, frame));
+  report("buffer", "to_hex", { bytes: FRAME_BYTES, usPerOp: hexUs });
+  report("buffer", "from_base64_in_place", { bytes: FRAME_BYTES, usPerOp: decodeUs });
+
+  // A 12-byte sensor record, written with a compiled layout and with a DataView.
+  const record = layout("<IhhHH", ["time", "x", "y", "temp", "flags"]);
+  const values = { time: 123456, x: -12, y: 340, temp: 2150, flags: 3 };
+  const view = new DataView(frame.buffer);
+  const packUs = timeLoop(PACK_ITERATIONS, () => record.pack(values, frame, 0));
+  const dataViewUs = timeLoop(PACK_ITERATIONS, () => {
+    view.setUint32(0, values.time, true);
+    view.setInt16(4, values.x, true);
+    view.setInt16(6, values.y, true);
+    view.setUint16(8, values.temp, true);
+    view.setUint16(10, values.flags, true);
+  });
+  const unpackUs = timeLoop(PACK_ITERATIONS, () => record.unpack(frame));
+  report("buffer", "pack_layout", { n: PACK_ITERATIONS, usPerOp: packUs });
+  report("buffer", "pack_dataview", { n: PACK_ITERATIONS, usPerOp: dataViewUs });
+  report("buffer", "unpack_layout", { n: PACK_ITERATIONS, usPerOp: unpackUs });
+}
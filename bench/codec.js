@@ -0,0 +1,58 @@
+// Native CBOR and JSON encoding against the built-in JSON, for a telemetry
+// record: time per message, and JS heap each encode or decode takes.
+import { gc, heap } from "perf";
+import { encodeCbor, encodeJson, decodeCbor, decodeJson, schema } from "codec";
+import { report, timeLoop } from "./harness.js";
+
+const ITERATIONS = 50;
+
+const record = {
+  device: "node-07",
+  seq: 1234,
+  time: 1718000000,
+  temp: 21.5,
+  humidity: 48.25,
+  accel: [0.01, -0.98, 0.12],
+  ok: true,
+};
+const keys = Object.keys(record);
+const telemetry = schema(keys);
+const target = new Uint8Array(256);
+
+// Heap bytes one call allocates, read before the garbage is collected. The
+// result is kept alive so it counts too.
+let kept;
+function heapBytes(fn) {
+  gc();
+  const before = heap().allocated;
+  kept = fn();
+  return heap().allocated - before;
+}
+
+function compare(name, fn) {
+  const stats = heap();
+  const fields = { usPerOp: timeLoop(ITERATIONS, fn) };
+  if (stats) {
+    fields.heapBytes = heapBytes(fn);
+  }
+  report("codec", name, fields);
+}
+
+export async function run() {
+  compare("json_stringify", () => JSON.stringify(record));
+  compare("encode_json", () => encodeJson(record, target));
+  compare("encode_json_schema", () => telemetry.encodeJson(record, target));
+  compare("encode_cbor", () => encodeCbor(record, target));
+  compare("encode_cbor_schema", () => telemetry.encodeCbor(record, target));
+
+  const text = JSON.stringify(record);
+  const jsonBytes = target.subarray(0, encodeJson(record, target));
+  compare("json_parse", () => JSON.parse(text));
+  compare("decode_json", () => decodeJson(jsonBytes));
+  compare("decode_json_schema", () => telemetry.decodeJson(jsonBytes));
+
+  const cbor = encodeCbor(record);
+  compare("decode_cbor", () => decodeCbor(cbor));
+  compare("decode_cbor_schema", () => telemetry.decodeCbor(cbor));
+  report("codec", "size", { json: jsonBytes.length, cbor: cbor.byteLength });
+}
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""Compares two benchmark logs and flags regressions.
+
+Usage: compare.py BASELINE.log CURRENT.log [--threshold PERCENT]
+
+Reads the `BENCH <json>` lines from each log (serial capture or host runner
+output) and prints every shared metric with its change. Exits with status 1
+if any metric got worse by more than the threshold (default 10%).
+"""
+
+import argparse
+import json
+import sys
+
+# Metrics where a larger value is better; everything else is a cost.
+HIGHER_IS_BETTER = {"opsPerSec", "jobsPerSec"}
+IGNORED = {"suite", "name", "n", "nodes", "bytes", "size", "skipped", "files", "chunk"}
+
+
+def load(path):
+    results = {}
+    with open(path, errors="replace") as f:
+        for line in f:
+            marker = line.find("BENCH {")
+            if marker < 0:
+                continue
+            entry = json.loads(line[marker + len("BENCH "):])
+            results[(entry["suite"], entry["name"])] = entry
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0)
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    regressions = 0
+
+    for key in sorted(baseline.keys() & current.keys()):
+        old, new = baseline[key], current[key]
+        for metric, old_value in old.items():
+            new_value = new.get(metric)
+            if metric in IGNORED or not isinstance(old_value, (int, float)) or not isinstance(new_value, (int, float)):
+                continue
+            if old_value == 0:
+                continue
+            change = (new_value - old_value) / abs(old_value) * 100
+            worse = -change if metric in HIGHER_IS_BETTER else change
+            flag = ""
+            if worse > args.threshold:
+                flag = "  REGRESSION"
+                regressions += 1
+            print(f"{key[0]}.{key[1]}.{metric}: {old_value} -> {new_value} ({change:+.1f}%){flag}")
+
+    for key in sorted(baseline.keys() - current.keys()):
+        print(f"{key[0]}.{key[1]}: missing from {args.current}")
+
+    print(f"{regressions} regression(s) over {args.threshold:g}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,11 @@
+// Cost of console.log, which formats into a buffer and goes through the IDF log.
+import { report, timeLoop } from "./harness.js";
+
+const ITERATIONS = 100;
+
+export async function run() {
+  const shortUs = timeLoop(ITERATIONS, () => console.log("bench"));
+  const mixedUs = timeLoop(ITERATIONS, (i) => console.log("bench", i, 3.25, true));
+  report("console", "log_short", { n: ITERATIONS, usPerOp: shortUs });
+  report("console", "log_mixed", { n: ITERATIONS, usPerOp: mixedUs });
+}
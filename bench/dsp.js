@@ -0,0 +1,142 @@
+// Native signal processing against the same work in interpreted JS.
+import { iir, biquad, movingAverage, median, stats, fft } from "dsp";
+import { report, timeLoop } from "./harness.js";
+
+const BLOCK = 256;
+const ITERATIONS = 10;
+
+const samples = new Float32Array(BLOCK);
+for (let i = 0; i < BLOCK; i++) {
+  samples[i] = Math.sin((2 * Math.PI * 5 * i) / BLOCK) + 0.3 * Math.sin(i * 1.7);
+}
+const output = new Float32Array(BLOCK);
+
+function movingAverageJs(window) {
+  const ring = new Float32Array(window);
+  let sum = 0;
+  let pos = 0;
+  let count = 0;
+  return (input, out) => {
+    for (let i = 0; i < input.length; i++) {
+      sum += input[i] - ring[pos];
+      ring[pos] = input[i];
+      pos = (pos + 1) % window;
+      if (count < window) count++;
+      out[i] = sum / count;
+    }
+  };
+}
+
+function medianJs(window) {
+  const ring = [];
+  return (input, out) => {
+    for (let i = 0; i < input.length; i++) {
+      ring.push(input[i]);
+      if (ring.length > window) ring.shift();
+      const sorted = ring.slice().sort((a, b) => a - b);
+      const mid = sorted.length >> 1;
+      out[i] = sorted.length & 1 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+    }
+  };
+}
+
+function biquadJs(c) {
+  let w1 = 0;
+  let w2 = 0;
+  return (input, out) => {
+    for (let i = 0; i < input.length; i++) {
+      const w0 = input[i] - c[3] * w1 - c[4] * w2;
+      out[i] = c[0] * w0 + c[1] * w1 + c[2] * w2;
+      w2 = w1;
+      w1 = w0;
+    }
+  };
+}
+
+function statsJs(data) {
+  let min = Infinity;
+  let max = -Infinity;
+  let sum = 0;
+  let squares = 0;
+  for (let i = 0; i < data.length; i++) {
+    const x = data[i];
+    if (x < min) min = x;
+    if (x > max) max = x;
+    sum += x;
+    squares += x * x;
+  }
+  const mean = sum / data.length;
+  return { min, max, mean, rms: Math.sqrt(squares / data.length) };
+}
+
+function fftJs(re, im) {
+  const n = re.length;
+  for (let i = 1, j = 0; i < n; i++) {
+    let bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      [re[i], re[j]] = [re[j], re[i]];
+      [im[i], im[j]] = [im[j], im[i]];
+    }
+  }
+  for (let len = 2; len <= n; len <<= 1) {
+    const angle = (-2 * Math.PI) / len;
+    for (let i = 0; i < n; i += len) {
+      for (let k = 0; k < len / 2; k++) {
+        const wr = Math.cos(angle * k);
+        const wi = Math.sin(angle * k);
+        const a = i + k;
+        const b = a + len / 2;
+        const tr = re[b] * wr - im[b] * wi;
+        const ti = re[b] * wi + im[b] * wr;
+        re[b] = re[a] - tr;
+        im[b] = im[a] - ti;
+        re[a] += tr;
+        im[a] += ti;
+      }
+    }
+  }
+}
+
+function compare(name, jsFn, nativeFn) {
+  const jsUs = timeLoop(ITERATIONS, jsFn);
+  const nativeUs = timeLoop(ITERATIONS, nativeFn);
+  report("dsp", name + "_js", { n: BLOCK, usPerOp: jsUs });
+  report("dsp", name + "_native", { n: BLOCK, usPerOp: nativeUs });
+}
+
+export async function run() {
+  const averageJs = movingAverageJs(16);
+  const average = movingAverage(16);
+  compare("moving_average_16", () => averageJs(samples, output), () => average.process(samples, output));
+
+  const medJs = medianJs(9);
+  const med = median(9);
+  compare("median_9", () => medJs(samples, output), () => med.process(samples, output));
+
+  const coeffs = biquad("lowpass", 50, 1000, 0.7071);
+  const lowpassJs = biquadJs(coeffs);
+  const lowpass = iir(coeffs);
+  compare("biquad", () => lowpassJs(samples, output), () => lowpass.process(samples, output));
+
+  compare("stats", () => statsJs(samples), () => stats(samples));
+
+  const re = new Float32Array(BLOCK);
+  const im = new Float32Array(BLOCK);
+  const reset = () => {
+    re.set(samples);
+    im.fill(0);
+  };
+  compare(
+    "fft_256",
+    () => {
+      reset();
+      fftJs(re, im);
+    },
+    () => {
+      reset();
+      fft(re, im);
+    }
+  );
+}
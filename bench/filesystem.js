@@ -0,0 +1,46 @@
+// Script filesystem: the cost of the access patterns SPIFFS is slow at.
+// Build the image once per backend ("Script filesystem" in the JavaScript
+// Runtime menu, or profiles.sh) and compare the logs; the "boot" suite has
+// the mount time and how long loading the modules took.
+import { open, readFile, stat } from "fs";
+import { now } from "perf";
+import { report, summarize } from "./harness.js";
+
+const FILE = "harness.js";
+const CHUNK = 64;
+const SEEKS = 50;
+
+async function timed(fn) {
+  const start = now();
+  await fn();
+  return now() - start;
+}
+
+export async function run() {
+  const samples = [];
+  for (let i = 0; i < 10; i++) {
+    samples.push(await timed(() => stat(FILE)));
+  }
+  report("filesystem", "stat", { p50Us: summarize(samples).p50Us });
+
+  const { size } = await stat(FILE);
+  const readUs = await timed(() => readFile(FILE));
+  report("filesystem", "read_whole", { bytes: size, us: readUs });
+
+  const reader = await open(FILE);
+  const chunk = new Uint8Array(CHUNK);
+  const sequentialUs = await timed(async () => {
+    while ((await reader.read(chunk)) > 0) {}
+  });
+  report("filesystem", "read_sequential", { bytes: size, chunk: CHUNK, us: sequentialUs });
+
+  // Backwards strides defeat any read-ahead, like a module loader seeking around.
+  samples.length = 0;
+  for (let i = 0; i < SEEKS; i++) {
+    const position = Math.floor(((SEEKS - i) * (size - CHUNK)) / SEEKS);
+    samples.push(await timed(() => reader.read(chunk, position)));
+  }
+  await reader.close();
+  const { p50Us, maxUs } = summarize(samples);
+  report("filesystem", "read_random", { n: SEEKS, chunk: CHUNK, p50Us, maxUs });
+}
@@ -0,0 +1,59 @@
+// GPIO interrupt to JS callback latency. Needs OUTPUT_PIN wired to INPUT_PIN;
+// the host build does the wiring from host.inject. Also times pin.write(),
+// whose boolean argument takes the binding layer's fast path.
+import { now } from "perf";
+import { setup } from "gpio";
+import { report, summarize, sleep, timeLoop } from "./harness.js";
+
+const OUTPUT_PIN = 18;
+const INPUT_PIN = 19;
+const SAMPLES = 200;
+const TIMEOUT_MS = 100;
+const WRITE_CALLS = 2000;
+
+export async function run() {
+  const out = setup(OUTPUT_PIN, { mode: "output" });
+  const input = setup(INPUT_PIN, { mode: "input", pullMode: "pulldown", interrupt: "rising" });
+  out.write(false);
+
+  report("gpio", "write_call", {
+    booleanUs: timeLoop(WRITE_CALLS, (i) => out.write((i & 1) === 1)),
+    coercedUs: timeLoop(WRITE_CALLS, (i) => out.write(i & 1)),
+  });
+  out.write(false);
+
+  let start = 0;
+  let pending = null;
+  input.attachISR(() => {
+    const latency = now() - start;
+    if (pending) {
+      pending(latency);
+      pending = null;
+    }
+  });
+
+  const samples = [];
+  for (let i = 0; i < SAMPLES; i++) {
+    const edge = new Promise((resolve) => {
+      pending = resolve;
+    });
+    start = now();
+    out.write(true);
+    const latency = await Promise.race([edge, sleep(TIMEOUT_MS).then(() => -1)]);
+    out.write(false);
+    if (latency < 0) {
+      break;
+    }
+    samples.push(latency);
+  }
+
+  input.detachISR();
+  input.close();
+  out.close();
+
+  if (samples.length === 0) {
+    report("gpio", "isr_latency", { skipped: `no edge on ${INPUT_PIN}; wire it to ${OUTPUT_PIN}` });
+    return;
+  }
+  report("gpio", "isr_latency", summarize(samples));
+}
@@ -0,0 +1,39 @@
+// Shared helpers for the benchmark suites. Every result is printed as one
+// `BENCH <json>` line so runs can be collected from a serial log or the host
+// runner's output and compared with compare.py.
+import { now } from "perf";
+
+export function report(suite, name, fields) {
+  const result = { suite, name };
+  for (const key in fields) {
+    const value = fields[key];
+    result[key] = typeof value === "number" ? Math.round(value * 100) / 100 : value;
+  }
+  console.log("BENCH " + JSON.stringify(result));
+}
+
+// Times `iterations` calls of `fn` and returns microseconds per call.
+export function timeLoop(iterations, fn) {
+  const start = now();
+  for (let i = 0; i < iterations; i++) {
+    fn(i);
+  }
+  return (now() - start) / iterations;
+}
+
+// Summarises a list of samples (microseconds) as min/mean/percentiles/max.
+export function summarize(samples) {
+  const sorted = samples.slice().sort((a, b) => a - b);
+  const pick = (q) => sorted[Math.min(sorted.length - 1, Math.floor(q * sorted.length))];
+  const total = sorted.reduce((a, b) => a + b, 0);
+  return {
+    n: sorted.length,
+    minUs: sorted[0],
+    meanUs: total / sorted.length,
+    p50Us: pick(0.5),
+    p99Us: pick(0.99),
+    maxUs: sorted[sorted.length - 1],
+  };
+}
+
+export { sleep } from "timers";
@@ -0,0 +1,41 @@
+// JS heap bytes held by each kind of runtime object, measured after a full GC.
+import { gc, heap } from "perf";
+import { setup } from "gpio";
+import { setTimeout, clearTimeout } from "timers";
+import { report } from "./harness.js";
+
+const PIN_NUMBERS = [21, 22, 23, 25, 26, 27, 32, 33];
+const TIMER_COUNT = 32;
+const OBJECT_COUNT = 100;
+
+function allocated() {
+  gc();
+  return heap().allocated;
+}
+
+function footprint(name, count, create, destroy) {
+  const before = allocated();
+  const held = [];
+  for (let i = 0; i < count; i++) {
+    held.push(create(i));
+  }
+  const after = allocated();
+  held.forEach(destroy);
+  report("heap", name, { n: count, bytesEach: (after - before) / count });
+}
+
+export async function run() {
+  const stats = heap();
+  if (!stats) {
+    report("heap", "footprint", { skipped: "engine built without JERRY_MEM_STATS" });
+    return;
+  }
+
+  // Baselines: the array holding the objects is included in every figure.
+  footprint("object", OBJECT_COUNT, () => ({}), () => {});
+  footprint("closure", OBJECT_COUNT, (i) => () => i, () => {});
+  footprint("pin", PIN_NUMBERS.length, (i) => setup(PIN_NUMBERS[i], { mode: "output" }), (pin) => pin.close());
+  footprint("timer", TIMER_COUNT, () => setTimeout(() => {}, 60000), (id) => clearTimeout(id));
+
+  report("heap", "total", { size: stats.size, allocated: allocated(), peak: heap().peak });
+}
@@ -0,0 +1,48 @@
+// Benchmark suite entry point. On a device, enable "Flash the benchmark
+// suite" in the JavaScript Runtime menu; on the host build run:
+//
+//   ./build-host/js_host bench --inject bench/host.inject > results.log 2>&1
+//
+// Results are `BENCH <json>` lines; compare two runs with
+// `python3 bench/compare.py baseline.log results.log`.
+import { boot, exit, now } from "perf";
+import { report } from "./harness.js";
+import { run as timers } from "./timers.js";
+import { run as gpio } from "./gpio.js";
+import { run as consoleLog } from "./console.js";
+import { run as modules } from "./modules.js";
+import { run as promises } from "./promises.js";
+import { run as heap } from "./heap.js";
+import { run as memory } from "./memory.js";
+import { run as storage } from "./storage.js";
+import { run as filesystem } from "./filesystem.js";
+import { run as buffer } from "./buffer.js";
+import { run as dsp } from "./dsp.js";
+import { run as codec } from "./codec.js";
+
+const SUITES = [timers, gpio, consoleLog, modules, promises, heap, memory, storage, filesystem, buffer, dsp, codec];
+
+// Taken while main.js is evaluated: boot, engine start-up and module loading.
+const bootUs = now();
+const bootFs = boot();
+
+async function main() {
+  report("boot", "toMainJs", { us: bootUs });
+  report("boot", "filesystem", {
+    filesystem: bootFs.filesystem,
+    mountUs: bootFs.mountUs,
+    files: bootFs.filesRead,
+    bytes: bootFs.bytesRead,
+    moduleReadUs: bootFs.readUs,
+  });
+  for (const suite of SUITES) {
+    await suite();
+  }
+  console.log("BENCH_DONE");
+  exit(0);
+}
+
+main().catch((e) => {
+  console.error("Benchmark failed: " + e);
+  exit(1);
+});
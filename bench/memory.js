@@ -0,0 +1,78 @@
+// Heap access and garbage collection speed. The figures depend mostly on
+// where the heap lives, so run the suite once per placement (JavaScript
+// Runtime > JavaScript heap placement) and compare the logs with compare.py.
+import { gc, heap, now } from "perf";
+import { report, summarize, timeLoop } from "./harness.js";
+
+const ACCESS_ITERATIONS = 20000;
+const ARRAY_LENGTH = 1000;
+const BYTES_PER_NODE = 400; // Keeps the live graph near a quarter of the heap
+const DEFAULT_NODES = 300;
+const GC_RUNS = 5;
+
+function timeGc() {
+  const samples = [];
+  for (let i = 0; i < GC_RUNS; i++) {
+    const start = now();
+    gc();
+    samples.push(now() - start);
+  }
+  return summarize(samples);
+}
+
+function buildGraph(count) {
+  let head = null;
+  for (let i = 0; i < count; i++) {
+    head = { id: i, next: head, data: [i, i + 1, i + 2] };
+  }
+  return head;
+}
+
+function propertyAccess(placement) {
+  const point = { x: 1, y: 2, z: 3, w: 4, a: 5, b: 6, c: 7, d: 8 };
+  let sum = 0;
+  const readUs = timeLoop(ACCESS_ITERATIONS, () => {
+    sum += point.x + point.d;
+  });
+  report("memory", "propertyRead", { placement, n: ACCESS_ITERATIONS, nsPerOp: readUs * 1000 });
+
+  const writeUs = timeLoop(ACCESS_ITERATIONS, (i) => {
+    point.z = i;
+  });
+  report("memory", "propertyWrite", { placement, n: ACCESS_ITERATIONS, nsPerOp: writeUs * 1000 });
+
+  const keys = Object.keys(point);
+  const dynamicUs = timeLoop(ACCESS_ITERATIONS, (i) => {
+    sum += point[keys[i & 7]];
+  });
+  report("memory", "propertyDynamic", { placement, n: ACCESS_ITERATIONS, nsPerOp: dynamicUs * 1000 });
+
+  const array = Array.from({ length: ARRAY_LENGTH }, (_, i) => i);
+  const arrayUs = timeLoop(ACCESS_ITERATIONS, (i) => {
+    sum += array[i % ARRAY_LENGTH];
+  });
+  report("memory", "arrayIndex", { placement, n: ACCESS_ITERATIONS, nsPerOp: arrayUs * 1000 });
+  return sum;
+}
+
+export async function run() {
+  const stats = heap();
+  const placement = stats ? stats.placement : "unknown";
+  const nodes = stats ? Math.floor(stats.size / BYTES_PER_NODE) : DEFAULT_NODES;
+
+  propertyAccess(placement);
+
+  const allocUs = timeLoop(ACCESS_ITERATIONS, (i) => ({ i }));
+  report("memory", "allocate", { placement, n: ACCESS_ITERATIONS, nsPerOp: allocUs * 1000 });
+
+  report("memory", "gcIdle", Object.assign({ placement }, timeGc()));
+
+  let graph = buildGraph(nodes);
+  report("memory", "gcLive", Object.assign({ placement, nodes }, timeGc()));
+
+  // One collection that has to sweep the whole graph once it is dead.
+  graph = null;
+  const start = now();
+  gc();
+  report("memory", "gcGarbage", { placement, nodes, us: now() - start });
+}
@@ -0,0 +1,32 @@
+// Native module import cost and file module read/parse cost.
+import { importNative, parseModule } from "perf";
+import { report, summarize } from "./harness.js";
+
+const NATIVE_MODULES = ["console", "timers", "gpio", "i2c", "spi", "perf"];
+const FILE_MODULES = ["harness.js", "timers.js", "gpio.js", "main.js"];
+const REPEATS = 10;
+
+export async function run() {
+  for (const name of NATIVE_MODULES) {
+    const samples = [];
+    for (let i = 0; i < REPEATS; i++) {
+      samples.push(importNative(name));
+    }
+    const { p50Us, maxUs } = summarize(samples);
+    report("modules", "import_" + name, { p50Us, maxUs });
+  }
+
+  for (const path of FILE_MODULES) {
+    const samples = [];
+    let bytes = 0;
+    let readUs = 0;
+    for (let i = 0; i < REPEATS; i++) {
+      const result = parseModule(path);
+      bytes = result.bytes;
+      readUs += result.readUs / REPEATS;
+      samples.push(result.parseUs);
+    }
+    const { p50Us } = summarize(samples);
+    report("modules", "parse_" + path, { bytes, readUs, parseUs: p50Us, parseUsPerKB: (p50Us * 1024) / bytes });
+  }
+}
@@ -0,0 +1,31 @@
+#!/bin/sh
+# Builds the benchmark image three times: with the project's engine
+# configuration, with the "production-fast" preset (sdkconfig.production),
+# and with the scripts on LittleFS instead of SPIFFS (sdkconfig.littlefs),
+# and prints the flash footprint of each. Flash each build, capture its serial
+# log and compare them with compare.py; the "boot" suite gives the time to
+# main.js, the mount time and module read time, and the "filesystem" suite the
+# cost of random access.
+#
+#   bench/profiles.sh            # from the project root
+#   idf.py -B build-production flash monitor | tee production.log
+set -e
+
+cd "$(dirname "$0")/.."
+BENCH_DEFAULTS=bench/sdkconfig.bench
+PROFILES="default production littlefs"
+
+for profile in $PROFILES; do
+  defaults="sdkconfig;$BENCH_DEFAULTS"
+  if [ "$profile" = production ]; then
+    defaults="$defaults;sdkconfig.production"
+  elif [ "$profile" = littlefs ]; then
+    defaults="$defaults;bench/sdkconfig.littlefs"
+  fi
+  idf.py -B "build-$profile" -D SDKCONFIG="build-$profile/sdkconfig" -D SDKCONFIG_DEFAULTS="$defaults" build
+done
+
+for profile in $PROFILES; do
+  echo "== $profile"
+  idf.py -B "build-$profile" size
+done
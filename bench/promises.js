@@ -0,0 +1,33 @@
+// Promise job throughput through jerry_run_jobs().
+import { now } from "perf";
+import { report } from "./harness.js";
+
+const CHAIN_LENGTH = 2000;
+const FAN_OUT = 500;
+
+export async function run() {
+  let start = now();
+  let p = Promise.resolve(0);
+  for (let i = 0; i < CHAIN_LENGTH; i++) {
+    p = p.then((n) => n + 1);
+  }
+  await p;
+  let us = now() - start;
+  report("promises", "then_chain", { n: CHAIN_LENGTH, usPerJob: us / CHAIN_LENGTH, jobsPerSec: (CHAIN_LENGTH * 1e6) / us });
+
+  start = now();
+  const all = [];
+  for (let i = 0; i < FAN_OUT; i++) {
+    all.push(new Promise((resolve) => resolve(i)));
+  }
+  await Promise.all(all);
+  us = now() - start;
+  report("promises", "all_fan_out", { n: FAN_OUT, usPerPromise: us / FAN_OUT });
+
+  start = now();
+  for (let i = 0; i < FAN_OUT; i++) {
+    await i;
+  }
+  us = now() - start;
+  report("promises", "await_loop", { n: FAN_OUT, usPerAwait: us / FAN_OUT });
+}
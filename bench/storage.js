@@ -0,0 +1,31 @@
+// NVS storage: cached writes and reads against committed ones. On the host
+// build commits go to RAM, so only the cached numbers are meaningful there.
+import * as storage from "storage";
+import { now } from "perf";
+import { report, timeLoop } from "./harness.js";
+
+const CACHED_ITERATIONS = 500;
+const COMMIT_ITERATIONS = 20;
+const KEY = "bench";
+
+export async function run() {
+  const setUs = timeLoop(CACHED_ITERATIONS, (i) => storage.set(KEY, i));
+  const getUs = timeLoop(CACHED_ITERATIONS, () => storage.get(KEY));
+  report("storage", "set_cached", { n: CACHED_ITERATIONS, usPerOp: setUs });
+  report("storage", "get_cached", { n: CACHED_ITERATIONS, usPerOp: getUs });
+
+  const flushUs = timeLoop(COMMIT_ITERATIONS, (i) => {
+    storage.set(KEY, -i - 1);
+    storage.flush();
+  });
+  report("storage", "set_flush", { n: COMMIT_ITERATIONS, usPerOp: flushUs });
+
+  const start = now();
+  for (let i = 0; i < COMMIT_ITERATIONS; i++) {
+    await storage.setAsync(KEY, i + 0.5);
+  }
+  report("storage", "set_async", { n: COMMIT_ITERATIONS, usPerOp: (now() - start) / COMMIT_ITERATIONS });
+
+  storage.delete(KEY);
+  storage.flush();
+}
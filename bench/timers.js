@@ -0,0 +1,103 @@
+// Timer bookkeeping and event-loop dispatch cost.
+import { now } from "perf";
+import { setTimeout, clearTimeout, setInterval, clearInterval, setImmediate, sleep, every, yield as yieldNow } from "timers";
+import { report, timeLoop } from "./harness.js";
+
+const SET_CLEAR_ITERATIONS = 500;
+const DISPATCH_ITERATIONS = 200;
+
+function noop() {}
+
+// Each timeout schedules the next, so only one timer event is ever queued.
+function dispatchChain(count) {
+  return new Promise((resolve) => {
+    let remaining = count;
+    const start = now();
+    function tick() {
+      if (--remaining === 0) {
+        resolve((now() - start) / count);
+      } else {
+        setTimeout(tick, 0);
+      }
+    }
+    setTimeout(tick, 0);
+  });
+}
+
+// The same chain through promises: a closure-wrapped setTimeout against the
+// native sleep(), which resolves its promise without calling back into JS.
+async function awaitChain(count, wait) {
+  const start = now();
+  for (let i = 0; i < count; i++) {
+    await wait();
+  }
+  return (now() - start) / count;
+}
+
+function immediateChain(count) {
+  return new Promise((resolve) => {
+    let remaining = count;
+    const start = now();
+    function tick() {
+      if (--remaining === 0) {
+        resolve((now() - start) / count);
+      } else {
+        setImmediate(tick);
+      }
+    }
+    setImmediate(tick);
+  });
+}
+
+async function tickChain(count) {
+  const start = now();
+  for await (const tick of every(1)) {
+    if (tick >= count) break;
+  }
+  return (now() - start) / count;
+}
+
+// Lateness of a paced interval: how long after its slot each tick ran.
+function pacedLateness(count, periodMs) {
+  return new Promise((resolve) => {
+    let lateUs = 0;
+    let missed = 0;
+    const id = setInterval(
+      (tick) => {
+        lateUs += tick.actual - tick.scheduled;
+        missed += tick.missed;
+        if (tick.tick >= count) {
+          clearInterval(id);
+          resolve({ lateUs: lateUs / count, missed });
+        }
+      },
+      periodMs,
+      { policy: "skip" },
+    );
+  });
+}
+
+export async function run() {
+  const setClearUs = timeLoop(SET_CLEAR_ITERATIONS, () => clearTimeout(setTimeout(noop, 1000)));
+  report("timers", "set_clear", { n: SET_CLEAR_ITERATIONS, usPerOp: setClearUs, opsPerSec: 1e6 / setClearUs });
+
+  const dispatchUs = await dispatchChain(DISPATCH_ITERATIONS);
+  report("timers", "dispatch", { n: DISPATCH_ITERATIONS, usPerOp: dispatchUs, opsPerSec: 1e6 / dispatchUs });
+
+  const immediateUs = await immediateChain(DISPATCH_ITERATIONS);
+  report("timers", "immediate", { n: DISPATCH_ITERATIONS, usPerOp: immediateUs, opsPerSec: 1e6 / immediateUs });
+  const yieldUs = await awaitChain(DISPATCH_ITERATIONS, yieldNow);
+  report("timers", "await_yield", { n: DISPATCH_ITERATIONS, usPerOp: yieldUs });
+
+  const wrappedUs = await awaitChain(DISPATCH_ITERATIONS, () => new Promise((resolve) => setTimeout(resolve, 0)));
+  const sleepUs = await awaitChain(DISPATCH_ITERATIONS, () => sleep(0));
+  report("timers", "await_wrapped", { n: DISPATCH_ITERATIONS, usPerOp: wrappedUs });
+  report("timers", "await_sleep", { n: DISPATCH_ITERATIONS, usPerOp: sleepUs });
+
+  // Bounded below by the 1 ms period; the overhead is what exceeds it.
+  const tickUs = await tickChain(DISPATCH_ITERATIONS);
+  report("timers", "every_1ms", { n: DISPATCH_ITERATIONS, usPerTick: tickUs, overheadUs: tickUs - 1000 });
+
+  const paced = await pacedLateness(DISPATCH_ITERATIONS, 0.5);
+  report("timers", "paced_500us", { n: DISPATCH_ITERATIONS, lateUs: paced.lateUs, missed: paced.missed });
+}
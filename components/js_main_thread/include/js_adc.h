@@ -0,0 +1,92 @@
+#ifndef JS_ADC_H
+#define JS_ADC_H
+
+#include <stdbool.h>
+#include "driver/gpio.h"
+#include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_cali.h"
+#include "jerryscript.h"
+#include "js_event.h"
+
+#define JS_ADC_FRAME_BYTES 256 // Bytes the DMA engine fills before raising a conversion-done interrupt
+#define JS_ADC_POOL_BYTES 4096 // Size of the driver's ring buffer between DMA and the reducer
+
+/**
+ * @brief How a group of `decimation` raw samples is reduced to one output sample.
+ */
+typedef enum
+{
+  JS_ADC_REDUCE_AVERAGE,
+  JS_ADC_REDUCE_MIN,
+  JS_ADC_REDUCE_MAX,
+  JS_ADC_REDUCE_DECIMATE, /**< Keep the first sample of each group. */
+} js_adc_reduce_t;
+
+/**
+ * @brief Represents a pin opened for one-shot analog reads.
+ */
+typedef struct
+{
+  gpio_num_t pin_num;
+  adc_unit_t unit;
+  adc_channel_t channel;
+  adc_atten_t atten;
+  adc_cali_handle_t cali; /**< NULL if no calibration scheme is available for this chip. */
+} js_adc_pin_t;
+
+/**
+ * @brief Options for continuous (DMA) sampling of one pin.
+ */
+typedef struct
+{
+  gpio_num_t pin_num;
+  adc_atten_t atten;
+  uint32_t sample_rate_hz; /**< Hardware conversion rate; clamped to what the chip supports. */
+  uint32_t decimation;     /**< Raw samples reduced into each output sample. */
+  js_adc_reduce_t reduce;
+  uint32_t block_size; /**< Output samples delivered per callback. */
+} js_adc_stream_config_t;
+
+/**
+ * @brief Opens a pin for one-shot reads.
+ */
+esp_err_t js_adc_open(gpio_num_t pin_num, adc_atten_t atten, js_adc_pin_t **out_pin);
+
+/**
+ * @brief Performs a one-shot conversion and returns the raw reading.
+ */
+esp_err_t js_adc_read_raw(js_adc_pin_t *pin, int *out_raw);
+
+/**
+ * @brief Performs a one-shot conversion and returns the calibrated voltage in millivolts.
+ */
+esp_err_t js_adc_read_mv(js_adc_pin_t *pin, int *out_mv);
+
+/**
+ * @brief Releases a one-shot pin, and its ADC unit if no other pin uses it.
+ */
+void js_adc_close(js_adc_pin_t *pin);
+
+/**
+ * @brief Starts continuous sampling, calling `callback` with a Uint16Array per block.
+ *
+ * Only one stream can run at a time, as the ADC DMA engine is shared.
+ */
+esp_err_t js_adc_stream_start(const js_adc_stream_config_t *config, jerry_value_t callback);
+
+/**
+ * @brief Stops continuous sampling and releases the DMA engine.
+ */
+void js_adc_stream_stop(void);
+
+/**
+ * @brief Returns how many times the driver's pool overflowed since the stream started.
+ */
+uint32_t js_adc_stream_overruns(void);
+
+/**
+ * @brief Dispatches an ADC event from the main JS event loop.
+ */
+void js_adc_dispatch_event(js_event_t *event);
+
+#endif /* JS_ADC_H */
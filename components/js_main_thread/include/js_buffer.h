@@ -0,0 +1,134 @@
+#ifndef JS_BUFFER_H
+#define JS_BUFFER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#define JS_BUFFER_MAX_FIELDS 64 // Fields a layout may describe, counting each repeat
+
+/**
+ * @brief CRC-8 with polynomial 0x07, unreflected (CRC-8/SMBUS when `crc` starts at 0).
+ * @param crc The CRC of the preceding bytes, to continue a checksum over several chunks.
+ */
+uint8_t js_buffer_crc8(uint8_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief CRC-16 with polynomial 0x1021, unreflected (CRC-16/CCITT-FALSE when `crc` starts at 0xFFFF).
+ */
+uint16_t js_buffer_crc16_ccitt(uint16_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief CRC-16 with polynomial 0x8005, reflected (CRC-16/MODBUS when `crc` starts at 0xFFFF).
+ */
+uint16_t js_buffer_crc16_modbus(uint16_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief The CRC-32 of zlib and Ethernet. `crc` is the previous result, 0 to start.
+ */
+uint32_t js_buffer_crc32(uint32_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief Length of the padded base64 encoding of `len` bytes.
+ */
+static inline size_t js_buffer_base64_size(size_t len)
+{
+  return (len + 2) / 3 * 4;
+}
+
+/**
+ * @brief Writes the padded base64 encoding of `data` to `out`, which holds js_buffer_base64_size(len) bytes.
+ */
+void js_buffer_base64_encode(const uint8_t *data, size_t len, char *out);
+
+/**
+ * @brief Decodes base64, padded or not, into `out`.
+ *
+ * Whitespace is skipped. Decoding in place (`out` == `text`) is allowed,
+ * since the output never overtakes the input.
+ * @param out_len The room in `out`; receives the number of bytes written.
+ * @return ESP_ERR_INVALID_ARG on a character outside the alphabet, anything
+ * but padding after padding, or padding that does not complete the last
+ * group; ESP_ERR_INVALID_SIZE if `out` is too small.
+ */
+esp_err_t js_buffer_base64_decode(const char *text, size_t len, uint8_t *out, size_t *out_len);
+
+/**
+ * @brief Writes two lowercase hex digits per byte of `data` to `out`.
+ */
+void js_buffer_hex_encode(const uint8_t *data, size_t len, char *out);
+
+/**
+ * @brief Decodes hex digits, either case, into `out`. In-place decoding is allowed.
+ * @param out_len The room in `out`; receives the number of bytes written.
+ * @return ESP_ERR_INVALID_ARG on an odd length or a non-hex character,
+ * ESP_ERR_INVALID_SIZE if `out` is too small.
+ */
+esp_err_t js_buffer_hex_decode(const char *text, size_t len, uint8_t *out, size_t *out_len);
+
+/**
+ * @brief The type of one field of a layout.
+ */
+typedef enum
+{
+  JS_BUFFER_INT8,
+  JS_BUFFER_UINT8,
+  JS_BUFFER_BOOL,
+  JS_BUFFER_INT16,
+  JS_BUFFER_UINT16,
+  JS_BUFFER_INT32,
+  JS_BUFFER_UINT32,
+  JS_BUFFER_INT64,
+  JS_BUFFER_UINT64,
+  JS_BUFFER_FLOAT32,
+  JS_BUFFER_FLOAT64,
+  JS_BUFFER_BYTES, /**< A run of raw bytes, `size` long. */
+} js_buffer_type_t;
+
+typedef struct
+{
+  uint8_t type; /**< A js_buffer_type_t. */
+  uint16_t offset;
+  uint16_t size;
+} js_buffer_field_t;
+
+/**
+ * @brief A struct layout compiled from a format string, ready to pack and unpack.
+ */
+typedef struct
+{
+  bool little_endian;
+  uint16_t size;  /**< Bytes the whole struct takes. */
+  uint16_t count; /**< Fields in `fields`, excluding padding. */
+  js_buffer_field_t fields[];
+} js_buffer_layout_t;
+
+/**
+ * @brief Compiles a format string in the notation of Python's `struct` module.
+ *
+ * An optional first character sets the byte order: `<` little-endian (the
+ * default), `>` or `!` big-endian. Then come fields, each optionally preceded
+ * by a repeat count: `x` pad byte, `b`/`B` 8-bit, `?` bool, `h`/`H` 16-bit,
+ * `i`/`I`/`l`/`L` 32-bit, `q`/`Q` 64-bit, `f` float, `d` double, uppercase
+ * unsigned. `Ns` is one field of N raw bytes. Fields are packed without
+ * alignment; spaces are ignored.
+ *
+ * @param out Receives a malloc()ed layout, released with free().
+ * @return ESP_ERR_INVALID_ARG on an unknown character, ESP_ERR_INVALID_SIZE
+ * past JS_BUFFER_MAX_FIELDS fields or 65535 bytes.
+ */
+esp_err_t js_buffer_layout_compile(const char *format, size_t len, js_buffer_layout_t **out);
+
+/**
+ * @brief Reads a numeric field of a struct starting at `base`.
+ */
+double js_buffer_read_field(const js_buffer_layout_t *layout, const js_buffer_field_t *field, const uint8_t *base);
+
+/**
+ * @brief Writes a numeric field of a struct starting at `base`, wrapping integers like a typed array.
+ */
+void js_buffer_write_field(const js_buffer_layout_t *layout, const js_buffer_field_t *field, uint8_t *base,
+                           double value);
+
+#endif /* JS_BUFFER_H */
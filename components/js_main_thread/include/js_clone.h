@@ -0,0 +1,33 @@
+#ifndef JS_CLONE_H
+#define JS_CLONE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "jerryscript.h"
+
+#define JS_CLONE_MAX_DEPTH 8 // Nesting limit, which also stops cycles
+
+/**
+ * @brief Encodes a value so it can be rebuilt in another JerryScript context.
+ *
+ * A subset of the structured clone algorithm: undefined, null, booleans,
+ * numbers, strings, ArrayBuffers, typed arrays, arrays and plain objects
+ * (own enumerable string keys). Buffers are copied, and shared or repeated
+ * references arrive as separate copies.
+ *
+ * @param reserve Bytes left free at the start of the buffer for the caller's header.
+ * @param out Receives a malloc()ed buffer; the encoding starts at `*out + reserve`.
+ * @param out_len Receives the length of the encoding, excluding `reserve`.
+ * @return undefined on success, or an exception (TypeError for values that
+ * cannot be cloned, RangeError for nesting past JS_CLONE_MAX_DEPTH).
+ */
+jerry_value_t js_clone_serialize(jerry_value_t value, size_t reserve, uint8_t **out, size_t *out_len);
+
+/**
+ * @brief Rebuilds a value encoded by js_clone_serialize() in the current context.
+ *
+ * @return The value, or an exception if the encoding is malformed.
+ */
+jerry_value_t js_clone_deserialize(const uint8_t *data, size_t len);
+
+#endif /* JS_CLONE_H */
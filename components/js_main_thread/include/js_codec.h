@@ -0,0 +1,72 @@
+#ifndef JS_CODEC_H
+#define JS_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "jerryscript.h"
+
+#define JS_CODEC_MAX_DEPTH 16 // Nesting limit, which also stops cycles
+#define JS_CODEC_MAX_KEYS 64  // Keys a schema may list
+
+typedef enum
+{
+  JS_CODEC_CBOR, /**< RFC 8949, with RFC 8746 tags for typed arrays. */
+  JS_CODEC_JSON, /**< Compact JSON, UTF-8, no whitespace. */
+} js_codec_format_t;
+
+/**
+ * @brief The keys of an object compiled once, with each key pre-encoded in
+ * both formats.
+ */
+typedef struct js_codec_schema js_codec_schema_t;
+
+/**
+ * @brief Compiles an array of key strings into a schema.
+ *
+ * @param out Receives a malloc()ed schema, released with free().
+ * @return ESP_ERR_INVALID_ARG if a key is not a string, ESP_ERR_INVALID_SIZE
+ * past JS_CODEC_MAX_KEYS keys, ESP_ERR_NO_MEM if out of memory.
+ */
+esp_err_t js_codec_schema_compile(jerry_value_t keys, js_codec_schema_t **out);
+
+/**
+ * @brief Encodes a value straight into `out`, without building a string.
+ *
+ * Handles undefined, null, booleans, numbers, strings, ArrayBuffers, typed
+ * arrays, arrays and plain objects (own enumerable string keys). JSON
+ * follows JSON.stringify: undefined properties are left out, undefined
+ * array elements and non-finite numbers become null, and typed arrays and
+ * ArrayBuffers become arrays of numbers.
+ *
+ * With a schema, the top-level value must be an object and only the
+ * schema's keys are written, in schema order. `keys` is the array the
+ * schema was compiled from; its strings are used to read the properties.
+ *
+ * @param out Where to write, or NULL to only measure the encoding.
+ * @param out_len Receives the length of the encoding, even when it does not fit.
+ * @return undefined on success, or an exception: RangeError when the
+ * encoding is longer than `cap` or nested past JS_CODEC_MAX_DEPTH,
+ * TypeError for values that cannot be encoded.
+ */
+jerry_value_t js_codec_encode(js_codec_format_t format, jerry_value_t value, const js_codec_schema_t *schema,
+                              jerry_value_t keys, uint8_t *out, size_t cap, size_t *out_len);
+
+/**
+ * @brief Decodes one value that fills all of `data`.
+ *
+ * CBOR byte strings become ArrayBuffers, and RFC 8746 typed array tags
+ * typed arrays; other tags are skipped. Map keys must be strings or
+ * integers. Indefinite-length arrays and maps are accepted, indefinite
+ * strings are not.
+ *
+ * With a schema, map keys that match one of its keys reuse the string from
+ * `keys` instead of creating a new one.
+ *
+ * @return The value, or a SyntaxError if the input is malformed or a string
+ * in it is not valid UTF-8.
+ */
+jerry_value_t js_codec_decode(js_codec_format_t format, const uint8_t *data, size_t len,
+                              const js_codec_schema_t *schema, jerry_value_t keys);
+
+#endif /* JS_CODEC_H */
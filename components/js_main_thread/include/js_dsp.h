@@ -0,0 +1,121 @@
+#ifndef JS_DSP_H
+#define JS_DSP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#define JS_DSP_MAX_WINDOW 1024  // Longest moving average or median window
+#define JS_DSP_MAX_TAPS 256     // Most FIR taps
+#define JS_DSP_MAX_SECTIONS 8   // Most biquad sections in one IIR filter
+#define JS_DSP_MAX_FFT 4096     // Largest FFT, in complex points
+
+/**
+ * @brief A filter with its state: every sample it is given depends on the ones before.
+ */
+typedef struct js_dsp_filter js_dsp_filter_t;
+
+/**
+ * @brief A cascade of biquad sections, each given as five coefficients
+ * `b0, b1, b2, a1, a2` (a0 normalised to 1), the layout ESP-DSP uses.
+ * @return The filter, or NULL if out of memory.
+ */
+js_dsp_filter_t *js_dsp_iir_new(const float *coeffs, size_t sections);
+
+/**
+ * @brief A FIR filter; `coeffs[0]` weighs the newest sample.
+ */
+js_dsp_filter_t *js_dsp_fir_new(const float *coeffs, size_t taps);
+
+/**
+ * @brief The mean of the last `window` samples, or of all of them until that many have been seen.
+ */
+js_dsp_filter_t *js_dsp_moving_average_new(size_t window);
+
+/**
+ * @brief The median of the last `window` samples, or of all of them until that many have been seen.
+ *
+ * The window is kept sorted, so each sample costs a binary search and a
+ * memmove rather than a sort.
+ */
+js_dsp_filter_t *js_dsp_median_new(size_t window);
+
+/**
+ * @brief Filters one sample.
+ */
+float js_dsp_filter_step(js_dsp_filter_t *filter, float x);
+
+/**
+ * @brief Filters a block of samples. `out` may be `in`.
+ */
+void js_dsp_filter_run(js_dsp_filter_t *filter, const float *in, float *out, size_t len);
+
+/**
+ * @brief Forgets every sample seen so far.
+ */
+void js_dsp_filter_reset(js_dsp_filter_t *filter);
+
+void js_dsp_filter_free(js_dsp_filter_t *filter);
+
+/**
+ * @brief Designs a biquad section from the Audio EQ Cookbook formulas.
+ *
+ * @param type "lowpass", "highpass", "bandpass" or "notch".
+ * @param out Receives `b0, b1, b2, a1, a2`.
+ * @return ESP_ERR_INVALID_ARG for an unknown type or a frequency not below
+ * half the sample rate.
+ */
+esp_err_t js_dsp_biquad_design(const char *type, float cutoff, float sample_rate, float q, float out[5]);
+
+/**
+ * @brief Summary statistics of a block of samples.
+ */
+typedef struct
+{
+  float min;
+  float max;
+  size_t min_index;
+  size_t max_index;
+  double mean;
+  double rms;
+  double std; /**< Population standard deviation. */
+} js_dsp_stats_t;
+
+/**
+ * @brief Computes the statistics of `len` samples in one pass. `len` must not be 0.
+ */
+void js_dsp_stats(const float *data, size_t len, js_dsp_stats_t *out);
+
+/**
+ * @brief Finds local maxima above `threshold`, at least `min_distance` samples apart.
+ *
+ * Of two peaks closer than that, the higher one is kept.
+ * @param out Receives up to `max_peaks` indices, in order.
+ * @return The number of peaks written.
+ */
+size_t js_dsp_peaks(const float *data, size_t len, float threshold, size_t min_distance, uint32_t *out,
+                    size_t max_peaks);
+
+/**
+ * @brief In-place radix-2 FFT of `n` complex points stored as interleaved
+ * real and imaginary parts, as ESP-DSP's dsps_fft2r_fc32() takes them.
+ *
+ * The output is in natural order. With CONFIG_JS_DSP_ESP_DSP the optimised
+ * ESP-DSP kernels are used.
+ * @return ESP_ERR_INVALID_ARG unless `n` is a power of two up to JS_DSP_MAX_FFT.
+ */
+esp_err_t js_dsp_fft(float *data, size_t n);
+
+/**
+ * @brief The amplitude spectrum of `n` real samples, `n` a power of two.
+ *
+ * Bin k of `out` (n / 2 bins) is the amplitude at k * sampleRate / n,
+ * scaled so a full-scale sine of amplitude A reads A. A Hann window is
+ * applied first when `hann` is set.
+ * @param work Scratch space of 2 * n floats.
+ */
+esp_err_t js_dsp_spectrum(const float *samples, size_t n, bool hann, float *work, float *out);
+
+#endif /* JS_DSP_H */
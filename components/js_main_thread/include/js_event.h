@@ -1,6 +1,7 @@
 #ifndef JS_EVENT_H
 #define JS_EVENT_H
 #include <stdint.h>
+#include "sdkconfig.h"
 
 /**
  * @brief Defines the types of events that can be posted to the main JS event queue.
@@ -10,9 +11,19 @@
  */
 typedef enum
 {
-  JS_EVENT_TIMER, /**< An event originating from a timer created with setTimeout or setInterval. */
-  JS_EVENT_GPIO,  /**< An event originating from a GPIO interrupt. */
-  // later: JS_EVENT_HTTP, JS_EVENT_ADC, etc.
+  JS_EVENT_TIMER,   /**< An event originating from a timer created with setTimeout or setInterval. */
+  JS_EVENT_GPIO,    /**< An event originating from a GPIO interrupt. */
+  JS_EVENT_RMT,     /**< RMT transmissions finished or a frame was received; the channel records which. */
+  JS_EVENT_ADC,     /**< Continuous ADC conversions are waiting in the driver's pool. */
+  JS_EVENT_I2C,     /**< An I2C bus worker finished a request. `data` points to the js_i2c_request_t. */
+  JS_EVENT_SPI,     /**< SPI transfers of a device finished, in queue order; the device counts them. */
+  JS_EVENT_SERIAL,  /**< A UART has bytes to read or TX space again. `data` holds a js_serial_event_kind_t. */
+  JS_EVENT_OFFLOAD, /**< Workers finished offloaded jobs; they wait in the offload module. */
+  JS_EVENT_WORKER,  /**< A js_message_t in `data` on the channel of worker `handle_id`; NULL when a worker exits or is told to stop. */
+  JS_EVENT_STORAGE, /**< Storage commits finished, or the write-back timer expired. */
+  JS_EVENT_FS,      /**< A file request finished (`data` is the request) or a log's flush timer expired (`data` is NULL). */
+  JS_EVENT_NET,     /**< A socket is readable, or writable after a connect or short write. `data` holds a js_net_event_kind_t. */
+  // later: JS_EVENT_HTTP, etc.
 } js_event_type_t;
 
 /**
@@ -26,5 +37,8 @@ typedef struct
   js_event_type_t type; /**< The category of the event. */
   uint32_t handle_id;   /**< A unique ID to identify the source of the event (e.g., which timer fired). */
   void *data;           /**< An optional payload carrying extra data for the event. NULL for timers. */
+#if CONFIG_JS_LATENCY_TRACE
+  uint32_t isr_time_us; /**< Low 32 bits of esp_timer_get_time() when a GPIO ISR posted the event. */
+#endif
 } js_event_t;
 #endif
\ No newline at end of file
@@ -0,0 +1,158 @@
+#ifndef JS_FS_H
+#define JS_FS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "esp_err.h"
+#include "jerryscript.h"
+#include "js_event.h"
+#include "sdkconfig.h"
+
+#define JS_FS_MAX_PATH 64            // Full path, including the script directory
+#define JS_FS_QUEUE_DEPTH 8          // Requests that may wait for the I/O task
+#define JS_FS_TASK_STACK 4096
+#define JS_FS_TASK_PRIORITY 5
+#define JS_FS_TASK_CORE 0            // The JS thread runs on core 1
+#define JS_FS_MAX_LOGS 2             // Log writers open at once
+#define JS_FS_LOG_DEFAULT_BUFFER 1024
+#define JS_FS_LOG_MAX_BUFFER 16384
+#define JS_FS_LOG_DEFAULT_FLUSH_MS 1000
+#define JS_FS_LOG_RETRY_MS 10        // Flush timer re-arm delay while the event queue is full
+
+/**
+ * @brief What the I/O task does with a request.
+ */
+typedef enum
+{
+  JS_FS_READ_FILE,  /**< Reads the whole file into a new buffer; resolves with an ArrayBuffer or string. */
+  JS_FS_WRITE_FILE, /**< Replaces the file with `data`. */
+  JS_FS_APPEND,     /**< Appends `data`, creating the file if needed. */
+  JS_FS_STAT,       /**< Resolves with `{ size, isDirectory, mtimeMs }`. */
+  JS_FS_READDIR,    /**< Resolves with the names in a directory. */
+  JS_FS_OPEN,       /**< Opens a file for chunked reads; the module wraps `file` in a reader. */
+  JS_FS_READ,       /**< Reads up to `len` bytes of `file` into `data`; resolves with the count. */
+  JS_FS_CLOSE,      /**< Closes `file`. */
+} js_fs_op_t;
+
+/**
+ * @brief One filesystem operation, owned by the runtime from submission until it settles.
+ *
+ * Fields up to `promise` are filled in on the JS thread; the I/O task only
+ * touches the results. `data` either points into the buffer held by
+ * `target`, or is owned by the request when `owns_data` is set.
+ */
+typedef struct js_fs_request
+{
+  js_fs_op_t op;
+  char path[JS_FS_MAX_PATH];
+  FILE *file;       /**< The open file of a reader, for JS_FS_READ and JS_FS_CLOSE. */
+  uint8_t *data;    /**< Bytes to write, or where to read into. */
+  size_t len;       /**< Bytes in, or room in, `data`. */
+  bool owns_data;   /**< free() `data` along with the request. */
+  bool as_text;     /**< JS_FS_READ_FILE resolves with a UTF-8 string. */
+  long position;    /**< JS_FS_READ seeks here first; -1 continues where the last read ended. */
+  uint32_t log_id;  /**< The log writer a JS_FS_APPEND flushes, or 0. */
+
+  jerry_value_t promise; /**< Settled on the JS thread; undefined if nobody waits. */
+  jerry_value_t target;  /**< Keeps the buffer behind `data` alive. */
+  jerry_value_t owner;   /**< Keeps the reader object behind `file` alive. */
+
+  // Results, written by the I/O task
+  int error;             /**< errno of the call that failed, 0 on success. */
+  size_t result_len;     /**< Bytes read or written. */
+  uint64_t stat_size;
+  bool stat_is_directory;
+  int64_t stat_mtime_ms;
+} js_fs_request_t;
+
+/**
+ * @brief Converts an open reader to the JS object `fs.open()` resolves with.
+ *
+ * Set by the 'fs' module, which owns the reader's native object.
+ */
+typedef jerry_value_t (*js_fs_reader_factory_t)(FILE *file, const char *path);
+
+/**
+ * @brief Starts the I/O task.
+ */
+void js_fs_init(void);
+
+/**
+ * @brief Allocates a request with every JS value set to undefined.
+ */
+js_fs_request_t *js_fs_request_new(js_fs_op_t op);
+
+/**
+ * @brief Frees a request that was never submitted, or has been dispatched.
+ */
+void js_fs_request_free(js_fs_request_t *request);
+
+/**
+ * @brief Queues a request for the I/O task without blocking.
+ *
+ * @return ESP_ERR_NO_MEM if the queue is full; the request is then still the caller's.
+ */
+esp_err_t js_fs_submit(js_fs_request_t *request);
+
+/**
+ * @brief Sets how JS_FS_OPEN results are wrapped.
+ */
+void js_fs_set_reader_factory(js_fs_reader_factory_t factory);
+
+/**
+ * @brief Counters of a log writer.
+ */
+typedef struct
+{
+  size_t buffered; /**< Bytes waiting in RAM. */
+  size_t written;  /**< Bytes appended to the file so far. */
+  size_t dropped;  /**< Bytes refused because the buffer was full while a flush was in flight. */
+  uint32_t flushes;
+} js_fs_log_stats_t;
+
+/**
+ * @brief Opens an append-only log writer on `path`, which must be a full path.
+ *
+ * Writes are buffered in RAM and appended on the I/O task when the buffer
+ * fills or `flush_ms` after the first buffered write.
+ *
+ * @return ESP_ERR_NOT_FOUND if JS_FS_MAX_LOGS writers are open, ESP_ERR_NO_MEM
+ * if the buffer or timer could not be created.
+ */
+esp_err_t js_fs_log_open(const char *path, size_t buffer_size, uint32_t flush_ms, uint32_t *out_id);
+
+/**
+ * @brief Buffers `len` bytes for the log. Never blocks.
+ *
+ * @return ESP_ERR_INVALID_SIZE if `len` exceeds the buffer size,
+ * ESP_ERR_NO_MEM if the buffer is full and a flush is still in flight (the
+ * bytes are dropped and counted), ESP_ERR_NOT_FOUND if the log is closed.
+ */
+esp_err_t js_fs_log_write(uint32_t id, const uint8_t *data, size_t len);
+
+/**
+ * @brief Appends what is buffered. `promise`, if not undefined, settles once it is in the file.
+ */
+esp_err_t js_fs_log_flush(uint32_t id, jerry_value_t promise);
+
+/**
+ * @brief Flushes and closes the log. Later writes return ESP_ERR_NOT_FOUND.
+ */
+esp_err_t js_fs_log_close(uint32_t id, jerry_value_t promise);
+
+/**
+ * @brief Closes the log for garbage collection: what is buffered is appended
+ * if the I/O queue has room, and the slot and timer are freed either way.
+ */
+void js_fs_log_release(uint32_t id);
+
+esp_err_t js_fs_log_stats(uint32_t id, js_fs_log_stats_t *out);
+
+/**
+ * @brief Settles a finished request, or flushes a log whose timer expired, for a JS_EVENT_FS event.
+ */
+void js_fs_dispatch_event(js_event_t *event);
+
+#endif /* JS_FS_H */
@@ -2,12 +2,38 @@
 #define JS_GPIO_H
 
 #include <stdbool.h>
+#include "sdkconfig.h"
 #include "driver/gpio.h"
 #include "jerryscript.h"
 #include "js_event.h"
 
 #define MAX_GPIO_PINS 40 // Maximum number of GPIO pins on ESP32
 
+#if CONFIG_JS_LATENCY_TRACE
+#define JS_LATENCY_BUCKETS 16 // Bucket i counts samples of [2^i, 2^(i+1)) µs; the last is open-ended
+
+/**
+ * @brief A log2 histogram of latency samples, in microseconds.
+ */
+typedef struct
+{
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t total_us;
+  uint32_t buckets[JS_LATENCY_BUCKETS];
+} js_latency_histogram_t;
+
+/**
+ * @brief Latency of one pin's interrupts, measured from ISR entry.
+ */
+typedef struct
+{
+  js_latency_histogram_t dispatch; /**< Until the event loop picked the event up. */
+  js_latency_histogram_t callback; /**< Until the JS callback returned. */
+} js_gpio_latency_t;
+#endif
+
 /**
  * @brief Represents the internal state of a single managed GPIO pin.
  */
@@ -15,9 +41,13 @@ typedef struct
 {
   bool in_use;
   gpio_num_t pin_num;
+  gpio_int_type_t intr_type;
   jerry_value_t js_isr_callback;
   uint32_t debounce_ms;
   int64_t last_isr_time_us;
+#if CONFIG_JS_LATENCY_TRACE
+  js_gpio_latency_t *latency; /**< Allocated on the pin's first traced event. */
+#endif
 } js_pin_t;
 /**
  * @brief Initializes the GPIO management system.
@@ -54,4 +84,21 @@ void js_gpio_close(gpio_num_t pin_num);
  */
 void js_gpio_dispatch_event(js_event_t *event);
 
+#if CONFIG_JS_LATENCY_TRACE
+/**
+ * @brief Gets a pin's latency histograms, or NULL if it has no samples yet.
+ */
+const js_gpio_latency_t *js_gpio_get_latency(gpio_num_t pin_num);
+
+/**
+ * @brief Clears a pin's latency histograms.
+ */
+void js_gpio_reset_latency(gpio_num_t pin_num);
+
+/**
+ * @brief Enables or disables logging every latency sample as it is recorded.
+ */
+void js_gpio_set_latency_logging(bool enabled);
+#endif
+
 #endif /* JS_GPIO_H */
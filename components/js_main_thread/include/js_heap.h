@@ -0,0 +1,61 @@
+#ifndef JS_HEAP_H
+#define JS_HEAP_H
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "sdkconfig.h"
+
+#define JS_HEAP_CONTEXT_RESERVE 2048 // Engine state allocated in front of each heap
+
+#ifdef CONFIG_JS_HEAP_KB
+#define JS_HEAP_KB CONFIG_JS_HEAP_KB
+#else
+#define JS_HEAP_KB 64
+#endif
+
+#if CONFIG_JS_HEAP_PSRAM
+#define JS_HEAP_CAPS (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#define JS_HEAP_PLACEMENT "psram"
+#else
+#define JS_HEAP_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define JS_HEAP_PLACEMENT "internal"
+#endif
+
+/**
+ * @brief The memory block behind one JerryScript context: engine state followed by its heap.
+ *
+ * The engine is built with JERRY_EXTERNAL_CONTEXT, so the heap is allocated
+ * at runtime, from PSRAM or internal RAM as configured, instead of being a
+ * fixed buffer in .bss.
+ */
+typedef struct
+{
+  struct jerry_context_t *block;
+  size_t size;      /**< Bytes allocated for the block. */
+  size_t heap_size; /**< Bytes of it the engine may use as heap. */
+} js_heap_t;
+
+/**
+ * @brief Allocates a context block with `heap_kb` KB of engine heap.
+ *
+ * @return ESP_ERR_NO_MEM if the configured memory has no block that large.
+ */
+esp_err_t js_heap_create(js_heap_t *heap, size_t heap_kb);
+
+/**
+ * @brief Makes `heap` the one jerry_init() on the calling task will use.
+ *
+ * With CONFIG_JS_WORKERS each task has its own; otherwise there is one for
+ * the whole program. The engine frees the block in jerry_cleanup().
+ */
+void js_heap_bind(js_heap_t *heap);
+
+/**
+ * @brief Allocates and binds the main context's heap of CONFIG_JS_HEAP_KB.
+ *
+ * Must run on the JS task before jerry_init().
+ */
+esp_err_t js_heap_init_main(void);
+
+#endif /* JS_HEAP_H */
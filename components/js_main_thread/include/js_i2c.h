@@ -0,0 +1,107 @@
+#ifndef JS_I2C_H
+#define JS_I2C_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "jerryscript.h"
+#include "js_event.h"
+
+#define JS_I2C_MAX_BUSES 2        // ESP32 has two I2C controllers
+#define JS_I2C_QUEUE_DEPTH 8      // Transactions that may wait for one bus worker
+#define JS_I2C_WORKER_STACK 3072
+#define JS_I2C_WORKER_PRIORITY 9  // Just below the JS thread
+
+/**
+ * @brief Options for opening a bus.
+ */
+typedef struct
+{
+  int port;
+  gpio_num_t sda;
+  gpio_num_t scl;
+  uint32_t frequency_hz;
+  uint32_t timeout_ms; /**< Per-operation timeout. */
+} js_i2c_bus_config_t;
+
+/**
+ * @brief Represents an open bus and the worker task that owns it.
+ *
+ * Only the worker task touches the hardware; the JS thread communicates with
+ * it exclusively through `queue`.
+ */
+typedef struct
+{
+  js_i2c_bus_config_t config;
+  QueueHandle_t queue;
+  TaskHandle_t worker;
+  void *backend; /**< Backend-specific state (driver handles or mock devices). */
+  volatile bool closing;
+} js_i2c_bus_t;
+
+/**
+ * @brief A single operation within a transaction.
+ *
+ * Operations with both `write_len` and `read_len` set are executed as one
+ * write-then-read with a repeated start, the usual way to read registers.
+ */
+typedef struct
+{
+  uint16_t address;
+  uint16_t write_offset; /**< Offset of this operation's bytes in the request's write data. */
+  uint16_t write_len;
+  uint16_t read_offset; /**< Offset of this operation's bytes in the request's read data. */
+  uint16_t read_len;
+} js_i2c_op_t;
+
+/**
+ * @brief A batch of operations executed by the worker in one queue round-trip.
+ *
+ * The request, its operations and both data areas live in a single allocation
+ * made by `js_i2c_request_new`, so a whole batch costs one malloc and one free.
+ */
+typedef struct
+{
+  jerry_value_t promise; /**< Settled on the JS thread; never touched by the worker. */
+  bool batch;            /**< Resolve with one result per operation instead of a single Uint8Array. */
+  size_t op_count;
+  js_i2c_op_t *ops;
+  uint8_t *write_data;
+  uint8_t *read_data;
+  size_t read_total;
+  esp_err_t result;
+  size_t failed_op; /**< Index of the operation that failed, if `result` is not ESP_OK. */
+} js_i2c_request_t;
+
+/**
+ * @brief Opens a bus and starts its worker task.
+ */
+esp_err_t js_i2c_open(const js_i2c_bus_config_t *config, js_i2c_bus_t **out_bus);
+
+/**
+ * @brief Allocates a request with room for its operations and data.
+ */
+js_i2c_request_t *js_i2c_request_new(size_t op_count, size_t write_total, size_t read_total);
+
+/**
+ * @brief Hands a request to the bus worker.
+ *
+ * On success the worker owns the request until it is returned to the JS thread
+ * as a JS_EVENT_I2C event. On failure the caller still owns it.
+ */
+esp_err_t js_i2c_submit(js_i2c_bus_t *bus, js_i2c_request_t *request);
+
+/**
+ * @brief Closes a bus. Transactions already queued still complete.
+ */
+void js_i2c_close(js_i2c_bus_t *bus);
+
+/**
+ * @brief Settles the promise of a completed request and frees it.
+ */
+void js_i2c_dispatch_event(js_event_t *event);
+
+#endif /* JS_I2C_H */
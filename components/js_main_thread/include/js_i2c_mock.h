@@ -0,0 +1,53 @@
+#ifndef JS_I2C_MOCK_H
+#define JS_I2C_MOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#define JS_I2C_MOCK_MAX_DEVICES 8
+#define JS_I2C_MOCK_REGISTER_COUNT 256
+
+/**
+ * @brief In-memory I2C bus, linked instead of the IDF driver when
+ * CONFIG_JS_I2C_MOCK_BUS is set.
+ *
+ * Each simulated device is a register file addressed like most sensors: the
+ * first byte of a write selects the register, further bytes are written from
+ * there, and reads continue from the selected register, auto-incrementing.
+ * Transfers to an address without a device fail with ESP_ERR_NOT_FOUND, as a
+ * NACK would on real hardware.
+ */
+
+/**
+ * @brief Creates the lock shared by the bus workers and test code.
+ *
+ * Must run before any other task uses the mock: the host runner calls it
+ * at startup, and opening a bus calls it on the JS thread. Later calls do
+ * nothing.
+ */
+void js_i2c_mock_init(void);
+
+/**
+ * @brief Attaches a simulated device to a port.
+ *
+ * @param registers Initial register contents, copied from register 0; may be NULL.
+ */
+esp_err_t js_i2c_mock_add_device(int port, uint16_t address, const uint8_t *registers, size_t len);
+
+/**
+ * @brief Detaches every simulated device from every port.
+ */
+void js_i2c_mock_reset(void);
+
+/**
+ * @brief Reads a register of a simulated device, e.g. to check what a script wrote.
+ */
+esp_err_t js_i2c_mock_get_register(int port, uint16_t address, uint8_t reg, uint8_t *out_value);
+
+/**
+ * @brief Writes a register of a simulated device, e.g. to inject a sensor reading.
+ */
+esp_err_t js_i2c_mock_set_register(int port, uint16_t address, uint8_t reg, uint8_t value);
+
+#endif /* JS_I2C_MOCK_H */
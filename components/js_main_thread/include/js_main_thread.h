@@ -8,6 +8,7 @@
 #ifndef JS_MAIN_THREAD_H
 #define JS_MAIN_THREAD_H
 
+#include <stdbool.h>
 #include <stdio.h>
 
 #include "freertos/FreeRTOS.h"
@@ -30,6 +31,14 @@ extern QueueHandle_t js_event_queue;
  */
 void print_js_error(jerry_value_t error_val);
 
+/**
+ * @brief Runs promise jobs and dispatches events from `queue` to the current context.
+ *
+ * Returns once `*stop` is set and the event being handled is done; with a NULL
+ * `stop` it never returns. Each context's task runs one of these loops.
+ */
+void js_run_event_loop(QueueHandle_t queue, volatile const bool *stop);
+
 /**
  * @brief The main task for the JavaScript runtime.
  *
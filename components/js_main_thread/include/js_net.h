@@ -0,0 +1,167 @@
+#ifndef JS_NET_H
+#define JS_NET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "jerryscript.h"
+#include "js_event.h"
+
+#define JS_NET_MAX_SOCKETS 6         // Open sockets, listeners included; lwIP allows 10, and the I/O task takes 2
+#define JS_NET_RX_CHUNK 1460         // Read size when the stack cannot say how much is buffered: one TCP segment
+#define JS_NET_MAX_BATCH 8192        // Most bytes one data callback receives
+#define JS_NET_MAX_DATAGRAM 1472     // Largest UDP payload received: an Ethernet frame's worth
+#define JS_NET_DATAGRAMS_PER_EVENT 8 // So one busy UDP socket cannot hold up the event loop
+#define JS_NET_IO_STACK 3072
+#define JS_NET_IO_PRIORITY 9 // Just below the JS thread
+
+typedef enum
+{
+  JS_NET_TCP,      /**< A connected stream, made by connect or accepted by a listener. */
+  JS_NET_LISTENER, /**< A TCP server socket. */
+  JS_NET_UDP,      /**< A bound datagram socket. */
+} js_net_kind_t;
+
+/**
+ * @brief What a JS_EVENT_NET event reports, carried in the event's `data`.
+ */
+typedef enum
+{
+  JS_NET_EVENT_READABLE, /**< Bytes, datagrams, connections or end of stream are waiting. */
+  JS_NET_EVENT_WRITABLE, /**< A connect finished, or the send buffer has room after a short write. */
+} js_net_event_kind_t;
+
+typedef struct js_net_socket js_net_socket_t;
+
+/**
+ * @brief Makes the JS object of a socket a listener accepted. Supplied by the
+ * net module, which owns the socket objects.
+ */
+typedef jerry_value_t (*js_net_wrap_cb_t)(js_net_socket_t *sock);
+
+/**
+ * @brief Represents the internal state of an open socket.
+ *
+ * The I/O task only waits in select() and posts a single pending
+ * JS_EVENT_NET per socket; the bytes themselves are read on the JS thread,
+ * straight into the ArrayBuffers handed to the callbacks.
+ */
+struct js_net_socket
+{
+  bool in_use;        /**< Set until the I/O task has closed the descriptor. */
+  bool closing;       /**< Set on the JS thread by `js_net_close`. */
+  uint32_t handle_id; /**< Slot number plus a generation count, so stale events are ignored. */
+  js_net_kind_t kind;
+  int fd;
+
+  volatile bool reading;    /**< A callback is set, so the I/O task watches for input. */
+  volatile bool rx_pending; /**< A readable event is queued and not yet dispatched. */
+  volatile bool want_write; /**< Connecting, or a send was short; the I/O task watches for room. */
+  bool connecting;
+
+  jerry_value_t callback;        /**< Data, datagram or connection callback. */
+  jerry_value_t connect_promise; /**< Settled when a connect finishes. */
+  jerry_value_t connect_value;   /**< The socket object `connect_promise` resolves to. */
+  jerry_value_t drain_promise;   /**< Shared by every `drain()` call while backpressured. */
+  js_net_wrap_cb_t wrap;         /**< Listeners only. */
+};
+
+/**
+ * @brief Starts a non-blocking TCP connection.
+ *
+ * `host` may be an IPv4 address, "localhost" or a name; names are resolved
+ * with a DNS lookup that blocks the calling thread.
+ * @return ESP_ERR_NOT_FOUND if the host does not resolve, ESP_ERR_NO_MEM if
+ * every socket is in use, ESP_FAIL with `errno` set if the stack refuses.
+ */
+esp_err_t js_net_connect(const char *host, uint16_t port, js_net_socket_t **out);
+
+/**
+ * @brief Returns the promise a connect settles, resolving to `object`.
+ *
+ * Takes its own reference to `object`, and sets its `remoteAddress` and
+ * `remotePort` once connected. Already settled if the connection
+ * completed or failed at once, as on loopback.
+ */
+jerry_value_t js_net_connect_promise(js_net_socket_t *sock, jerry_value_t object);
+
+/**
+ * @brief Opens a TCP listener. Accepted sockets are wrapped with `wrap`,
+ * given `remoteAddress` and `remotePort`, and passed to `callback`; they
+ * deliver nothing until given a data callback.
+ *
+ * @param host The address to bind, or NULL for every interface.
+ * @return ESP_ERR_INVALID_STATE if the address is in use, otherwise as js_net_connect().
+ */
+esp_err_t js_net_listen(const char *host, uint16_t port, int backlog, jerry_value_t callback, js_net_wrap_cb_t wrap,
+                        js_net_socket_t **out);
+
+/**
+ * @brief Opens a UDP socket bound to `host` and `port` (0 for any port).
+ * Each datagram is passed to `callback` with its sender.
+ */
+esp_err_t js_net_udp(const char *host, uint16_t port, jerry_value_t callback, js_net_socket_t **out);
+
+/**
+ * @brief Finds an open socket by handle.
+ *
+ * @return NULL once the socket is closed, even if its slot has been reused.
+ */
+js_net_socket_t *js_net_find(uint32_t handle_id);
+
+/**
+ * @brief Sets the data callback of a TCP socket and starts reading.
+ *
+ * Takes its own reference to `callback`.
+ */
+void js_net_set_callback(js_net_socket_t *sock, jerry_value_t callback);
+
+/**
+ * @brief Sends bytes on a TCP socket without blocking.
+ *
+ * @return The number of bytes accepted, which is less than `len` when the
+ *         send buffer is full, or -1 with `errno` set if the connection is
+ *         gone. After a short write the drain promise resolves once there
+ *         is room again.
+ */
+int js_net_write(js_net_socket_t *sock, const uint8_t *data, size_t len);
+
+/**
+ * @brief Sends one datagram from a UDP socket without blocking.
+ *
+ * @return ESP_ERR_NOT_FOUND if the host does not resolve, ESP_FAIL with
+ * `errno` set if the datagram was not sent.
+ */
+esp_err_t js_net_send_to(js_net_socket_t *sock, const uint8_t *data, size_t len, const char *host, uint16_t port);
+
+/**
+ * @brief Returns a promise resolved once a TCP socket's send buffer has room again.
+ *
+ * Already resolved if the last write was accepted in full.
+ */
+jerry_value_t js_net_drain(js_net_socket_t *sock);
+
+/**
+ * @brief The local or remote address of a socket, as dotted IPv4 text.
+ */
+esp_err_t js_net_address(js_net_socket_t *sock, bool remote, char address[16], uint16_t *port);
+
+/**
+ * @brief Closes a socket, resolving a pending drain and rejecting a pending
+ * connect. The descriptor is closed by the I/O task.
+ */
+void js_net_close(js_net_socket_t *sock);
+
+/**
+ * @brief Closes a socket without settling its connect or drain promise, for
+ * garbage collection, where no promise may be settled.
+ */
+void js_net_release(js_net_socket_t *sock);
+
+/**
+ * @brief Reads pending input, finishes a connect or resolves a drain, for a JS_EVENT_NET event.
+ */
+void js_net_dispatch_event(js_event_t *event);
+
+#endif /* JS_NET_H */
@@ -0,0 +1,115 @@
+#ifndef JS_OFFLOAD_H
+#define JS_OFFLOAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "jerryscript.h"
+#include "js_event.h"
+#include "sdkconfig.h"
+
+#define JS_OFFLOAD_MAX_OPS 16
+#define JS_OFFLOAD_MAX_PARAMS 4
+#define JS_OFFLOAD_QUEUE_DEPTH 8  // Jobs that may wait for a worker
+#define JS_OFFLOAD_WORKER_STACK 4096
+#define JS_OFFLOAD_WORKER_PRIORITY 5
+#define JS_OFFLOAD_WORKER_CORE 0  // The JS thread runs on core 1
+#define JS_OFFLOAD_RETRY_MS 10    // Wait before telling a busy JS thread again that jobs finished
+
+#ifdef CONFIG_JS_OFFLOAD_WORKERS
+#define JS_OFFLOAD_WORKERS CONFIG_JS_OFFLOAD_WORKERS
+#else
+#define JS_OFFLOAD_WORKERS 1
+#endif
+
+/**
+ * @brief What a job hands back to JS.
+ */
+typedef enum
+{
+  JS_OFFLOAD_RESULT_UNDEFINED, /**< Resolves with undefined. */
+  JS_OFFLOAD_RESULT_NUMBER,    /**< Resolves with `number`. */
+  JS_OFFLOAD_RESULT_BYTES,     /**< Resolves with a Uint8Array copied from `data`. */
+  JS_OFFLOAD_RESULT_STRING,    /**< Resolves with a string decoded from `data` as UTF-8. */
+} js_offload_result_kind_t;
+
+/**
+ * @brief A job's input, captured on the JS thread when it was submitted.
+ *
+ * `data` points into the caller's buffer, which is kept alive (but not
+ * copied) until the job settles, or into a copy of a string argument.
+ */
+typedef struct
+{
+  const uint8_t *data;
+  size_t len;
+  double params[JS_OFFLOAD_MAX_PARAMS]; /**< Numeric arguments after the data; missing ones are 0. */
+  size_t param_count;
+} js_offload_input_t;
+
+/**
+ * @brief A job's output. `data` must come from malloc() and is freed by the runtime.
+ */
+typedef struct
+{
+  js_offload_result_kind_t kind;
+  double number;
+  uint8_t *data;
+  size_t len;
+  const char *error; /**< Set (to a static string) to reject the promise instead. */
+} js_offload_output_t;
+
+/**
+ * @brief A native operation run on a worker task.
+ *
+ * Runs off the JS thread, so it must not call any jerry_* function.
+ */
+typedef void (*js_offload_fn_t)(const js_offload_input_t *input, js_offload_output_t *output);
+
+/**
+ * @brief A submitted job, owned by the runtime from submission to settlement.
+ */
+typedef struct js_offload_job
+{
+  struct js_offload_job *next; /**< Next finished job waiting for the JS thread. */
+  js_offload_fn_t fn;
+  jerry_value_t promise;
+  jerry_value_t input_value; /**< Keeps the input buffer alive while a worker reads it. */
+  uint8_t *input_copy;       /**< Owned copy of a string input, or NULL. */
+  js_offload_input_t input;
+  js_offload_output_t output;
+} js_offload_job_t;
+
+/**
+ * @brief Registers the built-in operations and starts the worker tasks.
+ */
+void js_offload_init(void);
+
+/**
+ * @brief Makes a native operation available to `runtime.offload(name, ...)`.
+ *
+ * Call before js_task() starts or from the JS thread. `name` is not copied.
+ *
+ * @return ESP_ERR_INVALID_STATE if the name is taken, ESP_ERR_NO_MEM if the table is full.
+ */
+esp_err_t js_offload_register(const char *name, js_offload_fn_t fn);
+
+/**
+ * @brief Looks up a registered operation by name.
+ */
+js_offload_fn_t js_offload_find(const char *name);
+
+/**
+ * @brief Queues a job for the workers without blocking.
+ *
+ * @return ESP_ERR_NO_MEM if the job queue is full; the job is then still the caller's.
+ */
+esp_err_t js_offload_submit(js_offload_job_t *job);
+
+/**
+ * @brief Settles the promises of the finished jobs and frees them, for a JS_EVENT_OFFLOAD event.
+ */
+void js_offload_dispatch_event(js_event_t *event);
+
+#endif /* JS_OFFLOAD_H */
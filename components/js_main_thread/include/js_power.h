@@ -0,0 +1,61 @@
+#ifndef JS_POWER_H
+#define JS_POWER_H
+
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "driver/gpio.h"
+
+/**
+ * @brief How the current context has spent its time since it started.
+ */
+typedef struct
+{
+  int64_t active_us;     /**< Running JS: callbacks, promise jobs and immediates. */
+  int64_t idle_us;       /**< Blocked waiting for an event. */
+  int64_t sleep_us;      /**< Time the chip spent in light sleep; 0 without CONFIG_JS_POWER_SAVE. */
+  uint32_t light_sleeps; /**< Light sleeps entered by the chip. */
+  uint32_t wakeups;      /**< Idle waits ended by an event. */
+} js_power_stats_t;
+
+/**
+ * @brief Starts the power accounting of the current context, which counts as active.
+ *
+ * Call from the context's task before it runs any JS, and js_power_idle()
+ * when it exits so it does not keep the chip awake. With
+ * CONFIG_JS_POWER_SAVE the first call also enables automatic light sleep.
+ */
+void js_power_init(void);
+
+/**
+ * @brief Marks the current context as running JS. Does nothing if it already is.
+ *
+ * With CONFIG_JS_POWER_SAVE this holds a PM lock, so the CPU stays at full
+ * speed and the chip awake until the context goes idle again.
+ */
+void js_power_active(void);
+
+/**
+ * @brief Marks the current context as about to block for an event, releasing its PM lock.
+ *
+ * Once every context is idle, FreeRTOS tickless idle puts the chip into light
+ * sleep until the next esp_timer alarm (every JS timer is one) or a wake pin.
+ */
+void js_power_idle(void);
+
+js_power_stats_t js_power_stats(void);
+
+#if CONFIG_JS_POWER_SAVE
+/**
+ * @brief Makes a pin with a JS interrupt wake the chip from light sleep.
+ *
+ * Light sleep can only wake on a level, so the pin is switched to the level
+ * its edge leads to while asleep and back to `intr_type` on wake-up. The
+ * interrupt latched by the wake-up is then delivered as a normal GPIO event.
+ * @param intr_type The pin's interrupt; GPIO_INTR_DISABLE stops it waking the chip.
+ */
+void js_power_set_wake_pin(gpio_num_t pin_num, gpio_int_type_t intr_type);
+#else
+static inline void js_power_set_wake_pin(gpio_num_t pin_num, gpio_int_type_t intr_type) {}
+#endif
+
+#endif /* JS_POWER_H */
@@ -0,0 +1,187 @@
+#ifndef JS_RMT_H
+#define JS_RMT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "driver/gpio.h"
+#include "driver/rmt_tx.h"
+#include "driver/rmt_rx.h"
+#include "jerryscript.h"
+#include "js_event.h"
+
+#define JS_RMT_MAX_CHANNELS 8       // ESP32 has 8 RMT channels, shared between TX and RX
+#define JS_RMT_TX_QUEUE_DEPTH 4     // Transmissions that may be in flight on one channel
+#define JS_RMT_NEC_FRAME_SYMBOLS 34 // Leading code + 32 data bits + end pulse
+
+/**
+ * @brief The role a managed RMT channel has been opened for.
+ */
+typedef enum
+{
+  JS_RMT_UNUSED,
+  JS_RMT_TX,
+  JS_RMT_RX,
+} js_rmt_kind_t;
+
+/**
+ * @brief A transmission that has been handed to the driver but not yet completed.
+ *
+ * The JS buffer is referenced (not copied) until the driver reports completion,
+ * so the backing store handed to the RMT engine cannot be garbage collected
+ * while it is still being read.
+ */
+typedef struct
+{
+  jerry_value_t promise;                              /**< Resolved on the JS thread when the frame is sent. */
+  jerry_value_t buffer;                               /**< The JS buffer being transmitted, or undefined. */
+  rmt_symbol_word_t symbols[JS_RMT_NEC_FRAME_SYMBOLS]; /**< Storage for frames encoded natively (e.g. NEC). */
+} js_rmt_tx_slot_t;
+
+/**
+ * @brief Represents the internal state of a single managed RMT channel.
+ */
+typedef struct
+{
+  js_rmt_kind_t kind;
+  uint32_t handle_id; /**< Pool index plus a generation count, so stale events are ignored. */
+  gpio_num_t pin_num;
+  uint32_t resolution_hz;
+  rmt_channel_handle_t channel;
+
+  // --- Transmit state ---
+  rmt_encoder_handle_t copy_encoder;
+  rmt_encoder_handle_t ws2812_encoder;
+  js_rmt_tx_slot_t tx_slots[JS_RMT_TX_QUEUE_DEPTH];
+  uint8_t tx_head;
+  uint8_t tx_count;
+  volatile uint8_t tx_done; /**< Transmissions the driver has finished that are not yet resolved. */
+
+  // --- Receive state ---
+  rmt_symbol_word_t *rx_buffer;
+  size_t rx_buffer_symbols;
+  rmt_receive_config_t rx_config;
+  bool rx_active; /**< JS wants frames delivered. */
+  bool rx_armed;  /**< A receive is armed in the driver; it stays armed across stop() and start(). */
+  volatile bool rx_done;      /**< The armed receive has finished and `rx_symbols` holds its length. */
+  volatile size_t rx_symbols;
+  jerry_value_t js_rx_callback;
+
+  volatile bool event_pending; /**< A JS_EVENT_RMT is queued; set by the interrupt callbacks, cleared on dispatch. */
+} js_rmt_channel_t;
+
+/**
+ * @brief Options for opening a transmit channel.
+ */
+typedef struct
+{
+  gpio_num_t pin_num;
+  uint32_t resolution_hz;
+  size_t mem_block_symbols;
+  uint32_t carrier_hz; /**< 0 disables carrier modulation. */
+  bool open_drain;     /**< Open-drain with loopback, so a receiver can share the pin (e.g. DHT22). */
+  bool with_dma;       /**< Ignored on targets without RMT DMA support. */
+} js_rmt_tx_config_t;
+
+/**
+ * @brief Options for opening a receive channel.
+ */
+typedef struct
+{
+  gpio_num_t pin_num;
+  uint32_t resolution_hz;
+  size_t max_symbols;
+  uint32_t min_pulse_ns; /**< Pulses shorter than this are treated as glitches. */
+  uint32_t max_pulse_ns; /**< A level held longer than this ends the frame. */
+} js_rmt_rx_config_t;
+
+/**
+ * @brief Result of decoding a NEC infrared frame.
+ */
+typedef struct
+{
+  uint16_t address;
+  uint8_t command;
+  bool repeat;
+} js_rmt_nec_frame_t;
+
+/**
+ * @brief Initializes the RMT channel management system.
+ */
+void js_rmt_init(void);
+
+/**
+ * @brief Opens a transmit channel on a pin.
+ */
+esp_err_t js_rmt_new_tx(const js_rmt_tx_config_t *config, js_rmt_channel_t **out_channel);
+
+/**
+ * @brief Opens a receive channel on a pin.
+ */
+esp_err_t js_rmt_new_rx(const js_rmt_rx_config_t *config, js_rmt_channel_t **out_channel);
+
+/**
+ * @brief Queues a prebuilt symbol buffer for transmission without copying it.
+ *
+ * @param buffer The JS value owning `symbols`; it is kept alive until the frame is sent.
+ * @param promise Resolved once the driver reports the transmission as done.
+ */
+esp_err_t js_rmt_transmit_symbols(js_rmt_channel_t *ch, jerry_value_t buffer,
+                                  const rmt_symbol_word_t *symbols, size_t count,
+                                  jerry_value_t promise);
+
+/**
+ * @brief Queues GRB pixel bytes for transmission with the WS2812 bit encoder.
+ */
+esp_err_t js_rmt_transmit_ws2812(js_rmt_channel_t *ch, jerry_value_t buffer,
+                                 const uint8_t *pixels, size_t length,
+                                 jerry_value_t promise);
+
+/**
+ * @brief Encodes and queues a NEC infrared frame.
+ *
+ * Addresses above 0xFF are sent as extended (16-bit) NEC addresses.
+ */
+esp_err_t js_rmt_transmit_nec(js_rmt_channel_t *ch, uint16_t address, uint8_t command,
+                              jerry_value_t promise);
+
+/**
+ * @brief Starts continuous frame capture, calling `callback` once per frame.
+ */
+esp_err_t js_rmt_start_receive(js_rmt_channel_t *ch, jerry_value_t callback);
+
+/**
+ * @brief Stops frame capture after the frame currently being received.
+ */
+void js_rmt_stop_receive(js_rmt_channel_t *ch);
+
+/**
+ * @brief Releases the channel, resolving any transmissions still pending.
+ */
+void js_rmt_close(js_rmt_channel_t *ch);
+
+/**
+ * @brief Releases the channel without settling pending transmissions, for
+ * garbage collection, where no promise may be settled.
+ */
+void js_rmt_release(js_rmt_channel_t *ch);
+
+/**
+ * @brief Dispatches an RMT event from the main JS event loop.
+ */
+void js_rmt_dispatch_event(js_event_t *event);
+
+/**
+ * @brief Decodes a captured NEC frame.
+ * @return True if the symbols form a valid NEC frame or repeat code.
+ */
+bool js_rmt_decode_nec(const rmt_symbol_word_t *symbols, size_t count, uint32_t resolution_hz,
+                       js_rmt_nec_frame_t *out_frame);
+
+/**
+ * @brief Decodes a captured DHT22 response into tenths of a unit.
+ * @return True if 40 data bits were found and the checksum matches.
+ */
+bool js_rmt_decode_dht22(const rmt_symbol_word_t *symbols, size_t count, uint32_t resolution_hz,
+                         int16_t *out_humidity_x10, int16_t *out_temperature_x10);
+
+#endif /* JS_RMT_H */
@@ -0,0 +1,65 @@
+#ifndef JS_SCHEDULER_H
+#define JS_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "jerryscript.h"
+
+#define JS_SCHEDULER_IMMEDIATE_DEPTH 32 // setImmediate() callbacks and yield() promises waiting, per context
+
+/**
+ * @brief Resets the current context's immediate queue.
+ *
+ * It is a fixed ring of JS values, so scheduling work never allocates
+ * native memory or an esp_timer.
+ */
+void js_scheduler_init(void);
+
+/**
+ * @brief Queues `callback` to run once the event loop has dispatched the events already waiting.
+ * @return The immediate's ID for clearImmediate(), or 0 if the queue is full.
+ */
+uint32_t js_scheduler_set_immediate(jerry_value_t callback);
+
+/**
+ * @brief Cancels an immediate that has not run yet.
+ * @return True if it was still queued.
+ */
+bool js_scheduler_clear_immediate(uint32_t id);
+
+/**
+ * @brief Queues `promise` to be resolved in the immediate phase, for scheduler.yield().
+ * @return ESP_ERR_NO_MEM if the queue is full.
+ */
+esp_err_t js_scheduler_yield(jerry_value_t promise);
+
+/**
+ * @brief Queues `callback` as a promise job, after the promise jobs already pending.
+ *
+ * What the callback throws is reported like any uncaught exception.
+ * @return ESP_ERR_NO_MEM if the engine heap is exhausted.
+ */
+esp_err_t js_scheduler_queue_microtask(jerry_value_t callback);
+
+/**
+ * @brief Runs promise jobs, microtasks included, until none are left.
+ */
+void js_scheduler_run_jobs(void);
+
+/**
+ * @brief Whether immediates are waiting, so the event loop must not block.
+ */
+bool js_scheduler_has_immediates(void);
+
+/**
+ * @brief Runs the immediates queued before this call; ones they queue wait for the next round.
+ */
+void js_scheduler_run_immediates(void);
+
+/**
+ * @brief Drops everything queued in the current context, before it shuts down.
+ */
+void js_scheduler_clear_all(void);
+
+#endif /* JS_SCHEDULER_H */
@@ -0,0 +1,117 @@
+#ifndef JS_SERIAL_H
+#define JS_SERIAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "driver/uart.h"
+#include "jerryscript.h"
+#include "js_event.h"
+
+#define JS_SERIAL_MAX_PORTS UART_NUM_MAX
+#define JS_SERIAL_RX_BUFFER 2048       // Driver ring buffer; absorbs bursts while JS is busy
+#define JS_SERIAL_TX_BUFFER 1024       // Driver ring buffer that non-blocking writes fill
+#define JS_SERIAL_UART_QUEUE_DEPTH 16  // Driver events waiting for the reader task
+#define JS_SERIAL_READER_STACK 2560
+#define JS_SERIAL_READER_PRIORITY 9    // Just below the JS thread
+#define JS_SERIAL_DRAIN_POLL_MS 5      // How often a backpressured port checks for TX space
+#define JS_SERIAL_MAX_DELIMITER 4
+
+/**
+ * @brief What a JS_EVENT_SERIAL event reports, carried in the event's `data`.
+ */
+typedef enum
+{
+  JS_SERIAL_EVENT_DATA,  /**< Bytes are waiting in the driver's RX ring buffer. */
+  JS_SERIAL_EVENT_DRAIN, /**< The TX ring buffer has room again after a short write. */
+} js_serial_event_kind_t;
+
+/**
+ * @brief Options for opening a port.
+ */
+typedef struct
+{
+  uart_port_t port;
+  gpio_num_t tx;
+  gpio_num_t rx;
+  gpio_num_t rts; /**< -1 disables hardware flow control on this line. */
+  gpio_num_t cts; /**< -1 disables hardware flow control on this line. */
+  uart_config_t uart;
+
+  // --- Framing ---
+  uint8_t delimiter[JS_SERIAL_MAX_DELIMITER];
+  size_t delimiter_len; /**< 0 delivers raw chunks as they arrive. */
+  size_t max_frame;     /**< A frame this long without a delimiter is delivered as is. */
+  bool as_string;       /**< Deliver frames as UTF-8 strings instead of Uint8Arrays. */
+} js_serial_config_t;
+
+/**
+ * @brief Represents the internal state of an open port.
+ *
+ * The reader task only waits on the driver's event queue and posts a single
+ * pending JS_EVENT_SERIAL; the bytes themselves are read, framed and handed
+ * to JS on the JS thread, in as few callbacks as possible.
+ */
+typedef struct
+{
+  bool in_use;        /**< Set until the reader task has released the driver. */
+  bool closing;       /**< Set on the JS thread by `js_serial_close`. */
+  uint32_t handle_id; /**< Port number plus a generation count, so stale events are ignored. */
+  js_serial_config_t config;
+  QueueHandle_t uart_queue;
+  TaskHandle_t reader;
+
+  volatile bool rx_pending; /**< A data event is queued and not yet dispatched. */
+  volatile bool want_drain; /**< A write was short; the reader polls for TX space. */
+  volatile uint32_t overruns;
+
+  jerry_value_t js_data_callback;
+  jerry_value_t drain_promise; /**< Shared by every `drain()` call while backpressured. */
+
+  uint8_t *frame; /**< Partial frame carried over between reads. */
+  size_t frame_len;
+} js_serial_port_t;
+
+/**
+ * @brief Installs the UART driver on a port and starts its reader task.
+ *
+ * Takes its own reference to `data_callback`.
+ */
+esp_err_t js_serial_open(const js_serial_config_t *config, jerry_value_t data_callback, js_serial_port_t **out_port);
+
+/**
+ * @brief Queues bytes for transmission without blocking.
+ *
+ * @return The number of bytes accepted, which is less than `len` when the TX
+ *         buffer is full. The port then resolves its drain promise once the
+ *         buffer has room again.
+ */
+size_t js_serial_write(js_serial_port_t *port, const uint8_t *data, size_t len);
+
+/**
+ * @brief Returns a promise resolved once the TX buffer has room again.
+ *
+ * Already resolved if the last write was accepted in full.
+ */
+jerry_value_t js_serial_drain(js_serial_port_t *port);
+
+/**
+ * @brief Closes a port. The driver is released by the reader task as it exits.
+ */
+void js_serial_close(js_serial_port_t *port);
+
+/**
+ * @brief Closes a port without resolving a pending drain, for garbage
+ * collection, where no promise may be settled.
+ */
+void js_serial_release(js_serial_port_t *port);
+
+/**
+ * @brief Reads and frames pending bytes, or resolves a drain, for a JS_EVENT_SERIAL event.
+ */
+void js_serial_dispatch_event(js_event_t *event);
+
+#endif /* JS_SERIAL_H */
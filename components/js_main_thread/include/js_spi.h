@@ -0,0 +1,129 @@
+#ifndef JS_SPI_H
+#define JS_SPI_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "driver/gpio.h"
+#include "jerryscript.h"
+#include "js_event.h"
+
+#define JS_SPI_MAX_BUSES 2      // SPI2 and SPI3; SPI1 is reserved for flash
+#define JS_SPI_MAX_DEVICES 6    // Shared between both buses
+#define JS_SPI_QUEUE_DEPTH 4    // Transfers that may be in flight on one device
+#define JS_SPI_DMA_ALIGNMENT 4  // DMA engines move whole words
+
+/**
+ * @brief Options for initialising a bus.
+ */
+typedef struct
+{
+  int host; /**< 2 for SPI2 (HSPI), 3 for SPI3 (VSPI). */
+  gpio_num_t mosi;
+  gpio_num_t miso;
+  gpio_num_t sclk;
+  size_t max_transfer_size; /**< 0 selects the driver default (4092 bytes with DMA). */
+} js_spi_bus_config_t;
+
+/**
+ * @brief Represents an initialised bus shared by one or more devices.
+ *
+ * The bus is only released once it has been closed and its last device has
+ * finished closing, because devices may outlive the JS bus object while
+ * transfers are in flight.
+ */
+typedef struct
+{
+  bool in_use;
+  bool closing;
+  int host;
+  uint8_t device_count;
+  void *backend;
+} js_spi_bus_t;
+
+/**
+ * @brief Options for adding a device to a bus.
+ */
+typedef struct
+{
+  gpio_num_t cs;
+  uint32_t frequency_hz;
+  uint8_t mode; /**< SPI mode 0-3 (clock polarity and phase). */
+} js_spi_device_config_t;
+
+/**
+ * @brief A transfer that has been handed to the driver but not yet completed.
+ *
+ * The DMA engine reads from and writes to the JS buffers' backing stores
+ * directly when they are DMA-capable and word-aligned; otherwise the backend
+ * bounces them through a DMA buffer of its own. The buffers are referenced
+ * until the driver reports completion, so they cannot be garbage collected
+ * while a transfer is using them.
+ */
+typedef struct
+{
+  jerry_value_t promise; /**< Settled on the JS thread when the transfer completes. */
+  jerry_value_t tx;      /**< The JS value being sent, or undefined. */
+  jerry_value_t rx;      /**< The JS value being received into, or undefined. */
+  const uint8_t *tx_data;
+  uint8_t *rx_data;
+  size_t length;    /**< Bytes clocked out. */
+  size_t rx_length; /**< Bytes clocked in. */
+} js_spi_transfer_t;
+
+/**
+ * @brief Represents the internal state of a single managed device.
+ */
+typedef struct
+{
+  bool in_use;
+  bool closing;
+  uint32_t handle_id; /**< Pool index plus a generation count, so stale events are ignored. */
+  js_spi_bus_t *bus;
+  js_spi_device_config_t config;
+  js_spi_transfer_t transfers[JS_SPI_QUEUE_DEPTH]; /**< Ring of in-flight transfers, completed in order. */
+  uint8_t head;
+  uint8_t count;
+  volatile uint8_t completed; /**< Transfers the backend has finished that are not yet settled. */
+  void *backend;
+} js_spi_device_t;
+
+/**
+ * @brief Initializes the SPI management system.
+ */
+void js_spi_init(void);
+
+/**
+ * @brief Initialises a bus.
+ */
+esp_err_t js_spi_bus_open(const js_spi_bus_config_t *config, js_spi_bus_t **out_bus);
+
+/**
+ * @brief Closes a bus. It is released once all of its devices have closed.
+ */
+void js_spi_bus_close(js_spi_bus_t *bus);
+
+/**
+ * @brief Adds a device to a bus.
+ */
+esp_err_t js_spi_device_open(js_spi_bus_t *bus, const js_spi_device_config_t *config, js_spi_device_t **out_device);
+
+/**
+ * @brief Queues a transfer.
+ *
+ * On success the device takes over the references in `transfer` (promise and
+ * buffers) and releases them when the transfer completes. Returns
+ * ESP_ERR_NO_MEM when JS_SPI_QUEUE_DEPTH transfers are already in flight.
+ */
+esp_err_t js_spi_device_transfer(js_spi_device_t *device, const js_spi_transfer_t *transfer);
+
+/**
+ * @brief Closes a device. Transfers already queued still complete.
+ */
+void js_spi_device_close(js_spi_device_t *device);
+
+/**
+ * @brief Settles the promises of every completed transfer of a device.
+ */
+void js_spi_dispatch_event(js_event_t *event);
+
+#endif /* JS_SPI_H */
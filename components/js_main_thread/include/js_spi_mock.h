@@ -0,0 +1,31 @@
+#ifndef JS_SPI_MOCK_H
+#define JS_SPI_MOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "driver/gpio.h"
+
+/**
+ * @brief Simulated SPI bus, linked instead of the IDF driver when
+ * CONFIG_JS_SPI_MOCK_BUS is set.
+ *
+ * Transfers complete immediately. By default every device behaves as if MOSI
+ * were wired to MISO, so received bytes echo the transmitted ones; a responder
+ * can be installed to simulate a specific device instead.
+ */
+
+/**
+ * @brief Produces the bytes a simulated device clocks back.
+ *
+ * @param tx Bytes sent, or NULL for a receive-only transfer.
+ * @param rx Where to store received bytes, or NULL for a transmit-only transfer.
+ */
+typedef void (*js_spi_mock_responder_t)(int host, gpio_num_t cs, const uint8_t *tx, size_t tx_len,
+                                        uint8_t *rx, size_t rx_len);
+
+/**
+ * @brief Installs a responder for all devices, or restores loopback when NULL.
+ */
+void js_spi_mock_set_responder(js_spi_mock_responder_t responder);
+
+#endif /* JS_SPI_MOCK_H */
@@ -0,0 +1,110 @@
+#ifndef JS_STORAGE_H
+#define JS_STORAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "jerryscript.h"
+#include "js_event.h"
+#include "sdkconfig.h"
+
+#define JS_STORAGE_NAMESPACE "js"      // NVS namespace holding every key set from JS
+#define JS_STORAGE_MAX_KEY 16          // NVS key length limit, including the terminator
+#define JS_STORAGE_MAX_VALUE 4000      // Largest value in bytes, keeping each blob within one NVS page
+#define JS_STORAGE_QUEUE_DEPTH 4       // Commits that may wait for the commit task
+#define JS_STORAGE_COMMIT_STACK 3072
+#define JS_STORAGE_COMMIT_PRIORITY 4   // Below the offload workers; flash writes are not urgent
+#define JS_STORAGE_COMMIT_CORE 0       // The JS thread runs on core 1
+#define JS_STORAGE_RETRY_MS 10         // Wait before telling a busy JS thread again that commits finished
+
+#ifdef CONFIG_JS_STORAGE_CACHE_ENTRIES
+#define JS_STORAGE_CACHE_ENTRIES CONFIG_JS_STORAGE_CACHE_ENTRIES
+#else
+#define JS_STORAGE_CACHE_ENTRIES 16
+#endif
+
+#ifdef CONFIG_JS_STORAGE_FLUSH_MS
+#define JS_STORAGE_FLUSH_MS CONFIG_JS_STORAGE_FLUSH_MS
+#else
+#define JS_STORAGE_FLUSH_MS 1000
+#endif
+
+/**
+ * @brief The kind of a stored value. The tag is kept in front of the value in flash.
+ */
+typedef enum
+{
+  JS_STORAGE_STRING = 's', /**< UTF-8 bytes, without a terminator. */
+  JS_STORAGE_NUMBER = 'n', /**< A double in native byte order. */
+  JS_STORAGE_BYTES = 'b',  /**< The contents of an ArrayBuffer. */
+} js_storage_type_t;
+
+/**
+ * @brief A value read from storage.
+ *
+ * `data` points into the cache and stays valid until the next js_storage_*
+ * call; copy it into a JS value straight away.
+ */
+typedef struct
+{
+  js_storage_type_t type;
+  const uint8_t *data;
+  size_t len;
+} js_storage_value_t;
+
+/**
+ * @brief Opens the NVS namespace and starts the commit task.
+ *
+ * Erases the NVS partition if it is full or was written by a newer IDF,
+ * as nvs_flash_init() requires. The functions below must all be called
+ * from the main JS thread.
+ */
+esp_err_t js_storage_init(void);
+
+/**
+ * @brief Reads `key`, from the cache if it holds it and from NVS otherwise.
+ *
+ * @return ESP_ERR_NOT_FOUND if the key does not exist.
+ */
+esp_err_t js_storage_get(const char *key, js_storage_value_t *out);
+
+/**
+ * @brief Stores a value in the cache and arms the write-back timer.
+ *
+ * Writes to the same key before the next commit replace each other in RAM,
+ * so only the last one reaches flash.
+ *
+ * @return ESP_ERR_INVALID_ARG for an empty or too long key,
+ * ESP_ERR_INVALID_SIZE if the value is larger than JS_STORAGE_MAX_VALUE.
+ */
+esp_err_t js_storage_set(const char *key, js_storage_type_t type, const void *data, size_t len);
+
+/**
+ * @brief Deletes `key`. Like js_storage_set(), it reaches flash with the next commit.
+ */
+esp_err_t js_storage_delete(const char *key);
+
+/**
+ * @brief Commits every pending write and waits for the commit to finish.
+ *
+ * Earlier asynchronous commits are written first, so flash ends up in the
+ * same order the writes were made.
+ */
+esp_err_t js_storage_flush(void);
+
+/**
+ * @brief Hands every pending write to the commit task without waiting.
+ *
+ * `promise`, if not undefined, is resolved once the writes are in flash or
+ * rejected if the commit fails. The runtime takes its own reference.
+ *
+ * @return ESP_ERR_NO_MEM if the commit queue is full; the writes then stay pending.
+ */
+esp_err_t js_storage_flush_async(jerry_value_t promise);
+
+/**
+ * @brief Settles a finished commit, or starts the timed one, for a JS_EVENT_STORAGE event.
+ */
+void js_storage_dispatch_event(js_event_t *event);
+
+#endif /* JS_STORAGE_H */
@@ -7,6 +7,52 @@
 #include "jerryscript.h"
 #include "js_event.h"
 
+/**
+ * @brief What a timer does when it fires.
+ */
+typedef enum
+{
+  JS_TIMER_CALLBACK, /**< Calls `js_callback` (setTimeout, setInterval). */
+  JS_TIMER_PROMISE,  /**< Resolves the promise in `js_callback` with `js_value` (sleep). */
+  JS_TIMER_TICKS,    /**< Counts ticks and resolves the promise next() left in `js_callback` (every). */
+  JS_TIMER_PACED,    /**< Calls `js_callback` with the timing of each tick (setInterval with a policy). */
+} js_timer_kind_t;
+
+/**
+ * @brief What a paced interval does with ticks that fell due while the JS thread was busy.
+ */
+typedef enum
+{
+  JS_TIMER_SKIP,     /**< Runs the latest tick once and reports the ones before it as missed. */
+  JS_TIMER_CATCH_UP, /**< Runs every missed tick back to back, up to JS_TIMER_CATCH_UP_MAX per event. */
+} js_timer_policy_t;
+
+/// @brief The most ticks a catching-up interval runs for one event; older ones count as missed.
+#define JS_TIMER_CATCH_UP_MAX 8
+
+/// @brief The shortest period of an interval, in microseconds; shorter ones are raised to it.
+#define JS_TIMER_MIN_PERIOD_US 50
+
+/// @brief The longest delay or period, in milliseconds, as in browsers (about 24.8 days); longer ones are lowered to it.
+#define JS_TIMER_MAX_DELAY_MS 2147483647.0
+
+/// @brief Paced intervals that may run at once, across all contexts.
+#define JS_TIMER_MAX_PACED 8
+
+/**
+ * @brief What the interrupt callback of a paced timer reads and writes.
+ *
+ * Cells are static, so a callback that fires after its timer was freed
+ * touches nothing but a cell. `pending` holds back a second event until
+ * the first is dispatched, so even a sub-millisecond interval takes at
+ * most one slot of the event queue.
+ */
+typedef struct
+{
+  volatile uint32_t handle_id; /**< The timer using the cell, or 0 if free. */
+  volatile bool pending;       /**< Set by the interrupt callback, cleared on dispatch. */
+} js_timer_cell_t;
+
 /**
  * @brief Represents a single timer node in a linked list.
  */
@@ -14,28 +60,92 @@ typedef struct js_timer_t
 {
   uint32_t handle_id;
   bool is_interval;
+  js_timer_kind_t kind;
   esp_timer_handle_t timer;
-  jerry_value_t js_callback;
-  struct js_timer_t *next; // Pointer to the next timer in the list
+  jerry_value_t js_callback; // The callback, or the promise to settle; undefined for a tick timer nobody awaits
+  jerry_value_t js_value;    // What a sleep resolves with, or the iterator result a tick timer reuses
+  uint32_t ticks;            // Ticks fired so far (tick timers), or ticks handled (paced timers)
+  uint32_t ticks_seen;       // Ticks already handed out by next()
+  js_timer_policy_t policy;  // What a paced timer does with late ticks
+  int64_t start_us;          // When a paced timer started; tick n is due at start_us + n * period_us
+  uint64_t period_us;        // The period of a paced timer
+  js_timer_cell_t *cell;     // A paced timer's pending flag; NULL for other kinds
+  struct js_timer_t *next;   // Pointer to the next timer in the list
 } js_timer_t;
 
 /**
- * @brief Initializes the timer management system.
+ * @brief Initializes the timer management system for the current context.
+ *
+ * Each JerryScript context (the main one and every worker) keeps its own
+ * timer list; all functions here act on the caller's.
  */
 void js_timers_init(void);
 
 /**
  * @brief Creates and starts a new timer, adding it to the linked list.
+ *
+ * Delays are in microseconds, so fractional milliseconds from JS survive.
+ * @return The handle ID of the new timer, or 0 on failure.
+ */
+uint32_t js_timers_set(bool is_interval, jerry_value_t callback, uint64_t delay_us);
+
+/**
+ * @brief Starts an interval that stays phase-locked to its start time.
+ *
+ * Tick n is due at start + n * period. When the callback runs, it gets an
+ * object `{ tick, scheduled, actual, missed }`, with the times in
+ * microseconds on the perf.now() clock. Ticks that fell due while the JS
+ * thread was busy are handled by `policy`; either way the next tick keeps
+ * its original slot, so lateness never accumulates. The object is reused.
+ * @return The handle ID of the new timer, or 0 on failure, including when
+ * JS_TIMER_MAX_PACED paced timers are already running.
+ */
+uint32_t js_timers_set_paced(jerry_value_t callback, uint64_t period_us, js_timer_policy_t policy);
+
+/**
+ * @brief Starts a one-shot timer that resolves `promise` with `value`.
+ *
+ * Nothing is called back, so no closure is needed to sequence code with `await`.
+ * @return The handle ID of the new timer, or 0 on failure.
+ */
+uint32_t js_timers_sleep(jerry_value_t promise, jerry_value_t value, uint64_t delay_us);
+
+/**
+ * @brief Starts a periodic timer whose ticks are read with js_timers_next_tick().
  * @return The handle ID of the new timer, or 0 on failure.
  */
-uint32_t js_timers_set(bool is_interval, jerry_value_t callback, uint64_t delay_ms);
+uint32_t js_timers_every(uint64_t period_us);
+
+/**
+ * @brief Returns a promise for the next tick of a timer from js_timers_every().
+ *
+ * It resolves with an iterator result `{ value, done }` whose value is the
+ * number of ticks so far. If ticks fired since the last call it is already
+ * resolved; several missed ticks are reported as one, with the count
+ * showing the gap. Once the timer is cleared it resolves with `done` set.
+ * The result object is reused, so read it before calling again.
+ */
+jerry_value_t js_timers_next_tick(uint32_t handle_id);
 
 /**
  * @brief Stops, removes, and frees a timer from the linked list.
+ *
+ * A tick timer's pending next() promise resolves with `done` set.
  * @return True if the timer was found and cleared, false otherwise.
  */
 bool js_timers_clear(uint32_t handle_id);
 
+/**
+ * @brief Like js_timers_clear(), but leaves a pending next() promise
+ * unsettled, for garbage collection, where no promise may be settled.
+ */
+void js_timers_release(uint32_t handle_id);
+
+/**
+ * @brief Stops and frees every timer of the current context, before it shuts down.
+ */
+void js_timers_clear_all(void);
+
 /**
  * @brief Dispatches a timer event by finding it in the linked list and executing its callback.
  * @return True if the timer was found and dispatched, false otherwise.
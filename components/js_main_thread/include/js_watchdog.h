@@ -0,0 +1,58 @@
+#ifndef JS_WATCHDOG_H
+#define JS_WATCHDOG_H
+
+#include <stdint.h>
+#include "sdkconfig.h"
+
+#if CONFIG_JS_WATCHDOG
+
+#define JS_WATCHDOG_CHECK_INTERVAL 1024 // Engine halt checks skipped between two clock reads
+
+/**
+ * @brief Counters of the current context's watchdog.
+ */
+typedef struct
+{
+  uint32_t budget_ms; /**< Longest a callback may run; 0 when disabled. */
+  uint32_t aborted;   /**< Callbacks interrupted for running over budget. */
+  int64_t longest_us; /**< Longest callback so far, including any that were interrupted. */
+} js_watchdog_stats_t;
+
+/**
+ * @brief Installs the engine halt handler in the current context.
+ *
+ * A callback that runs out of budget is thrown a catchable RangeError, so its
+ * `finally` blocks can release what they hold. One that is still running a
+ * budget later, having swallowed the error, is aborted: an abort skips every
+ * `catch`, which is the only way to end a loop that catches everything.
+ *
+ * Call after jerry_init(). The budget starts at CONFIG_JS_WATCHDOG_BUDGET_MS.
+ */
+void js_watchdog_init(void);
+
+/**
+ * @brief Starts the budget of one callback: an event dispatch and the promise jobs it triggers.
+ */
+void js_watchdog_arm(void);
+
+/**
+ * @brief Ends the callback started by js_watchdog_arm() and records how long it ran.
+ */
+void js_watchdog_disarm(void);
+
+/**
+ * @brief Sets the budget of the current context's callbacks. 0 disables the watchdog.
+ */
+void js_watchdog_set_budget(uint32_t budget_ms);
+
+js_watchdog_stats_t js_watchdog_stats(void);
+
+#else
+
+static inline void js_watchdog_init(void) {}
+static inline void js_watchdog_arm(void) {}
+static inline void js_watchdog_disarm(void) {}
+
+#endif
+
+#endif /* JS_WATCHDOG_H */
@@ -0,0 +1,135 @@
+#ifndef JS_WORKER_H
+#define JS_WORKER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_err.h"
+#include "jerryscript.h"
+#include "js_event.h"
+#include "js_main_thread.h" // For js_event_queue
+#include "sdkconfig.h"
+
+#define JS_MAX_CONTEXTS 4              // The main context plus up to three workers
+#define JS_MAIN_CONTEXT 0              // Context index of the task running main.js
+#define JS_WORKER_MAX_SCRIPT 48        // Longest worker script path, including the terminator
+#define JS_WORKER_STACK 12288
+#define JS_WORKER_PRIORITY 5           // Below the main JS task, so control code wins ties
+#define JS_WORKER_EVENT_QUEUE_DEPTH 8
+#define JS_CHANNEL_DEFAULT_DEPTH 4     // Messages in flight per direction
+
+#ifdef CONFIG_JS_WORKER_HEAP_KB
+#define JS_WORKER_HEAP_KB CONFIG_JS_WORKER_HEAP_KB
+#else
+#define JS_WORKER_HEAP_KB 32
+#endif
+
+/**
+ * @brief A cloned value travelling between two contexts.
+ *
+ * Allocated by the sender as one block and freed by whoever dispatches or
+ * drops it. `bytes` holds the js_clone encoding of the posted value.
+ */
+typedef struct
+{
+  size_t len;
+  uint8_t bytes[];
+} js_message_t;
+
+/**
+ * @brief How js_worker_spawn() sets up a worker.
+ */
+typedef struct
+{
+  size_t heap_kb;         /**< Engine heap for the worker's context. */
+  uint32_t channel_depth; /**< Messages that may be in flight in each direction. */
+  int core;               /**< Core the worker task is pinned to. */
+} js_worker_options_t;
+
+#if CONFIG_JS_WORKERS
+
+/// @brief Event queues of the worker contexts, indexed by context. Slot 0 is unused.
+extern QueueHandle_t js_worker_queues[JS_MAX_CONTEXTS];
+
+/**
+ * @brief The context index of the calling task: JS_MAIN_CONTEXT or a worker slot.
+ */
+uint32_t js_context_index(void);
+
+/**
+ * @brief Starts a worker task running `script` in a context of its own.
+ *
+ * Called from the main context. The worker shares no JS values with its
+ * parent; they talk only through js_worker_post().
+ *
+ * @param out_id Receives the worker's id, used for every later call.
+ * @return ESP_ERR_NOT_FOUND if every worker slot is taken, ESP_ERR_NO_MEM if
+ * the heap, queue or task could not be created.
+ */
+esp_err_t js_worker_spawn(const char *script, const js_worker_options_t *options, uint32_t *out_id);
+
+/**
+ * @brief Posts a message to the other end of a channel without blocking.
+ *
+ * From the main context the message goes to worker `worker_id`; from a worker
+ * it goes to the parent and `worker_id` is ignored. On success the runtime
+ * owns `message`.
+ *
+ * @return ESP_ERR_NO_MEM if the channel is full, ESP_ERR_NOT_FOUND if the
+ * worker has exited or is stopping.
+ */
+esp_err_t js_worker_post(uint32_t worker_id, js_message_t *message);
+
+/**
+ * @brief Sets the callback for messages arriving in the calling context.
+ *
+ * In the main context this is the handler for messages from worker
+ * `worker_id`; in a worker it is the handler for messages from the parent.
+ * The callback is copied. Messages that arrive while no callback is set
+ * are dropped.
+ *
+ * @return ESP_ERR_NOT_FOUND if the worker has exited.
+ */
+esp_err_t js_worker_set_on_message(uint32_t worker_id, jerry_value_t callback);
+
+/**
+ * @brief Asks a worker to stop after the event it is handling.
+ *
+ * A worker busy in a long-running script only notices once it returns to
+ * its event loop.
+ *
+ * @return ESP_ERR_NOT_FOUND if the worker has already exited.
+ */
+esp_err_t js_worker_terminate(uint32_t worker_id);
+
+/**
+ * @brief Delivers a message, or retires an exited worker, for a JS_EVENT_WORKER event.
+ */
+void js_worker_dispatch_event(js_event_t *event);
+
+#else
+
+static inline uint32_t js_context_index(void)
+{
+  return JS_MAIN_CONTEXT;
+}
+
+#endif /* CONFIG_JS_WORKERS */
+
+/**
+ * @brief The event queue of context `index`. Safe to call from an ISR.
+ */
+static inline QueueHandle_t js_context_queue(uint32_t index)
+{
+#if CONFIG_JS_WORKERS
+  if (index != JS_MAIN_CONTEXT)
+  {
+    return js_worker_queues[index];
+  }
+#endif
+  return js_event_queue;
+}
+
+#endif /* JS_WORKER_H */
@@ -0,0 +1,455 @@
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "soc/soc_caps.h"
+
+#include "js_adc.h"
+#include "js_main_thread.h" // For js_event_queue and print_js_error
+
+static const char *TAG = "JS_ADC_ENGINE";
+
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define JS_ADC_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define JS_ADC_GET_CHANNEL(p) ((p)->type1.channel)
+#define JS_ADC_GET_DATA(p) ((p)->type1.data)
+#else
+#define JS_ADC_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define JS_ADC_GET_CHANNEL(p) ((p)->type2.channel)
+#define JS_ADC_GET_DATA(p) ((p)->type2.data)
+#endif
+
+/**
+ * @brief State of the single continuous-sampling stream.
+ */
+typedef struct
+{
+  bool running;
+  adc_continuous_handle_t handle;
+  adc_channel_t channel;
+  volatile bool drain_pending; /**< Set by the ISR so at most one drain event is queued. */
+  volatile uint32_t overruns;
+
+  // --- Reducer state ---
+  js_adc_reduce_t reduce;
+  uint32_t decimation;
+  uint32_t acc_count;
+  uint32_t acc_sum;
+  uint16_t acc_min;
+  uint16_t acc_max;
+  uint16_t acc_first;
+
+  // --- Output block ---
+  uint16_t *block;
+  uint32_t block_size;
+  uint32_t block_fill;
+  jerry_value_t js_callback;
+} js_adc_stream_t;
+
+/// @brief One-shot unit handles, shared by all pins on the same ADC unit.
+static adc_oneshot_unit_handle_t units[SOC_ADC_PERIPH_NUM];
+static int unit_refs[SOC_ADC_PERIPH_NUM];
+
+static js_adc_stream_t stream;
+
+/**
+ * @brief Creates a calibration scheme for a channel, if the chip supports one.
+ */
+static adc_cali_handle_t create_calibration(adc_unit_t unit, adc_channel_t channel, adc_atten_t atten)
+{
+  adc_cali_handle_t handle = NULL;
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+  adc_cali_curve_fitting_config_t config = {
+      .unit_id = unit,
+      .chan = channel,
+      .atten = atten,
+      .bitwidth = ADC_BITWIDTH_DEFAULT,
+  };
+  if (adc_cali_create_scheme_curve_fitting(&config, &handle) != ESP_OK)
+  {
+    handle = NULL;
+  }
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+  adc_cali_line_fitting_config_t config = {
+      .unit_id = unit,
+      .atten = atten,
+      .bitwidth = ADC_BITWIDTH_DEFAULT,
+  };
+  if (adc_cali_create_scheme_line_fitting(&config, &handle) != ESP_OK)
+  {
+    handle = NULL;
+  }
+#endif
+  return handle;
+}
+
+static void delete_calibration(adc_cali_handle_t handle)
+{
+  if (!handle)
+  {
+    return;
+  }
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+  adc_cali_delete_scheme_curve_fitting(handle);
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+  adc_cali_delete_scheme_line_fitting(handle);
+#endif
+}
+
+/**
+ * @brief Opens a pin for one-shot reads.
+ */
+esp_err_t js_adc_open(gpio_num_t pin_num, adc_atten_t atten, js_adc_pin_t **out_pin)
+{
+  adc_unit_t unit;
+  adc_channel_t channel;
+  esp_err_t err = adc_oneshot_io_to_channel(pin_num, &unit, &channel);
+  if (err != ESP_OK)
+  {
+    return err; // Not an analog-capable pin
+  }
+
+  if (units[unit] == NULL)
+  {
+    adc_oneshot_unit_init_cfg_t unit_config = {
+        .unit_id = unit,
+    };
+    err = adc_oneshot_new_unit(&unit_config, &units[unit]);
+    if (err != ESP_OK)
+    {
+      return err;
+    }
+  }
+
+  adc_oneshot_chan_cfg_t chan_config = {
+      .atten = atten,
+      .bitwidth = ADC_BITWIDTH_DEFAULT,
+  };
+  err = adc_oneshot_config_channel(units[unit], channel, &chan_config);
+  if (err != ESP_OK)
+  {
+    if (unit_refs[unit] == 0)
+    {
+      adc_oneshot_del_unit(units[unit]);
+      units[unit] = NULL;
+    }
+    return err;
+  }
+
+  js_adc_pin_t *pin = (js_adc_pin_t *)malloc(sizeof(js_adc_pin_t));
+  if (!pin)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  pin->pin_num = pin_num;
+  pin->unit = unit;
+  pin->channel = channel;
+  pin->atten = atten;
+  pin->cali = create_calibration(unit, channel, atten);
+  unit_refs[unit]++;
+
+  *out_pin = pin;
+  return ESP_OK;
+}
+
+/**
+ * @brief Performs a one-shot conversion and returns the raw reading.
+ */
+esp_err_t js_adc_read_raw(js_adc_pin_t *pin, int *out_raw)
+{
+  return adc_oneshot_read(units[pin->unit], pin->channel, out_raw);
+}
+
+/**
+ * @brief Performs a one-shot conversion and returns the calibrated voltage in millivolts.
+ */
+esp_err_t js_adc_read_mv(js_adc_pin_t *pin, int *out_mv)
+{
+  if (!pin->cali)
+  {
+    return ESP_ERR_NOT_SUPPORTED;
+  }
+  int raw;
+  esp_err_t err = adc_oneshot_read(units[pin->unit], pin->channel, &raw);
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+  return adc_cali_raw_to_voltage(pin->cali, raw, out_mv);
+}
+
+/**
+ * @brief Releases a one-shot pin, and its ADC unit if no other pin uses it.
+ */
+void js_adc_close(js_adc_pin_t *pin)
+{
+  delete_calibration(pin->cali);
+  if (--unit_refs[pin->unit] == 0)
+  {
+    adc_oneshot_del_unit(units[pin->unit]);
+    units[pin->unit] = NULL;
+  }
+  free(pin);
+}
+
+// --- Continuous Sampling ---
+
+static bool IRAM_ATTR conv_done_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+  if (stream.drain_pending)
+  {
+    return false; // The JS thread has not drained the previous frames yet.
+  }
+  stream.drain_pending = true;
+
+  js_event_t ev = {
+      .type = JS_EVENT_ADC,
+      .handle_id = 0,
+      .data = NULL,
+  };
+  BaseType_t woke = pdFALSE;
+  xQueueSendFromISR(js_event_queue, &ev, &woke);
+  return woke == pdTRUE;
+}
+
+static bool IRAM_ATTR pool_ovf_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+  stream.overruns++;
+  return false;
+}
+
+/**
+ * @brief Starts continuous sampling, calling `callback` with a Uint16Array per block.
+ */
+esp_err_t js_adc_stream_start(const js_adc_stream_config_t *config, jerry_value_t callback)
+{
+  if (stream.running)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  adc_unit_t unit;
+  adc_channel_t channel;
+  esp_err_t err = adc_continuous_io_to_channel(config->pin_num, &unit, &channel);
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+  if (unit != ADC_UNIT_1)
+  {
+    return ESP_ERR_NOT_SUPPORTED; // DMA sampling is only available on ADC1 on the ESP32.
+  }
+
+  stream.block = (uint16_t *)malloc(config->block_size * sizeof(uint16_t));
+  if (!stream.block)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+
+  adc_continuous_handle_cfg_t handle_config = {
+      .max_store_buf_size = JS_ADC_POOL_BYTES,
+      .conv_frame_size = JS_ADC_FRAME_BYTES,
+  };
+  err = adc_continuous_new_handle(&handle_config, &stream.handle);
+  if (err != ESP_OK)
+  {
+    free(stream.block);
+    stream.block = NULL;
+    return err;
+  }
+
+  uint32_t rate = config->sample_rate_hz;
+  if (rate < SOC_ADC_SAMPLE_FREQ_THRES_LOW)
+    rate = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+  if (rate > SOC_ADC_SAMPLE_FREQ_THRES_HIGH)
+    rate = SOC_ADC_SAMPLE_FREQ_THRES_HIGH;
+
+  adc_digi_pattern_config_t pattern = {
+      .atten = config->atten,
+      .channel = channel,
+      .unit = unit,
+      .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+  };
+  adc_continuous_config_t dig_config = {
+      .pattern_num = 1,
+      .adc_pattern = &pattern,
+      .sample_freq_hz = rate,
+      .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+      .format = JS_ADC_OUTPUT_FORMAT,
+  };
+  adc_continuous_evt_cbs_t cbs = {
+      .on_conv_done = conv_done_cb,
+      .on_pool_ovf = pool_ovf_cb,
+  };
+
+  // Set before starting: the callbacks may run as soon as the driver does.
+  stream.channel = channel;
+  stream.reduce = config->reduce;
+  stream.decimation = config->decimation > 0 ? config->decimation : 1;
+  stream.acc_count = 0;
+  stream.block_size = config->block_size;
+  stream.block_fill = 0;
+  stream.overruns = 0;
+  stream.drain_pending = false;
+
+  err = adc_continuous_config(stream.handle, &dig_config);
+  if (err == ESP_OK)
+  {
+    err = adc_continuous_register_event_callbacks(stream.handle, &cbs, NULL);
+  }
+  if (err == ESP_OK)
+  {
+    err = adc_continuous_start(stream.handle);
+  }
+  if (err != ESP_OK)
+  {
+    // Nothing may call back into a stream that never started.
+    adc_continuous_evt_cbs_t no_cbs = {0};
+    adc_continuous_register_event_callbacks(stream.handle, &no_cbs, NULL);
+    adc_continuous_deinit(stream.handle);
+    stream.handle = NULL;
+    free(stream.block);
+    stream.block = NULL;
+    return err;
+  }
+
+  stream.js_callback = jerry_value_copy(callback);
+  stream.running = true;
+
+  ESP_LOGI(TAG, "ADC stream on pin %d at %lu Hz, decimation %lu.", config->pin_num,
+           (unsigned long)rate, (unsigned long)stream.decimation);
+  return ESP_OK;
+}
+
+/**
+ * @brief Stops continuous sampling and releases the DMA engine.
+ */
+void js_adc_stream_stop(void)
+{
+  if (!stream.running)
+  {
+    return;
+  }
+  stream.running = false;
+  adc_continuous_stop(stream.handle);
+  adc_continuous_deinit(stream.handle);
+  stream.handle = NULL;
+  free(stream.block);
+  stream.block = NULL;
+  jerry_value_free(stream.js_callback);
+  stream.js_callback = jerry_undefined();
+}
+
+/**
+ * @brief Returns how many times the driver's pool overflowed since the stream started.
+ */
+uint32_t js_adc_stream_overruns(void)
+{
+  return stream.overruns;
+}
+
+/**
+ * @brief Hands a completed block to JS as a Uint16Array.
+ */
+static void deliver_block(void)
+{
+  jerry_value_t samples = jerry_typedarray(JERRY_TYPEDARRAY_UINT16, stream.block_fill);
+  jerry_length_t offset = 0;
+  jerry_length_t length = 0;
+  jerry_value_t array_buffer = jerry_typedarray_buffer(samples, &offset, &length);
+  jerry_arraybuffer_write(array_buffer, offset, (const uint8_t *)stream.block, length);
+  jerry_value_free(array_buffer);
+  stream.block_fill = 0;
+
+  // Hold our own reference: the callback may stop the stream.
+  jerry_value_t callback = jerry_value_copy(stream.js_callback);
+  jerry_value_t global = jerry_current_realm();
+  jerry_value_t res = jerry_call(callback, global, &samples, 1);
+  jerry_value_free(global);
+  jerry_value_free(callback);
+  if (jerry_value_is_exception(res))
+  {
+    print_js_error(res);
+  }
+  jerry_value_free(res);
+  jerry_value_free(samples);
+}
+
+/**
+ * @brief Feeds one raw sample through the reducer into the output block.
+ */
+static inline void reduce_sample(uint16_t sample)
+{
+  if (stream.acc_count == 0)
+  {
+    stream.acc_sum = 0;
+    stream.acc_min = sample;
+    stream.acc_max = sample;
+    stream.acc_first = sample;
+  }
+  stream.acc_sum += sample;
+  if (sample < stream.acc_min)
+    stream.acc_min = sample;
+  if (sample > stream.acc_max)
+    stream.acc_max = sample;
+
+  if (++stream.acc_count < stream.decimation)
+  {
+    return;
+  }
+
+  uint16_t out;
+  switch (stream.reduce)
+  {
+  case JS_ADC_REDUCE_MIN:
+    out = stream.acc_min;
+    break;
+  case JS_ADC_REDUCE_MAX:
+    out = stream.acc_max;
+    break;
+  case JS_ADC_REDUCE_DECIMATE:
+    out = stream.acc_first;
+    break;
+  case JS_ADC_REDUCE_AVERAGE:
+  default:
+    out = (uint16_t)(stream.acc_sum / stream.acc_count);
+    break;
+  }
+  stream.acc_count = 0;
+  stream.block[stream.block_fill++] = out;
+}
+
+/**
+ * @brief Drains every converted frame from the driver's pool through the reducer.
+ */
+void js_adc_dispatch_event(js_event_t *event)
+{
+  // Clear first: a frame completing while we drain must queue another event.
+  stream.drain_pending = false;
+
+  uint8_t frame[JS_ADC_FRAME_BYTES];
+  uint32_t frame_len = 0;
+  while (stream.running && adc_continuous_read(stream.handle, frame, sizeof(frame), &frame_len, 0) == ESP_OK)
+  {
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= frame_len; i += SOC_ADC_DIGI_RESULT_BYTES)
+    {
+      adc_digi_output_data_t *p = (adc_digi_output_data_t *)&frame[i];
+      if (JS_ADC_GET_CHANNEL(p) != stream.channel)
+      {
+        continue;
+      }
+      reduce_sample(JS_ADC_GET_DATA(p));
+      if (stream.block_fill == stream.block_size)
+      {
+        deliver_block();
+        if (!stream.running)
+        {
+          return; // Stopped from the callback; the rest of the frame is discarded.
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,525 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "js_buffer.h"
+
+// Byte-at-a-time lookup tables, kept in flash.
+
+static const uint8_t crc8_table[256] = {
+    0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b, 0x12, 0x15, 0x38, 0x3f, 0x36, 0x31, 0x24, 0x23, 0x2a, 0x2d,
+    0x70, 0x77, 0x7e, 0x79, 0x6c, 0x6b, 0x62, 0x65, 0x48, 0x4f, 0x46, 0x41, 0x54, 0x53, 0x5a, 0x5d,
+    0xe0, 0xe7, 0xee, 0xe9, 0xfc, 0xfb, 0xf2, 0xf5, 0xd8, 0xdf, 0xd6, 0xd1, 0xc4, 0xc3, 0xca, 0xcd,
+    0x90, 0x97, 0x9e, 0x99, 0x8c, 0x8b, 0x82, 0x85, 0xa8, 0xaf, 0xa6, 0xa1, 0xb4, 0xb3, 0xba, 0xbd,
+    0xc7, 0xc0, 0xc9, 0xce, 0xdb, 0xdc, 0xd5, 0xd2, 0xff, 0xf8, 0xf1, 0xf6, 0xe3, 0xe4, 0xed, 0xea,
+    0xb7, 0xb0, 0xb9, 0xbe, 0xab, 0xac, 0xa5, 0xa2, 0x8f, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9d, 0x9a,
+    0x27, 0x20, 0x29, 0x2e, 0x3b, 0x3c, 0x35, 0x32, 0x1f, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0d, 0x0a,
+    0x57, 0x50, 0x59, 0x5e, 0x4b, 0x4c, 0x45, 0x42, 0x6f, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7d, 0x7a,
+    0x89, 0x8e, 0x87, 0x80, 0x95, 0x92, 0x9b, 0x9c, 0xb1, 0xb6, 0xbf, 0xb8, 0xad, 0xaa, 0xa3, 0xa4,
+    0xf9, 0xfe, 0xf7, 0xf0, 0xe5, 0xe2, 0xeb, 0xec, 0xc1, 0xc6, 0xcf, 0xc8, 0xdd, 0xda, 0xd3, 0xd4,
+    0x69, 0x6e, 0x67, 0x60, 0x75, 0x72, 0x7b, 0x7c, 0x51, 0x56, 0x5f, 0x58, 0x4d, 0x4a, 0x43, 0x44,
+    0x19, 0x1e, 0x17, 0x10, 0x05, 0x02, 0x0b, 0x0c, 0x21, 0x26, 0x2f, 0x28, 0x3d, 0x3a, 0x33, 0x34,
+    0x4e, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5c, 0x5b, 0x76, 0x71, 0x78, 0x7f, 0x6a, 0x6d, 0x64, 0x63,
+    0x3e, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2c, 0x2b, 0x06, 0x01, 0x08, 0x0f, 0x1a, 0x1d, 0x14, 0x13,
+    0xae, 0xa9, 0xa0, 0xa7, 0xb2, 0xb5, 0xbc, 0xbb, 0x96, 0x91, 0x98, 0x9f, 0x8a, 0x8d, 0x84, 0x83,
+    0xde, 0xd9, 0xd0, 0xd7, 0xc2, 0xc5, 0xcc, 0xcb, 0xe6, 0xe1, 0xe8, 0xef, 0xfa, 0xfd, 0xf4, 0xf3,
+};
+
+static const uint16_t crc16_ccitt_table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
+    0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
+    0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4,
+    0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d, 0xc7bc,
+    0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
+    0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12,
+    0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a,
+    0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41,
+    0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b, 0x8d68, 0x9d49,
+    0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
+    0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78,
+    0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f,
+    0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e,
+    0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d,
+    0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xa7db, 0xb7fa, 0x8799, 0x97b8, 0xe75f, 0xf77e, 0xc71d, 0xd73c,
+    0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3,
+    0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
+    0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92,
+    0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9,
+    0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
+    0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
+    0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0,
+};
+
+static const uint16_t crc16_modbus_table[256] = {
+    0x0000, 0xc0c1, 0xc181, 0x0140, 0xc301, 0x03c0, 0x0280, 0xc241,
+    0xc601, 0x06c0, 0x0780, 0xc741, 0x0500, 0xc5c1, 0xc481, 0x0440,
+    0xcc01, 0x0cc0, 0x0d80, 0xcd41, 0x0f00, 0xcfc1, 0xce81, 0x0e40,
+    0x0a00, 0xcac1, 0xcb81, 0x0b40, 0xc901, 0x09c0, 0x0880, 0xc841,
+    0xd801, 0x18c0, 0x1980, 0xd941, 0x1b00, 0xdbc1, 0xda81, 0x1a40,
+    0x1e00, 0xdec1, 0xdf81, 0x1f40, 0xdd01, 0x1dc0, 0x1c80, 0xdc41,
+    0x1400, 0xd4c1, 0xd581, 0x1540, 0xd701, 0x17c0, 0x1680, 0xd641,
+    0xd201, 0x12c0, 0x1380, 0xd341, 0x1100, 0xd1c1, 0xd081, 0x1040,
+    0xf001, 0x30c0, 0x3180, 0xf141, 0x3300, 0xf3c1, 0xf281, 0x3240,
+    0x3600, 0xf6c1, 0xf781, 0x3740, 0xf501, 0x35c0, 0x3480, 0xf441,
+    0x3c00, 0xfcc1, 0xfd81, 0x3d40, 0xff01, 0x3fc0, 0x3e80, 0xfe41,
+    0xfa01, 0x3ac0, 0x3b80, 0xfb41, 0x3900, 0xf9c1, 0xf881, 0x3840,
+    0x2800, 0xe8c1, 0xe981, 0x2940, 0xeb01, 0x2bc0, 0x2a80, 0xea41,
+    0xee01, 0x2ec0, 0x2f80, 0xef41, 0x2d00, 0xedc1, 0xec81, 0x2c40,
+    0xe401, 0x24c0, 0x2580, 0xe541, 0x2700, 0xe7c1, 0xe681, 0x2640,
+    0x2200, 0xe2c1, 0xe381, 0x2340, 0xe101, 0x21c0, 0x2080, 0xe041,
+    0xa001, 0x60c0, 0x6180, 0xa141, 0x6300, 0xa3c1, 0xa281, 0x6240,
+    0x6600, 0xa6c1, 0xa781, 0x6740, 0xa501, 0x65c0, 0x6480, 0xa441,
+    0x6c00, 0xacc1, 0xad81, 0x6d40, 0xaf01, 0x6fc0, 0x6e80, 0xae41,
+    0xaa01, 0x6ac0, 0x6b80, 0xab41, 0x6900, 0xa9c1, 0xa881, 0x6840,
+    0x7800, 0xb8c1, 0xb981, 0x7940, 0xbb01, 0x7bc0, 0x7a80, 0xba41,
+    0xbe01, 0x7ec0, 0x7f80, 0xbf41, 0x7d00, 0xbdc1, 0xbc81, 0x7c40,
+    0xb401, 0x74c0, 0x7580, 0xb541, 0x7700, 0xb7c1, 0xb681, 0x7640,
+    0x7200, 0xb2c1, 0xb381, 0x7340, 0xb101, 0x71c0, 0x7080, 0xb041,
+    0x5000, 0x90c1, 0x9181, 0x5140, 0x9301, 0x53c0, 0x5280, 0x9241,
+    0x9601, 0x56c0, 0x5780, 0x9741, 0x5500, 0x95c1, 0x9481, 0x5440,
+    0x9c01, 0x5cc0, 0x5d80, 0x9d41, 0x5f00, 0x9fc1, 0x9e81, 0x5e40,
+    0x5a00, 0x9ac1, 0x9b81, 0x5b40, 0x9901, 0x59c0, 0x5880, 0x9841,
+    0x8801, 0x48c0, 0x4980, 0x8941, 0x4b00, 0x8bc1, 0x8a81, 0x4a40,
+    0x4e00, 0x8ec1, 0x8f81, 0x4f40, 0x8d01, 0x4dc0, 0x4c80, 0x8c41,
+    0x4400, 0x84c1, 0x8581, 0x4540, 0x8701, 0x47c0, 0x4680, 0x8641,
+    0x8201, 0x42c0, 0x4380, 0x8341, 0x4100, 0x81c1, 0x8081, 0x4040,
+};
+
+static const uint32_t crc32_table[256] = {
+    0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
+    0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
+    0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
+    0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9, 0xfa0f3d63, 0x8d080df5,
+    0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172, 0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b,
+    0x35b5a8fa, 0x42b2986c, 0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
+    0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423, 0xcfba9599, 0xb8bda50f,
+    0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924, 0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d,
+    0x76dc4190, 0x01db7106, 0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
+    0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d, 0x91646c97, 0xe6635c01,
+    0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e, 0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457,
+    0x65b0d9c6, 0x12b7e950, 0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
+    0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7, 0xa4d1c46d, 0xd3d6f4fb,
+    0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0, 0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9,
+    0x5005713c, 0x270241aa, 0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+    0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81, 0xb7bd5c3b, 0xc0ba6cad,
+    0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a, 0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683,
+    0xe3630b12, 0x94643b84, 0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
+    0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb, 0x196c3671, 0x6e6b06e7,
+    0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc, 0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5,
+    0xd6d6a3e8, 0xa1d1937e, 0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
+    0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55, 0x316e8eef, 0x4669be79,
+    0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236, 0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f,
+    0xc5ba3bbe, 0xb2bd0b28, 0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
+    0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f, 0x72076785, 0x05005713,
+    0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38, 0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21,
+    0x86d3d2d4, 0xf1d4e242, 0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
+    0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69, 0x616bffd3, 0x166ccf45,
+    0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2, 0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db,
+    0xaed16a4a, 0xd9d65adc, 0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+    0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
+    0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d,
+};
+
+uint8_t js_buffer_crc8(uint8_t crc, const uint8_t *data, size_t len)
+{
+  while (len--)
+  {
+    crc = crc8_table[crc ^ *data++];
+  }
+  return crc;
+}
+
+uint16_t js_buffer_crc16_ccitt(uint16_t crc, const uint8_t *data, size_t len)
+{
+  while (len--)
+  {
+    crc = (uint16_t)(crc << 8) ^ crc16_ccitt_table[(crc >> 8) ^ *data++];
+  }
+  return crc;
+}
+
+uint16_t js_buffer_crc16_modbus(uint16_t crc, const uint8_t *data, size_t len)
+{
+  while (len--)
+  {
+    crc = (crc >> 8) ^ crc16_modbus_table[(crc ^ *data++) & 0xFF];
+  }
+  return crc;
+}
+
+uint32_t js_buffer_crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+  crc = ~crc;
+  while (len--)
+  {
+    crc = (crc >> 8) ^ crc32_table[(crc ^ *data++) & 0xFF];
+  }
+  return ~crc;
+}
+
+static const char base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void js_buffer_base64_encode(const uint8_t *data, size_t len, char *out)
+{
+  size_t i = 0;
+  for (; i + 2 < len; i += 3)
+  {
+    uint32_t v = (uint32_t)data[i] << 16 | (uint32_t)data[i + 1] << 8 | data[i + 2];
+    *out++ = base64_alphabet[v >> 18];
+    *out++ = base64_alphabet[(v >> 12) & 0x3F];
+    *out++ = base64_alphabet[(v >> 6) & 0x3F];
+    *out++ = base64_alphabet[v & 0x3F];
+  }
+  if (i < len)
+  {
+    uint32_t v = (uint32_t)data[i] << 16 | (i + 1 < len ? (uint32_t)data[i + 1] << 8 : 0);
+    *out++ = base64_alphabet[v >> 18];
+    *out++ = base64_alphabet[(v >> 12) & 0x3F];
+    *out++ = i + 1 < len ? base64_alphabet[(v >> 6) & 0x3F] : '=';
+    *out++ = '=';
+  }
+}
+
+/**
+ * @brief The value of a base64 digit, also accepting the URL-safe `-` and `_`; -1 otherwise.
+ */
+static int base64_value(char c)
+{
+  if (c >= 'A' && c <= 'Z')
+    return c - 'A';
+  if (c >= 'a' && c <= 'z')
+    return c - 'a' + 26;
+  if (c >= '0' && c <= '9')
+    return c - '0' + 52;
+  if (c == '+' || c == '-')
+    return 62;
+  if (c == '/' || c == '_')
+    return 63;
+  return -1;
+}
+
+esp_err_t js_buffer_base64_decode(const char *text, size_t len, uint8_t *out, size_t *out_len)
+{
+  size_t room = *out_len;
+  size_t written = 0;
+  size_t digits = 0;
+  size_t padding = 0;
+  uint32_t bits = 0;
+  int pending = 0;
+  for (size_t i = 0; i < len; i++)
+  {
+    char c = text[i];
+    if (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+    {
+      continue;
+    }
+    if (c == '=')
+    {
+      padding++;
+      continue;
+    }
+    int value = base64_value(c);
+    if (value < 0 || padding > 0)
+    {
+      return ESP_ERR_INVALID_ARG; // Nothing but padding may follow padding
+    }
+    digits++;
+    bits = bits << 6 | (uint32_t)value;
+    pending += 6;
+    if (pending >= 8)
+    {
+      pending -= 8;
+      if (written == room)
+      {
+        return ESP_ERR_INVALID_SIZE;
+      }
+      out[written++] = (uint8_t)(bits >> pending);
+    }
+  }
+
+  // A last group of one digit holds no whole byte, and padding, if any,
+  // must complete the last group exactly.
+  size_t tail = digits % 4;
+  if (tail == 1 || (padding > 0 && (tail == 0 || tail + padding != 4)))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  *out_len = written;
+  return ESP_OK;
+}
+
+void js_buffer_hex_encode(const uint8_t *data, size_t len, char *out)
+{
+  static const char digits[] = "0123456789abcdef";
+  for (size_t i = 0; i < len; i++)
+  {
+    *out++ = digits[data[i] >> 4];
+    *out++ = digits[data[i] & 0x0F];
+  }
+}
+
+static int hex_value(char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+esp_err_t js_buffer_hex_decode(const char *text, size_t len, uint8_t *out, size_t *out_len)
+{
+  if (len % 2 != 0)
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (len / 2 > *out_len)
+  {
+    return ESP_ERR_INVALID_SIZE;
+  }
+  for (size_t i = 0; i < len; i += 2)
+  {
+    int high = hex_value(text[i]);
+    int low = hex_value(text[i + 1]);
+    if (high < 0 || low < 0)
+    {
+      return ESP_ERR_INVALID_ARG;
+    }
+    out[i / 2] = (uint8_t)(high << 4 | low);
+  }
+  *out_len = len / 2;
+  return ESP_OK;
+}
+
+/**
+ * @brief The field type of each format character, except the pad byte and byte runs.
+ */
+static const struct
+{
+  char code;
+  uint8_t type;
+  uint8_t size;
+} format_fields[] = {
+    {'b', JS_BUFFER_INT8, 1},
+    {'B', JS_BUFFER_UINT8, 1},
+    {'?', JS_BUFFER_BOOL, 1},
+    {'h', JS_BUFFER_INT16, 2},
+    {'H', JS_BUFFER_UINT16, 2},
+    {'i', JS_BUFFER_INT32, 4},
+    {'l', JS_BUFFER_INT32, 4},
+    {'I', JS_BUFFER_UINT32, 4},
+    {'L', JS_BUFFER_UINT32, 4},
+    {'q', JS_BUFFER_INT64, 8},
+    {'Q', JS_BUFFER_UINT64, 8},
+    {'f', JS_BUFFER_FLOAT32, 4},
+    {'d', JS_BUFFER_FLOAT64, 8},
+};
+
+static bool format_field(char c, js_buffer_type_t *type, uint16_t *size)
+{
+  for (size_t i = 0; i < sizeof(format_fields) / sizeof(format_fields[0]); i++)
+  {
+    if (format_fields[i].code == c)
+    {
+      *type = (js_buffer_type_t)format_fields[i].type;
+      *size = format_fields[i].size;
+      return true;
+    }
+  }
+  return false;
+}
+
+esp_err_t js_buffer_layout_compile(const char *format, size_t len, js_buffer_layout_t **out)
+{
+  js_buffer_field_t fields[JS_BUFFER_MAX_FIELDS];
+  uint16_t count = 0;
+  uint32_t offset = 0;
+  bool little_endian = true;
+
+  size_t i = 0;
+  if (len > 0 && (format[0] == '<' || format[0] == '>' || format[0] == '!'))
+  {
+    little_endian = format[0] == '<';
+    i++;
+  }
+
+  while (i < len)
+  {
+    if (format[i] == ' ')
+    {
+      i++;
+      continue;
+    }
+
+    uint32_t repeat = 1;
+    if (format[i] >= '0' && format[i] <= '9')
+    {
+      repeat = 0;
+      while (i < len && format[i] >= '0' && format[i] <= '9' && repeat <= UINT16_MAX)
+      {
+        repeat = repeat * 10 + (uint32_t)(format[i++] - '0');
+      }
+      if (i == len)
+      {
+        return ESP_ERR_INVALID_ARG; // A count with nothing to repeat
+      }
+    }
+
+    char c = format[i++];
+    js_buffer_type_t type;
+    uint16_t size;
+    if (c == 'x')
+    {
+      offset += repeat;
+    }
+    else if (c == 's')
+    {
+      if (count == JS_BUFFER_MAX_FIELDS)
+      {
+        return ESP_ERR_INVALID_SIZE;
+      }
+      fields[count++] = (js_buffer_field_t){.type = JS_BUFFER_BYTES, .offset = (uint16_t)offset, .size = (uint16_t)repeat};
+      offset += repeat;
+    }
+    else if (format_field(c, &type, &size))
+    {
+      if (repeat > (uint32_t)(JS_BUFFER_MAX_FIELDS - count))
+      {
+        return ESP_ERR_INVALID_SIZE;
+      }
+      for (uint32_t r = 0; r < repeat; r++)
+      {
+        fields[count++] = (js_buffer_field_t){.type = type, .offset = (uint16_t)offset, .size = size};
+        offset += size;
+      }
+    }
+    else
+    {
+      return ESP_ERR_INVALID_ARG;
+    }
+
+    if (offset > UINT16_MAX)
+    {
+      return ESP_ERR_INVALID_SIZE;
+    }
+  }
+
+  js_buffer_layout_t *layout = malloc(sizeof(js_buffer_layout_t) + count * sizeof(js_buffer_field_t));
+  if (layout == NULL)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  layout->little_endian = little_endian;
+  layout->size = (uint16_t)offset;
+  layout->count = count;
+  memcpy(layout->fields, fields, count * sizeof(js_buffer_field_t));
+  *out = layout;
+  return ESP_OK;
+}
+
+static uint64_t load(const js_buffer_layout_t *layout, const uint8_t *p, uint16_t size)
+{
+  uint64_t bits = 0;
+  for (uint16_t i = 0; i < size; i++)
+  {
+    bits |= (uint64_t)p[layout->little_endian ? i : size - 1 - i] << (8 * i);
+  }
+  return bits;
+}
+
+static void store(const js_buffer_layout_t *layout, uint8_t *p, uint16_t size, uint64_t bits)
+{
+  for (uint16_t i = 0; i < size; i++)
+  {
+    p[layout->little_endian ? i : size - 1 - i] = (uint8_t)(bits >> (8 * i));
+  }
+}
+
+/**
+ * @brief A number modulo 2^64, as typed arrays convert to integers.
+ */
+static uint64_t to_bits(double value)
+{
+  if (!isfinite(value))
+  {
+    return 0;
+  }
+  if (value < 0)
+  {
+    return (uint64_t)0 - to_bits(-value);
+  }
+  double m = fmod(trunc(value), 18446744073709551616.0);
+  return m >= 9223372036854775808.0 ? (uint64_t)(m - 9223372036854775808.0) | 0x8000000000000000ULL : (uint64_t)m;
+}
+
+double js_buffer_read_field(const js_buffer_layout_t *layout, const js_buffer_field_t *field, const uint8_t *base)
+{
+  uint64_t bits = load(layout, base + field->offset, field->size);
+  switch (field->type)
+  {
+  case JS_BUFFER_INT8:
+    return (int8_t)bits;
+  case JS_BUFFER_BOOL:
+    return bits != 0;
+  case JS_BUFFER_INT16:
+    return (int16_t)bits;
+  case JS_BUFFER_INT32:
+    return (int32_t)bits;
+  case JS_BUFFER_INT64:
+    return (double)(int64_t)bits;
+  case JS_BUFFER_FLOAT32:
+  {
+    uint32_t word = (uint32_t)bits;
+    float f;
+    memcpy(&f, &word, sizeof(f));
+    return f;
+  }
+  case JS_BUFFER_FLOAT64:
+  {
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+  }
+  default:
+    return (double)bits;
+  }
+}
+
+void js_buffer_write_field(const js_buffer_layout_t *layout, const js_buffer_field_t *field, uint8_t *base,
+                           double value)
+{
+  uint64_t bits;
+  switch (field->type)
+  {
+  case JS_BUFFER_BOOL:
+    bits = value != 0 && !isnan(value);
+    break;
+  case JS_BUFFER_FLOAT32:
+  {
+    float f = (float)value;
+    uint32_t word;
+    memcpy(&word, &f, sizeof(word));
+    bits = word;
+    break;
+  }
+  case JS_BUFFER_FLOAT64:
+    memcpy(&bits, &value, sizeof(bits));
+    break;
+  default:
+    bits = to_bits(value);
+    break;
+  }
+  store(layout, base + field->offset, field->size, bits);
+}
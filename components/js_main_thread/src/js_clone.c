@@ -0,0 +1,409 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "js_clone.h"
+
+/**
+ * @brief Type tags of the encoding. Lengths and counts are native-endian
+ * uint32_t, since both ends run on the same chip.
+ */
+typedef enum
+{
+  CLONE_UNDEFINED,
+  CLONE_NULL,
+  CLONE_FALSE,
+  CLONE_TRUE,
+  CLONE_NUMBER,      /**< A double. */
+  CLONE_STRING,      /**< Byte length, then UTF-8. */
+  CLONE_ARRAYBUFFER, /**< Byte length, then the bytes. */
+  CLONE_TYPEDARRAY,  /**< jerry_typedarray_type_t byte, byte length, then the bytes. */
+  CLONE_ARRAY,       /**< Element count, then the elements. */
+  CLONE_OBJECT,      /**< Property count, then key string and value pairs. */
+} clone_tag_t;
+
+typedef struct
+{
+  uint8_t *data;
+  size_t len;
+  size_t cap;
+} clone_writer_t;
+
+typedef struct
+{
+  const uint8_t *pos;
+  const uint8_t *end;
+} clone_reader_t;
+
+// --- Encoding ---
+
+static bool writer_reserve(clone_writer_t *w, size_t n)
+{
+  if (w->len + n <= w->cap)
+  {
+    return true;
+  }
+  size_t cap = w->cap ? w->cap * 2 : 64;
+  while (cap < w->len + n)
+  {
+    cap *= 2;
+  }
+  uint8_t *data = (uint8_t *)realloc(w->data, cap);
+  if (!data)
+  {
+    return false;
+  }
+  w->data = data;
+  w->cap = cap;
+  return true;
+}
+
+static bool write_bytes(clone_writer_t *w, const void *bytes, size_t n)
+{
+  if (!writer_reserve(w, n))
+  {
+    return false;
+  }
+  memcpy(w->data + w->len, bytes, n);
+  w->len += n;
+  return true;
+}
+
+static bool write_tag(clone_writer_t *w, clone_tag_t tag)
+{
+  uint8_t byte = (uint8_t)tag;
+  return write_bytes(w, &byte, 1);
+}
+
+static bool write_u32(clone_writer_t *w, uint32_t n)
+{
+  return write_bytes(w, &n, sizeof(n));
+}
+
+static bool write_string(clone_writer_t *w, jerry_value_t string)
+{
+  jerry_size_t size = jerry_string_size(string, JERRY_ENCODING_UTF8);
+  if (!write_u32(w, size) || !writer_reserve(w, size))
+  {
+    return false;
+  }
+  jerry_string_to_buffer(string, JERRY_ENCODING_UTF8, w->data + w->len, size);
+  w->len += size;
+  return true;
+}
+
+static jerry_value_t out_of_memory(void)
+{
+  return jerry_throw_sz(JERRY_ERROR_RANGE, "Out of memory cloning message");
+}
+
+static jerry_value_t write_value(clone_writer_t *w, jerry_value_t value, int depth);
+
+static jerry_value_t write_array(clone_writer_t *w, jerry_value_t array, int depth)
+{
+  uint32_t count = jerry_array_length(array);
+  if (!write_tag(w, CLONE_ARRAY) || !write_u32(w, count))
+  {
+    return out_of_memory();
+  }
+  for (uint32_t i = 0; i < count; i++)
+  {
+    jerry_value_t element = jerry_object_get_index(array, i);
+    if (jerry_value_is_exception(element))
+    {
+      return element;
+    }
+    jerry_value_t result = write_value(w, element, depth + 1);
+    jerry_value_free(element);
+    if (jerry_value_is_exception(result))
+    {
+      return result;
+    }
+  }
+  return jerry_undefined();
+}
+
+static jerry_value_t write_object(clone_writer_t *w, jerry_value_t object, int depth)
+{
+  jerry_value_t keys = jerry_object_keys(object);
+  if (jerry_value_is_exception(keys))
+  {
+    return keys;
+  }
+
+  uint32_t count = jerry_array_length(keys);
+  jerry_value_t result = jerry_undefined();
+  if (!write_tag(w, CLONE_OBJECT) || !write_u32(w, count))
+  {
+    result = out_of_memory();
+  }
+
+  for (uint32_t i = 0; i < count && !jerry_value_is_exception(result); i++)
+  {
+    jerry_value_t key = jerry_object_get_index(keys, i);
+    jerry_value_t property = jerry_object_get(object, key);
+    if (jerry_value_is_exception(property))
+    {
+      result = property;
+      property = jerry_undefined();
+    }
+    else if (!write_string(w, key))
+    {
+      result = out_of_memory();
+    }
+    else
+    {
+      result = write_value(w, property, depth + 1);
+    }
+    jerry_value_free(property);
+    jerry_value_free(key);
+  }
+
+  jerry_value_free(keys);
+  return result;
+}
+
+static jerry_value_t write_value(clone_writer_t *w, jerry_value_t value, int depth)
+{
+  if (depth > JS_CLONE_MAX_DEPTH)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Message is nested too deeply to clone");
+  }
+
+  bool ok;
+  if (jerry_value_is_undefined(value))
+  {
+    ok = write_tag(w, CLONE_UNDEFINED);
+  }
+  else if (jerry_value_is_null(value))
+  {
+    ok = write_tag(w, CLONE_NULL);
+  }
+  else if (jerry_value_is_boolean(value))
+  {
+    ok = write_tag(w, jerry_value_is_true(value) ? CLONE_TRUE : CLONE_FALSE);
+  }
+  else if (jerry_value_is_number(value))
+  {
+    double number = jerry_value_as_number(value);
+    ok = write_tag(w, CLONE_NUMBER) && write_bytes(w, &number, sizeof(number));
+  }
+  else if (jerry_value_is_string(value))
+  {
+    ok = write_tag(w, CLONE_STRING) && write_string(w, value);
+  }
+  else if (jerry_value_is_arraybuffer(value))
+  {
+    jerry_length_t size = jerry_arraybuffer_size(value);
+    ok = write_tag(w, CLONE_ARRAYBUFFER) && write_u32(w, size) && writer_reserve(w, size);
+    if (ok)
+    {
+      w->len += jerry_arraybuffer_read(value, 0, w->data + w->len, size);
+    }
+  }
+  else if (jerry_value_is_typedarray(value))
+  {
+    jerry_length_t offset = 0, size = 0;
+    jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, &size);
+    uint8_t type = (uint8_t)jerry_typedarray_type(value);
+    ok = write_tag(w, CLONE_TYPEDARRAY) && write_bytes(w, &type, 1) && write_u32(w, size) && writer_reserve(w, size);
+    if (ok)
+    {
+      w->len += jerry_arraybuffer_read(buffer, offset, w->data + w->len, size);
+    }
+    jerry_value_free(buffer);
+  }
+  else if (jerry_value_is_array(value))
+  {
+    return write_array(w, value, depth);
+  }
+  else if (jerry_value_is_object(value) && !jerry_value_is_function(value))
+  {
+    return write_object(w, value, depth);
+  }
+  else
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Value cannot be cloned");
+  }
+
+  return ok ? jerry_undefined() : out_of_memory();
+}
+
+jerry_value_t js_clone_serialize(jerry_value_t value, size_t reserve, uint8_t **out, size_t *out_len)
+{
+  clone_writer_t w = {0};
+  if (!writer_reserve(&w, reserve))
+  {
+    return out_of_memory();
+  }
+  w.len = reserve;
+
+  jerry_value_t result = write_value(&w, value, 0);
+  if (jerry_value_is_exception(result))
+  {
+    free(w.data);
+    return result;
+  }
+
+  *out = w.data;
+  *out_len = w.len - reserve;
+  return result;
+}
+
+// --- Decoding ---
+
+static bool read_bytes(clone_reader_t *r, void *out, size_t n)
+{
+  if ((size_t)(r->end - r->pos) < n)
+  {
+    return false;
+  }
+  memcpy(out, r->pos, n);
+  r->pos += n;
+  return true;
+}
+
+static bool read_u32(clone_reader_t *r, uint32_t *out)
+{
+  return read_bytes(r, out, sizeof(*out));
+}
+
+/**
+ * @brief Reads a length and returns a pointer to that many bytes, or NULL.
+ */
+static const uint8_t *read_span(clone_reader_t *r, uint32_t *len)
+{
+  if (!read_u32(r, len) || (size_t)(r->end - r->pos) < *len)
+  {
+    return NULL;
+  }
+  const uint8_t *span = r->pos;
+  r->pos += *len;
+  return span;
+}
+
+static jerry_value_t malformed(void)
+{
+  return jerry_throw_sz(JERRY_ERROR_COMMON, "Malformed cloned message");
+}
+
+static jerry_value_t read_value(clone_reader_t *r, int depth)
+{
+  uint8_t tag;
+  if (depth > JS_CLONE_MAX_DEPTH || !read_bytes(r, &tag, 1))
+  {
+    return malformed();
+  }
+
+  uint32_t len;
+  const uint8_t *span;
+  switch (tag)
+  {
+  case CLONE_UNDEFINED:
+    return jerry_undefined();
+
+  case CLONE_NULL:
+    return jerry_null();
+
+  case CLONE_FALSE:
+  case CLONE_TRUE:
+    return jerry_boolean(tag == CLONE_TRUE);
+
+  case CLONE_NUMBER:
+  {
+    double number;
+    return read_bytes(r, &number, sizeof(number)) ? jerry_number(number) : malformed();
+  }
+
+  case CLONE_STRING:
+    span = read_span(r, &len);
+    return span ? jerry_string(span, len, JERRY_ENCODING_UTF8) : malformed();
+
+  case CLONE_ARRAYBUFFER:
+  case CLONE_TYPEDARRAY:
+  {
+    uint8_t type = JERRY_TYPEDARRAY_UINT8;
+    if (tag == CLONE_TYPEDARRAY && !read_bytes(r, &type, 1))
+    {
+      return malformed();
+    }
+    span = read_span(r, &len);
+    if (!span)
+    {
+      return malformed();
+    }
+    jerry_value_t buffer = jerry_arraybuffer(len);
+    jerry_arraybuffer_write(buffer, 0, span, len);
+    if (tag == CLONE_ARRAYBUFFER)
+    {
+      return buffer;
+    }
+    jerry_value_t view = jerry_typedarray_with_buffer((jerry_typedarray_type_t)type, buffer);
+    jerry_value_free(buffer);
+    return view;
+  }
+
+  case CLONE_ARRAY:
+  {
+    if (!read_u32(r, &len))
+    {
+      return malformed();
+    }
+    jerry_value_t array = jerry_array(len);
+    for (uint32_t i = 0; i < len; i++)
+    {
+      jerry_value_t element = read_value(r, depth + 1);
+      if (jerry_value_is_exception(element))
+      {
+        jerry_value_free(array);
+        return element;
+      }
+      jerry_value_free(jerry_object_set_index(array, i, element));
+      jerry_value_free(element);
+    }
+    return array;
+  }
+
+  case CLONE_OBJECT:
+  {
+    if (!read_u32(r, &len))
+    {
+      return malformed();
+    }
+    jerry_value_t object = jerry_object();
+    for (uint32_t i = 0; i < len; i++)
+    {
+      uint32_t key_len;
+      const uint8_t *key_bytes = read_span(r, &key_len);
+      if (!key_bytes)
+      {
+        jerry_value_free(object);
+        return malformed();
+      }
+      jerry_value_t property = read_value(r, depth + 1);
+      if (jerry_value_is_exception(property))
+      {
+        jerry_value_free(object);
+        return property;
+      }
+      jerry_value_t key = jerry_string(key_bytes, key_len, JERRY_ENCODING_UTF8);
+      jerry_value_free(jerry_object_set(object, key, property));
+      jerry_value_free(key);
+      jerry_value_free(property);
+    }
+    return object;
+  }
+
+  default:
+    return malformed();
+  }
+}
+
+jerry_value_t js_clone_deserialize(const uint8_t *data, size_t len)
+{
+  clone_reader_t r = {
+      .pos = data,
+      .end = data + len,
+  };
+  return read_value(&r, 0);
+}
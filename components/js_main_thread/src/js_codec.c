@@ -0,0 +1,1564 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "js_codec.h"
+
+#define MAX_KEY_BYTES 255   // Longest key a schema may hold
+#define MAX_NUMBER_CHARS 40 // Longest JSON number the decoder accepts
+
+typedef struct
+{
+  const uint8_t *cbor; /**< Text string head, then the UTF-8 key. */
+  const uint8_t *json; /**< The quoted, escaped key and a colon. */
+  uint16_t cbor_len;
+  uint16_t json_len;
+  uint8_t head_len; /**< Bytes of `cbor` before the key itself. */
+} codec_key_t;
+
+struct js_codec_schema
+{
+  size_t count;
+  codec_key_t keys[];
+};
+
+/**
+ * @brief Writes into a fixed buffer, counting on past its end so the
+ * caller learns how long the whole encoding is.
+ */
+typedef struct
+{
+  uint8_t *out;
+  size_t cap;
+  size_t len;
+} codec_writer_t;
+
+typedef struct
+{
+  js_codec_format_t format;
+  codec_writer_t w;
+} codec_encoder_t;
+
+typedef struct
+{
+  const uint8_t *pos;
+  const uint8_t *end;
+  const js_codec_schema_t *schema;
+  jerry_value_t keys;
+  size_t next_key; /**< Schema key expected next, tried first. */
+} codec_reader_t;
+
+// --- Writing ---
+
+static bool writer_fits(const codec_writer_t *w, size_t n)
+{
+  return w->out && w->len + n <= w->cap;
+}
+
+static void put(codec_writer_t *w, const void *bytes, size_t n)
+{
+  if (writer_fits(w, n))
+  {
+    memcpy(w->out + w->len, bytes, n);
+  }
+  w->len += n;
+}
+
+static void put_byte(codec_writer_t *w, uint8_t byte)
+{
+  put(w, &byte, 1);
+}
+
+static void put_sz(codec_writer_t *w, const char *text)
+{
+  put(w, text, strlen(text));
+}
+
+static void put_be(codec_writer_t *w, uint64_t value, size_t n)
+{
+  uint8_t bytes[8];
+  for (size_t i = 0; i < n; i++)
+  {
+    bytes[i] = (uint8_t)(value >> (8 * (n - 1 - i)));
+  }
+  put(w, bytes, n);
+}
+
+static jerry_value_t out_of_memory(void)
+{
+  return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+}
+
+// --- CBOR encoding ---
+
+static size_t cbor_head_size(uint64_t arg)
+{
+  return arg < 24 ? 1 : arg <= 0xff ? 2 : arg <= 0xffff ? 3 : arg <= 0xffffffff ? 5 : 9;
+}
+
+static void cbor_head(codec_writer_t *w, uint8_t major, uint64_t arg)
+{
+  size_t size = cbor_head_size(arg);
+  if (size == 1)
+  {
+    put_byte(w, (uint8_t)(major << 5 | arg));
+    return;
+  }
+  static const uint8_t info[] = {0, 24, 25, 0, 26, 0, 0, 0, 27};
+  put_byte(w, (uint8_t)(major << 5 | info[size - 1]));
+  put_be(w, arg, size - 1);
+}
+
+static void cbor_number(codec_writer_t *w, double number)
+{
+  if (number == trunc(number) && fabs(number) <= 9007199254740991.0)
+  {
+    if (number >= 0)
+    {
+      cbor_head(w, 0, (uint64_t)number);
+    }
+    else
+    {
+      cbor_head(w, 1, (uint64_t)(-1 - number));
+    }
+    return;
+  }
+
+  // The shortest float that holds the value exactly; float32 covers
+  // sensor readings, which start life as floats.
+  float single = (float)number;
+  if ((double)single == number || isnan(number))
+  {
+    uint32_t bits;
+    memcpy(&bits, &single, sizeof(bits));
+    put_byte(w, 0xfa);
+    put_be(w, bits, 4);
+  }
+  else
+  {
+    uint64_t bits;
+    memcpy(&bits, &number, sizeof(bits));
+    put_byte(w, 0xfb);
+    put_be(w, bits, 8);
+  }
+}
+
+static void cbor_string(codec_writer_t *w, jerry_value_t string)
+{
+  jerry_size_t size = jerry_string_size(string, JERRY_ENCODING_UTF8);
+  cbor_head(w, 3, size);
+  if (writer_fits(w, size))
+  {
+    jerry_string_to_buffer(string, JERRY_ENCODING_UTF8, w->out + w->len, size);
+  }
+  w->len += size;
+}
+
+/**
+ * @brief The RFC 8746 tag of a little-endian typed array.
+ */
+static uint8_t cbor_typed_array_tag(jerry_typedarray_type_t type)
+{
+  switch (type)
+  {
+  case JERRY_TYPEDARRAY_UINT8:
+    return 64;
+  case JERRY_TYPEDARRAY_UINT8CLAMPED:
+    return 68;
+  case JERRY_TYPEDARRAY_UINT16:
+    return 69;
+  case JERRY_TYPEDARRAY_UINT32:
+    return 70;
+  case JERRY_TYPEDARRAY_BIGUINT64:
+    return 71;
+  case JERRY_TYPEDARRAY_INT8:
+    return 72;
+  case JERRY_TYPEDARRAY_INT16:
+    return 77;
+  case JERRY_TYPEDARRAY_INT32:
+    return 78;
+  case JERRY_TYPEDARRAY_BIGINT64:
+    return 79;
+  case JERRY_TYPEDARRAY_FLOAT32:
+    return 85;
+  case JERRY_TYPEDARRAY_FLOAT64:
+    return 86;
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Copies `size` bytes of `buffer` from `offset` straight into the output.
+ */
+static void put_arraybuffer(codec_writer_t *w, jerry_value_t buffer, jerry_length_t offset, jerry_length_t size)
+{
+  if (writer_fits(w, size))
+  {
+    jerry_arraybuffer_read(buffer, offset, w->out + w->len, size);
+  }
+  w->len += size;
+}
+
+// --- JSON encoding ---
+
+/**
+ * @brief Writes the JSON escape of byte `c` into `buf`.
+ * @return Its length: 1 when the byte stands for itself.
+ */
+static size_t json_escape(uint8_t c, char buf[7])
+{
+  static const char short_escapes[] = "btn\0fr";
+  if (c == '"' || c == '\\')
+  {
+    buf[0] = '\\';
+    buf[1] = (char)c;
+    return 2;
+  }
+  if (c >= 0x20)
+  {
+    buf[0] = (char)c;
+    return 1;
+  }
+  if (c >= '\b' && c <= '\r' && short_escapes[c - '\b'])
+  {
+    buf[0] = '\\';
+    buf[1] = short_escapes[c - '\b'];
+    return 2;
+  }
+  snprintf(buf, 7, "\\u%04x", c);
+  return 6;
+}
+
+static size_t json_escaped_size(const uint8_t *bytes, size_t len)
+{
+  size_t size = 0;
+  char buf[7];
+  for (size_t i = 0; i < len; i++)
+  {
+    size += json_escape(bytes[i], buf);
+  }
+  return size;
+}
+
+static void json_put_escaped(codec_writer_t *w, const uint8_t *bytes, size_t len)
+{
+  char buf[7];
+  for (size_t i = 0; i < len; i++)
+  {
+    put(w, buf, json_escape(bytes[i], buf));
+  }
+}
+
+/**
+ * @brief Writes a quoted string. When the raw bytes fit, they are copied
+ * straight into the output and escaped in place, back to front, so no
+ * copy of the string is made.
+ */
+static bool json_string(codec_writer_t *w, jerry_value_t string)
+{
+  jerry_size_t size = jerry_string_size(string, JERRY_ENCODING_UTF8);
+  if (writer_fits(w, size + 2))
+  {
+    uint8_t *raw = w->out + w->len + 1;
+    jerry_string_to_buffer(string, JERRY_ENCODING_UTF8, raw, size);
+    size_t escaped = json_escaped_size(raw, size);
+    if (escaped != size && writer_fits(w, escaped + 2))
+    {
+      char buf[7];
+      uint8_t *dst = raw + escaped;
+      for (size_t i = size; i > 0; i--)
+      {
+        size_t n = json_escape(raw[i - 1], buf);
+        dst -= n;
+        memcpy(dst, buf, n);
+      }
+    }
+    w->out[w->len] = '"';
+    if (writer_fits(w, escaped + 2))
+    {
+      w->out[w->len + 1 + escaped] = '"';
+    }
+    w->len += escaped + 2;
+    return true;
+  }
+
+  // Only measuring, or out of room: escape from a scratch copy.
+  uint8_t stack[64];
+  uint8_t *raw = size <= sizeof(stack) ? stack : malloc(size);
+  if (!raw)
+  {
+    return false;
+  }
+  jerry_string_to_buffer(string, JERRY_ENCODING_UTF8, raw, size);
+  put_byte(w, '"');
+  json_put_escaped(w, raw, size);
+  put_byte(w, '"');
+  if (raw != stack)
+  {
+    free(raw);
+  }
+  return true;
+}
+
+static void json_number(codec_writer_t *w, double number)
+{
+  char buf[32];
+  if (!isfinite(number))
+  {
+    put_sz(w, "null");
+    return;
+  }
+  if (number == trunc(number) && fabs(number) < 1e21)
+  {
+    snprintf(buf, sizeof(buf), "%.0f", number == 0 ? 0.0 : number);
+  }
+  else
+  {
+    // The shortest of the round-tripping precisions, as JSON.stringify prints.
+    for (int precision = 15; precision <= 17; precision++)
+    {
+      snprintf(buf, sizeof(buf), "%.*g", precision, number);
+      if (strtod(buf, NULL) == number)
+      {
+        break;
+      }
+    }
+  }
+  put_sz(w, buf);
+}
+
+/**
+ * @brief Reads element `index` of typed array bytes as a number.
+ */
+static double typed_element(jerry_typedarray_type_t type, const uint8_t *bytes, size_t index)
+{
+  switch (type)
+  {
+  case JERRY_TYPEDARRAY_INT8:
+    return ((const int8_t *)bytes)[index];
+  case JERRY_TYPEDARRAY_UINT16:
+  {
+    uint16_t v;
+    memcpy(&v, bytes + 2 * index, 2);
+    return v;
+  }
+  case JERRY_TYPEDARRAY_INT16:
+  {
+    int16_t v;
+    memcpy(&v, bytes + 2 * index, 2);
+    return v;
+  }
+  case JERRY_TYPEDARRAY_UINT32:
+  {
+    uint32_t v;
+    memcpy(&v, bytes + 4 * index, 4);
+    return v;
+  }
+  case JERRY_TYPEDARRAY_INT32:
+  {
+    int32_t v;
+    memcpy(&v, bytes + 4 * index, 4);
+    return v;
+  }
+  case JERRY_TYPEDARRAY_FLOAT32:
+  {
+    float v;
+    memcpy(&v, bytes + 4 * index, 4);
+    return v;
+  }
+  case JERRY_TYPEDARRAY_FLOAT64:
+  {
+    double v;
+    memcpy(&v, bytes + 8 * index, 8);
+    return v;
+  }
+  default:
+    return bytes[index];
+  }
+}
+
+static size_t typed_element_size(jerry_typedarray_type_t type)
+{
+  switch (type)
+  {
+  case JERRY_TYPEDARRAY_UINT16:
+  case JERRY_TYPEDARRAY_INT16:
+    return 2;
+  case JERRY_TYPEDARRAY_UINT32:
+  case JERRY_TYPEDARRAY_INT32:
+  case JERRY_TYPEDARRAY_FLOAT32:
+    return 4;
+  case JERRY_TYPEDARRAY_FLOAT64:
+  case JERRY_TYPEDARRAY_BIGINT64:
+  case JERRY_TYPEDARRAY_BIGUINT64:
+    return 8;
+  default:
+    return 1;
+  }
+}
+
+static void json_bytes(codec_writer_t *w, jerry_typedarray_type_t type, const uint8_t *bytes, size_t size)
+{
+  size_t count = size / typed_element_size(type);
+  put_byte(w, '[');
+  for (size_t i = 0; i < count; i++)
+  {
+    if (i > 0)
+    {
+      put_byte(w, ',');
+    }
+    json_number(w, typed_element(type, bytes, i));
+  }
+  put_byte(w, ']');
+}
+
+// --- Values ---
+
+static jerry_value_t encode_value(codec_encoder_t *e, jerry_value_t value, int depth);
+
+static jerry_value_t encode_buffer(codec_encoder_t *e, jerry_value_t value)
+{
+  jerry_typedarray_type_t type = JERRY_TYPEDARRAY_UINT8;
+  jerry_length_t offset = 0, size;
+  jerry_value_t buffer;
+  bool typed = jerry_value_is_typedarray(value);
+  if (typed)
+  {
+    type = jerry_typedarray_type(value);
+    buffer = jerry_typedarray_buffer(value, &offset, &size);
+  }
+  else
+  {
+    buffer = jerry_value_copy(value);
+    size = jerry_arraybuffer_size(value);
+  }
+
+  jerry_value_t result = jerry_undefined();
+  if (e->format == JS_CODEC_CBOR)
+  {
+    if (typed)
+    {
+      cbor_head(&e->w, 6, cbor_typed_array_tag(type));
+    }
+    cbor_head(&e->w, 2, size);
+    put_arraybuffer(&e->w, buffer, offset, size);
+  }
+  else if (type == JERRY_TYPEDARRAY_BIGINT64 || type == JERRY_TYPEDARRAY_BIGUINT64)
+  {
+    result = jerry_throw_sz(JERRY_ERROR_TYPE, "BigInt arrays cannot be encoded as JSON.");
+  }
+  else
+  {
+    uint8_t *bytes = jerry_arraybuffer_data(buffer);
+    json_bytes(&e->w, type, bytes ? bytes + offset : NULL, bytes ? size : 0);
+  }
+  jerry_value_free(buffer);
+  return result;
+}
+
+static jerry_value_t encode_array(codec_encoder_t *e, jerry_value_t array, int depth)
+{
+  uint32_t count = jerry_array_length(array);
+  if (e->format == JS_CODEC_CBOR)
+  {
+    cbor_head(&e->w, 4, count);
+  }
+  else
+  {
+    put_byte(&e->w, '[');
+  }
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    jerry_value_t element = jerry_object_get_index(array, i);
+    if (jerry_value_is_exception(element))
+    {
+      return element;
+    }
+    if (e->format == JS_CODEC_JSON && i > 0)
+    {
+      put_byte(&e->w, ',');
+    }
+    jerry_value_t result;
+    if (e->format == JS_CODEC_JSON && jerry_value_is_undefined(element))
+    {
+      put_sz(&e->w, "null");
+      result = jerry_undefined();
+    }
+    else
+    {
+      result = encode_value(e, element, depth + 1);
+    }
+    jerry_value_free(element);
+    if (jerry_value_is_exception(result))
+    {
+      return result;
+    }
+  }
+
+  if (e->format == JS_CODEC_JSON)
+  {
+    put_byte(&e->w, ']');
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Writes one property: the key as `key` or, if given, pre-encoded
+ * as `schema_key`, then the value. JSON leaves out undefined values.
+ */
+static jerry_value_t encode_property(codec_encoder_t *e, jerry_value_t key, const codec_key_t *schema_key,
+                                     jerry_value_t property, bool *first, int depth)
+{
+  if (e->format == JS_CODEC_JSON)
+  {
+    if (jerry_value_is_undefined(property))
+    {
+      return jerry_undefined();
+    }
+    if (!*first)
+    {
+      put_byte(&e->w, ',');
+    }
+    if (schema_key)
+    {
+      put(&e->w, schema_key->json, schema_key->json_len);
+    }
+    else
+    {
+      if (!json_string(&e->w, key))
+      {
+        return out_of_memory();
+      }
+      put_byte(&e->w, ':');
+    }
+  }
+  else if (schema_key)
+  {
+    put(&e->w, schema_key->cbor, schema_key->cbor_len);
+  }
+  else
+  {
+    cbor_string(&e->w, key);
+  }
+  *first = false;
+  return encode_value(e, property, depth + 1);
+}
+
+static jerry_value_t encode_object(codec_encoder_t *e, jerry_value_t object, const js_codec_schema_t *schema,
+                                   jerry_value_t schema_keys, int depth)
+{
+  jerry_value_t keys = schema ? jerry_value_copy(schema_keys) : jerry_object_keys(object);
+  if (jerry_value_is_exception(keys))
+  {
+    return keys;
+  }
+
+  uint32_t count = schema ? (uint32_t)schema->count : jerry_array_length(keys);
+  if (e->format == JS_CODEC_CBOR)
+  {
+    cbor_head(&e->w, 5, count);
+  }
+  else
+  {
+    put_byte(&e->w, '{');
+  }
+
+  bool first = true;
+  jerry_value_t result = jerry_undefined();
+  for (uint32_t i = 0; i < count && !jerry_value_is_exception(result); i++)
+  {
+    jerry_value_t key = jerry_object_get_index(keys, i);
+    jerry_value_t property = jerry_object_get(object, key);
+    if (jerry_value_is_exception(property))
+    {
+      result = property;
+      property = jerry_undefined();
+    }
+    else
+    {
+      result = encode_property(e, key, schema ? &schema->keys[i] : NULL, property, &first, depth);
+    }
+    jerry_value_free(property);
+    jerry_value_free(key);
+  }
+  jerry_value_free(keys);
+
+  if (e->format == JS_CODEC_JSON)
+  {
+    put_byte(&e->w, '}');
+  }
+  return result;
+}
+
+static jerry_value_t encode_value(codec_encoder_t *e, jerry_value_t value, int depth)
+{
+  if (depth > JS_CODEC_MAX_DEPTH)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Value is nested too deeply to encode.");
+  }
+
+  bool cbor = e->format == JS_CODEC_CBOR;
+  if (jerry_value_is_undefined(value))
+  {
+    cbor ? put_byte(&e->w, 0xf7) : put_sz(&e->w, "null");
+  }
+  else if (jerry_value_is_null(value))
+  {
+    cbor ? put_byte(&e->w, 0xf6) : put_sz(&e->w, "null");
+  }
+  else if (jerry_value_is_boolean(value))
+  {
+    bool truth = jerry_value_is_true(value);
+    cbor ? put_byte(&e->w, truth ? 0xf5 : 0xf4) : put_sz(&e->w, truth ? "true" : "false");
+  }
+  else if (jerry_value_is_number(value))
+  {
+    double number = jerry_value_as_number(value);
+    cbor ? cbor_number(&e->w, number) : json_number(&e->w, number);
+  }
+  else if (jerry_value_is_string(value))
+  {
+    if (cbor)
+    {
+      cbor_string(&e->w, value);
+    }
+    else if (!json_string(&e->w, value))
+    {
+      return out_of_memory();
+    }
+  }
+  else if (jerry_value_is_arraybuffer(value) || jerry_value_is_typedarray(value))
+  {
+    return encode_buffer(e, value);
+  }
+  else if (jerry_value_is_array(value))
+  {
+    return encode_array(e, value, depth);
+  }
+  else if (jerry_value_is_object(value) && !jerry_value_is_function(value))
+  {
+    return encode_object(e, value, NULL, 0, depth);
+  }
+  else
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Value cannot be encoded.");
+  }
+  return jerry_undefined();
+}
+
+jerry_value_t js_codec_encode(js_codec_format_t format, jerry_value_t value, const js_codec_schema_t *schema,
+                              jerry_value_t keys, uint8_t *out, size_t cap, size_t *out_len)
+{
+  codec_encoder_t e = {
+      .format = format,
+      .w = {.out = out, .cap = cap},
+  };
+
+  jerry_value_t result;
+  if (schema)
+  {
+    result = jerry_value_is_object(value) && !jerry_value_is_array(value)
+                 ? encode_object(&e, value, schema, keys, 0)
+                 : jerry_throw_sz(JERRY_ERROR_TYPE, "A schema encodes objects only.");
+  }
+  else
+  {
+    result = encode_value(&e, value, 0);
+  }
+
+  *out_len = e.w.len;
+  if (!jerry_value_is_exception(result) && out && e.w.len > cap)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Target is too small for the encoding.");
+  }
+  return result;
+}
+
+// --- Schemas ---
+
+esp_err_t js_codec_schema_compile(jerry_value_t keys, js_codec_schema_t **out)
+{
+  uint32_t count = jerry_array_length(keys);
+  if (count > JS_CODEC_MAX_KEYS)
+  {
+    return ESP_ERR_INVALID_SIZE;
+  }
+
+  // First pass: check the keys and size the pre-encoded forms.
+  uint8_t raw[MAX_KEY_BYTES];
+  size_t total = 0;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    jerry_value_t key = jerry_object_get_index(keys, i);
+    bool is_string = jerry_value_is_string(key);
+    jerry_size_t size = is_string ? jerry_string_size(key, JERRY_ENCODING_UTF8) : 0;
+    if (is_string && size <= MAX_KEY_BYTES)
+    {
+      jerry_string_to_buffer(key, JERRY_ENCODING_UTF8, raw, size);
+      total += cbor_head_size(size) + size + json_escaped_size(raw, size) + 3;
+    }
+    jerry_value_free(key);
+    if (!is_string)
+    {
+      return ESP_ERR_INVALID_ARG;
+    }
+    if (size > MAX_KEY_BYTES)
+    {
+      return ESP_ERR_INVALID_SIZE;
+    }
+  }
+
+  js_codec_schema_t *schema = malloc(sizeof(js_codec_schema_t) + count * sizeof(codec_key_t) + total);
+  if (!schema)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  schema->count = count;
+
+  // Second pass: render each key in both formats into the tail of the allocation.
+  codec_writer_t w = {
+      .out = (uint8_t *)&schema->keys[count],
+      .cap = total,
+  };
+  for (uint32_t i = 0; i < count; i++)
+  {
+    jerry_value_t key = jerry_object_get_index(keys, i);
+    jerry_size_t size = jerry_string_to_buffer(key, JERRY_ENCODING_UTF8, raw, sizeof(raw));
+    jerry_value_free(key);
+
+    codec_key_t *k = &schema->keys[i];
+    size_t start = w.len;
+    cbor_head(&w, 3, size);
+    k->head_len = (uint8_t)(w.len - start);
+    put(&w, raw, size);
+    k->cbor = w.out + start;
+    k->cbor_len = (uint16_t)(w.len - start);
+
+    start = w.len;
+    put_byte(&w, '"');
+    json_put_escaped(&w, raw, size);
+    put(&w, "\":", 2);
+    k->json = w.out + start;
+    k->json_len = (uint16_t)(w.len - start);
+  }
+
+  *out = schema;
+  return ESP_OK;
+}
+
+/**
+ * @brief Finds the schema key spelled `bytes` and returns a copy of its
+ * string from `keys`, or undefined if the schema does not list it.
+ *
+ * Objects tend to arrive with their keys in schema order, so the key after
+ * the last match is tried first.
+ */
+static jerry_value_t schema_key(codec_reader_t *r, const uint8_t *bytes, size_t len)
+{
+  const js_codec_schema_t *schema = r->schema;
+  if (!schema)
+  {
+    return jerry_undefined();
+  }
+  for (size_t n = 0; n < schema->count; n++)
+  {
+    size_t i = (r->next_key + n) % schema->count;
+    const codec_key_t *k = &schema->keys[i];
+    if ((size_t)(k->cbor_len - k->head_len) == len && memcmp(k->cbor + k->head_len, bytes, len) == 0)
+    {
+      r->next_key = i + 1;
+      return jerry_object_get_index(r->keys, (uint32_t)i);
+    }
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief A string made from decoded text, which is untrusted: the engine
+ * assumes valid UTF-8, so anything else is rejected first.
+ */
+static jerry_value_t text_string(const uint8_t *bytes, size_t len)
+{
+  if (!jerry_validate_string(bytes, (jerry_size_t)len, JERRY_ENCODING_UTF8))
+  {
+    return jerry_throw_sz(JERRY_ERROR_SYNTAX, "Text is not valid UTF-8.");
+  }
+  return jerry_string(bytes, (jerry_size_t)len, JERRY_ENCODING_UTF8);
+}
+
+/**
+ * @brief A key string: the schema's copy if it lists the key, else a new string.
+ */
+static jerry_value_t key_string(codec_reader_t *r, const uint8_t *bytes, size_t len)
+{
+  jerry_value_t key = schema_key(r, bytes, len);
+  if (jerry_value_is_string(key))
+  {
+    return key;
+  }
+  jerry_value_free(key);
+  return text_string(bytes, len);
+}
+
+static jerry_value_t too_deep(void)
+{
+  return jerry_throw_sz(JERRY_ERROR_RANGE, "Value is nested too deeply to decode.");
+}
+
+/**
+ * @brief Sets `object[key] = value` and releases both.
+ */
+static void set_property(jerry_value_t object, jerry_value_t key, jerry_value_t value)
+{
+  jerry_value_free(jerry_object_set(object, key, value));
+  jerry_value_free(key);
+  jerry_value_free(value);
+}
+
+// --- CBOR decoding ---
+
+static jerry_value_t cbor_malformed(void)
+{
+  return jerry_throw_sz(JERRY_ERROR_SYNTAX, "Malformed CBOR.");
+}
+
+/**
+ * @brief Reads the head of a data item.
+ *
+ * @param info Receives the additional information; 31 means indefinite length.
+ * @param arg Receives the argument: a length, count, integer, tag or float bits.
+ */
+static bool cbor_read_head(codec_reader_t *r, uint8_t *major, uint8_t *info, uint64_t *arg)
+{
+  if (r->pos >= r->end)
+  {
+    return false;
+  }
+  uint8_t byte = *r->pos++;
+  *major = byte >> 5;
+  *info = byte & 0x1f;
+  *arg = *info;
+  if (*info < 24 || *info == 31)
+  {
+    return true;
+  }
+  if (*info > 27)
+  {
+    return false;
+  }
+  size_t n = (size_t)1 << (*info - 24);
+  if ((size_t)(r->end - r->pos) < n)
+  {
+    return false;
+  }
+  *arg = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    *arg = *arg << 8 | *r->pos++;
+  }
+  return true;
+}
+
+/**
+ * @brief Takes `len` bytes from the input, or returns NULL if there are fewer.
+ */
+static const uint8_t *cbor_span(codec_reader_t *r, uint64_t len)
+{
+  if ((uint64_t)(r->end - r->pos) < len)
+  {
+    return NULL;
+  }
+  const uint8_t *span = r->pos;
+  r->pos += len;
+  return span;
+}
+
+static bool cbor_at_break(codec_reader_t *r)
+{
+  if (r->pos < r->end && *r->pos == 0xff)
+  {
+    r->pos++;
+    return true;
+  }
+  return false;
+}
+
+static double half_to_double(uint16_t half)
+{
+  int exponent = (half >> 10) & 0x1f;
+  double mantissa = half & 0x3ff;
+  double value = exponent == 0    ? ldexp(mantissa, -24)
+                 : exponent == 31 ? (mantissa == 0 ? INFINITY : NAN)
+                                  : ldexp(mantissa + 1024, exponent - 25);
+  return half & 0x8000 ? -value : value;
+}
+
+/**
+ * @brief Maps an RFC 8746 tag to a typed array type and whether its
+ * elements are big-endian.
+ */
+static jerry_typedarray_type_t cbor_typed_array_type(uint64_t tag, bool *big_endian)
+{
+  if (tag < 64 || tag > 87 || tag == 76)
+  {
+    return JERRY_TYPEDARRAY_INVALID;
+  }
+  bool is_float = tag & 0x10;
+  bool is_signed = tag & 0x08;
+  unsigned size_log2 = tag & 0x03;
+  *big_endian = !(tag & 0x04);
+  if (tag == 68)
+  {
+    *big_endian = false;
+    return JERRY_TYPEDARRAY_UINT8CLAMPED;
+  }
+  if (is_float)
+  {
+    return size_log2 == 1 && !is_signed ? JERRY_TYPEDARRAY_FLOAT32
+           : size_log2 == 2 && !is_signed ? JERRY_TYPEDARRAY_FLOAT64
+                                          : JERRY_TYPEDARRAY_INVALID;
+  }
+  static const jerry_typedarray_type_t unsigned_types[] = {JERRY_TYPEDARRAY_UINT8, JERRY_TYPEDARRAY_UINT16,
+                                                           JERRY_TYPEDARRAY_UINT32, JERRY_TYPEDARRAY_BIGUINT64};
+  static const jerry_typedarray_type_t signed_types[] = {JERRY_TYPEDARRAY_INT8, JERRY_TYPEDARRAY_INT16,
+                                                         JERRY_TYPEDARRAY_INT32, JERRY_TYPEDARRAY_BIGINT64};
+  return is_signed ? signed_types[size_log2] : unsigned_types[size_log2];
+}
+
+static jerry_value_t cbor_typed_array(codec_reader_t *r, uint64_t tag)
+{
+  bool big_endian;
+  jerry_typedarray_type_t type = cbor_typed_array_type(tag, &big_endian);
+  uint8_t major, info;
+  uint64_t len;
+  if (!cbor_read_head(r, &major, &info, &len) || major != 2 || info == 31)
+  {
+    return cbor_malformed();
+  }
+  const uint8_t *span = cbor_span(r, len);
+  size_t element = typed_element_size(type);
+  if (!span || len % element != 0)
+  {
+    return cbor_malformed();
+  }
+
+  jerry_value_t buffer = jerry_arraybuffer((jerry_length_t)len);
+  uint8_t *bytes = jerry_arraybuffer_data(buffer);
+  if (!bytes)
+  {
+    jerry_value_free(buffer);
+    return out_of_memory();
+  }
+  memcpy(bytes, span, len);
+  for (size_t i = 0; big_endian && element > 1 && i < len; i += element)
+  {
+    for (size_t a = i, b = i + element - 1; a < b; a++, b--)
+    {
+      uint8_t t = bytes[a];
+      bytes[a] = bytes[b];
+      bytes[b] = t;
+    }
+  }
+  jerry_value_t view = jerry_typedarray_with_buffer(type, buffer);
+  jerry_value_free(buffer);
+  return view;
+}
+
+static jerry_value_t cbor_value(codec_reader_t *r, int depth);
+
+static jerry_value_t cbor_array(codec_reader_t *r, uint8_t info, uint64_t count, int depth)
+{
+  bool indefinite = info == 31;
+  if (!indefinite && count > (uint64_t)(r->end - r->pos))
+  {
+    return cbor_malformed();
+  }
+  jerry_value_t array = jerry_array(indefinite ? 0 : (jerry_length_t)count);
+  for (uint32_t i = 0; indefinite ? !cbor_at_break(r) : i < count; i++)
+  {
+    jerry_value_t element = cbor_value(r, depth + 1);
+    if (jerry_value_is_exception(element))
+    {
+      jerry_value_free(array);
+      return element;
+    }
+    jerry_value_free(jerry_object_set_index(array, i, element));
+    jerry_value_free(element);
+  }
+  return array;
+}
+
+/**
+ * @brief Reads a map key: a text string, or an integer turned into one.
+ */
+static jerry_value_t cbor_key(codec_reader_t *r)
+{
+  uint8_t major, info;
+  uint64_t arg;
+  const uint8_t *start = r->pos;
+  if (!cbor_read_head(r, &major, &info, &arg))
+  {
+    return cbor_malformed();
+  }
+  if (major == 3 && info != 31)
+  {
+    const uint8_t *span = cbor_span(r, arg);
+    return span ? key_string(r, span, (size_t)arg) : cbor_malformed();
+  }
+  if (major == 0 || major == 1)
+  {
+    r->pos = start;
+    jerry_value_t number = cbor_value(r, 0);
+    jerry_value_t key = jerry_value_to_string(number);
+    jerry_value_free(number);
+    return key;
+  }
+  return cbor_malformed();
+}
+
+static jerry_value_t cbor_map(codec_reader_t *r, uint8_t info, uint64_t count, int depth)
+{
+  bool indefinite = info == 31;
+  if (!indefinite && count > (uint64_t)(r->end - r->pos) / 2)
+  {
+    return cbor_malformed();
+  }
+  jerry_value_t object = jerry_object();
+  for (uint64_t i = 0; indefinite ? !cbor_at_break(r) : i < count; i++)
+  {
+    jerry_value_t key = cbor_key(r);
+    if (jerry_value_is_exception(key))
+    {
+      jerry_value_free(object);
+      return key;
+    }
+    jerry_value_t property = cbor_value(r, depth + 1);
+    if (jerry_value_is_exception(property))
+    {
+      jerry_value_free(key);
+      jerry_value_free(object);
+      return property;
+    }
+    set_property(object, key, property);
+  }
+  return object;
+}
+
+static jerry_value_t cbor_value(codec_reader_t *r, int depth)
+{
+  if (depth > JS_CODEC_MAX_DEPTH)
+  {
+    return too_deep();
+  }
+  uint8_t major, info;
+  uint64_t arg;
+  if (!cbor_read_head(r, &major, &info, &arg))
+  {
+    return cbor_malformed();
+  }
+
+  const uint8_t *span;
+  switch (major)
+  {
+  case 0:
+    return info == 31 ? cbor_malformed() : jerry_number((double)arg);
+
+  case 1:
+    return info == 31 ? cbor_malformed() : jerry_number(-1.0 - (double)arg);
+
+  case 2:
+  {
+    span = info == 31 ? NULL : cbor_span(r, arg);
+    if (!span)
+    {
+      return cbor_malformed();
+    }
+    jerry_value_t buffer = jerry_arraybuffer((jerry_length_t)arg);
+    jerry_arraybuffer_write(buffer, 0, span, (jerry_length_t)arg);
+    return buffer;
+  }
+
+  case 3:
+    span = info == 31 ? NULL : cbor_span(r, arg);
+    return span ? text_string(span, (size_t)arg) : cbor_malformed();
+
+  case 4:
+    return cbor_array(r, info, arg, depth);
+
+  case 5:
+    return cbor_map(r, info, arg, depth);
+
+  case 6:
+  {
+    bool big_endian;
+    if (info != 31 && cbor_typed_array_type(arg, &big_endian) != JERRY_TYPEDARRAY_INVALID)
+    {
+      return cbor_typed_array(r, arg);
+    }
+    // Other tags (dates, bignums, ...) are dropped and the tagged item kept.
+    return info == 31 ? cbor_malformed() : cbor_value(r, depth + 1);
+  }
+
+  default:
+    switch (info)
+    {
+    case 20:
+    case 21:
+      return jerry_boolean(info == 21);
+    case 22:
+      return jerry_null();
+    case 23:
+      return jerry_undefined();
+    case 25:
+      return jerry_number(half_to_double((uint16_t)arg));
+    case 26:
+    {
+      uint32_t bits = (uint32_t)arg;
+      float single;
+      memcpy(&single, &bits, sizeof(single));
+      return jerry_number(single);
+    }
+    case 27:
+    {
+      double number;
+      memcpy(&number, &arg, sizeof(number));
+      return jerry_number(number);
+    }
+    default:
+      return cbor_malformed();
+    }
+  }
+}
+
+// --- JSON decoding ---
+
+static jerry_value_t json_malformed(void)
+{
+  return jerry_throw_sz(JERRY_ERROR_SYNTAX, "Malformed JSON.");
+}
+
+static void json_skip_space(codec_reader_t *r)
+{
+  while (r->pos < r->end && (*r->pos == ' ' || *r->pos == '\t' || *r->pos == '\n' || *r->pos == '\r'))
+  {
+    r->pos++;
+  }
+}
+
+/**
+ * @brief Consumes `c` after any whitespace.
+ */
+static bool json_expect(codec_reader_t *r, char c)
+{
+  json_skip_space(r);
+  if (r->pos < r->end && *r->pos == c)
+  {
+    r->pos++;
+    return true;
+  }
+  return false;
+}
+
+static int hex_digit(uint8_t c)
+{
+  return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+}
+
+static int32_t json_hex4(const uint8_t *p)
+{
+  int32_t value = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    int digit = hex_digit(p[i]);
+    if (digit < 0)
+    {
+      return -1;
+    }
+    value = value << 4 | digit;
+  }
+  return value;
+}
+
+static size_t utf8_put(uint8_t *out, uint32_t cp)
+{
+  if (cp < 0x80)
+  {
+    out[0] = (uint8_t)cp;
+    return 1;
+  }
+  if (cp < 0x800)
+  {
+    out[0] = (uint8_t)(0xc0 | cp >> 6);
+    out[1] = (uint8_t)(0x80 | (cp & 0x3f));
+    return 2;
+  }
+  if (cp < 0x10000)
+  {
+    out[0] = (uint8_t)(0xe0 | cp >> 12);
+    out[1] = (uint8_t)(0x80 | ((cp >> 6) & 0x3f));
+    out[2] = (uint8_t)(0x80 | (cp & 0x3f));
+    return 3;
+  }
+  out[0] = (uint8_t)(0xf0 | cp >> 18);
+  out[1] = (uint8_t)(0x80 | ((cp >> 12) & 0x3f));
+  out[2] = (uint8_t)(0x80 | ((cp >> 6) & 0x3f));
+  out[3] = (uint8_t)(0x80 | (cp & 0x3f));
+  return 4;
+}
+
+/**
+ * @brief Unescapes the body of a string into `out`, which needs at most
+ * `len` bytes since every escape is at least as long as what it stands for.
+ *
+ * @return The length written, or -1 for an invalid escape.
+ */
+static ptrdiff_t json_unescape(const uint8_t *s, size_t len, uint8_t *out)
+{
+  const uint8_t *end = s + len;
+  uint8_t *d = out;
+  while (s < end)
+  {
+    uint8_t c = *s++;
+    if (c != '\\')
+    {
+      *d++ = c;
+      continue;
+    }
+    if (s >= end)
+    {
+      return -1;
+    }
+    c = *s++;
+    switch (c)
+    {
+    case '"':
+    case '\\':
+    case '/':
+      *d++ = c;
+      break;
+    case 'b':
+      *d++ = '\b';
+      break;
+    case 'f':
+      *d++ = '\f';
+      break;
+    case 'n':
+      *d++ = '\n';
+      break;
+    case 'r':
+      *d++ = '\r';
+      break;
+    case 't':
+      *d++ = '\t';
+      break;
+    case 'u':
+    {
+      int32_t cp = end - s >= 4 ? json_hex4(s) : -1;
+      if (cp < 0)
+      {
+        return -1;
+      }
+      s += 4;
+      if (cp >= 0xd800 && cp <= 0xdbff && end - s >= 6 && s[0] == '\\' && s[1] == 'u')
+      {
+        int32_t low = json_hex4(s + 2);
+        if (low >= 0xdc00 && low <= 0xdfff)
+        {
+          cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+          s += 6;
+        }
+      }
+      if (cp >= 0xd800 && cp <= 0xdfff)
+      {
+        cp = 0xfffd; // A lone surrogate has no UTF-8 form
+      }
+      d += utf8_put(d, (uint32_t)cp);
+      break;
+    }
+    default:
+      return -1;
+    }
+  }
+  return d - out;
+}
+
+/**
+ * @brief Reads a string. Strings without escapes are made straight from
+ * the input; keys are first looked up in the schema.
+ */
+static jerry_value_t json_string_value(codec_reader_t *r, bool is_key)
+{
+  const uint8_t *start = ++r->pos;
+  bool escaped = false;
+  while (r->pos < r->end && *r->pos != '"')
+  {
+    if (*r->pos == '\\')
+    {
+      escaped = true;
+      r->pos++;
+    }
+    r->pos++;
+  }
+  if (r->pos >= r->end)
+  {
+    return json_malformed();
+  }
+  size_t len = (size_t)(r->pos - start);
+  r->pos++;
+
+  if (!escaped)
+  {
+    return is_key ? key_string(r, start, len) : text_string(start, len);
+  }
+
+  uint8_t stack[64];
+  uint8_t *text = len <= sizeof(stack) ? stack : malloc(len);
+  if (!text)
+  {
+    return out_of_memory();
+  }
+  ptrdiff_t text_len = json_unescape(start, len, text);
+  jerry_value_t result = text_len < 0 ? json_malformed()
+                         : is_key     ? key_string(r, text, (size_t)text_len)
+                                      : text_string(text, (size_t)text_len);
+  if (text != stack)
+  {
+    free(text);
+  }
+  return result;
+}
+
+static bool is_digit(const codec_reader_t *r)
+{
+  return r->pos < r->end && *r->pos >= '0' && *r->pos <= '9';
+}
+
+/**
+ * @brief Reads a number, following the JSON grammar. Integers of up to 15
+ * digits are summed directly; anything else goes through strtod().
+ */
+static jerry_value_t json_number_value(codec_reader_t *r)
+{
+  const uint8_t *start = r->pos;
+  bool negative = r->pos < r->end && *r->pos == '-';
+  if (negative)
+  {
+    r->pos++;
+  }
+  if (!is_digit(r))
+  {
+    return json_malformed();
+  }
+
+  double integer = 0;
+  size_t digits = 0;
+  if (*r->pos == '0')
+  {
+    r->pos++;
+  }
+  else
+  {
+    for (; is_digit(r); r->pos++, digits++)
+    {
+      integer = integer * 10 + (*r->pos - '0');
+    }
+  }
+
+  bool simple = digits <= 15;
+  if (r->pos < r->end && *r->pos == '.')
+  {
+    r->pos++;
+    simple = false;
+    if (!is_digit(r))
+    {
+      return json_malformed();
+    }
+    while (is_digit(r))
+    {
+      r->pos++;
+    }
+  }
+  if (r->pos < r->end && (*r->pos == 'e' || *r->pos == 'E'))
+  {
+    r->pos++;
+    simple = false;
+    if (r->pos < r->end && (*r->pos == '+' || *r->pos == '-'))
+    {
+      r->pos++;
+    }
+    if (!is_digit(r))
+    {
+      return json_malformed();
+    }
+    while (is_digit(r))
+    {
+      r->pos++;
+    }
+  }
+
+  if (simple)
+  {
+    return jerry_number(negative ? -integer : integer);
+  }
+  char text[MAX_NUMBER_CHARS + 1];
+  size_t len = (size_t)(r->pos - start);
+  if (len > MAX_NUMBER_CHARS)
+  {
+    return json_malformed();
+  }
+  memcpy(text, start, len);
+  text[len] = '\0';
+  return jerry_number(strtod(text, NULL));
+}
+
+static jerry_value_t json_value(codec_reader_t *r, int depth);
+
+static jerry_value_t json_array(codec_reader_t *r, int depth)
+{
+  r->pos++;
+  jerry_value_t array = jerry_array(0);
+  if (json_expect(r, ']'))
+  {
+    return array;
+  }
+  for (uint32_t i = 0;; i++)
+  {
+    jerry_value_t element = json_value(r, depth + 1);
+    if (jerry_value_is_exception(element))
+    {
+      jerry_value_free(array);
+      return element;
+    }
+    jerry_value_free(jerry_object_set_index(array, i, element));
+    jerry_value_free(element);
+    if (json_expect(r, ']'))
+    {
+      return array;
+    }
+    if (!json_expect(r, ','))
+    {
+      jerry_value_free(array);
+      return json_malformed();
+    }
+  }
+}
+
+static jerry_value_t json_object(codec_reader_t *r, int depth)
+{
+  r->pos++;
+  jerry_value_t object = jerry_object();
+  if (json_expect(r, '}'))
+  {
+    return object;
+  }
+  for (;;)
+  {
+    json_skip_space(r);
+    jerry_value_t key = r->pos < r->end && *r->pos == '"' ? json_string_value(r, true) : json_malformed();
+    if (!jerry_value_is_exception(key) && !json_expect(r, ':'))
+    {
+      jerry_value_free(key);
+      key = json_malformed();
+    }
+    if (jerry_value_is_exception(key))
+    {
+      jerry_value_free(object);
+      return key;
+    }
+    jerry_value_t property = json_value(r, depth + 1);
+    if (jerry_value_is_exception(property))
+    {
+      jerry_value_free(key);
+      jerry_value_free(object);
+      return property;
+    }
+    set_property(object, key, property);
+    if (json_expect(r, '}'))
+    {
+      return object;
+    }
+    if (!json_expect(r, ','))
+    {
+      jerry_value_free(object);
+      return json_malformed();
+    }
+  }
+}
+
+/**
+ * @brief Consumes `word` if the input continues with it.
+ */
+static bool json_literal(codec_reader_t *r, const char *word)
+{
+  size_t len = strlen(word);
+  if ((size_t)(r->end - r->pos) < len || memcmp(r->pos, word, len) != 0)
+  {
+    return false;
+  }
+  r->pos += len;
+  return true;
+}
+
+static jerry_value_t json_value(codec_reader_t *r, int depth)
+{
+  if (depth > JS_CODEC_MAX_DEPTH)
+  {
+    return too_deep();
+  }
+  json_skip_space(r);
+  if (r->pos >= r->end)
+  {
+    return json_malformed();
+  }
+
+  switch (*r->pos)
+  {
+  case '{':
+    return json_object(r, depth);
+  case '[':
+    return json_array(r, depth);
+  case '"':
+    return json_string_value(r, false);
+  case 't':
+    return json_literal(r, "true") ? jerry_boolean(true) : json_malformed();
+  case 'f':
+    return json_literal(r, "false") ? jerry_boolean(false) : json_malformed();
+  case 'n':
+    return json_literal(r, "null") ? jerry_null() : json_malformed();
+  default:
+    return json_number_value(r);
+  }
+}
+
+jerry_value_t js_codec_decode(js_codec_format_t format, const uint8_t *data, size_t len,
+                              const js_codec_schema_t *schema, jerry_value_t keys)
+{
+  codec_reader_t r = {
+      .pos = data,
+      .end = data + len,
+      .schema = schema,
+      .keys = keys,
+  };
+
+  jerry_value_t value;
+  if (format == JS_CODEC_CBOR)
+  {
+    value = cbor_value(&r, 0);
+  }
+  else
+  {
+    value = json_value(&r, 0);
+    json_skip_space(&r);
+  }
+
+  if (!jerry_value_is_exception(value) && r.pos != r.end)
+  {
+    jerry_value_free(value);
+    return format == JS_CODEC_CBOR ? cbor_malformed() : json_malformed();
+  }
+  return value;
+}
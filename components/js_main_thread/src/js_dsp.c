@@ -0,0 +1,439 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "js_dsp.h"
+
+#if CONFIG_JS_DSP_ESP_DSP
+#include "dsps_biquad.h"
+#include "dsps_fft2r.h"
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+typedef enum
+{
+  FILTER_IIR,
+  FILTER_FIR,
+  FILTER_MOVING_AVERAGE,
+  FILTER_MEDIAN,
+} filter_kind_t;
+
+/**
+ * @brief A filter and its state, allocated in one block with the arrays `data` holds.
+ */
+struct js_dsp_filter
+{
+  filter_kind_t kind;
+  size_t size;    /**< Sections, taps or window length. */
+  size_t count;   /**< Samples in the window so far (moving average, median). */
+  size_t pos;     /**< Next slot of the delay line or window. */
+  double sum;     /**< Running sum of the window (moving average). */
+  float *coeffs; /**< IIR: 5 per section. FIR: one per tap. */
+  float *state;  /**< IIR: 2 per section. FIR: delay line. Windows: samples in arrival order. */
+  float *sorted; /**< Median: the window, sorted. */
+  float data[];
+};
+
+static js_dsp_filter_t *filter_new(filter_kind_t kind, size_t size, size_t coeff_count, size_t state_count,
+                                   size_t sorted_count)
+{
+  js_dsp_filter_t *filter = malloc(sizeof(js_dsp_filter_t) + (coeff_count + state_count + sorted_count) * sizeof(float));
+  if (filter == NULL)
+  {
+    return NULL;
+  }
+  filter->kind = kind;
+  filter->size = size;
+  filter->coeffs = filter->data;
+  filter->state = filter->data + coeff_count;
+  filter->sorted = filter->state + state_count;
+  js_dsp_filter_reset(filter);
+  return filter;
+}
+
+js_dsp_filter_t *js_dsp_iir_new(const float *coeffs, size_t sections)
+{
+  js_dsp_filter_t *filter = filter_new(FILTER_IIR, sections, 5 * sections, 2 * sections, 0);
+  if (filter)
+  {
+    memcpy(filter->coeffs, coeffs, 5 * sections * sizeof(float));
+  }
+  return filter;
+}
+
+js_dsp_filter_t *js_dsp_fir_new(const float *coeffs, size_t taps)
+{
+  js_dsp_filter_t *filter = filter_new(FILTER_FIR, taps, taps, taps, 0);
+  if (filter)
+  {
+    memcpy(filter->coeffs, coeffs, taps * sizeof(float));
+  }
+  return filter;
+}
+
+js_dsp_filter_t *js_dsp_moving_average_new(size_t window)
+{
+  return filter_new(FILTER_MOVING_AVERAGE, window, 0, window, 0);
+}
+
+js_dsp_filter_t *js_dsp_median_new(size_t window)
+{
+  return filter_new(FILTER_MEDIAN, window, 0, window, window);
+}
+
+void js_dsp_filter_reset(js_dsp_filter_t *filter)
+{
+  size_t state_count = filter->sorted - filter->state;
+  memset(filter->state, 0, state_count * sizeof(float));
+  filter->count = 0;
+  filter->pos = 0;
+  filter->sum = 0;
+}
+
+void js_dsp_filter_free(js_dsp_filter_t *filter)
+{
+  free(filter);
+}
+
+/**
+ * @brief Runs one biquad section over a block, in ESP-DSP's direct form II.
+ */
+static void biquad_run(const float *in, float *out, size_t len, const float *coef, float *w)
+{
+#if CONFIG_JS_DSP_ESP_DSP
+  dsps_biquad_f32(in, out, (int)len, (float *)coef, w);
+#else
+  for (size_t i = 0; i < len; i++)
+  {
+    float d0 = in[i] - coef[3] * w[0] - coef[4] * w[1];
+    out[i] = coef[0] * d0 + coef[1] * w[0] + coef[2] * w[1];
+    w[1] = w[0];
+    w[0] = d0;
+  }
+#endif
+}
+
+static float fir_step(js_dsp_filter_t *filter, float x)
+{
+  // The delay line is walked newest to oldest in two runs, so no index wraps.
+  float *delay = filter->state;
+  const float *c = filter->coeffs;
+  size_t pos = filter->pos;
+  delay[pos] = x;
+  float acc = 0;
+  size_t k = 0;
+  for (size_t i = pos + 1; i-- > 0;)
+  {
+    acc += c[k++] * delay[i];
+  }
+  for (size_t i = filter->size; i-- > pos + 1;)
+  {
+    acc += c[k++] * delay[i];
+  }
+  filter->pos = pos + 1 == filter->size ? 0 : pos + 1;
+  return acc;
+}
+
+static float moving_average_step(js_dsp_filter_t *filter, float x)
+{
+  if (filter->count == filter->size)
+  {
+    filter->sum -= filter->state[filter->pos];
+  }
+  else
+  {
+    filter->count++;
+  }
+  filter->state[filter->pos] = x;
+  filter->sum += x;
+  filter->pos = filter->pos + 1 == filter->size ? 0 : filter->pos + 1;
+  return (float)(filter->sum / filter->count);
+}
+
+/**
+ * @brief The index of the first element of `sorted` not below `x`.
+ */
+static size_t lower_bound(const float *sorted, size_t count, float x)
+{
+  size_t low = 0, high = count;
+  while (low < high)
+  {
+    size_t mid = (low + high) / 2;
+    if (sorted[mid] < x)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return low;
+}
+
+static float median_step(js_dsp_filter_t *filter, float x)
+{
+  float *sorted = filter->sorted;
+  size_t count = filter->count;
+  if (count == filter->size)
+  {
+    // Drop the oldest sample from the sorted window.
+    size_t old = lower_bound(sorted, count, filter->state[filter->pos]);
+    memmove(sorted + old, sorted + old + 1, (count - old - 1) * sizeof(float));
+    count--;
+  }
+  size_t at = lower_bound(sorted, count, x);
+  memmove(sorted + at + 1, sorted + at, (count - at) * sizeof(float));
+  sorted[at] = x;
+  filter->count = ++count;
+
+  filter->state[filter->pos] = x;
+  filter->pos = filter->pos + 1 == filter->size ? 0 : filter->pos + 1;
+  return count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+}
+
+float js_dsp_filter_step(js_dsp_filter_t *filter, float x)
+{
+  js_dsp_filter_run(filter, &x, &x, 1);
+  return x;
+}
+
+void js_dsp_filter_run(js_dsp_filter_t *filter, const float *in, float *out, size_t len)
+{
+  switch (filter->kind)
+  {
+  case FILTER_IIR:
+    // Section by section over the whole block, which is how the ESP-DSP kernel works best.
+    for (size_t s = 0; s < filter->size; s++)
+    {
+      biquad_run(s == 0 ? in : out, out, len, filter->coeffs + 5 * s, filter->state + 2 * s);
+    }
+    break;
+  case FILTER_FIR:
+    for (size_t i = 0; i < len; i++)
+    {
+      out[i] = fir_step(filter, in[i]);
+    }
+    break;
+  case FILTER_MOVING_AVERAGE:
+    for (size_t i = 0; i < len; i++)
+    {
+      out[i] = moving_average_step(filter, in[i]);
+    }
+    break;
+  case FILTER_MEDIAN:
+    for (size_t i = 0; i < len; i++)
+    {
+      out[i] = median_step(filter, in[i]);
+    }
+    break;
+  }
+}
+
+esp_err_t js_dsp_biquad_design(const char *type, float cutoff, float sample_rate, float q, float out[5])
+{
+  if (!(cutoff > 0 && cutoff < sample_rate / 2) || !(q > 0))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  double w0 = 2 * M_PI * cutoff / sample_rate;
+  double cosw = cos(w0);
+  double alpha = sin(w0) / (2 * q);
+  double b0, b1, b2;
+  if (strcmp(type, "lowpass") == 0)
+  {
+    b0 = (1 - cosw) / 2;
+    b1 = 1 - cosw;
+    b2 = b0;
+  }
+  else if (strcmp(type, "highpass") == 0)
+  {
+    b0 = (1 + cosw) / 2;
+    b1 = -(1 + cosw);
+    b2 = b0;
+  }
+  else if (strcmp(type, "bandpass") == 0)
+  {
+    b0 = alpha;
+    b1 = 0;
+    b2 = -alpha;
+  }
+  else if (strcmp(type, "notch") == 0)
+  {
+    b0 = 1;
+    b1 = -2 * cosw;
+    b2 = 1;
+  }
+  else
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  double a0 = 1 + alpha;
+  out[0] = (float)(b0 / a0);
+  out[1] = (float)(b1 / a0);
+  out[2] = (float)(b2 / a0);
+  out[3] = (float)(-2 * cosw / a0);
+  out[4] = (float)((1 - alpha) / a0);
+  return ESP_OK;
+}
+
+void js_dsp_stats(const float *data, size_t len, js_dsp_stats_t *out)
+{
+  float min = data[0], max = data[0];
+  size_t min_index = 0, max_index = 0;
+  double sum = 0, sum_sq = 0;
+  for (size_t i = 0; i < len; i++)
+  {
+    float x = data[i];
+    if (x < min)
+    {
+      min = x;
+      min_index = i;
+    }
+    if (x > max)
+    {
+      max = x;
+      max_index = i;
+    }
+    sum += x;
+    sum_sq += (double)x * x;
+  }
+  double mean = sum / len;
+  double variance = sum_sq / len - mean * mean;
+  out->min = min;
+  out->max = max;
+  out->min_index = min_index;
+  out->max_index = max_index;
+  out->mean = mean;
+  out->rms = sqrt(sum_sq / len);
+  out->std = variance > 0 ? sqrt(variance) : 0;
+}
+
+size_t js_dsp_peaks(const float *data, size_t len, float threshold, size_t min_distance, uint32_t *out,
+                    size_t max_peaks)
+{
+  size_t found = 0;
+  for (size_t i = 1; i + 1 < len; i++)
+  {
+    // A plateau counts once, at its first sample.
+    if (data[i] < threshold || data[i] <= data[i - 1] || data[i] < data[i + 1])
+    {
+      continue;
+    }
+    if (found > 0 && i - out[found - 1] < min_distance)
+    {
+      if (data[i] > data[out[found - 1]])
+      {
+        out[found - 1] = (uint32_t)i;
+      }
+      continue;
+    }
+    if (found == max_peaks)
+    {
+      break;
+    }
+    out[found++] = (uint32_t)i;
+  }
+  return found;
+}
+
+#if CONFIG_JS_DSP_ESP_DSP
+/// @brief Whether ESP-DSP's twiddle table has been set up, for sizes up to CONFIG_DSP_MAX_FFT_SIZE.
+static bool esp_dsp_ready = false;
+#endif
+
+/**
+ * @brief The portable kernel: bit reversal, then butterflies with twiddles by recurrence.
+ */
+static void fft_radix2(float *data, size_t n)
+{
+  for (size_t i = 1, j = 0; i < n; i++)
+  {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+    {
+      j ^= bit;
+    }
+    j |= bit;
+    if (i < j)
+    {
+      float re = data[2 * i], im = data[2 * i + 1];
+      data[2 * i] = data[2 * j];
+      data[2 * i + 1] = data[2 * j + 1];
+      data[2 * j] = re;
+      data[2 * j + 1] = im;
+    }
+  }
+
+  for (size_t len = 2; len <= n; len <<= 1)
+  {
+    double angle = -2 * M_PI / len;
+    double step_re = cos(angle), step_im = sin(angle);
+    for (size_t start = 0; start < n; start += len)
+    {
+      double w_re = 1, w_im = 0;
+      for (size_t k = 0; k < len / 2; k++)
+      {
+        float *a = data + 2 * (start + k);
+        float *b = data + 2 * (start + k + len / 2);
+        float t_re = (float)(b[0] * w_re - b[1] * w_im);
+        float t_im = (float)(b[0] * w_im + b[1] * w_re);
+        b[0] = a[0] - t_re;
+        b[1] = a[1] - t_im;
+        a[0] += t_re;
+        a[1] += t_im;
+        double next_re = w_re * step_re - w_im * step_im;
+        w_im = w_re * step_im + w_im * step_re;
+        w_re = next_re;
+      }
+    }
+  }
+}
+
+esp_err_t js_dsp_fft(float *data, size_t n)
+{
+  if (n < 2 || n > JS_DSP_MAX_FFT || (n & (n - 1)) != 0)
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+#if CONFIG_JS_DSP_ESP_DSP
+  if (n <= CONFIG_DSP_MAX_FFT_SIZE)
+  {
+    if (!esp_dsp_ready)
+    {
+      esp_dsp_ready = dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE) == ESP_OK;
+    }
+    if (esp_dsp_ready)
+    {
+      dsps_fft2r_fc32(data, n);
+      dsps_bit_rev_fc32(data, n);
+      return ESP_OK;
+    }
+  }
+#endif
+  fft_radix2(data, n);
+  return ESP_OK;
+}
+
+esp_err_t js_dsp_spectrum(const float *samples, size_t n, bool hann, float *work, float *out)
+{
+  if (n < 2 || n > JS_DSP_MAX_FFT || (n & (n - 1)) != 0)
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  for (size_t i = 0; i < n; i++)
+  {
+    float w = hann ? (float)(0.5 - 0.5 * cos(2 * M_PI * i / n)) : 1.0f;
+    work[2 * i] = samples[i] * w;
+    work[2 * i + 1] = 0;
+  }
+  js_dsp_fft(work, n);
+
+  // The Hann window halves the amplitude of a sine, so its bins are scaled twice as much.
+  float scale = (hann ? 4.0f : 2.0f) / n;
+  for (size_t k = 0; k < n / 2; k++)
+  {
+    float magnitude = sqrtf(work[2 * k] * work[2 * k] + work[2 * k + 1] * work[2 * k + 1]) * scale;
+    out[k] = k == 0 ? magnitude / 2 : magnitude;
+  }
+  return ESP_OK;
+}
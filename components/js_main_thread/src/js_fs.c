@@ -0,0 +1,651 @@
+#include <dirent.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "js_fs.h"
+#include "js_main_thread.h" // For js_event_queue
+
+static const char *TAG = "JS_FS";
+
+#define LOG_SLOT(id) (((id) & 0xFF) - 1) // Log ids are (generation << 8) | (slot + 1)
+
+/**
+ * @brief An append-only log writer. Only the JS thread touches it, except
+ * that the flush timer's callback re-arms the timer under `log_lock`.
+ *
+ * `buffer` is allocated on the first write after each flush; the previous
+ * one belongs to the append request that is writing it out.
+ */
+typedef struct
+{
+  uint32_t id; /**< 0 while the slot is free. */
+  char path[JS_FS_MAX_PATH];
+  uint8_t *buffer;
+  size_t used;
+  size_t capacity;
+  uint32_t flush_ms;
+  uint32_t in_flight; /**< Appends submitted and not yet dispatched. */
+  esp_timer_handle_t timer;
+  js_fs_log_stats_t stats;
+} fs_log_t;
+
+static QueueHandle_t request_queue = NULL;
+static js_fs_reader_factory_t reader_factory = NULL;
+static fs_log_t logs[JS_FS_MAX_LOGS];
+static uint32_t next_log_generation = 1;
+
+// Held while a log's timer is re-armed or deleted, so it is never re-armed once deleted.
+static SemaphoreHandle_t log_lock;
+static StaticSemaphore_t log_lock_buffer;
+
+// --- I/O task ---
+
+static void read_whole_file(js_fs_request_t *request)
+{
+  struct stat st;
+  FILE *file = fopen(request->path, "rb");
+  if (!file || fstat(fileno(file), &st) != 0)
+  {
+    request->error = errno;
+    if (file)
+    {
+      fclose(file);
+    }
+    return;
+  }
+
+  request->data = (uint8_t *)malloc(st.st_size ? st.st_size : 1);
+  request->owns_data = true;
+  if (!request->data)
+  {
+    request->error = ENOMEM;
+  }
+  else
+  {
+    request->result_len = fread(request->data, 1, st.st_size, file);
+    if (ferror(file))
+    {
+      request->error = errno ? errno : EIO;
+    }
+  }
+  fclose(file);
+}
+
+static void write_file(js_fs_request_t *request, const char *mode)
+{
+  if (request->len == 0 && mode[0] == 'a')
+  {
+    return; // Flushing an empty log orders the promise without touching the file
+  }
+  FILE *file = fopen(request->path, mode);
+  if (!file)
+  {
+    request->error = errno;
+    return;
+  }
+  request->result_len = fwrite(request->data, 1, request->len, file);
+  if (request->result_len != request->len)
+  {
+    request->error = errno ? errno : ENOSPC;
+  }
+  if (fclose(file) != 0 && !request->error)
+  {
+    request->error = errno;
+  }
+}
+
+/**
+ * @brief Lists a directory as NUL-terminated names packed into `data`.
+ */
+static void read_directory(js_fs_request_t *request)
+{
+  DIR *dir = opendir(request->path);
+  if (!dir)
+  {
+    request->error = errno;
+    return;
+  }
+
+  size_t capacity = 0;
+  struct dirent *entry;
+  request->owns_data = true;
+  while ((entry = readdir(dir)) != NULL)
+  {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+    {
+      continue;
+    }
+    size_t len = strlen(entry->d_name) + 1;
+    if (request->result_len + len > capacity)
+    {
+      capacity = (request->result_len + len) * 2;
+      uint8_t *grown = (uint8_t *)realloc(request->data, capacity);
+      if (!grown)
+      {
+        request->error = ENOMEM;
+        break;
+      }
+      request->data = grown;
+    }
+    memcpy(request->data + request->result_len, entry->d_name, len);
+    request->result_len += len;
+  }
+  closedir(dir);
+}
+
+static void run_request(js_fs_request_t *request)
+{
+  errno = 0;
+  switch (request->op)
+  {
+  case JS_FS_READ_FILE:
+    read_whole_file(request);
+    break;
+
+  case JS_FS_WRITE_FILE:
+    write_file(request, "wb");
+    break;
+
+  case JS_FS_APPEND:
+    write_file(request, "ab");
+    break;
+
+  case JS_FS_STAT:
+  {
+    struct stat st;
+    if (stat(request->path, &st) != 0)
+    {
+      request->error = errno;
+      break;
+    }
+    request->stat_size = st.st_size;
+    request->stat_is_directory = S_ISDIR(st.st_mode);
+    request->stat_mtime_ms = (int64_t)st.st_mtime * 1000;
+    break;
+  }
+
+  case JS_FS_READDIR:
+    read_directory(request);
+    break;
+
+  case JS_FS_OPEN:
+    request->file = fopen(request->path, "rb");
+    if (!request->file)
+    {
+      request->error = errno;
+    }
+    break;
+
+  case JS_FS_READ:
+    if (request->position >= 0 && fseek(request->file, request->position, SEEK_SET) != 0)
+    {
+      request->error = errno;
+      break;
+    }
+    request->result_len = fread(request->data, 1, request->len, request->file);
+    if (ferror(request->file))
+    {
+      request->error = errno ? errno : EIO;
+      clearerr(request->file);
+    }
+    break;
+
+  case JS_FS_CLOSE:
+    if (fclose(request->file) != 0)
+    {
+      request->error = errno;
+    }
+    break;
+  }
+}
+
+/**
+ * @brief Runs requests one at a time, in submission order, and posts each one back.
+ *
+ * One task is enough: the flash is a single device and SPIFFS serialises
+ * access anyway, but it keeps its latency off the JS thread.
+ */
+static void fs_task(void *params)
+{
+  js_fs_request_t *request;
+  while (xQueueReceive(request_queue, &request, portMAX_DELAY) == pdTRUE)
+  {
+    run_request(request);
+
+    js_event_t ev = {
+        .type = JS_EVENT_FS,
+        .handle_id = 0,
+        .data = request,
+    };
+    xQueueSend(js_event_queue, &ev, portMAX_DELAY);
+  }
+}
+
+void js_fs_init(void)
+{
+  log_lock = xSemaphoreCreateMutexStatic(&log_lock_buffer);
+  request_queue = xQueueCreate(JS_FS_QUEUE_DEPTH, sizeof(js_fs_request_t *));
+  if (!request_queue)
+  {
+    ESP_LOGE(TAG, "Failed to create I/O request queue");
+    return;
+  }
+  if (xTaskCreatePinnedToCore(fs_task, "js_fs", JS_FS_TASK_STACK, NULL, JS_FS_TASK_PRIORITY, NULL,
+                              JS_FS_TASK_CORE) != pdPASS)
+  {
+    ESP_LOGE(TAG, "Failed to start the I/O task");
+  }
+}
+
+// --- Requests ---
+
+js_fs_request_t *js_fs_request_new(js_fs_op_t op)
+{
+  js_fs_request_t *request = (js_fs_request_t *)calloc(1, sizeof(js_fs_request_t));
+  if (request)
+  {
+    request->op = op;
+    request->position = -1;
+    request->promise = jerry_undefined();
+    request->target = jerry_undefined();
+    request->owner = jerry_undefined();
+  }
+  return request;
+}
+
+void js_fs_request_free(js_fs_request_t *request)
+{
+  if (request->owns_data)
+  {
+    free(request->data);
+  }
+  jerry_value_free(request->promise);
+  jerry_value_free(request->target);
+  jerry_value_free(request->owner);
+  free(request);
+}
+
+esp_err_t js_fs_submit(js_fs_request_t *request)
+{
+  if (!request_queue || xQueueSend(request_queue, &request, 0) != pdTRUE)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  return ESP_OK;
+}
+
+void js_fs_set_reader_factory(js_fs_reader_factory_t factory)
+{
+  reader_factory = factory;
+}
+
+// --- Log writers ---
+
+static fs_log_t *find_log(uint32_t id)
+{
+  uint32_t slot = LOG_SLOT(id);
+  if (id == 0 || slot >= JS_FS_MAX_LOGS || logs[slot].id != id)
+  {
+    return NULL;
+  }
+  return &logs[slot];
+}
+
+static void log_timer_cb(void *arg)
+{
+  js_event_t ev = {
+      .type = JS_EVENT_FS,
+      .handle_id = (uint32_t)(uintptr_t)arg,
+      .data = NULL,
+  };
+  if (xQueueSend(js_event_queue, &ev, 0) != pdTRUE)
+  {
+    // Busy; try again shortly. A closed log is no longer found.
+    xSemaphoreTake(log_lock, portMAX_DELAY);
+    fs_log_t *log = find_log(ev.handle_id);
+    if (log)
+    {
+      esp_timer_start_once(log->timer, JS_FS_LOG_RETRY_MS * 1000ULL);
+    }
+    xSemaphoreGive(log_lock);
+  }
+}
+
+/**
+ * @brief Hands the buffered bytes to the I/O task as one append.
+ */
+static esp_err_t submit_log_buffer(fs_log_t *log, jerry_value_t promise)
+{
+  js_fs_request_t *request = js_fs_request_new(JS_FS_APPEND);
+  if (!request)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  strcpy(request->path, log->path);
+  request->data = log->buffer;
+  request->len = log->used;
+  request->log_id = log->id;
+  request->promise = jerry_value_copy(promise);
+  if (js_fs_submit(request) != ESP_OK)
+  {
+    js_fs_request_free(request); // Does not own the buffer yet
+    return ESP_ERR_NO_MEM;
+  }
+
+  request->owns_data = true; // Not read by the I/O task
+  log->buffer = NULL;
+  log->used = 0;
+  log->in_flight++;
+  esp_timer_stop(log->timer);
+  return ESP_OK;
+}
+
+esp_err_t js_fs_log_open(const char *path, size_t buffer_size, uint32_t flush_ms, uint32_t *out_id)
+{
+  uint32_t slot = 0;
+  while (slot < JS_FS_MAX_LOGS && logs[slot].id != 0)
+  {
+    slot++;
+  }
+  if (slot == JS_FS_MAX_LOGS)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  fs_log_t *log = &logs[slot];
+  memset(log, 0, sizeof(*log));
+  uint32_t id = ((next_log_generation++ & 0xFFFFFF) << 8) | (slot + 1);
+  const esp_timer_create_args_t timer_args = {
+      .callback = log_timer_cb,
+      .arg = (void *)(uintptr_t)id,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "js_fs_log",
+  };
+  if (esp_timer_create(&timer_args, &log->timer) != ESP_OK)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+
+  strncpy(log->path, path, sizeof(log->path) - 1);
+  log->capacity = buffer_size;
+  log->flush_ms = flush_ms;
+  log->id = id;
+  *out_id = id;
+  return ESP_OK;
+}
+
+esp_err_t js_fs_log_write(uint32_t id, const uint8_t *data, size_t len)
+{
+  fs_log_t *log = find_log(id);
+  if (!log)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+  if (len > log->capacity)
+  {
+    return ESP_ERR_INVALID_SIZE;
+  }
+
+  if (log->used + len > log->capacity)
+  {
+    // Double buffering: with one append in flight there is nowhere left to put the bytes.
+    if (log->in_flight > 0 || submit_log_buffer(log, jerry_undefined()) != ESP_OK)
+    {
+      log->stats.dropped += len;
+      return ESP_ERR_NO_MEM;
+    }
+  }
+  if (!log->buffer)
+  {
+    log->buffer = (uint8_t *)malloc(log->capacity);
+    if (!log->buffer)
+    {
+      log->stats.dropped += len;
+      return ESP_ERR_NO_MEM;
+    }
+  }
+
+  memcpy(log->buffer + log->used, data, len);
+  log->used += len;
+  if (!esp_timer_is_active(log->timer))
+  {
+    esp_timer_start_once(log->timer, log->flush_ms * 1000ULL);
+  }
+  return ESP_OK;
+}
+
+esp_err_t js_fs_log_flush(uint32_t id, jerry_value_t promise)
+{
+  fs_log_t *log = find_log(id);
+  if (!log)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+  return submit_log_buffer(log, promise);
+}
+
+/**
+ * @brief Frees the slot, its timer and any bytes not handed to an append.
+ * Appends still in flight settle normally; their log is simply gone.
+ */
+static void free_log(fs_log_t *log)
+{
+  xSemaphoreTake(log_lock, portMAX_DELAY);
+  log->id = 0;
+  esp_timer_stop(log->timer);
+  esp_timer_delete(log->timer);
+  xSemaphoreGive(log_lock);
+  free(log->buffer);
+  log->buffer = NULL;
+}
+
+esp_err_t js_fs_log_close(uint32_t id, jerry_value_t promise)
+{
+  fs_log_t *log = find_log(id);
+  if (!log)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+  esp_err_t err = submit_log_buffer(log, promise);
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+  free_log(log);
+  return ESP_OK;
+}
+
+void js_fs_log_release(uint32_t id)
+{
+  fs_log_t *log = find_log(id);
+  if (!log)
+  {
+    return;
+  }
+  submit_log_buffer(log, jerry_undefined()); // If it fails, the bytes go with the slot
+  free_log(log);
+}
+
+esp_err_t js_fs_log_stats(uint32_t id, js_fs_log_stats_t *out)
+{
+  fs_log_t *log = find_log(id);
+  if (!log)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+  *out = log->stats;
+  out->buffered = log->used;
+  return ESP_OK;
+}
+
+static void log_append_done(const js_fs_request_t *request)
+{
+  fs_log_t *log = find_log(request->log_id);
+  if (request->error)
+  {
+    ESP_LOGE(TAG, "Appending %u bytes to %s failed: %s", (unsigned)request->len, request->path,
+             strerror(request->error));
+  }
+  if (!log)
+  {
+    return;
+  }
+  log->in_flight--;
+  if (!request->error)
+  {
+    log->stats.written += request->len;
+    log->stats.flushes += request->len > 0;
+  }
+}
+
+// --- Settling ---
+
+static const char *op_name(js_fs_op_t op)
+{
+  static const char *const names[] = {"readFile", "writeFile", "append", "stat",
+                                      "readdir", "open", "read", "close"};
+  return names[op];
+}
+
+static jerry_value_t stat_to_object(const js_fs_request_t *request)
+{
+  jerry_value_t result = jerry_object();
+  jerry_value_t size = jerry_number((double)request->stat_size);
+  jerry_value_t is_directory = jerry_boolean(request->stat_is_directory);
+  jerry_value_t mtime = jerry_number((double)request->stat_mtime_ms);
+  jerry_value_t size_name = jerry_string_sz("size");
+  jerry_value_t is_directory_name = jerry_string_sz("isDirectory");
+  jerry_value_t mtime_name = jerry_string_sz("mtimeMs");
+  jerry_value_free(jerry_object_set(result, size_name, size));
+  jerry_value_free(jerry_object_set(result, is_directory_name, is_directory));
+  jerry_value_free(jerry_object_set(result, mtime_name, mtime));
+  jerry_value_free(size_name);
+  jerry_value_free(is_directory_name);
+  jerry_value_free(mtime_name);
+  jerry_value_free(size);
+  jerry_value_free(is_directory);
+  jerry_value_free(mtime);
+  return result;
+}
+
+static jerry_value_t names_to_array(const js_fs_request_t *request)
+{
+  uint32_t count = 0;
+  for (size_t i = 0; i < request->result_len; i++)
+  {
+    count += request->data[i] == '\0';
+  }
+
+  jerry_value_t names = jerry_array(count);
+  size_t offset = 0;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    const char *name = (const char *)request->data + offset;
+    jerry_value_t value = jerry_string_sz(name);
+    jerry_value_free(jerry_object_set_index(names, i, value));
+    jerry_value_free(value);
+    offset += strlen(name) + 1;
+  }
+  return names;
+}
+
+/**
+ * @brief Converts a finished request to the value its promise resolves with.
+ */
+static jerry_value_t result_to_value(js_fs_request_t *request)
+{
+  switch (request->op)
+  {
+  case JS_FS_READ_FILE:
+    if (request->as_text)
+    {
+      return jerry_string(request->data, request->result_len, JERRY_ENCODING_UTF8);
+    }
+    else
+    {
+      jerry_value_t buffer = jerry_arraybuffer(request->result_len);
+      jerry_arraybuffer_write(buffer, 0, request->data, request->result_len);
+      return buffer;
+    }
+
+  case JS_FS_STAT:
+    return stat_to_object(request);
+
+  case JS_FS_READDIR:
+    return names_to_array(request);
+
+  case JS_FS_OPEN:
+    if (!reader_factory)
+    {
+      fclose(request->file);
+      return jerry_undefined();
+    }
+    return reader_factory(request->file, request->path);
+
+  case JS_FS_READ:
+    return jerry_number((double)request->result_len);
+
+  default:
+    return jerry_undefined();
+  }
+}
+
+void js_fs_dispatch_event(js_event_t *event)
+{
+  js_fs_request_t *request = (js_fs_request_t *)event->data;
+  if (!request)
+  {
+    // A log's flush timer expired.
+    fs_log_t *log = find_log(event->handle_id);
+    if (log && log->used > 0 && submit_log_buffer(log, jerry_undefined()) != ESP_OK)
+    {
+      esp_timer_start_once(log->timer, log->flush_ms * 1000ULL);
+    }
+    return;
+  }
+
+  if (request->log_id)
+  {
+    log_append_done(request);
+  }
+
+  if (jerry_value_is_promise(request->promise))
+  {
+    if (request->error)
+    {
+      char message[96];
+      snprintf(message, sizeof(message), "%s: %s", op_name(request->op), strerror(request->error));
+      jerry_value_t error = jerry_error_sz(JERRY_ERROR_COMMON, message);
+      jerry_value_free(jerry_promise_reject(request->promise, error));
+      jerry_value_free(error);
+    }
+    else
+    {
+      jerry_value_t value = result_to_value(request);
+      if (jerry_value_is_exception(value))
+      {
+        jerry_value_t error = jerry_exception_value(value, true);
+        jerry_value_free(jerry_promise_reject(request->promise, error));
+        jerry_value_free(error);
+      }
+      else
+      {
+        jerry_value_free(jerry_promise_resolve(request->promise, value));
+        jerry_value_free(value);
+      }
+    }
+  }
+  else if (request->op == JS_FS_OPEN && request->file)
+  {
+    fclose(request->file); // Nobody is left to read it
+  }
+  js_fs_request_free(request);
+}
@@ -1,9 +1,11 @@
+#include <stdlib.h>
 #include "freertos/FreeRTOS.h"
 #include "esp_log.h"
 #include "driver/gpio.h"
 #include "esp_timer.h"
 
 #include "js_gpio.h"
+#include "js_power.h"
 #include "js_main_thread.h" // For js_event_queue and print_js_error
 
 static const char *TAG = "JS_GPIO_ENGINE";
@@ -14,6 +16,11 @@ static js_pin_t pins[MAX_GPIO_PINS];
 /// @brief Flag to track if the ISR service has been installed.
 static bool isr_service_installed = false;
 
+#if CONFIG_JS_LATENCY_TRACE
+/// @brief Whether every latency sample is also written to the log.
+static bool latency_logging = false;
+#endif
+
 /**
  * @brief The low-level ISR handler that runs in an interrupt context.
  * It simply sends an event to the main JS task for processing.
@@ -41,6 +48,9 @@ static void IRAM_ATTR gpio_isr_handler(void *arg)
       .type = JS_EVENT_GPIO,
       .handle_id = pin_num,
       .data = NULL,
+#if CONFIG_JS_LATENCY_TRACE
+      .isr_time_us = (uint32_t)esp_timer_get_time(),
+#endif
   };
   BaseType_t woke = pdFALSE;
   xQueueSendFromISR(js_event_queue, &ev, &woke);
@@ -58,6 +68,7 @@ void js_gpio_init(void)
   for (int i = 0; i < MAX_GPIO_PINS; i++)
   {
     pins[i].in_use = false;
+    pins[i].intr_type = GPIO_INTR_DISABLE;
     pins[i].js_isr_callback = jerry_undefined();
     pins[i].debounce_ms = 0;
     pins[i].last_isr_time_us = 0;
@@ -106,6 +117,7 @@ esp_err_t js_gpio_configure(const gpio_config_t *pGPIOConfig)
     {
       pins[i].in_use = true;
       pins[i].pin_num = i;
+      pins[i].intr_type = pGPIOConfig->intr_type;
     }
   }
 
@@ -130,6 +142,7 @@ esp_err_t js_gpio_attach_isr(gpio_num_t pin_num, jerry_value_t callback)
   }
   pin_state->js_isr_callback = jerry_value_copy(callback);
 
+  js_power_set_wake_pin(pin_num, pin_state->intr_type);
   return gpio_isr_handler_add(pin_num, &gpio_isr_handler, (void *)pin_num);
 }
 
@@ -150,6 +163,7 @@ esp_err_t js_gpio_detach_isr(gpio_num_t pin_num)
     pin_state->js_isr_callback = jerry_undefined();
   }
 
+  js_power_set_wake_pin(pin_num, GPIO_INTR_DISABLE);
   return gpio_isr_handler_remove(pin_num);
 }
 
@@ -163,10 +177,94 @@ void js_gpio_close(gpio_num_t pin_num)
   {
     js_gpio_detach_isr(pin_num); // Ensure ISR is detached
     gpio_reset_pin(pin_num);
+#if CONFIG_JS_LATENCY_TRACE
+    // A later user of the pin starts with fresh histograms.
+    free(pin_state->latency);
+    pin_state->latency = NULL;
+#endif
     pin_state->in_use = false;
   }
 }
 
+#if CONFIG_JS_LATENCY_TRACE
+/**
+ * @brief Adds one sample to a histogram.
+ */
+static void histogram_add(js_latency_histogram_t *h, uint32_t us)
+{
+  if (h->count == 0 || us < h->min_us)
+  {
+    h->min_us = us;
+  }
+  if (us > h->max_us)
+  {
+    h->max_us = us;
+  }
+  h->count++;
+  h->total_us += us;
+
+  int bucket = us ? 31 - __builtin_clz(us) : 0;
+  h->buckets[bucket < JS_LATENCY_BUCKETS ? bucket : JS_LATENCY_BUCKETS - 1]++;
+}
+
+/**
+ * @brief Records the dispatch and callback latency of one event.
+ */
+static void record_latency(js_pin_t *pin_state, uint32_t isr_time_us, uint32_t dispatch_us, uint32_t return_us)
+{
+  if (!pin_state->latency)
+  {
+    pin_state->latency = (js_gpio_latency_t *)calloc(1, sizeof(js_gpio_latency_t));
+    if (!pin_state->latency)
+    {
+      return;
+    }
+  }
+
+  // Unsigned differences stay correct across the 32-bit wrap.
+  uint32_t queued = dispatch_us - isr_time_us;
+  uint32_t total = return_us - isr_time_us;
+  histogram_add(&pin_state->latency->dispatch, queued);
+  histogram_add(&pin_state->latency->callback, total);
+
+  if (latency_logging)
+  {
+    ESP_LOGI(TAG, "GPIO%d latency: dispatch %lu us, callback returned %lu us", pin_state->pin_num,
+             (unsigned long)queued, (unsigned long)total);
+  }
+}
+
+/**
+ * @brief Gets a pin's latency histograms, or NULL if it has no samples yet.
+ */
+const js_gpio_latency_t *js_gpio_get_latency(gpio_num_t pin_num)
+{
+  js_pin_t *pin_state = js_gpio_get_state(pin_num);
+  return pin_state ? pin_state->latency : NULL;
+}
+
+/**
+ * @brief Clears a pin's latency histograms.
+ */
+void js_gpio_reset_latency(gpio_num_t pin_num)
+{
+  js_pin_t *pin_state = js_gpio_get_state(pin_num);
+  if (pin_state)
+  {
+    free(pin_state->latency);
+    pin_state->latency = NULL;
+  }
+}
+
+/**
+ * @brief Enables or disables logging every latency sample as it is recorded.
+ */
+void js_gpio_set_latency_logging(bool enabled)
+{
+  latency_logging = enabled;
+}
+#endif
+
 /**
  * @brief Executes the JavaScript callback for a given GPIO event.
  */
@@ -175,9 +273,15 @@ void js_gpio_dispatch_event(js_event_t *event)
   js_pin_t *pin_state = js_gpio_get_state(event->handle_id);
   if (pin_state && pin_state->in_use && jerry_value_is_function(pin_state->js_isr_callback))
   {
+#if CONFIG_JS_LATENCY_TRACE
+    uint32_t dispatch_us = (uint32_t)esp_timer_get_time();
+#endif
     jerry_value_t global = jerry_current_realm();
     jerry_value_t res = jerry_call(pin_state->js_isr_callback, global, NULL, 0);
     jerry_value_free(global);
+#if CONFIG_JS_LATENCY_TRACE
+    record_latency(pin_state, event->isr_time_us, dispatch_us, (uint32_t)esp_timer_get_time());
+#endif
     if (jerry_value_is_exception(res))
     {
       print_js_error(res);
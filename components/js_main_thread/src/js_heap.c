@@ -0,0 +1,75 @@
+#include <stdlib.h>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "jerryscript-port.h"
+#include "sdkconfig.h"
+
+#include "js_heap.h"
+
+static const char *TAG = "JS_HEAP";
+
+static js_heap_t main_heap;
+
+/// @brief The heap of the calling task's context.
+#if CONFIG_JS_WORKERS
+static __thread js_heap_t *current_heap = NULL;
+#else
+static js_heap_t *current_heap = NULL;
+#endif
+
+esp_err_t js_heap_create(js_heap_t *heap, size_t heap_kb)
+{
+  heap->heap_size = heap_kb * 1024;
+  heap->size = heap->heap_size + JS_HEAP_CONTEXT_RESERVE;
+  heap->block = (struct jerry_context_t *)heap_caps_malloc(heap->size, JS_HEAP_CAPS);
+  return heap->block ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+void js_heap_bind(js_heap_t *heap)
+{
+  current_heap = heap;
+}
+
+esp_err_t js_heap_init_main(void)
+{
+  esp_err_t err = js_heap_create(&main_heap, JS_HEAP_KB);
+  if (err != ESP_OK)
+  {
+    ESP_LOGE(TAG, "No %s block of %d KB for the JS heap", JS_HEAP_PLACEMENT, JS_HEAP_KB);
+    return err;
+  }
+  ESP_LOGI(TAG, "%d KB JS heap in %s memory", JS_HEAP_KB, JS_HEAP_PLACEMENT);
+  js_heap_bind(&main_heap);
+  return ESP_OK;
+}
+
+// --- JerryScript port: the context lives in the bound block ---
+
+/**
+ * @brief Hands the engine the block bound to the calling task.
+ *
+ * The block is allocated up front, where running out of memory can be
+ * reported instead of crashing jerry_init(). The heap gets exactly the
+ * configured size, which keeps it within reach of 16-bit compressed pointers.
+ */
+size_t jerry_port_context_alloc(size_t context_size)
+{
+  if (context_size + current_heap->heap_size > current_heap->size)
+  {
+    ESP_LOGW(TAG, "Engine state (%u bytes) is taking %u bytes of heap", (unsigned)context_size,
+             (unsigned)(context_size - JS_HEAP_CONTEXT_RESERVE));
+    return current_heap->size;
+  }
+  return context_size + current_heap->heap_size;
+}
+
+struct jerry_context_t *jerry_port_context_get(void)
+{
+  return current_heap->block;
+}
+
+void jerry_port_context_free(void)
+{
+  heap_caps_free(current_heap->block);
+  current_heap->block = NULL;
+}
@@ -0,0 +1,227 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "js_i2c.h"
+#include "js_i2c_backend.h"
+#include "js_main_thread.h" // For js_event_queue
+
+static const char *TAG = "JS_I2C_ENGINE";
+
+/// @brief Ports with an open bus or a worker that is still shutting down.
+static volatile bool ports_in_use[JS_I2C_MAX_BUSES];
+
+/**
+ * @brief Runs every operation of a request, stopping at the first failure.
+ */
+static void execute_request(js_i2c_bus_t *bus, js_i2c_request_t *request)
+{
+  request->result = ESP_OK;
+  for (size_t i = 0; i < request->op_count; i++)
+  {
+    const js_i2c_op_t *op = &request->ops[i];
+    esp_err_t err = js_i2c_backend_transfer(bus, op->address,
+                                            request->write_data + op->write_offset, op->write_len,
+                                            request->read_data + op->read_offset, op->read_len);
+    if (err != ESP_OK)
+    {
+      request->result = err;
+      request->failed_op = i;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief The bus worker task. Owns the hardware and executes requests in order.
+ *
+ * A NULL request, or an empty queue once `closing` is set, is the shutdown
+ * signal from `js_i2c_close`; everything queued before it is still executed.
+ */
+static void i2c_worker_task(void *params)
+{
+  js_i2c_bus_t *bus = (js_i2c_bus_t *)params;
+  js_i2c_request_t *request;
+
+  while (xQueueReceive(bus->queue, &request, bus->closing ? 0 : portMAX_DELAY) == pdTRUE && request != NULL)
+  {
+    execute_request(bus, request);
+
+    js_event_t ev = {
+        .type = JS_EVENT_I2C,
+        .handle_id = 0,
+        .data = request,
+    };
+    xQueueSend(js_event_queue, &ev, portMAX_DELAY);
+  }
+
+  int port = bus->config.port;
+  js_i2c_backend_close(bus);
+  vQueueDelete(bus->queue);
+  free(bus);
+  ports_in_use[port] = false;
+  ESP_LOGD(TAG, "I2C worker for port %d exited.", port);
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief Opens a bus and starts its worker task.
+ */
+esp_err_t js_i2c_open(const js_i2c_bus_config_t *config, js_i2c_bus_t **out_bus)
+{
+  if (config->port < 0 || config->port >= JS_I2C_MAX_BUSES)
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (ports_in_use[config->port])
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  js_i2c_bus_t *bus = (js_i2c_bus_t *)calloc(1, sizeof(js_i2c_bus_t));
+  if (!bus)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  bus->config = *config;
+
+  esp_err_t err = js_i2c_backend_open(bus);
+  if (err != ESP_OK)
+  {
+    free(bus);
+    return err;
+  }
+
+  bus->queue = xQueueCreate(JS_I2C_QUEUE_DEPTH, sizeof(js_i2c_request_t *));
+  if (!bus->queue ||
+      xTaskCreate(i2c_worker_task, "js_i2c", JS_I2C_WORKER_STACK, bus, JS_I2C_WORKER_PRIORITY, &bus->worker) != pdPASS)
+  {
+    if (bus->queue)
+    {
+      vQueueDelete(bus->queue);
+    }
+    js_i2c_backend_close(bus);
+    free(bus);
+    return ESP_ERR_NO_MEM;
+  }
+
+  ports_in_use[config->port] = true;
+  *out_bus = bus;
+  return ESP_OK;
+}
+
+/**
+ * @brief Allocates a request with room for its operations and data.
+ */
+js_i2c_request_t *js_i2c_request_new(size_t op_count, size_t write_total, size_t read_total)
+{
+  size_t size = sizeof(js_i2c_request_t) + op_count * sizeof(js_i2c_op_t) + write_total + read_total;
+  js_i2c_request_t *request = (js_i2c_request_t *)calloc(1, size);
+  if (!request)
+  {
+    return NULL;
+  }
+  request->promise = jerry_undefined();
+  request->op_count = op_count;
+  request->ops = (js_i2c_op_t *)(request + 1);
+  request->write_data = (uint8_t *)(request->ops + op_count);
+  request->read_data = request->write_data + write_total;
+  request->read_total = read_total;
+  return request;
+}
+
+/**
+ * @brief Hands a request to the bus worker.
+ */
+esp_err_t js_i2c_submit(js_i2c_bus_t *bus, js_i2c_request_t *request)
+{
+  if (xQueueSend(bus->queue, &request, 0) != pdTRUE)
+  {
+    return ESP_ERR_NO_MEM; // Queue full: too many transactions in flight.
+  }
+  return ESP_OK;
+}
+
+/**
+ * @brief Closes a bus. Transactions already queued still complete.
+ */
+void js_i2c_close(js_i2c_bus_t *bus)
+{
+  // Never block here: the worker may itself be waiting for space in
+  // js_event_queue, which only this thread drains. If the bus queue is full,
+  // the worker is busy and will see `closing` once it has drained the queue.
+  bus->closing = true;
+  js_i2c_request_t *shutdown = NULL;
+  xQueueSend(bus->queue, &shutdown, 0);
+}
+
+/**
+ * @brief Builds the value a successful request resolves with.
+ *
+ * All read data is exposed through views over one ArrayBuffer.
+ */
+static jerry_value_t build_result(js_i2c_request_t *request)
+{
+  jerry_value_t buffer = jerry_arraybuffer(request->read_total);
+  if (request->read_total > 0)
+  {
+    jerry_arraybuffer_write(buffer, 0, request->read_data, request->read_total);
+  }
+
+  if (!request->batch)
+  {
+    const js_i2c_op_t *op = &request->ops[0];
+    jerry_value_t view = op->read_len > 0
+                             ? jerry_typedarray_with_buffer_span(JERRY_TYPEDARRAY_UINT8, buffer, op->read_offset, op->read_len)
+                             : jerry_undefined();
+    jerry_value_free(buffer);
+    return view;
+  }
+
+  jerry_value_t results = jerry_array(request->op_count);
+  for (size_t i = 0; i < request->op_count; i++)
+  {
+    const js_i2c_op_t *op = &request->ops[i];
+    if (op->read_len == 0)
+    {
+      continue; // Leave a hole for write-only operations.
+    }
+    jerry_value_t view = jerry_typedarray_with_buffer_span(JERRY_TYPEDARRAY_UINT8, buffer, op->read_offset, op->read_len);
+    jerry_value_free(jerry_object_set_index(results, i, view));
+    jerry_value_free(view);
+  }
+  jerry_value_free(buffer);
+  return results;
+}
+
+/**
+ * @brief Settles the promise of a completed request and frees it.
+ */
+void js_i2c_dispatch_event(js_event_t *event)
+{
+  js_i2c_request_t *request = (js_i2c_request_t *)event->data;
+
+  if (request->result == ESP_OK)
+  {
+    jerry_value_t value = build_result(request);
+    jerry_value_free(jerry_promise_resolve(request->promise, value));
+    jerry_value_free(value);
+  }
+  else
+  {
+    char message[64];
+    snprintf(message, sizeof(message), "I2C operation %u to 0x%02x failed: %s",
+             (unsigned)request->failed_op, request->ops[request->failed_op].address,
+             esp_err_to_name(request->result));
+    jerry_value_t error = jerry_error_sz(JERRY_ERROR_COMMON, message);
+    jerry_value_free(jerry_promise_reject(request->promise, error));
+    jerry_value_free(error);
+  }
+
+  jerry_value_free(request->promise);
+  free(request);
+}
@@ -0,0 +1,34 @@
+#ifndef JS_I2C_BACKEND_H
+#define JS_I2C_BACKEND_H
+
+#include "js_i2c.h"
+
+/**
+ * @brief The operations a bus worker needs from the underlying I2C implementation.
+ *
+ * The worker is backend-agnostic; either the IDF master driver or the
+ * in-memory mock bus is linked in, selected by CONFIG_JS_I2C_MOCK_BUS.
+ * Only `js_i2c_backend_transfer` is on the hot path, and it is only ever
+ * called from the bus worker task.
+ */
+
+/**
+ * @brief Acquires the controller for `bus` and stores backend state in `bus->backend`.
+ */
+esp_err_t js_i2c_backend_open(js_i2c_bus_t *bus);
+
+/**
+ * @brief Performs one write, read, or write-then-read with a repeated start.
+ *
+ * Either length may be zero, but not both.
+ */
+esp_err_t js_i2c_backend_transfer(js_i2c_bus_t *bus, uint16_t address,
+                                  const uint8_t *write_data, size_t write_len,
+                                  uint8_t *read_data, size_t read_len);
+
+/**
+ * @brief Releases the controller and any state stored in `bus->backend`.
+ */
+void js_i2c_backend_close(js_i2c_bus_t *bus);
+
+#endif /* JS_I2C_BACKEND_H */
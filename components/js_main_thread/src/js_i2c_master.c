@@ -0,0 +1,134 @@
+#include <stdlib.h>
+#include "driver/i2c_master.h"
+#include "esp_log.h"
+
+#include "js_i2c_backend.h"
+
+static const char *TAG = "JS_I2C_MASTER";
+
+#define MAX_CACHED_DEVICES 8
+
+/**
+ * @brief Driver state for one bus, with device handles cached per address.
+ *
+ * The IDF driver needs a device handle per target address; creating one per
+ * transfer would add an allocation to every operation, so they are kept for
+ * the lifetime of the bus.
+ */
+typedef struct
+{
+  i2c_master_bus_handle_t bus;
+  struct
+  {
+    uint16_t address;
+    i2c_master_dev_handle_t handle;
+  } devices[MAX_CACHED_DEVICES];
+  size_t device_count;
+} i2c_master_state_t;
+
+/**
+ * @brief Returns the cached device handle for an address, creating it if needed.
+ */
+static i2c_master_dev_handle_t get_device(js_i2c_bus_t *bus, uint16_t address)
+{
+  i2c_master_state_t *state = (i2c_master_state_t *)bus->backend;
+  for (size_t i = 0; i < state->device_count; i++)
+  {
+    if (state->devices[i].address == address)
+    {
+      return state->devices[i].handle;
+    }
+  }
+
+  if (state->device_count == MAX_CACHED_DEVICES)
+  {
+    // Evict the oldest entry; talking to more devices than this is unusual.
+    i2c_master_bus_rm_device(state->devices[0].handle);
+    for (size_t i = 1; i < MAX_CACHED_DEVICES; i++)
+    {
+      state->devices[i - 1] = state->devices[i];
+    }
+    state->device_count--;
+  }
+
+  i2c_device_config_t dev_config = {
+      .dev_addr_length = address > 0x7F ? I2C_ADDR_BIT_LEN_10 : I2C_ADDR_BIT_LEN_7,
+      .device_address = address,
+      .scl_speed_hz = bus->config.frequency_hz,
+  };
+  i2c_master_dev_handle_t handle;
+  if (i2c_master_bus_add_device(state->bus, &dev_config, &handle) != ESP_OK)
+  {
+    return NULL;
+  }
+  state->devices[state->device_count].address = address;
+  state->devices[state->device_count].handle = handle;
+  state->device_count++;
+  return handle;
+}
+
+esp_err_t js_i2c_backend_open(js_i2c_bus_t *bus)
+{
+  i2c_master_state_t *state = (i2c_master_state_t *)calloc(1, sizeof(i2c_master_state_t));
+  if (!state)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+
+  i2c_master_bus_config_t bus_config = {
+      .i2c_port = bus->config.port,
+      .sda_io_num = bus->config.sda,
+      .scl_io_num = bus->config.scl,
+      .clk_source = I2C_CLK_SRC_DEFAULT,
+      .glitch_ignore_cnt = 7,
+      .flags.enable_internal_pullup = true,
+  };
+  esp_err_t err = i2c_new_master_bus(&bus_config, &state->bus);
+  if (err != ESP_OK)
+  {
+    ESP_LOGE(TAG, "Failed to create I2C bus on port %d: %s", bus->config.port, esp_err_to_name(err));
+    free(state);
+    return err;
+  }
+
+  bus->backend = state;
+  return ESP_OK;
+}
+
+esp_err_t js_i2c_backend_transfer(js_i2c_bus_t *bus, uint16_t address,
+                                  const uint8_t *write_data, size_t write_len,
+                                  uint8_t *read_data, size_t read_len)
+{
+  i2c_master_dev_handle_t dev = get_device(bus, address);
+  if (!dev)
+  {
+    return ESP_FAIL;
+  }
+
+  int timeout = (int)bus->config.timeout_ms;
+  if (write_len > 0 && read_len > 0)
+  {
+    return i2c_master_transmit_receive(dev, write_data, write_len, read_data, read_len, timeout);
+  }
+  if (write_len > 0)
+  {
+    return i2c_master_transmit(dev, write_data, write_len, timeout);
+  }
+  return i2c_master_receive(dev, read_data, read_len, timeout);
+}
+
+void js_i2c_backend_close(js_i2c_bus_t *bus)
+{
+  i2c_master_state_t *state = (i2c_master_state_t *)bus->backend;
+  if (!state)
+  {
+    return;
+  }
+  for (size_t i = 0; i < state->device_count; i++)
+  {
+    i2c_master_bus_rm_device(state->devices[i].handle);
+  }
+  i2c_del_master_bus(state->bus);
+  free(state);
+  bus->backend = NULL;
+}
@@ -0,0 +1,160 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "js_i2c_backend.h"
+#include "js_i2c_mock.h"
+
+typedef struct
+{
+  bool in_use;
+  int port;
+  uint16_t address;
+  uint8_t pointer; /**< Register selected by the last write. */
+  uint8_t registers[JS_I2C_MOCK_REGISTER_COUNT];
+} mock_device_t;
+
+static mock_device_t devices[JS_I2C_MOCK_MAX_DEVICES];
+
+// Devices are touched by bus workers and by test code on other tasks.
+static SemaphoreHandle_t devices_lock;
+static StaticSemaphore_t devices_lock_buffer;
+
+void js_i2c_mock_init(void)
+{
+  if (!devices_lock)
+  {
+    devices_lock = xSemaphoreCreateMutexStatic(&devices_lock_buffer);
+  }
+}
+
+static void lock(void)
+{
+  xSemaphoreTake(devices_lock, portMAX_DELAY);
+}
+
+static void unlock(void)
+{
+  xSemaphoreGive(devices_lock);
+}
+
+/**
+ * @brief Finds a device. Must be called with the lock held.
+ */
+static mock_device_t *find_device(int port, uint16_t address)
+{
+  for (int i = 0; i < JS_I2C_MOCK_MAX_DEVICES; i++)
+  {
+    if (devices[i].in_use && devices[i].port == port && devices[i].address == address)
+    {
+      return &devices[i];
+    }
+  }
+  return NULL;
+}
+
+esp_err_t js_i2c_mock_add_device(int port, uint16_t address, const uint8_t *registers, size_t len)
+{
+  if (len > JS_I2C_MOCK_REGISTER_COUNT)
+  {
+    return ESP_ERR_INVALID_SIZE;
+  }
+
+  lock();
+  mock_device_t *dev = find_device(port, address);
+  for (int i = 0; !dev && i < JS_I2C_MOCK_MAX_DEVICES; i++)
+  {
+    if (!devices[i].in_use)
+    {
+      dev = &devices[i];
+    }
+  }
+  if (!dev)
+  {
+    unlock();
+    return ESP_ERR_NO_MEM;
+  }
+
+  memset(dev, 0, sizeof(*dev));
+  dev->in_use = true;
+  dev->port = port;
+  dev->address = address;
+  if (registers)
+  {
+    memcpy(dev->registers, registers, len);
+  }
+  unlock();
+  return ESP_OK;
+}
+
+void js_i2c_mock_reset(void)
+{
+  lock();
+  memset(devices, 0, sizeof(devices));
+  unlock();
+}
+
+esp_err_t js_i2c_mock_get_register(int port, uint16_t address, uint8_t reg, uint8_t *out_value)
+{
+  lock();
+  mock_device_t *dev = find_device(port, address);
+  if (dev)
+  {
+    *out_value = dev->registers[reg];
+  }
+  unlock();
+  return dev ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t js_i2c_mock_set_register(int port, uint16_t address, uint8_t reg, uint8_t value)
+{
+  lock();
+  mock_device_t *dev = find_device(port, address);
+  if (dev)
+  {
+    dev->registers[reg] = value;
+  }
+  unlock();
+  return dev ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t js_i2c_backend_open(js_i2c_bus_t *bus)
+{
+  js_i2c_mock_init(); // On the JS thread, before the bus worker exists
+  bus->backend = NULL; // Devices are looked up by port on each transfer.
+  return ESP_OK;
+}
+
+esp_err_t js_i2c_backend_transfer(js_i2c_bus_t *bus, uint16_t address,
+                                  const uint8_t *write_data, size_t write_len,
+                                  uint8_t *read_data, size_t read_len)
+{
+  lock();
+  mock_device_t *dev = find_device(bus->config.port, address);
+  if (!dev)
+  {
+    unlock();
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  if (write_len > 0)
+  {
+    dev->pointer = write_data[0];
+    for (size_t i = 1; i < write_len; i++)
+    {
+      dev->registers[dev->pointer++] = write_data[i];
+    }
+  }
+  for (size_t i = 0; i < read_len; i++)
+  {
+    read_data[i] = dev->registers[dev->pointer++];
+  }
+  unlock();
+  return ESP_OK;
+}
+
+void js_i2c_backend_close(js_i2c_bus_t *bus)
+{
+  // Simulated devices outlive the bus so tests can inspect them afterwards.
+  (void)bus;
+}
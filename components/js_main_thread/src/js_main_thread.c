@@ -1,7 +1,9 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/task.h"
 #include "jerryscript.h"
 #include "esp_log.h"
+#include "sdkconfig.h"
 
 #include "js_main_thread.h"
 #include "js_std_lib.h"
@@ -9,6 +11,22 @@
 #include "js_event.h"
 #include "js_timers.h"
 #include "js_gpio.h"
+#include "js_i2c.h"
+#include "js_spi.h"
+#include "js_offload.h"
+#include "js_storage.h"
+#include "js_fs.h"
+#include "js_net.h"
+#include "js_scheduler.h"
+#include "js_watchdog.h"
+#include "js_power.h"
+#include "js_worker.h"
+#include "js_heap.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "js_rmt.h"
+#include "js_adc.h"
+#include "js_serial.h"
+#endif
 
 #define TAG "JS_THREAD"
 #define MAX_LOG_LENGTH 64
@@ -54,22 +72,124 @@ static void js_dispatch_event(const js_event_t *event)
     js_gpio_dispatch_event((js_event_t *)event); // Forward to the GPIO module's dispatcher
     break;
 
+  case JS_EVENT_I2C:
+    js_i2c_dispatch_event((js_event_t *)event);
+    break;
+
+  case JS_EVENT_SPI:
+    js_spi_dispatch_event((js_event_t *)event);
+    break;
+
+  case JS_EVENT_OFFLOAD:
+    js_offload_dispatch_event((js_event_t *)event);
+    break;
+
+  case JS_EVENT_STORAGE:
+    js_storage_dispatch_event((js_event_t *)event);
+    break;
+
+  case JS_EVENT_FS:
+    js_fs_dispatch_event((js_event_t *)event);
+    break;
+
+  case JS_EVENT_NET:
+    js_net_dispatch_event((js_event_t *)event);
+    break;
+
+#if CONFIG_JS_WORKERS
+  case JS_EVENT_WORKER:
+    js_worker_dispatch_event((js_event_t *)event);
+    break;
+#endif
+
+#if !CONFIG_IDF_TARGET_LINUX
+  case JS_EVENT_RMT:
+    js_rmt_dispatch_event((js_event_t *)event);
+    break;
+
+  case JS_EVENT_ADC:
+    js_adc_dispatch_event((js_event_t *)event);
+    break;
+
+  case JS_EVENT_SERIAL:
+    js_serial_dispatch_event((js_event_t *)event);
+    break;
+#endif
+
   default:
     ESP_LOGW(TAG, "[EVENT] Unknown type=%d", event->type);
     break;
   }
 }
 
+void js_run_event_loop(QueueHandle_t queue, volatile const bool *stop)
+{
+  js_event_t event;
+  while (stop == NULL || !*stop)
+  {
+    // Run promises and queued microtasks:
+    js_watchdog_arm();
+    js_scheduler_run_jobs();
+    js_watchdog_disarm();
+
+    // Block until an event arrives, unless immediates are waiting. Then take
+    // only the events queued by then, counted once, so neither chunked work
+    // nor a busy event source can hold immediates back for long.
+    // Only a blocking wait lets go of the PM lock, so the chip can sleep.
+    TickType_t wait = js_scheduler_has_immediates() ? 0 : portMAX_DELAY;
+    if (wait != 0)
+    {
+      js_power_idle();
+    }
+    UBaseType_t budget = wait == 0 ? uxQueueMessagesWaiting(queue) : 1;
+    while (budget > 0 && (stop == NULL || !*stop) && xQueueReceive(queue, &event, wait) == pdTRUE)
+    {
+      if (wait != 0)
+      {
+        budget += uxQueueMessagesWaiting(queue); // After blocking, those that arrived with it
+      }
+      budget--;
+      js_power_active();
+      js_watchdog_arm();
+      js_dispatch_event(&event);
+      js_scheduler_run_jobs();
+      js_watchdog_disarm();
+      wait = 0;
+    }
+    js_power_active();
+
+    js_scheduler_run_immediates();
+
+    // TODO: handle promise rejections
+  }
+}
+
 void js_task(void *params)
 {
+  // 0. Allocate the engine heap in internal RAM or PSRAM
+  if (js_heap_init_main() != ESP_OK)
+  {
+    vTaskDelete(NULL);
+  }
+
   // 1. Initialise JerryScript engine
   jerry_init(JERRY_INIT_EMPTY);
+  js_watchdog_init();
+  js_power_init();
 
   // 2. Initialise and bind standard libraries (like global 'console').
   js_init_std_libs();
 
-  // 3. Initialise timers
+  // 3. Initialise timers and peripheral state pools
   js_timers_init();
+  js_scheduler_init();
+  js_spi_init();
+  js_offload_init();
+  js_storage_init();
+  js_fs_init();
+#if !CONFIG_IDF_TARGET_LINUX
+  js_rmt_init();
+#endif
 
   // 4. Create a queue that can hold up to 8 events
   js_event_queue = xQueueCreate(8, sizeof(js_event_t));
@@ -85,20 +205,7 @@ void js_task(void *params)
 
   // 6. Event-driven loop
   ESP_LOGI(TAG, "Main module finished. Entering event loop.");
-  js_event_t event;
-  while (1)
-  {
-    // Run promises:
-    jerry_run_jobs();
-
-    // Block indefinitely until an event arrives
-    if (xQueueReceive(js_event_queue, &event, portMAX_DELAY) == pdTRUE)
-    {
-      js_dispatch_event(&event);
-    }
-
-    // TODO: handle promise rejections
-  }
+  js_run_event_loop(js_event_queue, NULL);
 
   // Final cleanup (will not be reached in the current loop)
   jerry_cleanup();
@@ -0,0 +1,892 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include <sys/ioctl.h>
+#define ioctlsocket ioctl
+#else
+#include "esp_netif.h"
+#endif
+
+#include "js_net.h"
+#include "js_main_thread.h" // For js_event_queue and print_js_error
+
+static const char *TAG = "JS_NET_ENGINE";
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+/// @brief Socket states, indexed by the low byte of their handle.
+static js_net_socket_t sockets[JS_NET_MAX_SOCKETS];
+
+/// @brief Incremented on every open so a reused slot gets a new handle.
+static uint32_t next_generation = 1;
+
+/// @brief Guards the flags the I/O task reads while building its fd sets.
+static SemaphoreHandle_t lock;
+
+/// @brief A loopback UDP pair: a byte sent to `wake_rx` ends the I/O task's select().
+static int wake_rx = -1;
+static int wake_tx = -1;
+
+/// @brief Datagrams are read here first, since their size is only known once read.
+static uint8_t datagram[JS_NET_MAX_DATAGRAM];
+
+// --- I/O task ---
+
+/**
+ * @brief Makes the I/O task rebuild its fd sets, after a flag changed.
+ */
+static void wake_io(void)
+{
+  uint8_t byte = 0;
+  // If the send buffer is full a wake-up is already pending.
+  send(wake_tx, &byte, 1, MSG_DONTWAIT);
+}
+
+static void post_event(uint32_t handle_id, js_net_event_kind_t kind)
+{
+  js_event_t ev = {
+      .type = JS_EVENT_NET,
+      .handle_id = handle_id,
+      .data = (void *)(uintptr_t)kind,
+  };
+  xQueueSend(js_event_queue, &ev, portMAX_DELAY);
+}
+
+/**
+ * @brief Waits for every socket at once and posts what became ready.
+ *
+ * A socket with a readable event queued is left out of the read set until
+ * the JS thread has read it, so a busy stream costs one event per batch
+ * rather than one per segment, and the task never spins on input it has
+ * already reported.
+ */
+static void net_io_task(void *params)
+{
+  fd_set readable, writable;
+  struct
+  {
+    uint32_t handle_id;
+    js_net_event_kind_t kind;
+  } ready[2 * JS_NET_MAX_SOCKETS];
+
+  while (true)
+  {
+    FD_ZERO(&readable);
+    FD_ZERO(&writable);
+    FD_SET(wake_rx, &readable);
+    int max_fd = wake_rx;
+
+    xSemaphoreTake(lock, portMAX_DELAY);
+    for (int i = 0; i < JS_NET_MAX_SOCKETS; i++)
+    {
+      js_net_socket_t *sock = &sockets[i];
+      if (!sock->in_use)
+      {
+        continue;
+      }
+      if (sock->closing)
+      {
+        // Closed here so the descriptor is never in a set while it goes away.
+        close(sock->fd);
+        sock->fd = -1;
+        sock->in_use = false;
+        continue;
+      }
+      if (sock->reading && !sock->rx_pending && !sock->connecting)
+      {
+        FD_SET(sock->fd, &readable);
+      }
+      if (sock->want_write)
+      {
+        FD_SET(sock->fd, &writable);
+      }
+      if (sock->fd > max_fd)
+      {
+        max_fd = sock->fd;
+      }
+    }
+    xSemaphoreGive(lock);
+
+    if (select(max_fd + 1, &readable, &writable, NULL, NULL) < 0)
+    {
+      if (errno != EINTR)
+      {
+        ESP_LOGE(TAG, "select() failed: %s", strerror(errno));
+        vTaskDelay(pdMS_TO_TICKS(100));
+      }
+      continue;
+    }
+
+    if (FD_ISSET(wake_rx, &readable))
+    {
+      uint8_t bytes[16];
+      while (recv(wake_rx, bytes, sizeof(bytes), MSG_DONTWAIT) > 0)
+      {
+      }
+    }
+
+    // Events are posted after the lock is released: the JS thread may be
+    // waiting for it while the event queue is full.
+    int count = 0;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    for (int i = 0; i < JS_NET_MAX_SOCKETS; i++)
+    {
+      js_net_socket_t *sock = &sockets[i];
+      if (!sock->in_use || sock->closing)
+      {
+        continue;
+      }
+      if (FD_ISSET(sock->fd, &readable) && sock->reading && !sock->rx_pending)
+      {
+        sock->rx_pending = true;
+        ready[count].handle_id = sock->handle_id;
+        ready[count++].kind = JS_NET_EVENT_READABLE;
+      }
+      if (FD_ISSET(sock->fd, &writable) && sock->want_write)
+      {
+        sock->want_write = false;
+        ready[count].handle_id = sock->handle_id;
+        ready[count++].kind = JS_NET_EVENT_WRITABLE;
+      }
+    }
+    xSemaphoreGive(lock);
+
+    for (int i = 0; i < count; i++)
+    {
+      post_event(ready[i].handle_id, ready[i].kind);
+    }
+  }
+}
+
+/**
+ * @brief Starts the I/O task and its wake-up pair, on the first open.
+ */
+static esp_err_t net_start(void)
+{
+  if (lock)
+  {
+    return ESP_OK;
+  }
+
+#if !CONFIG_IDF_TARGET_LINUX
+  // Starts the lwIP thread; harmless if Wi-Fi already did.
+  esp_err_t err = esp_netif_init();
+  if (err != ESP_OK && err != ESP_ERR_INVALID_STATE)
+  {
+    return err;
+  }
+#endif
+
+  struct sockaddr_in address = {
+      .sin_family = AF_INET,
+      .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+  };
+  socklen_t address_len = sizeof(address);
+  wake_rx = socket(AF_INET, SOCK_DGRAM, 0);
+  wake_tx = socket(AF_INET, SOCK_DGRAM, 0);
+  if (wake_rx < 0 || wake_tx < 0 || bind(wake_rx, (struct sockaddr *)&address, sizeof(address)) < 0 ||
+      getsockname(wake_rx, (struct sockaddr *)&address, &address_len) < 0 ||
+      connect(wake_tx, (struct sockaddr *)&address, sizeof(address)) < 0)
+  {
+    ESP_LOGE(TAG, "Failed to create the wake-up sockets: %s", strerror(errno));
+    goto fail;
+  }
+  fcntl(wake_rx, F_SETFL, O_NONBLOCK);
+  fcntl(wake_tx, F_SETFL, O_NONBLOCK);
+
+  lock = xSemaphoreCreateMutex();
+  if (!lock)
+  {
+    goto fail;
+  }
+  if (xTaskCreate(net_io_task, "js_net", JS_NET_IO_STACK, NULL, JS_NET_IO_PRIORITY, NULL) != pdPASS)
+  {
+    ESP_LOGE(TAG, "Failed to start the I/O task");
+    vSemaphoreDelete(lock);
+    lock = NULL;
+    goto fail;
+  }
+  return ESP_OK;
+
+fail:
+  if (wake_rx >= 0)
+  {
+    close(wake_rx);
+  }
+  if (wake_tx >= 0)
+  {
+    close(wake_tx);
+  }
+  wake_rx = wake_tx = -1;
+  return ESP_FAIL;
+}
+
+// --- Opening ---
+
+/**
+ * @brief Turns a host into an IPv4 address.
+ *
+ * NULL or "" means every interface. Names other than "localhost" go to the
+ * resolver, which blocks until DNS answers.
+ */
+static esp_err_t resolve(const char *host, uint16_t port, struct sockaddr_in *address)
+{
+  memset(address, 0, sizeof(*address));
+  address->sin_family = AF_INET;
+  address->sin_port = htons(port);
+
+  if (!host || host[0] == '\0')
+  {
+    address->sin_addr.s_addr = htonl(INADDR_ANY);
+    return ESP_OK;
+  }
+  if (strcmp(host, "localhost") == 0)
+  {
+    address->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return ESP_OK;
+  }
+  if (inet_pton(AF_INET, host, &address->sin_addr) == 1)
+  {
+    return ESP_OK;
+  }
+
+  struct addrinfo hints = {.ai_family = AF_INET};
+  struct addrinfo *found = NULL;
+  if (getaddrinfo(host, NULL, &hints, &found) != 0 || !found)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+  address->sin_addr = ((struct sockaddr_in *)found->ai_addr)->sin_addr;
+  freeaddrinfo(found);
+  return ESP_OK;
+}
+
+/**
+ * @brief Claims a free slot for a descriptor, which is made non-blocking.
+ *
+ * @return NULL if every slot is taken.
+ */
+static js_net_socket_t *claim(int fd, js_net_kind_t kind)
+{
+  js_net_socket_t *sock = NULL;
+  xSemaphoreTake(lock, portMAX_DELAY);
+  for (int i = 0; i < JS_NET_MAX_SOCKETS; i++)
+  {
+    if (!sockets[i].in_use)
+    {
+      sock = &sockets[i];
+      memset(sock, 0, sizeof(*sock));
+      sock->handle_id = (next_generation++ << 8) | (uint32_t)i;
+      sock->kind = kind;
+      sock->fd = fd;
+      sock->callback = jerry_undefined();
+      sock->connect_promise = jerry_undefined();
+      sock->connect_value = jerry_undefined();
+      sock->drain_promise = jerry_undefined();
+      sock->in_use = true;
+      break;
+    }
+  }
+  xSemaphoreGive(lock);
+
+  if (sock)
+  {
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+  }
+  return sock;
+}
+
+/**
+ * @brief Creates a socket bound to `host` and `port`, in a slot.
+ */
+static esp_err_t open_bound(const char *host, uint16_t port, int type, js_net_kind_t kind, js_net_socket_t **out)
+{
+  struct sockaddr_in address;
+  esp_err_t err = net_start();
+  if (err == ESP_OK)
+  {
+    err = resolve(host, port, &address);
+  }
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+
+  int fd = socket(AF_INET, type, 0);
+  if (fd < 0)
+  {
+    return ESP_FAIL;
+  }
+  int reuse = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0)
+  {
+    int bind_errno = errno;
+    close(fd);
+    errno = bind_errno;
+    return bind_errno == EADDRINUSE ? ESP_ERR_INVALID_STATE : ESP_FAIL;
+  }
+
+  js_net_socket_t *sock = claim(fd, kind);
+  if (!sock)
+  {
+    close(fd);
+    return ESP_ERR_NO_MEM;
+  }
+  *out = sock;
+  return ESP_OK;
+}
+
+esp_err_t js_net_connect(const char *host, uint16_t port, js_net_socket_t **out)
+{
+  struct sockaddr_in address;
+  esp_err_t err = net_start();
+  if (err == ESP_OK)
+  {
+    err = resolve(host, port, &address);
+  }
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+  {
+    return ESP_FAIL;
+  }
+  js_net_socket_t *sock = claim(fd, JS_NET_TCP);
+  if (!sock)
+  {
+    close(fd);
+    return ESP_ERR_NO_MEM;
+  }
+
+  if (connect(fd, (struct sockaddr *)&address, sizeof(address)) < 0)
+  {
+    if (errno != EINPROGRESS)
+    {
+      int connect_errno = errno;
+      xSemaphoreTake(lock, portMAX_DELAY);
+      sock->closing = true;
+      xSemaphoreGive(lock);
+      wake_io();
+      errno = connect_errno;
+      return ESP_FAIL;
+    }
+    // Finished by the first writable event.
+    xSemaphoreTake(lock, portMAX_DELAY);
+    sock->connecting = true;
+    sock->want_write = true;
+    xSemaphoreGive(lock);
+    wake_io();
+  }
+
+  *out = sock;
+  return ESP_OK;
+}
+
+/**
+ * @brief Sets `remoteAddress` and `remotePort` on the object of a connected socket.
+ */
+static void set_peer(js_net_socket_t *sock, jerry_value_t object)
+{
+  char text[16];
+  uint16_t port;
+  if (js_net_address(sock, true, text, &port) != ESP_OK)
+  {
+    return;
+  }
+  jerry_value_t key = jerry_string_sz("remoteAddress");
+  jerry_value_t value = jerry_string_sz(text);
+  jerry_value_free(jerry_object_set(object, key, value));
+  jerry_value_free(value);
+  jerry_value_free(key);
+  key = jerry_string_sz("remotePort");
+  value = jerry_number(port);
+  jerry_value_free(jerry_object_set(object, key, value));
+  jerry_value_free(value);
+  jerry_value_free(key);
+}
+
+jerry_value_t js_net_connect_promise(js_net_socket_t *sock, jerry_value_t object)
+{
+  jerry_value_t promise = jerry_promise();
+  if (sock->connecting)
+  {
+    sock->connect_promise = jerry_value_copy(promise);
+    sock->connect_value = jerry_value_copy(object);
+  }
+  else
+  {
+    set_peer(sock, object);
+    jerry_value_free(jerry_promise_resolve(promise, object));
+  }
+  return promise;
+}
+
+esp_err_t js_net_listen(const char *host, uint16_t port, int backlog, jerry_value_t callback, js_net_wrap_cb_t wrap,
+                        js_net_socket_t **out)
+{
+  js_net_socket_t *sock;
+  esp_err_t err = open_bound(host, port, SOCK_STREAM, JS_NET_LISTENER, &sock);
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+  if (listen(sock->fd, backlog) < 0)
+  {
+    int listen_errno = errno;
+    js_net_close(sock);
+    errno = listen_errno;
+    return ESP_FAIL;
+  }
+  sock->wrap = wrap;
+  js_net_set_callback(sock, callback);
+  *out = sock;
+  return ESP_OK;
+}
+
+esp_err_t js_net_udp(const char *host, uint16_t port, jerry_value_t callback, js_net_socket_t **out)
+{
+  js_net_socket_t *sock;
+  esp_err_t err = open_bound(host, port, SOCK_DGRAM, JS_NET_UDP, &sock);
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+  js_net_set_callback(sock, callback);
+  *out = sock;
+  return ESP_OK;
+}
+
+js_net_socket_t *js_net_find(uint32_t handle_id)
+{
+  uint32_t index = handle_id & 0xFF;
+  if (index >= JS_NET_MAX_SOCKETS)
+  {
+    return NULL;
+  }
+  js_net_socket_t *sock = &sockets[index];
+  if (!sock->in_use || sock->closing || sock->handle_id != handle_id)
+  {
+    return NULL;
+  }
+  return sock;
+}
+
+// --- Using ---
+
+void js_net_set_callback(js_net_socket_t *sock, jerry_value_t callback)
+{
+  jerry_value_free(sock->callback);
+  sock->callback = jerry_value_copy(callback);
+
+  xSemaphoreTake(lock, portMAX_DELAY);
+  sock->reading = jerry_value_is_function(callback);
+  xSemaphoreGive(lock);
+  wake_io();
+}
+
+int js_net_write(js_net_socket_t *sock, const uint8_t *data, size_t len)
+{
+  size_t accepted = 0;
+  while (accepted < len)
+  {
+    ssize_t sent = send(sock->fd, data + accepted, len - accepted, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sent > 0)
+    {
+      accepted += (size_t)sent;
+    }
+    else if (sent < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+    {
+      break;
+    }
+    else
+    {
+      return -1;
+    }
+  }
+
+  if (accepted < len && !sock->want_write)
+  {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    sock->want_write = true; // Watch for room again
+    xSemaphoreGive(lock);
+    wake_io();
+  }
+  return (int)accepted;
+}
+
+esp_err_t js_net_send_to(js_net_socket_t *sock, const uint8_t *data, size_t len, const char *host, uint16_t port)
+{
+  struct sockaddr_in address;
+  esp_err_t err = resolve(host, port, &address);
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+  if (sendto(sock->fd, data, len, MSG_DONTWAIT, (struct sockaddr *)&address, sizeof(address)) < 0)
+  {
+    return ESP_FAIL;
+  }
+  return ESP_OK;
+}
+
+jerry_value_t js_net_drain(js_net_socket_t *sock)
+{
+  if (!sock->want_write || sock->connecting)
+  {
+    jerry_value_t promise = jerry_promise();
+    jerry_value_t undefined = jerry_undefined();
+    jerry_value_free(jerry_promise_resolve(promise, undefined));
+    return promise;
+  }
+  if (jerry_value_is_undefined(sock->drain_promise))
+  {
+    sock->drain_promise = jerry_promise();
+  }
+  return jerry_value_copy(sock->drain_promise);
+}
+
+esp_err_t js_net_address(js_net_socket_t *sock, bool remote, char address[16], uint16_t *port)
+{
+  struct sockaddr_in name;
+  socklen_t name_len = sizeof(name);
+  int res = remote ? getpeername(sock->fd, (struct sockaddr *)&name, &name_len)
+                   : getsockname(sock->fd, (struct sockaddr *)&name, &name_len);
+  if (res < 0 || name.sin_family != AF_INET || !inet_ntop(AF_INET, &name.sin_addr, address, 16))
+  {
+    return ESP_FAIL;
+  }
+  *port = ntohs(name.sin_port);
+  return ESP_OK;
+}
+
+/**
+ * @brief Settles a pending drain promise, if any.
+ */
+static void settle_drain(js_net_socket_t *sock)
+{
+  if (!jerry_value_is_undefined(sock->drain_promise))
+  {
+    jerry_value_t undefined = jerry_undefined();
+    jerry_value_free(jerry_promise_resolve(sock->drain_promise, undefined));
+    jerry_value_free(sock->drain_promise);
+    sock->drain_promise = jerry_undefined();
+  }
+}
+
+/**
+ * @brief Rejects a pending connect promise, if any.
+ */
+static void reject_connect(js_net_socket_t *sock, const char *reason)
+{
+  if (!jerry_value_is_undefined(sock->connect_promise))
+  {
+    char message[80];
+    snprintf(message, sizeof(message), "Failed to connect: %s", reason);
+    jerry_value_t error = jerry_error_sz(JERRY_ERROR_COMMON, message);
+    jerry_value_free(jerry_promise_reject(sock->connect_promise, error));
+    jerry_value_free(error);
+    jerry_value_free(sock->connect_promise);
+    sock->connect_promise = jerry_undefined();
+  }
+}
+
+/**
+ * @brief Marks a socket closing for the I/O task, first settling its
+ * promises if `settle` is set, else only dropping them.
+ */
+static void close_socket(js_net_socket_t *sock, bool settle)
+{
+  if (sock->closing)
+  {
+    return;
+  }
+
+  if (settle)
+  {
+    // Nothing more will be written, so waiting writers can carry on.
+    settle_drain(sock);
+    reject_connect(sock, "Socket closed.");
+  }
+  jerry_value_free(sock->drain_promise);
+  sock->drain_promise = jerry_undefined();
+  jerry_value_free(sock->connect_promise);
+  sock->connect_promise = jerry_undefined();
+  jerry_value_free(sock->connect_value);
+  sock->connect_value = jerry_undefined();
+  jerry_value_free(sock->callback);
+  sock->callback = jerry_undefined();
+
+  xSemaphoreTake(lock, portMAX_DELAY);
+  sock->closing = true;
+  xSemaphoreGive(lock);
+  wake_io();
+}
+
+void js_net_close(js_net_socket_t *sock)
+{
+  close_socket(sock, true);
+}
+
+void js_net_release(js_net_socket_t *sock)
+{
+  close_socket(sock, false);
+}
+
+// --- Dispatch ---
+
+/**
+ * @brief Calls the socket's callback with `argc` arguments.
+ */
+static void deliver(js_net_socket_t *sock, const jerry_value_t *args, jerry_length_t argc)
+{
+  // Hold our own reference: the callback may close the socket.
+  jerry_value_t callback = jerry_value_copy(sock->callback);
+  jerry_value_t global = jerry_current_realm();
+  jerry_value_t res = jerry_call(callback, global, args, argc);
+  if (jerry_value_is_exception(res))
+  {
+    print_js_error(res);
+  }
+  jerry_value_free(res);
+  jerry_value_free(global);
+  jerry_value_free(callback);
+}
+
+/**
+ * @brief Reads what a stream has buffered into one ArrayBuffer.
+ *
+ * FIONREAD sizes the buffer exactly, so the bytes go from the stack to JS
+ * in a single copy; end of stream is delivered as null.
+ */
+static void read_stream(js_net_socket_t *sock)
+{
+  int available = 0;
+  size_t size = JS_NET_RX_CHUNK;
+  if (ioctlsocket(sock->fd, FIONREAD, &available) == 0 && available > 0)
+  {
+    size = (size_t)available < JS_NET_MAX_BATCH ? (size_t)available : JS_NET_MAX_BATCH;
+  }
+
+  jerry_value_t buffer = jerry_arraybuffer((jerry_length_t)size);
+  uint8_t *data = jerry_arraybuffer_data(buffer);
+  if (!data)
+  {
+    ESP_LOGE(TAG, "Out of memory for %u received bytes", (unsigned)size);
+    jerry_value_free(buffer);
+    return;
+  }
+
+  size_t got = 0;
+  bool ended = false;
+  while (got < size)
+  {
+    ssize_t n = recv(sock->fd, data + got, size - got, MSG_DONTWAIT);
+    if (n > 0)
+    {
+      got += (size_t)n;
+    }
+    else if (n < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    else
+    {
+      // 0 is the peer's FIN; any error but "nothing yet" ends the stream too.
+      ended = n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+      break;
+    }
+  }
+
+  if (got > 0)
+  {
+    jerry_value_t view = jerry_typedarray_with_buffer_span(JERRY_TYPEDARRAY_UINT8, buffer, 0, (jerry_length_t)got);
+    deliver(sock, &view, 1);
+    jerry_value_free(view);
+  }
+  jerry_value_free(buffer);
+
+  if (ended && !sock->closing)
+  {
+    jerry_value_t end = jerry_null();
+    deliver(sock, &end, 1);
+    js_net_close(sock);
+  }
+}
+
+/**
+ * @brief Hands up to JS_NET_DATAGRAMS_PER_EVENT datagrams to the callback,
+ * each with its sender.
+ */
+static void read_datagrams(js_net_socket_t *sock)
+{
+  for (int i = 0; i < JS_NET_DATAGRAMS_PER_EVENT && !sock->closing; i++)
+  {
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+    ssize_t n = recvfrom(sock->fd, datagram, sizeof(datagram), MSG_DONTWAIT, (struct sockaddr *)&from, &from_len);
+    if (n < 0)
+    {
+      break; // Nothing left, or an ICMP error nobody is waiting for
+    }
+
+    jerry_value_t buffer = jerry_arraybuffer((jerry_length_t)n);
+    uint8_t *data = jerry_arraybuffer_data(buffer);
+    if (n > 0 && !data)
+    {
+      ESP_LOGE(TAG, "Out of memory for a %d byte datagram", (int)n);
+      jerry_value_free(buffer);
+      break;
+    }
+    memcpy(data, datagram, (size_t)n);
+
+    char text[16] = "";
+    inet_ntop(AF_INET, &from.sin_addr, text, sizeof(text));
+    jerry_value_t sender = jerry_object();
+    jerry_value_t key = jerry_string_sz("address");
+    jerry_value_t value = jerry_string_sz(text);
+    jerry_value_free(jerry_object_set(sender, key, value));
+    jerry_value_free(value);
+    jerry_value_free(key);
+    key = jerry_string_sz("port");
+    value = jerry_number(ntohs(from.sin_port));
+    jerry_value_free(jerry_object_set(sender, key, value));
+    jerry_value_free(value);
+    jerry_value_free(key);
+
+    jerry_value_t args[2] = {jerry_typedarray_with_buffer(JERRY_TYPEDARRAY_UINT8, buffer), sender};
+    deliver(sock, args, 2);
+    jerry_value_free(args[0]);
+    jerry_value_free(args[1]);
+    jerry_value_free(buffer);
+  }
+}
+
+/**
+ * @brief Accepts every waiting connection and hands each to the callback.
+ */
+static void accept_connections(js_net_socket_t *listener)
+{
+  for (int i = 0; i < JS_NET_MAX_SOCKETS && !listener->closing; i++)
+  {
+    int fd = accept(listener->fd, NULL, NULL);
+    if (fd < 0)
+    {
+      break;
+    }
+    js_net_socket_t *sock = claim(fd, JS_NET_TCP);
+    if (!sock)
+    {
+      ESP_LOGW(TAG, "Refusing a connection: all %d sockets are in use", JS_NET_MAX_SOCKETS);
+      close(fd);
+      continue;
+    }
+
+    jerry_value_t object = listener->wrap(sock);
+    set_peer(sock, object);
+    deliver(listener, &object, 1);
+    jerry_value_free(object);
+  }
+}
+
+/**
+ * @brief Finishes a connect, or resolves a drain.
+ */
+static void handle_writable(js_net_socket_t *sock)
+{
+  if (!sock->connecting)
+  {
+    settle_drain(sock);
+    return;
+  }
+
+  int error = 0;
+  socklen_t error_len = sizeof(error);
+  if (getsockopt(sock->fd, SOL_SOCKET, SO_ERROR, &error, &error_len) < 0)
+  {
+    error = errno;
+  }
+
+  xSemaphoreTake(lock, portMAX_DELAY);
+  sock->connecting = false;
+  xSemaphoreGive(lock);
+
+  if (error != 0)
+  {
+    reject_connect(sock, strerror(error));
+    js_net_close(sock);
+    return;
+  }
+
+  jerry_value_t promise = sock->connect_promise;
+  jerry_value_t object = sock->connect_value;
+  sock->connect_promise = jerry_undefined();
+  sock->connect_value = jerry_undefined();
+  if (!jerry_value_is_undefined(promise))
+  {
+    set_peer(sock, object);
+    jerry_value_free(jerry_promise_resolve(promise, object));
+  }
+  jerry_value_free(promise);
+  jerry_value_free(object);
+  wake_io(); // Reading was held back until now
+}
+
+void js_net_dispatch_event(js_event_t *event)
+{
+  js_net_socket_t *sock = js_net_find(event->handle_id);
+  if (!sock)
+  {
+    return; // Closed after the event was posted
+  }
+
+  if ((js_net_event_kind_t)(uintptr_t)event->data == JS_NET_EVENT_WRITABLE)
+  {
+    handle_writable(sock);
+    return;
+  }
+
+  switch (sock->kind)
+  {
+  case JS_NET_TCP:
+    read_stream(sock);
+    break;
+  case JS_NET_UDP:
+    read_datagrams(sock);
+    break;
+  case JS_NET_LISTENER:
+    accept_connections(sock);
+    break;
+  }
+
+  if (!sock->closing)
+  {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    sock->rx_pending = false;
+    xSemaphoreGive(lock);
+    wake_io();
+  }
+}
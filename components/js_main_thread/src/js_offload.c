@@ -0,0 +1,276 @@
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "js_offload.h"
+#include "js_main_thread.h" // For js_event_queue
+
+static const char *TAG = "JS_OFFLOAD";
+
+typedef struct
+{
+  const char *name;
+  js_offload_fn_t fn;
+} offload_op_t;
+
+/// @brief Registered operations. Only written before or on the JS thread.
+static offload_op_t ops[JS_OFFLOAD_MAX_OPS];
+static size_t op_count = 0;
+
+/// @brief Jobs waiting for a worker.
+static QueueHandle_t job_queue = NULL;
+
+/// @brief Finished jobs, oldest first, guarded by `done_lock`.
+static js_offload_job_t *done_head = NULL;
+static js_offload_job_t *done_tail = NULL;
+static bool done_posted = false; /**< A JS_EVENT_OFFLOAD event is queued and not yet dispatched. */
+static SemaphoreHandle_t done_lock = NULL;
+
+// --- Built-in operations ---
+
+/**
+ * @brief "crc32": the IEEE 802.3 CRC of the input, as a number.
+ */
+static void op_crc32(const js_offload_input_t *input, js_offload_output_t *output)
+{
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < input->len; i++)
+  {
+    crc ^= input->data[i];
+    for (int bit = 0; bit < 8; bit++)
+    {
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+  }
+  output->kind = JS_OFFLOAD_RESULT_NUMBER;
+  output->number = (double)(crc ^ 0xFFFFFFFF);
+}
+
+/**
+ * @brief "hex": the input formatted as a lowercase hex string.
+ */
+static void op_hex(const js_offload_input_t *input, js_offload_output_t *output)
+{
+  static const char digits[] = "0123456789abcdef";
+  uint8_t *text = (uint8_t *)malloc(input->len * 2 + 1);
+  if (!text)
+  {
+    output->error = "Out of memory";
+    return;
+  }
+  for (size_t i = 0; i < input->len; i++)
+  {
+    text[2 * i] = digits[input->data[i] >> 4];
+    text[2 * i + 1] = digits[input->data[i] & 0x0F];
+  }
+  output->kind = JS_OFFLOAD_RESULT_STRING;
+  output->data = text;
+  output->len = input->len * 2;
+}
+
+// --- Workers ---
+
+/**
+ * @brief Tells the JS thread that finished jobs are waiting, unless it already knows.
+ *
+ * Never blocks, so a JS thread busy for long holds up only the posting, not
+ * the workers.
+ * @return False if the event could not be queued and must be retried.
+ */
+static bool post_done(void)
+{
+  xSemaphoreTake(done_lock, portMAX_DELAY);
+  if (done_head && !done_posted)
+  {
+    js_event_t ev = {
+        .type = JS_EVENT_OFFLOAD,
+        .handle_id = 0,
+        .data = NULL,
+    };
+    done_posted = xQueueSend(js_event_queue, &ev, 0) == pdTRUE;
+  }
+  bool delivered = !done_head || done_posted;
+  xSemaphoreGive(done_lock);
+  return delivered;
+}
+
+/**
+ * @brief Runs jobs in the order they were submitted and hands each one back.
+ */
+static void offload_worker_task(void *params)
+{
+  js_offload_job_t *job;
+  bool delivered = true;
+  for (;;)
+  {
+    TickType_t wait = delivered ? portMAX_DELAY : pdMS_TO_TICKS(JS_OFFLOAD_RETRY_MS);
+    if (xQueueReceive(job_queue, &job, wait) != pdTRUE)
+    {
+      delivered = post_done();
+      continue;
+    }
+
+    job->fn(&job->input, &job->output);
+
+    xSemaphoreTake(done_lock, portMAX_DELAY);
+    if (done_tail)
+    {
+      done_tail->next = job;
+    }
+    else
+    {
+      done_head = job;
+    }
+    done_tail = job;
+    xSemaphoreGive(done_lock);
+    delivered = post_done();
+  }
+}
+
+/**
+ * @brief Registers the built-in operations and starts the worker tasks.
+ */
+void js_offload_init(void)
+{
+  js_offload_register("crc32", op_crc32);
+  js_offload_register("hex", op_hex);
+
+  job_queue = xQueueCreate(JS_OFFLOAD_QUEUE_DEPTH, sizeof(js_offload_job_t *));
+  done_lock = xSemaphoreCreateMutex();
+  if (!job_queue || !done_lock)
+  {
+    ESP_LOGE(TAG, "Failed to create offload job queue or lock");
+    return;
+  }
+
+  for (int i = 0; i < JS_OFFLOAD_WORKERS; i++)
+  {
+    if (xTaskCreatePinnedToCore(offload_worker_task, "js_offload", JS_OFFLOAD_WORKER_STACK, NULL,
+                                JS_OFFLOAD_WORKER_PRIORITY, NULL, JS_OFFLOAD_WORKER_CORE) != pdPASS)
+    {
+      ESP_LOGE(TAG, "Failed to start offload worker %d", i);
+    }
+  }
+}
+
+/**
+ * @brief Makes a native operation available to `runtime.offload(name, ...)`.
+ */
+esp_err_t js_offload_register(const char *name, js_offload_fn_t fn)
+{
+  if (js_offload_find(name))
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (op_count == JS_OFFLOAD_MAX_OPS)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  ops[op_count].name = name;
+  ops[op_count].fn = fn;
+  op_count++;
+  return ESP_OK;
+}
+
+/**
+ * @brief Looks up a registered operation by name.
+ */
+js_offload_fn_t js_offload_find(const char *name)
+{
+  for (size_t i = 0; i < op_count; i++)
+  {
+    if (strcmp(ops[i].name, name) == 0)
+    {
+      return ops[i].fn;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Queues a job for the workers without blocking.
+ */
+esp_err_t js_offload_submit(js_offload_job_t *job)
+{
+  if (!job_queue || xQueueSend(job_queue, &job, 0) != pdTRUE)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  return ESP_OK;
+}
+
+/**
+ * @brief Converts a finished job's output to the value its promise resolves with.
+ */
+static jerry_value_t output_to_value(const js_offload_output_t *output)
+{
+  switch (output->kind)
+  {
+  case JS_OFFLOAD_RESULT_NUMBER:
+    return jerry_number(output->number);
+
+  case JS_OFFLOAD_RESULT_BYTES:
+  {
+    jerry_value_t buffer = jerry_arraybuffer(output->len);
+    jerry_arraybuffer_write(buffer, 0, output->data, output->len);
+    jerry_value_t view = jerry_typedarray_with_buffer(JERRY_TYPEDARRAY_UINT8, buffer);
+    jerry_value_free(buffer);
+    return view;
+  }
+
+  case JS_OFFLOAD_RESULT_STRING:
+    return jerry_string(output->data, output->len, JERRY_ENCODING_UTF8);
+
+  default:
+    return jerry_undefined();
+  }
+}
+
+/**
+ * @brief Settles a finished job's promise and frees it.
+ */
+static void finish_job(js_offload_job_t *job)
+{
+  if (job->output.error)
+  {
+    jerry_value_t error = jerry_error_sz(JERRY_ERROR_COMMON, job->output.error);
+    jerry_value_free(jerry_promise_reject(job->promise, error));
+    jerry_value_free(error);
+  }
+  else
+  {
+    jerry_value_t value = output_to_value(&job->output);
+    jerry_value_free(jerry_promise_resolve(job->promise, value));
+    jerry_value_free(value);
+  }
+
+  jerry_value_free(job->promise);
+  jerry_value_free(job->input_value);
+  free(job->input_copy);
+  free(job->output.data);
+  free(job);
+}
+
+/**
+ * @brief Settles the promises of the finished jobs and frees them, for a JS_EVENT_OFFLOAD event.
+ */
+void js_offload_dispatch_event(js_event_t *event)
+{
+  xSemaphoreTake(done_lock, portMAX_DELAY);
+  js_offload_job_t *job = done_head;
+  done_head = NULL;
+  done_tail = NULL;
+  done_posted = false;
+  xSemaphoreGive(done_lock);
+
+  while (job)
+  {
+    js_offload_job_t *next = job->next;
+    finish_job(job);
+    job = next;
+  }
+}
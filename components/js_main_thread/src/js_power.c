@@ -0,0 +1,225 @@
+#include <stdbool.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#if CONFIG_JS_POWER_SAVE
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#endif
+
+#include "js_power.h"
+#include "js_worker.h" // for js_context_index
+
+/**
+ * @brief The power accounting of one context. Only that context's thread touches it.
+ */
+typedef struct
+{
+  bool active;   /**< Running JS, and holding the PM lock with CONFIG_JS_POWER_SAVE. */
+  int64_t since; /**< When it last became active or idle. */
+  js_power_stats_t stats;
+} js_power_t;
+
+static js_power_t contexts[JS_MAX_CONTEXTS];
+
+#if CONFIG_JS_POWER_SAVE
+static const char *TAG = "JS_POWER";
+
+/// @brief Held by every active context: keeps the CPU at full speed and out of light sleep.
+static esp_pm_lock_handle_t active_lock = NULL;
+
+/// @brief Chip-wide light sleep counters, written by the idle task around each sleep.
+static volatile int64_t slept_us;
+static volatile uint32_t sleeps;
+static int64_t sleep_entered;
+
+/// @brief Pins that wake the chip, and the interrupt each one has while awake.
+static volatile uint64_t wake_pins;
+static gpio_int_type_t wake_intr[GPIO_NUM_MAX];
+
+/**
+ * @brief The level an interrupt waits for, as a light sleep wake-up level.
+ */
+static gpio_int_type_t wake_level(gpio_num_t pin_num, gpio_int_type_t intr_type)
+{
+  switch (intr_type)
+  {
+  case GPIO_INTR_POSEDGE:
+  case GPIO_INTR_HIGH_LEVEL:
+    return GPIO_INTR_HIGH_LEVEL;
+  case GPIO_INTR_ANYEDGE:
+    return gpio_get_level(pin_num) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL;
+  default:
+    return GPIO_INTR_LOW_LEVEL;
+  }
+}
+
+/**
+ * @brief Called by the idle task, interrupts disabled, just before a light sleep.
+ */
+static esp_err_t sleep_enter_cb(int64_t sleep_time_us, void *arg)
+{
+  for (int pin = 0; pin < GPIO_NUM_MAX; pin++)
+  {
+    if (wake_pins & (1ULL << pin))
+    {
+      gpio_wakeup_enable(pin, wake_level(pin, wake_intr[pin]));
+    }
+  }
+  sleep_entered = esp_timer_get_time();
+  return ESP_OK;
+}
+
+/**
+ * @brief Called by the idle task, interrupts still disabled, after a light sleep.
+ *
+ * Restores the edge interrupts; a pin that woke the chip has its interrupt
+ * latched, so its handler runs once interrupts are enabled again.
+ */
+static esp_err_t sleep_exit_cb(int64_t sleep_time_us, void *arg)
+{
+  slept_us += esp_timer_get_time() - sleep_entered;
+  sleeps++;
+  for (int pin = 0; pin < GPIO_NUM_MAX; pin++)
+  {
+    if (wake_pins & (1ULL << pin))
+    {
+      gpio_set_intr_type(pin, wake_intr[pin]);
+    }
+  }
+  return ESP_OK;
+}
+
+/**
+ * @brief Enables automatic light sleep and creates the lock that active contexts hold.
+ */
+static void power_save_init(void)
+{
+  esp_pm_config_t pm_config = {
+      .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+      .min_freq_mhz = CONFIG_XTAL_FREQ,
+      .light_sleep_enable = true,
+  };
+  esp_err_t err = esp_pm_configure(&pm_config);
+  if (err == ESP_OK)
+  {
+    err = esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "js", &active_lock);
+  }
+  if (err == ESP_OK)
+  {
+    err = esp_sleep_enable_gpio_wakeup();
+  }
+  if (err == ESP_OK)
+  {
+    esp_pm_sleep_cbs_register_config_t cbs = {
+        .enter_cb = sleep_enter_cb,
+        .exit_cb = sleep_exit_cb,
+    };
+    err = esp_pm_light_sleep_register_cbs(&cbs);
+  }
+  if (err != ESP_OK)
+  {
+    ESP_LOGE(TAG, "Failed to enable light sleep: %s", esp_err_to_name(err));
+    return;
+  }
+  ESP_LOGI(TAG, "Light sleep enabled between events.");
+}
+
+void js_power_set_wake_pin(gpio_num_t pin_num, gpio_int_type_t intr_type)
+{
+  if (pin_num < 0 || pin_num >= GPIO_NUM_MAX)
+  {
+    return;
+  }
+  if (intr_type == GPIO_INTR_DISABLE)
+  {
+    wake_pins &= ~(1ULL << pin_num);
+    gpio_wakeup_disable(pin_num);
+  }
+  else
+  {
+    wake_intr[pin_num] = intr_type;
+    wake_pins |= 1ULL << pin_num;
+  }
+}
+#endif
+
+void js_power_init(void)
+{
+#if CONFIG_JS_POWER_SAVE
+  if (active_lock == NULL)
+  {
+    power_save_init();
+  }
+#endif
+  js_power_t *power = &contexts[js_context_index()];
+  power->active = true;
+  power->since = esp_timer_get_time();
+  power->stats = (js_power_stats_t){0};
+#if CONFIG_JS_POWER_SAVE
+  if (active_lock != NULL)
+  {
+    esp_pm_lock_acquire(active_lock);
+  }
+#endif
+}
+
+void js_power_active(void)
+{
+  js_power_t *power = &contexts[js_context_index()];
+  if (power->active)
+  {
+    return;
+  }
+#if CONFIG_JS_POWER_SAVE
+  if (active_lock != NULL)
+  {
+    esp_pm_lock_acquire(active_lock);
+  }
+#endif
+  int64_t now = esp_timer_get_time();
+  power->stats.idle_us += now - power->since;
+  power->stats.wakeups++;
+  power->since = now;
+  power->active = true;
+}
+
+void js_power_idle(void)
+{
+  js_power_t *power = &contexts[js_context_index()];
+  if (!power->active)
+  {
+    return;
+  }
+  int64_t now = esp_timer_get_time();
+  power->stats.active_us += now - power->since;
+  power->since = now;
+  power->active = false;
+#if CONFIG_JS_POWER_SAVE
+  if (active_lock != NULL)
+  {
+    esp_pm_lock_release(active_lock);
+  }
+#endif
+}
+
+js_power_stats_t js_power_stats(void)
+{
+  js_power_t *power = &contexts[js_context_index()];
+  js_power_stats_t stats = power->stats;
+  int64_t current = esp_timer_get_time() - power->since;
+  if (power->active)
+  {
+    stats.active_us += current;
+  }
+  else
+  {
+    stats.idle_us += current;
+  }
+#if CONFIG_JS_POWER_SAVE
+  stats.sleep_us = slept_us;
+  stats.light_sleeps = sleeps;
+#endif
+  return stats;
+}
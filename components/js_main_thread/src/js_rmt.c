@@ -0,0 +1,729 @@
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "soc/soc_caps.h"
+
+#include "js_rmt.h"
+#include "js_main_thread.h" // For js_event_queue and print_js_error
+
+static const char *TAG = "JS_RMT_ENGINE";
+
+/// @brief Pool of RMT channel states.
+static js_rmt_channel_t channels[JS_RMT_MAX_CHANNELS];
+
+/// @brief Incremented on every open so a reused pool slot gets a new handle.
+static uint32_t next_generation = 1;
+
+// NEC timings in microseconds.
+#define NEC_LEADING_HIGH_US 9000
+#define NEC_LEADING_LOW_US 4500
+#define NEC_REPEAT_LOW_US 2250
+#define NEC_PULSE_US 560
+#define NEC_ONE_LOW_US 1690
+
+// WS2812 timings in nanoseconds.
+#define WS2812_T0H_NS 300
+#define WS2812_T0L_NS 900
+#define WS2812_T1H_NS 900
+#define WS2812_T1L_NS 300
+
+// DHT22 timings in microseconds.
+#define DHT22_BIT_LOW_MIN_US 35
+#define DHT22_BIT_LOW_MAX_US 75
+#define DHT22_ONE_HIGH_MIN_US 48
+#define DHT22_DATA_BITS 40
+
+/**
+ * @brief Converts a duration in nanoseconds to channel ticks.
+ */
+static inline uint32_t ns_to_ticks(uint32_t resolution_hz, uint32_t ns)
+{
+  return (uint32_t)(((uint64_t)resolution_hz * ns) / 1000000000ULL);
+}
+
+/**
+ * @brief Converts channel ticks to microseconds.
+ */
+static inline uint32_t ticks_to_us(uint32_t resolution_hz, uint32_t ticks)
+{
+  return (uint32_t)(((uint64_t)ticks * 1000000ULL) / resolution_hz);
+}
+
+/**
+ * @brief Checks a measured duration against a nominal one with 25% tolerance.
+ */
+static inline bool within_tolerance(uint32_t measured_us, uint32_t nominal_us)
+{
+  uint32_t margin = nominal_us / 4;
+  return measured_us + margin >= nominal_us && measured_us <= nominal_us + margin;
+}
+
+/**
+ * @brief Posts an RMT event for a channel from interrupt context, unless one
+ * is pending already.
+ *
+ * The completion itself is recorded in the channel first, so an event that
+ * does not fit in the queue loses nothing: the next event, or the next
+ * dispatch of any RMT event, picks it up.
+ */
+static bool IRAM_ATTR post_event_from_isr(js_rmt_channel_t *ch)
+{
+  if (ch->event_pending)
+  {
+    return false;
+  }
+  ch->event_pending = true;
+
+  js_event_t ev = {
+      .type = JS_EVENT_RMT,
+      .handle_id = ch->handle_id,
+      .data = NULL,
+  };
+  BaseType_t woke = pdFALSE;
+  if (xQueueSendFromISR(js_event_queue, &ev, &woke) != pdTRUE)
+  {
+    ch->event_pending = false; // The queue is full; the completion waits in the channel
+  }
+  return woke == pdTRUE;
+}
+
+static bool IRAM_ATTR tx_done_cb(rmt_channel_handle_t chan, const rmt_tx_done_event_data_t *edata, void *user_ctx)
+{
+  js_rmt_channel_t *ch = (js_rmt_channel_t *)user_ctx;
+  __atomic_fetch_add(&ch->tx_done, 1, __ATOMIC_RELEASE);
+  return post_event_from_isr(ch);
+}
+
+static bool IRAM_ATTR rx_done_cb(rmt_channel_handle_t chan, const rmt_rx_done_event_data_t *edata, void *user_ctx)
+{
+  js_rmt_channel_t *ch = (js_rmt_channel_t *)user_ctx;
+  ch->rx_symbols = edata->num_symbols;
+  __atomic_store_n(&ch->rx_done, true, __ATOMIC_RELEASE);
+  return post_event_from_isr(ch);
+}
+
+/**
+ * @brief Finds a free slot in the channel pool and stamps it with a fresh handle.
+ */
+static js_rmt_channel_t *claim_channel(js_rmt_kind_t kind)
+{
+  for (int i = 0; i < JS_RMT_MAX_CHANNELS; i++)
+  {
+    if (channels[i].kind == JS_RMT_UNUSED)
+    {
+      js_rmt_channel_t *ch = &channels[i];
+      memset(ch, 0, sizeof(*ch));
+      ch->kind = kind;
+      ch->handle_id = (next_generation++ << 8) | (uint32_t)i;
+      ch->js_rx_callback = jerry_undefined();
+      for (int s = 0; s < JS_RMT_TX_QUEUE_DEPTH; s++)
+      {
+        ch->tx_slots[s].promise = jerry_undefined();
+        ch->tx_slots[s].buffer = jerry_undefined();
+      }
+      return ch;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Returns the channel for an event handle, or NULL if it has since been closed.
+ */
+static js_rmt_channel_t *lookup_channel(uint32_t handle_id)
+{
+  uint32_t index = handle_id & 0xFF;
+  if (index < JS_RMT_MAX_CHANNELS && channels[index].kind != JS_RMT_UNUSED &&
+      channels[index].handle_id == handle_id)
+  {
+    return &channels[index];
+  }
+  return NULL;
+}
+
+/**
+ * @brief Initializes the RMT channel management system.
+ */
+void js_rmt_init(void)
+{
+  for (int i = 0; i < JS_RMT_MAX_CHANNELS; i++)
+  {
+    channels[i].kind = JS_RMT_UNUSED;
+    channels[i].js_rx_callback = jerry_undefined();
+  }
+}
+
+/**
+ * @brief Opens a transmit channel on a pin.
+ */
+esp_err_t js_rmt_new_tx(const js_rmt_tx_config_t *config, js_rmt_channel_t **out_channel)
+{
+  js_rmt_channel_t *ch = claim_channel(JS_RMT_TX);
+  if (!ch)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  rmt_tx_channel_config_t tx_config = {
+      .gpio_num = config->pin_num,
+      .clk_src = RMT_CLK_SRC_DEFAULT,
+      .resolution_hz = config->resolution_hz,
+      .mem_block_symbols = config->mem_block_symbols,
+      .trans_queue_depth = JS_RMT_TX_QUEUE_DEPTH,
+      .flags.io_od_mode = config->open_drain,
+      .flags.io_loop_back = config->open_drain,
+  };
+#if SOC_RMT_SUPPORT_DMA
+  tx_config.flags.with_dma = config->with_dma;
+#endif
+
+  esp_err_t err = rmt_new_tx_channel(&tx_config, &ch->channel);
+  if (err != ESP_OK)
+  {
+    ch->kind = JS_RMT_UNUSED;
+    return err;
+  }
+  ch->pin_num = config->pin_num;
+  ch->resolution_hz = config->resolution_hz;
+
+  if (config->carrier_hz > 0)
+  {
+    rmt_carrier_config_t carrier = {
+        .frequency_hz = config->carrier_hz,
+        .duty_cycle = 0.33,
+    };
+    err = rmt_apply_carrier(ch->channel, &carrier);
+  }
+
+  rmt_copy_encoder_config_t copy_config = {};
+  if (err == ESP_OK)
+  {
+    err = rmt_new_copy_encoder(&copy_config, &ch->copy_encoder);
+  }
+
+  rmt_tx_event_callbacks_t cbs = {.on_trans_done = tx_done_cb};
+  if (err == ESP_OK)
+  {
+    err = rmt_tx_register_event_callbacks(ch->channel, &cbs, ch);
+  }
+  if (err == ESP_OK)
+  {
+    err = rmt_enable(ch->channel);
+  }
+  if (err != ESP_OK)
+  {
+    js_rmt_close(ch);
+    return err;
+  }
+
+  *out_channel = ch;
+  return ESP_OK;
+}
+
+/**
+ * @brief Opens a receive channel on a pin.
+ */
+esp_err_t js_rmt_new_rx(const js_rmt_rx_config_t *config, js_rmt_channel_t **out_channel)
+{
+  js_rmt_channel_t *ch = claim_channel(JS_RMT_RX);
+  if (!ch)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  rmt_rx_channel_config_t rx_config = {
+      .gpio_num = config->pin_num,
+      .clk_src = RMT_CLK_SRC_DEFAULT,
+      .resolution_hz = config->resolution_hz,
+      .mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL,
+  };
+  esp_err_t err = rmt_new_rx_channel(&rx_config, &ch->channel);
+  if (err != ESP_OK)
+  {
+    ch->kind = JS_RMT_UNUSED;
+    return err;
+  }
+  ch->pin_num = config->pin_num;
+  ch->resolution_hz = config->resolution_hz;
+
+  ch->rx_buffer_symbols = config->max_symbols;
+  ch->rx_buffer = malloc(config->max_symbols * sizeof(rmt_symbol_word_t));
+  if (!ch->rx_buffer)
+  {
+    js_rmt_close(ch);
+    return ESP_ERR_NO_MEM;
+  }
+  ch->rx_config.signal_range_min_ns = config->min_pulse_ns;
+  ch->rx_config.signal_range_max_ns = config->max_pulse_ns;
+
+  rmt_rx_event_callbacks_t cbs = {.on_recv_done = rx_done_cb};
+  err = rmt_rx_register_event_callbacks(ch->channel, &cbs, ch);
+  if (err == ESP_OK)
+  {
+    err = rmt_enable(ch->channel);
+  }
+  if (err != ESP_OK)
+  {
+    js_rmt_close(ch);
+    return err;
+  }
+
+  *out_channel = ch;
+  return ESP_OK;
+}
+
+static void collect_tx_done(js_rmt_channel_t *ch);
+
+/**
+ * @brief Reserves the next pending-transmission slot, or NULL if the queue is full.
+ */
+static js_rmt_tx_slot_t *reserve_tx_slot(js_rmt_channel_t *ch)
+{
+  if (ch->kind != JS_RMT_TX)
+  {
+    return NULL;
+  }
+  collect_tx_done(ch); // In case their event was lost to a full queue
+  if (ch->tx_count >= JS_RMT_TX_QUEUE_DEPTH)
+  {
+    return NULL;
+  }
+  return &ch->tx_slots[(ch->tx_head + ch->tx_count) % JS_RMT_TX_QUEUE_DEPTH];
+}
+
+/**
+ * @brief Hands a payload to the driver and commits the reserved slot on success.
+ */
+static esp_err_t commit_tx(js_rmt_channel_t *ch, js_rmt_tx_slot_t *slot, rmt_encoder_handle_t encoder,
+                           const void *payload, size_t payload_bytes,
+                           jerry_value_t buffer, jerry_value_t promise)
+{
+  rmt_transmit_config_t tx_config = {
+      .loop_count = 0,
+  };
+  esp_err_t err = rmt_transmit(ch->channel, encoder, payload, payload_bytes, &tx_config);
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+  slot->buffer = jerry_value_copy(buffer);
+  slot->promise = jerry_value_copy(promise);
+  ch->tx_count++;
+  return ESP_OK;
+}
+
+/**
+ * @brief Queues a prebuilt symbol buffer for transmission without copying it.
+ */
+esp_err_t js_rmt_transmit_symbols(js_rmt_channel_t *ch, jerry_value_t buffer,
+                                  const rmt_symbol_word_t *symbols, size_t count,
+                                  jerry_value_t promise)
+{
+  js_rmt_tx_slot_t *slot = reserve_tx_slot(ch);
+  if (!slot)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+  return commit_tx(ch, slot, ch->copy_encoder, symbols, count * sizeof(rmt_symbol_word_t), buffer, promise);
+}
+
+/**
+ * @brief Queues GRB pixel bytes for transmission with the WS2812 bit encoder.
+ */
+esp_err_t js_rmt_transmit_ws2812(js_rmt_channel_t *ch, jerry_value_t buffer,
+                                 const uint8_t *pixels, size_t length,
+                                 jerry_value_t promise)
+{
+  js_rmt_tx_slot_t *slot = reserve_tx_slot(ch);
+  if (!slot)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  // The bit encoder depends on the channel resolution, so build it on first use.
+  if (ch->ws2812_encoder == NULL)
+  {
+    rmt_bytes_encoder_config_t config = {
+        .bit0 = {
+            .level0 = 1,
+            .duration0 = ns_to_ticks(ch->resolution_hz, WS2812_T0H_NS),
+            .level1 = 0,
+            .duration1 = ns_to_ticks(ch->resolution_hz, WS2812_T0L_NS),
+        },
+        .bit1 = {
+            .level0 = 1,
+            .duration0 = ns_to_ticks(ch->resolution_hz, WS2812_T1H_NS),
+            .level1 = 0,
+            .duration1 = ns_to_ticks(ch->resolution_hz, WS2812_T1L_NS),
+        },
+        .flags.msb_first = 1,
+    };
+    esp_err_t err = rmt_new_bytes_encoder(&config, &ch->ws2812_encoder);
+    if (err != ESP_OK)
+    {
+      return err;
+    }
+  }
+
+  return commit_tx(ch, slot, ch->ws2812_encoder, pixels, length, buffer, promise);
+}
+
+/**
+ * @brief Builds one NEC symbol from a high and a low duration in microseconds.
+ */
+static rmt_symbol_word_t nec_symbol(uint32_t resolution_hz, uint32_t high_us, uint32_t low_us)
+{
+  rmt_symbol_word_t symbol = {
+      .level0 = 1,
+      .duration0 = ns_to_ticks(resolution_hz, high_us * 1000),
+      .level1 = 0,
+      .duration1 = ns_to_ticks(resolution_hz, low_us * 1000),
+  };
+  return symbol;
+}
+
+/**
+ * @brief Encodes and queues a NEC infrared frame.
+ */
+esp_err_t js_rmt_transmit_nec(js_rmt_channel_t *ch, uint16_t address, uint8_t command,
+                              jerry_value_t promise)
+{
+  js_rmt_tx_slot_t *slot = reserve_tx_slot(ch);
+  if (!slot)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  // Standard NEC sends the address and its inverse; extended NEC sends 16 address bits.
+  uint32_t data = (address > 0xFF) ? address : (uint32_t)((address & 0xFF) | ((~address & 0xFF) << 8));
+  data |= (uint32_t)command << 16;
+  data |= (uint32_t)(~command & 0xFF) << 24;
+
+  size_t n = 0;
+  slot->symbols[n++] = nec_symbol(ch->resolution_hz, NEC_LEADING_HIGH_US, NEC_LEADING_LOW_US);
+  for (int bit = 0; bit < 32; bit++) // LSB first
+  {
+    uint32_t low_us = ((data >> bit) & 1) ? NEC_ONE_LOW_US : NEC_PULSE_US;
+    slot->symbols[n++] = nec_symbol(ch->resolution_hz, NEC_PULSE_US, low_us);
+  }
+  slot->symbols[n++] = nec_symbol(ch->resolution_hz, NEC_PULSE_US, 0);
+
+  return commit_tx(ch, slot, ch->copy_encoder, slot->symbols, n * sizeof(rmt_symbol_word_t),
+                   jerry_undefined(), promise);
+}
+
+/**
+ * @brief Arms the driver to capture the next frame into the channel's buffer,
+ * unless a receive is armed already.
+ */
+static esp_err_t arm_receive(js_rmt_channel_t *ch)
+{
+  if (ch->rx_armed)
+  {
+    return ESP_OK;
+  }
+  esp_err_t err = rmt_receive(ch->channel, ch->rx_buffer, ch->rx_buffer_symbols * sizeof(rmt_symbol_word_t),
+                              &ch->rx_config);
+  ch->rx_armed = err == ESP_OK;
+  return err;
+}
+
+/**
+ * @brief Starts continuous frame capture, calling `callback` once per frame.
+ */
+esp_err_t js_rmt_start_receive(js_rmt_channel_t *ch, jerry_value_t callback)
+{
+  if (ch->kind != JS_RMT_RX)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  if (jerry_value_is_function(ch->js_rx_callback))
+  {
+    jerry_value_free(ch->js_rx_callback);
+  }
+  ch->js_rx_callback = jerry_value_copy(callback);
+
+  // A receive armed before stop() is still waiting for its frame; reuse it.
+  esp_err_t err = arm_receive(ch);
+  ch->rx_active = err == ESP_OK;
+  return err;
+}
+
+/**
+ * @brief Stops frame capture after the frame currently being received.
+ *
+ * The driver cannot cancel an armed receive, so it stays armed; a frame it
+ * captures while stopped is dropped and not re-armed.
+ */
+void js_rmt_stop_receive(js_rmt_channel_t *ch)
+{
+  ch->rx_active = false;
+  if (jerry_value_is_function(ch->js_rx_callback))
+  {
+    jerry_value_free(ch->js_rx_callback);
+    ch->js_rx_callback = jerry_undefined();
+  }
+}
+
+/**
+ * @brief Releases the oldest pending transmission, resolving its promise if `settle`.
+ */
+static void complete_tx_slot(js_rmt_channel_t *ch, bool settle)
+{
+  js_rmt_tx_slot_t *slot = &ch->tx_slots[ch->tx_head];
+  if (settle)
+  {
+    jerry_value_t undefined = jerry_undefined();
+    jerry_value_free(jerry_promise_resolve(slot->promise, undefined));
+    jerry_value_free(undefined);
+  }
+  jerry_value_free(slot->promise);
+  jerry_value_free(slot->buffer);
+  slot->promise = jerry_undefined();
+  slot->buffer = jerry_undefined();
+
+  ch->tx_head = (ch->tx_head + 1) % JS_RMT_TX_QUEUE_DEPTH;
+  ch->tx_count--;
+}
+
+/**
+ * @brief Resolves the transmissions the driver has finished since the last call.
+ */
+static void collect_tx_done(js_rmt_channel_t *ch)
+{
+  uint8_t done = __atomic_exchange_n(&ch->tx_done, 0, __ATOMIC_ACQUIRE);
+  while (done-- > 0 && ch->tx_count > 0)
+  {
+    complete_tx_slot(ch, true);
+  }
+}
+
+static void release_channel(js_rmt_channel_t *ch, bool settle)
+{
+  if (ch->kind == JS_RMT_UNUSED)
+  {
+    return;
+  }
+
+  if (ch->channel)
+  {
+    if (ch->kind == JS_RMT_TX)
+    {
+      rmt_tx_wait_all_done(ch->channel, 100);
+    }
+    rmt_disable(ch->channel);
+    rmt_del_channel(ch->channel);
+  }
+  if (ch->copy_encoder)
+  {
+    rmt_del_encoder(ch->copy_encoder);
+  }
+  if (ch->ws2812_encoder)
+  {
+    rmt_del_encoder(ch->ws2812_encoder);
+  }
+  while (ch->tx_count > 0)
+  {
+    complete_tx_slot(ch, settle);
+  }
+  js_rmt_stop_receive(ch);
+  free(ch->rx_buffer);
+
+  ESP_LOGD(TAG, "Closed RMT channel on pin %d", ch->pin_num);
+  memset(ch, 0, sizeof(*ch));
+  ch->kind = JS_RMT_UNUSED;
+  ch->js_rx_callback = jerry_undefined();
+}
+
+/**
+ * @brief Releases the channel, resolving any transmissions still pending.
+ */
+void js_rmt_close(js_rmt_channel_t *ch)
+{
+  release_channel(ch, true);
+}
+
+/**
+ * @brief Releases the channel without settling pending transmissions.
+ */
+void js_rmt_release(js_rmt_channel_t *ch)
+{
+  release_channel(ch, false);
+}
+
+/**
+ * @brief Hands a captured frame to JS as a Uint32Array and re-arms the receiver.
+ */
+static void deliver_frame(js_rmt_channel_t *ch, size_t num_symbols)
+{
+  ch->rx_armed = false; // The driver finished this receive
+  if (!ch->rx_active || !jerry_value_is_function(ch->js_rx_callback))
+  {
+    return;
+  }
+
+  jerry_value_t symbols = jerry_typedarray(JERRY_TYPEDARRAY_UINT32, num_symbols);
+  jerry_length_t offset = 0;
+  jerry_length_t length = 0;
+  jerry_value_t array_buffer = jerry_typedarray_buffer(symbols, &offset, &length);
+  jerry_arraybuffer_write(array_buffer, offset, (const uint8_t *)ch->rx_buffer, length);
+  jerry_value_free(array_buffer);
+
+  // Re-arm before running JS so the next frame is not lost while the callback runs.
+  arm_receive(ch);
+
+  // Hold our own reference: the callback may close the channel or replace itself.
+  jerry_value_t callback = jerry_value_copy(ch->js_rx_callback);
+  jerry_value_t global = jerry_current_realm();
+  jerry_value_t res = jerry_call(callback, global, &symbols, 1);
+  jerry_value_free(global);
+  jerry_value_free(callback);
+  if (jerry_value_is_exception(res))
+  {
+    print_js_error(res);
+  }
+  jerry_value_free(res);
+  jerry_value_free(symbols);
+}
+
+/**
+ * @brief Handles every completion recorded in the channel.
+ */
+static void collect(js_rmt_channel_t *ch)
+{
+  ch->event_pending = false; // Before reading, so a completion from now on posts again
+  if (ch->kind == JS_RMT_TX)
+  {
+    collect_tx_done(ch);
+  }
+  else if (__atomic_exchange_n(&ch->rx_done, false, __ATOMIC_ACQUIRE))
+  {
+    deliver_frame(ch, ch->rx_symbols);
+  }
+}
+
+/**
+ * @brief Dispatches an RMT event from the main JS event loop.
+ */
+void js_rmt_dispatch_event(js_event_t *event)
+{
+  // A closed channel is not an error: it was closed after the event was queued.
+  js_rmt_channel_t *ch = lookup_channel(event->handle_id);
+  if (ch)
+  {
+    collect(ch);
+  }
+
+  // Completions whose event did not fit in the queue wait in their channel.
+  for (int i = 0; i < JS_RMT_MAX_CHANNELS; i++)
+  {
+    js_rmt_channel_t *other = &channels[i];
+    if (other->kind != JS_RMT_UNUSED && !other->event_pending && (other->tx_done > 0 || other->rx_done))
+    {
+      collect(other);
+    }
+  }
+}
+
+/**
+ * @brief Decodes a captured NEC frame.
+ */
+bool js_rmt_decode_nec(const rmt_symbol_word_t *symbols, size_t count, uint32_t resolution_hz,
+                       js_rmt_nec_frame_t *out_frame)
+{
+  if (count < 2 || !within_tolerance(ticks_to_us(resolution_hz, symbols[0].duration0), NEC_LEADING_HIGH_US))
+  {
+    return false;
+  }
+
+  uint32_t second_us = ticks_to_us(resolution_hz, symbols[0].duration1);
+  if (within_tolerance(second_us, NEC_REPEAT_LOW_US))
+  {
+    out_frame->address = 0;
+    out_frame->command = 0;
+    out_frame->repeat = true;
+    return true;
+  }
+  if (count < 33 || !within_tolerance(second_us, NEC_LEADING_LOW_US))
+  {
+    return false;
+  }
+
+  uint32_t data = 0;
+  for (int bit = 0; bit < 32; bit++)
+  {
+    const rmt_symbol_word_t *s = &symbols[bit + 1];
+    uint32_t low_us = ticks_to_us(resolution_hz, s->duration1);
+    if (!within_tolerance(ticks_to_us(resolution_hz, s->duration0), NEC_PULSE_US))
+    {
+      return false;
+    }
+    if (within_tolerance(low_us, NEC_ONE_LOW_US))
+    {
+      data |= 1UL << bit;
+    }
+    else if (!within_tolerance(low_us, NEC_PULSE_US))
+    {
+      return false;
+    }
+  }
+
+  uint8_t command = (data >> 16) & 0xFF;
+  if ((uint8_t)~command != ((data >> 24) & 0xFF))
+  {
+    return false;
+  }
+  uint8_t addr_lo = data & 0xFF;
+  uint8_t addr_hi = (data >> 8) & 0xFF;
+  out_frame->address = ((uint8_t)~addr_lo == addr_hi) ? addr_lo : (uint16_t)(data & 0xFFFF);
+  out_frame->command = command;
+  out_frame->repeat = false;
+  return true;
+}
+
+/**
+ * @brief Decodes a captured DHT22 response into tenths of a unit.
+ *
+ * Each data bit is a ~50us low followed by a high whose length encodes the bit.
+ * Only the last 40 such symbols are used, so the host start pulse and the
+ * sensor's response preamble may be present in the capture.
+ */
+bool js_rmt_decode_dht22(const rmt_symbol_word_t *symbols, size_t count, uint32_t resolution_hz,
+                         int16_t *out_humidity_x10, int16_t *out_temperature_x10)
+{
+  uint64_t bits = 0;
+  int found = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    uint32_t low_us = ticks_to_us(resolution_hz, symbols[i].duration0);
+    uint32_t high_us = ticks_to_us(resolution_hz, symbols[i].duration1);
+    if (low_us < DHT22_BIT_LOW_MIN_US || low_us > DHT22_BIT_LOW_MAX_US || high_us == 0)
+    {
+      continue;
+    }
+    bits = (bits << 1) | (high_us >= DHT22_ONE_HIGH_MIN_US ? 1 : 0);
+    found++;
+  }
+  if (found < DHT22_DATA_BITS)
+  {
+    return false;
+  }
+
+  uint8_t bytes[5];
+  for (int i = 0; i < 5; i++)
+  {
+    bytes[i] = (bits >> (8 * (4 - i))) & 0xFF;
+  }
+  if ((uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]) != bytes[4])
+  {
+    return false;
+  }
+
+  *out_humidity_x10 = (int16_t)((bytes[0] << 8) | bytes[1]);
+  int16_t temperature = (int16_t)(((bytes[2] & 0x7F) << 8) | bytes[3]);
+  *out_temperature_x10 = (bytes[2] & 0x80) ? -temperature : temperature;
+  return true;
+}
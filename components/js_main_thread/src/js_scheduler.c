@@ -0,0 +1,219 @@
+#include "esp_log.h"
+
+#include "js_scheduler.h"
+#include "js_main_thread.h" // for print_js_error
+#include "js_watchdog.h"
+#include "js_worker.h"      // for js_context_index
+
+static const char *TAG = "JS_SCHEDULER";
+
+/**
+ * @brief A ring of JS values waiting to run. Only its context's thread touches it.
+ */
+typedef struct
+{
+  jerry_value_t values[JS_SCHEDULER_IMMEDIATE_DEPTH];
+  uint32_t ids[JS_SCHEDULER_IMMEDIATE_DEPTH]; /**< 0 marks a cleared slot. */
+  uint32_t head;
+  uint32_t count;
+} js_ring_t;
+
+typedef struct
+{
+  js_ring_t immediates; /**< Functions to call, or promises to resolve for yield(). */
+  uint32_t next_id;
+} js_scheduler_t;
+
+static js_scheduler_t schedulers[JS_MAX_CONTEXTS];
+
+static bool ring_push(js_ring_t *ring, uint32_t depth, jerry_value_t value, uint32_t id)
+{
+  if (ring->count == depth)
+  {
+    return false;
+  }
+  uint32_t slot = (ring->head + ring->count) % depth;
+  ring->values[slot] = jerry_value_copy(value);
+  ring->ids[slot] = id;
+  ring->count++;
+  return true;
+}
+
+/**
+ * @brief Removes the oldest value; the caller owns it.
+ */
+static jerry_value_t ring_shift(js_ring_t *ring, uint32_t depth, uint32_t *id)
+{
+  jerry_value_t value = ring->values[ring->head];
+  *id = ring->ids[ring->head];
+  ring->head = (ring->head + 1) % depth;
+  ring->count--;
+  return value;
+}
+
+static void ring_clear(js_ring_t *ring, uint32_t depth)
+{
+  uint32_t id;
+  while (ring->count > 0)
+  {
+    jerry_value_free(ring_shift(ring, depth, &id));
+  }
+  ring->head = 0;
+}
+
+/**
+ * @brief Calls a queued callback with no arguments and reports what it throws.
+ */
+static void call_queued(jerry_value_t callback)
+{
+  jerry_value_t global = jerry_current_realm();
+  jerry_value_t res = jerry_call(callback, global, NULL, 0);
+  jerry_value_free(global);
+  if (jerry_value_is_exception(res))
+  {
+    print_js_error(res);
+  }
+  jerry_value_free(res);
+}
+
+void js_scheduler_init(void)
+{
+  js_scheduler_t *scheduler = &schedulers[js_context_index()];
+  scheduler->immediates.head = scheduler->immediates.count = 0;
+  scheduler->next_id = 1;
+}
+
+uint32_t js_scheduler_set_immediate(jerry_value_t callback)
+{
+  js_scheduler_t *scheduler = &schedulers[js_context_index()];
+  uint32_t id = scheduler->next_id;
+  if (!ring_push(&scheduler->immediates, JS_SCHEDULER_IMMEDIATE_DEPTH, callback, id))
+  {
+    return 0;
+  }
+  scheduler->next_id = id + 1 ? id + 1 : 1; // 0 means cleared
+  return id;
+}
+
+bool js_scheduler_clear_immediate(uint32_t id)
+{
+  js_ring_t *ring = &schedulers[js_context_index()].immediates;
+  for (uint32_t i = 0; i < ring->count && id != 0; i++)
+  {
+    uint32_t slot = (ring->head + i) % JS_SCHEDULER_IMMEDIATE_DEPTH;
+    if (ring->ids[slot] == id)
+    {
+      // The slot stays in the ring, and is skipped when its turn comes.
+      jerry_value_free(ring->values[slot]);
+      ring->values[slot] = jerry_undefined();
+      ring->ids[slot] = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+esp_err_t js_scheduler_yield(jerry_value_t promise)
+{
+  js_scheduler_t *scheduler = &schedulers[js_context_index()];
+  // yield() is never cleared, so its slot carries no ID of its own.
+  return ring_push(&scheduler->immediates, JS_SCHEDULER_IMMEDIATE_DEPTH, promise, UINT32_MAX) ? ESP_OK
+                                                                                               : ESP_ERR_NO_MEM;
+}
+
+/**
+ * @brief Rejection handler of a microtask: reports what its callback threw.
+ */
+static jerry_value_t report_microtask_error(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                                            const jerry_length_t argc)
+{
+  jerry_value_t error = jerry_throw_value(argc > 0 ? jerry_value_copy(args[0]) : jerry_undefined(), true);
+  print_js_error(error);
+  jerry_value_free(error);
+  return jerry_undefined();
+}
+
+/**
+ * @brief Calls `promise[name](arg)`.
+ */
+static jerry_value_t promise_invoke(jerry_value_t promise, const char *name, jerry_value_t arg)
+{
+  jerry_value_t method = jerry_object_get_sz(promise, name);
+  jerry_value_t result = jerry_call(method, promise, &arg, 1);
+  jerry_value_free(method);
+  return result;
+}
+
+esp_err_t js_scheduler_queue_microtask(jerry_value_t callback)
+{
+  // A reaction to a promise that is already resolved is queued as a promise
+  // job, so microtasks keep their order among the promise jobs and the
+  // engine heap is the only limit on how many wait.
+  jerry_value_t resolved = jerry_promise();
+  jerry_value_t undefined = jerry_undefined();
+  jerry_value_free(jerry_promise_resolve(resolved, undefined));
+
+  jerry_value_t job = promise_invoke(resolved, "then", callback);
+  jerry_value_free(resolved);
+  if (jerry_value_is_exception(job))
+  {
+    jerry_value_free(job);
+    return ESP_ERR_NO_MEM;
+  }
+
+  jerry_value_t reporter = jerry_function_external(report_microtask_error);
+  jerry_value_t caught = promise_invoke(job, "catch", reporter);
+  jerry_value_free(reporter);
+  jerry_value_free(job);
+  bool queued = !jerry_value_is_exception(caught);
+  jerry_value_free(caught);
+  return queued ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+void js_scheduler_run_jobs(void)
+{
+  // Microtasks are promise jobs too, so this runs them in the order queued.
+  jerry_value_t res = jerry_run_jobs();
+  if (jerry_value_is_exception(res))
+  {
+    print_js_error(res);
+  }
+  jerry_value_free(res);
+}
+
+bool js_scheduler_has_immediates(void)
+{
+  return schedulers[js_context_index()].immediates.count > 0;
+}
+
+void js_scheduler_run_immediates(void)
+{
+  js_ring_t *ring = &schedulers[js_context_index()].immediates;
+  uint32_t round = ring->count;
+  while (round-- > 0 && ring->count > 0)
+  {
+    uint32_t id;
+    jerry_value_t value = ring_shift(ring, JS_SCHEDULER_IMMEDIATE_DEPTH, &id);
+    js_watchdog_arm();
+    if (jerry_value_is_promise(value))
+    {
+      jerry_value_free(jerry_promise_resolve(value, jerry_undefined()));
+    }
+    else if (id != 0)
+    {
+      call_queued(value);
+    }
+    jerry_value_free(value);
+
+    // Promise jobs and microtasks run between immediates, as after any callback.
+    js_scheduler_run_jobs();
+    js_watchdog_disarm();
+  }
+}
+
+void js_scheduler_clear_all(void)
+{
+  js_scheduler_t *scheduler = &schedulers[js_context_index()];
+  ring_clear(&scheduler->immediates, JS_SCHEDULER_IMMEDIATE_DEPTH);
+  ESP_LOGD(TAG, "Cleared scheduler queues");
+}
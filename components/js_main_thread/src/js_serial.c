@@ -0,0 +1,444 @@
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#include "js_serial.h"
+#include "js_main_thread.h" // For js_event_queue and print_js_error
+
+static const char *TAG = "JS_SERIAL_ENGINE";
+
+/// @brief Port states, indexed by UART number.
+static js_serial_port_t ports[JS_SERIAL_MAX_PORTS];
+
+/// @brief Incremented on every open so a reopened port gets a new handle.
+static uint32_t next_generation = 1;
+
+/**
+ * @brief Posts a serial event for a port from the reader task.
+ */
+static void post_event(js_serial_port_t *port, js_serial_event_kind_t kind)
+{
+  js_event_t ev = {
+      .type = JS_EVENT_SERIAL,
+      .handle_id = port->handle_id,
+      .data = (void *)(uintptr_t)kind,
+  };
+  xQueueSend(js_event_queue, &ev, portMAX_DELAY);
+}
+
+/**
+ * @brief Wakes the reader task so it notices a changed flag.
+ */
+static void wake_reader(js_serial_port_t *port)
+{
+  uart_event_t wake = {.type = UART_EVENT_MAX};
+  xQueueSend(port->uart_queue, &wake, 0);
+}
+
+/**
+ * @brief Forwards driver events to the JS event queue.
+ *
+ * Bursts of driver events collapse into one pending data event, so a fast
+ * stream costs one JS callback per batch rather than per FIFO interrupt.
+ */
+static void serial_reader_task(void *params)
+{
+  js_serial_port_t *port = (js_serial_port_t *)params;
+  uart_port_t uart = port->config.port;
+  uart_event_t ev;
+
+  while (!port->closing)
+  {
+    TickType_t wait = port->want_drain ? pdMS_TO_TICKS(JS_SERIAL_DRAIN_POLL_MS) : portMAX_DELAY;
+    if (xQueueReceive(port->uart_queue, &ev, wait) == pdTRUE)
+    {
+      switch (ev.type)
+      {
+      case UART_DATA:
+      case UART_PATTERN_DET:
+        break;
+
+      case UART_FIFO_OVF:
+      case UART_BUFFER_FULL:
+        // JS fell behind: drop what is buffered so reception can resume.
+        port->overruns++;
+        uart_flush_input(uart);
+        xQueueReset(port->uart_queue);
+        continue;
+
+      default:
+        continue;
+      }
+
+      if (!port->rx_pending && !port->closing)
+      {
+        port->rx_pending = true;
+        post_event(port, JS_SERIAL_EVENT_DATA);
+      }
+    }
+
+    if (port->want_drain && !port->closing)
+    {
+      size_t free_space = 0;
+      uart_get_tx_buffer_free_size(uart, &free_space);
+      if (free_space >= JS_SERIAL_TX_BUFFER / 2)
+      {
+        port->want_drain = false;
+        post_event(port, JS_SERIAL_EVENT_DRAIN);
+      }
+    }
+  }
+
+  uart_driver_delete(uart); // Also deletes uart_queue
+  port->in_use = false;
+  ESP_LOGD(TAG, "Serial reader for UART%d exited.", uart);
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief Installs the UART driver on a port and starts its reader task.
+ */
+esp_err_t js_serial_open(const js_serial_config_t *config, jerry_value_t data_callback, js_serial_port_t **out_port)
+{
+  // UART0 carries the console and the log output.
+  if (config->port < 0 || config->port >= JS_SERIAL_MAX_PORTS || config->port == CONFIG_ESP_CONSOLE_UART_NUM)
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  js_serial_port_t *port = &ports[config->port];
+  if (port->in_use)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  memset(port, 0, sizeof(*port));
+  port->config = *config;
+  port->handle_id = (next_generation++ << 8) | (uint32_t)config->port;
+  port->js_data_callback = jerry_undefined();
+  port->drain_promise = jerry_undefined();
+
+  if (config->delimiter_len > 0)
+  {
+    port->frame = (uint8_t *)malloc(config->max_frame);
+    if (!port->frame)
+    {
+      return ESP_ERR_NO_MEM;
+    }
+  }
+
+  esp_err_t err = uart_driver_install(config->port, JS_SERIAL_RX_BUFFER, JS_SERIAL_TX_BUFFER,
+                                      JS_SERIAL_UART_QUEUE_DEPTH, &port->uart_queue, 0);
+  if (err == ESP_OK)
+  {
+    err = uart_param_config(config->port, &config->uart);
+  }
+  if (err == ESP_OK)
+  {
+    err = uart_set_pin(config->port, config->tx, config->rx, config->rts, config->cts);
+  }
+  if (err == ESP_OK &&
+      xTaskCreate(serial_reader_task, "js_serial", JS_SERIAL_READER_STACK, port, JS_SERIAL_READER_PRIORITY,
+                  &port->reader) != pdPASS)
+  {
+    err = ESP_ERR_NO_MEM;
+  }
+  if (err != ESP_OK)
+  {
+    ESP_LOGE(TAG, "Failed to open UART%d: %s", config->port, esp_err_to_name(err));
+    if (port->uart_queue)
+    {
+      uart_driver_delete(config->port);
+    }
+    free(port->frame);
+    port->frame = NULL;
+    return err;
+  }
+
+  port->js_data_callback = jerry_value_copy(data_callback);
+  port->in_use = true;
+  *out_port = port;
+  return ESP_OK;
+}
+
+/**
+ * @brief Queues bytes for transmission without blocking.
+ */
+size_t js_serial_write(js_serial_port_t *port, const uint8_t *data, size_t len)
+{
+  size_t free_space = 0;
+  uart_get_tx_buffer_free_size(port->config.port, &free_space);
+  size_t accepted = len < free_space ? len : free_space;
+  if (accepted > 0)
+  {
+    uart_write_bytes(port->config.port, data, accepted);
+  }
+
+  if (accepted < len && !port->want_drain)
+  {
+    port->want_drain = true;
+    wake_reader(port); // Start polling for space
+  }
+  return accepted;
+}
+
+/**
+ * @brief Returns a promise resolved once the TX buffer has room again.
+ */
+jerry_value_t js_serial_drain(js_serial_port_t *port)
+{
+  if (!port->want_drain)
+  {
+    jerry_value_t promise = jerry_promise();
+    jerry_value_t undefined = jerry_undefined();
+    jerry_value_free(jerry_promise_resolve(promise, undefined));
+    return promise;
+  }
+  if (jerry_value_is_undefined(port->drain_promise))
+  {
+    port->drain_promise = jerry_promise();
+  }
+  return jerry_value_copy(port->drain_promise);
+}
+
+/**
+ * @brief Settles a pending drain promise, if any.
+ */
+static void settle_drain(js_serial_port_t *port)
+{
+  if (!jerry_value_is_undefined(port->drain_promise))
+  {
+    jerry_value_t undefined = jerry_undefined();
+    jerry_value_free(jerry_promise_resolve(port->drain_promise, undefined));
+    jerry_value_free(port->drain_promise);
+    port->drain_promise = jerry_undefined();
+  }
+}
+
+/**
+ * @brief Marks a port closing and hands it to the reader task to release.
+ */
+static void close_port(js_serial_port_t *port, bool settle)
+{
+  if (port->closing)
+  {
+    return;
+  }
+  port->closing = true;
+
+  if (settle)
+  {
+    // Nothing more will be written, so waiting writers can carry on.
+    settle_drain(port);
+  }
+  else
+  {
+    jerry_value_free(port->drain_promise);
+    port->drain_promise = jerry_undefined();
+  }
+  jerry_value_free(port->js_data_callback);
+  port->js_data_callback = jerry_undefined();
+  free(port->frame);
+  port->frame = NULL;
+
+  wake_reader(port);
+}
+
+/**
+ * @brief Closes a port. The driver is released by the reader task as it exits.
+ */
+void js_serial_close(js_serial_port_t *port)
+{
+  close_port(port, true);
+}
+
+/**
+ * @brief Closes a port without resolving a pending drain.
+ */
+void js_serial_release(js_serial_port_t *port)
+{
+  close_port(port, false);
+}
+
+/**
+ * @brief Hands one chunk or frame to the data callback.
+ */
+static void deliver(js_serial_port_t *port, jerry_value_t value)
+{
+  // Hold our own reference: the callback may close the port.
+  jerry_value_t callback = jerry_value_copy(port->js_data_callback);
+  jerry_value_t global = jerry_current_realm();
+  jerry_value_t res = jerry_call(callback, global, &value, 1);
+  jerry_value_free(global);
+  jerry_value_free(callback);
+  if (jerry_value_is_exception(res))
+  {
+    print_js_error(res);
+  }
+  jerry_value_free(res);
+  jerry_value_free(value);
+}
+
+/**
+ * @brief Wraps bytes as the value the data callback receives.
+ */
+static jerry_value_t make_frame_value(js_serial_port_t *port, const uint8_t *data, size_t len)
+{
+  if (port->config.as_string)
+  {
+    return jerry_string(data, len, JERRY_ENCODING_UTF8);
+  }
+  jerry_value_t buffer = jerry_arraybuffer(len);
+  jerry_arraybuffer_write(buffer, 0, data, len);
+  jerry_value_t view = jerry_typedarray_with_buffer(JERRY_TYPEDARRAY_UINT8, buffer);
+  jerry_value_free(buffer);
+  return view;
+}
+
+/**
+ * @brief Delivers everything buffered by the driver as unframed chunks.
+ *
+ * Bytes are read straight into the ArrayBuffer handed to JS.
+ */
+static void read_raw(js_serial_port_t *port)
+{
+  size_t available = 0;
+  uart_get_buffered_data_len(port->config.port, &available);
+
+  while (available > 0 && !port->closing)
+  {
+    jerry_value_t buffer = jerry_arraybuffer(available);
+    int n = uart_read_bytes(port->config.port, jerry_arraybuffer_data(buffer), available, 0);
+    if (n <= 0)
+    {
+      jerry_value_free(buffer);
+      return;
+    }
+
+    jerry_value_t value;
+    if (port->config.as_string)
+    {
+      value = jerry_string(jerry_arraybuffer_data(buffer), n, JERRY_ENCODING_UTF8);
+    }
+    else
+    {
+      value = jerry_typedarray_with_buffer_span(JERRY_TYPEDARRAY_UINT8, buffer, 0, n);
+    }
+    jerry_value_free(buffer);
+    deliver(port, value);
+
+    uart_get_buffered_data_len(port->config.port, &available);
+  }
+}
+
+/**
+ * @brief Reads buffered bytes into the frame buffer and delivers every complete frame.
+ */
+static void read_framed(js_serial_port_t *port)
+{
+  const uint8_t *delim = port->config.delimiter;
+  const size_t delim_len = port->config.delimiter_len;
+  const size_t max_frame = port->config.max_frame;
+
+  while (true)
+  {
+    size_t available = 0;
+    uart_get_buffered_data_len(port->config.port, &available);
+    if (available == 0)
+    {
+      return;
+    }
+
+    size_t room = max_frame - port->frame_len;
+    int n = uart_read_bytes(port->config.port, port->frame + port->frame_len, available < room ? available : room, 0);
+    if (n <= 0)
+    {
+      return;
+    }
+
+    // Rescan the tail of the old data in case a delimiter straddles the reads.
+    size_t i = port->frame_len >= delim_len - 1 ? port->frame_len - (delim_len - 1) : 0;
+    size_t start = 0;
+    port->frame_len += n;
+
+    while (i + delim_len <= port->frame_len)
+    {
+      const uint8_t *hit = memchr(port->frame + i, delim[0], port->frame_len - i);
+      if (!hit)
+      {
+        break;
+      }
+      i = hit - port->frame;
+      if (i + delim_len > port->frame_len)
+      {
+        break;
+      }
+      if (memcmp(hit, delim, delim_len) != 0)
+      {
+        i++;
+        continue;
+      }
+
+      deliver(port, make_frame_value(port, port->frame + start, i - start));
+      if (port->closing)
+      {
+        return; // The frame buffer has been freed.
+      }
+      i += delim_len;
+      start = i;
+    }
+
+    if (start == 0 && port->frame_len == max_frame)
+    {
+      // No delimiter in a whole frame's worth of bytes: pass it on as is.
+      port->frame_len = 0;
+      deliver(port, make_frame_value(port, port->frame, max_frame));
+      if (port->closing)
+      {
+        return;
+      }
+    }
+    else if (start > 0)
+    {
+      memmove(port->frame, port->frame + start, port->frame_len - start);
+      port->frame_len -= start;
+    }
+  }
+}
+
+/**
+ * @brief Reads and frames pending bytes, or resolves a drain, for a JS_EVENT_SERIAL event.
+ */
+void js_serial_dispatch_event(js_event_t *event)
+{
+  uint32_t index = event->handle_id & 0xFF;
+  if (index >= JS_SERIAL_MAX_PORTS)
+  {
+    return;
+  }
+  js_serial_port_t *port = &ports[index];
+  if (!port->in_use || port->closing || port->handle_id != event->handle_id)
+  {
+    return; // Stale event for a closed port
+  }
+
+  if ((js_serial_event_kind_t)(uintptr_t)event->data == JS_SERIAL_EVENT_DRAIN)
+  {
+    settle_drain(port);
+    return;
+  }
+
+  // Clear first: bytes arriving from here on post a new event.
+  port->rx_pending = false;
+  if (port->config.delimiter_len > 0)
+  {
+    read_framed(port);
+  }
+  else
+  {
+    read_raw(port);
+  }
+}
@@ -0,0 +1,230 @@
+#include <string.h>
+#include "esp_log.h"
+
+#include "js_spi.h"
+#include "js_spi_backend.h"
+
+static const char *TAG = "JS_SPI_ENGINE";
+
+/// @brief Pool of buses, indexed by host number minus 2.
+static js_spi_bus_t buses[JS_SPI_MAX_BUSES];
+
+/// @brief Pool of device states.
+static js_spi_device_t devices[JS_SPI_MAX_DEVICES];
+
+/// @brief Incremented on every open so a reused pool slot gets a new handle.
+static uint32_t next_generation = 1;
+
+/**
+ * @brief Returns the device for an event handle, or NULL if it has since been closed.
+ */
+static js_spi_device_t *lookup_device(uint32_t handle_id)
+{
+  uint32_t index = handle_id & 0xFF;
+  if (index < JS_SPI_MAX_DEVICES && devices[index].in_use && devices[index].handle_id == handle_id)
+  {
+    return &devices[index];
+  }
+  return NULL;
+}
+
+/**
+ * @brief Releases a bus once it is closed and has no devices left.
+ */
+static void release_bus_if_unused(js_spi_bus_t *bus)
+{
+  if (bus->closing && bus->device_count == 0)
+  {
+    js_spi_backend_bus_close(bus);
+    ESP_LOGD(TAG, "Released SPI%d.", bus->host);
+    bus->in_use = false;
+  }
+}
+
+/**
+ * @brief Detaches a device that has no transfers in flight.
+ */
+static void release_device(js_spi_device_t *dev)
+{
+  js_spi_backend_device_close(dev);
+  dev->in_use = false;
+  dev->bus->device_count--;
+  release_bus_if_unused(dev->bus);
+}
+
+/**
+ * @brief Initializes the SPI management system.
+ */
+void js_spi_init(void)
+{
+  memset(buses, 0, sizeof(buses));
+  memset(devices, 0, sizeof(devices));
+}
+
+/**
+ * @brief Initialises a bus.
+ */
+esp_err_t js_spi_bus_open(const js_spi_bus_config_t *config, js_spi_bus_t **out_bus)
+{
+  int index = config->host - 2;
+  if (index < 0 || index >= JS_SPI_MAX_BUSES)
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  js_spi_bus_t *bus = &buses[index];
+  if (bus->in_use)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  memset(bus, 0, sizeof(*bus));
+  bus->host = config->host;
+  esp_err_t err = js_spi_backend_bus_open(bus, config);
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+
+  bus->in_use = true;
+  *out_bus = bus;
+  return ESP_OK;
+}
+
+/**
+ * @brief Closes a bus. It is released once all of its devices have closed.
+ */
+void js_spi_bus_close(js_spi_bus_t *bus)
+{
+  bus->closing = true;
+  release_bus_if_unused(bus);
+}
+
+/**
+ * @brief Adds a device to a bus.
+ */
+esp_err_t js_spi_device_open(js_spi_bus_t *bus, const js_spi_device_config_t *config, js_spi_device_t **out_device)
+{
+  if (bus->closing)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  for (int i = 0; i < JS_SPI_MAX_DEVICES; i++)
+  {
+    if (!devices[i].in_use)
+    {
+      js_spi_device_t *dev = &devices[i];
+      memset(dev, 0, sizeof(*dev));
+      dev->handle_id = (next_generation++ << 8) | (uint32_t)i;
+      dev->bus = bus;
+      dev->config = *config;
+
+      esp_err_t err = js_spi_backend_device_open(dev);
+      if (err != ESP_OK)
+      {
+        return err;
+      }
+
+      dev->in_use = true;
+      bus->device_count++;
+      *out_device = dev;
+      return ESP_OK;
+    }
+  }
+  return ESP_ERR_NOT_FOUND;
+}
+
+/**
+ * @brief Settles the transfers the backend has completed, oldest first.
+ */
+static void settle_completed(js_spi_device_t *dev)
+{
+  while (dev->count > 0 && __atomic_load_n(&dev->completed, __ATOMIC_ACQUIRE) > 0)
+  {
+    js_spi_transfer_t *transfer = &dev->transfers[dev->head];
+    esp_err_t err = js_spi_backend_complete(dev);
+    dev->head = (dev->head + 1) % JS_SPI_QUEUE_DEPTH;
+    dev->count--;
+
+    if (err == ESP_OK)
+    {
+      jerry_value_free(jerry_promise_resolve(transfer->promise, transfer->rx));
+    }
+    else
+    {
+      jerry_value_t error = jerry_error_sz(JERRY_ERROR_COMMON, esp_err_to_name(err));
+      jerry_value_free(jerry_promise_reject(transfer->promise, error));
+      jerry_value_free(error);
+    }
+    jerry_value_free(transfer->promise);
+    jerry_value_free(transfer->tx);
+    jerry_value_free(transfer->rx);
+
+    // Only now, so a completion from here on finds zero and posts again.
+    __atomic_sub_fetch(&dev->completed, 1, __ATOMIC_ACQ_REL);
+  }
+
+  if (dev->closing && dev->count == 0)
+  {
+    release_device(dev);
+  }
+}
+
+/**
+ * @brief Queues a transfer.
+ */
+esp_err_t js_spi_device_transfer(js_spi_device_t *device, const js_spi_transfer_t *transfer)
+{
+  settle_completed(device); // In case their event was lost to a full queue
+  if (device->count == JS_SPI_QUEUE_DEPTH)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+
+  size_t slot = (device->head + device->count) % JS_SPI_QUEUE_DEPTH;
+  device->transfers[slot] = *transfer;
+  esp_err_t err = js_spi_backend_queue(device, slot);
+  if (err != ESP_OK)
+  {
+    return err; // The slot was never counted, so the caller keeps its references.
+  }
+  device->count++;
+  return ESP_OK;
+}
+
+/**
+ * @brief Closes a device. Transfers already queued still complete.
+ */
+void js_spi_device_close(js_spi_device_t *device)
+{
+  if (device->closing)
+  {
+    return;
+  }
+  device->closing = true;
+  if (device->count == 0)
+  {
+    release_device(device);
+  }
+}
+
+/**
+ * @brief Settles the promises of every completed transfer of a device.
+ */
+void js_spi_dispatch_event(js_event_t *event)
+{
+  js_spi_device_t *dev = lookup_device(event->handle_id);
+  if (dev)
+  {
+    settle_completed(dev);
+  }
+
+  // Completions whose event did not fit in the queue wait in their device.
+  for (int i = 0; i < JS_SPI_MAX_DEVICES; i++)
+  {
+    if (devices[i].in_use && devices[i].completed > 0)
+    {
+      settle_completed(&devices[i]);
+    }
+  }
+}
@@ -0,0 +1,47 @@
+#ifndef JS_SPI_BACKEND_H
+#define JS_SPI_BACKEND_H
+
+#include "js_spi.h"
+
+/**
+ * @brief The operations the SPI engine needs from the underlying implementation.
+ *
+ * Either the IDF master driver or the loopback mock bus is linked in, selected
+ * by CONFIG_JS_SPI_MOCK_BUS. A backend completes transfers in queue order,
+ * counts each one in the device's `completed`, and posts a JS_EVENT_SPI
+ * carrying the device's handle_id when the count goes from 0 to 1. If that
+ * post fails the count is kept, and a later dispatch or transfer settles it.
+ */
+
+/**
+ * @brief Acquires the controller for `bus` and stores backend state in `bus->backend`.
+ */
+esp_err_t js_spi_backend_bus_open(js_spi_bus_t *bus, const js_spi_bus_config_t *config);
+
+/**
+ * @brief Releases the controller.
+ */
+void js_spi_backend_bus_close(js_spi_bus_t *bus);
+
+/**
+ * @brief Attaches a device and stores backend state in `device->backend`.
+ */
+esp_err_t js_spi_backend_device_open(js_spi_device_t *device);
+
+/**
+ * @brief Detaches a device. Only called once no transfers are in flight.
+ */
+void js_spi_backend_device_close(js_spi_device_t *device);
+
+/**
+ * @brief Starts the transfer held in ring slot `slot` without waiting for it.
+ */
+esp_err_t js_spi_backend_queue(js_spi_device_t *device, size_t slot);
+
+/**
+ * @brief Reclaims the oldest completed transfer from the backend. Only
+ * called once the transfer has been counted in `completed`.
+ */
+esp_err_t js_spi_backend_complete(js_spi_device_t *device);
+
+#endif /* JS_SPI_BACKEND_H */
@@ -0,0 +1,216 @@
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "driver/spi_master.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_memory_utils.h"
+
+#include "js_spi_backend.h"
+#include "js_main_thread.h" // For js_event_queue
+
+static const char *TAG = "JS_SPI_MASTER";
+
+/**
+ * @brief Driver state for one device.
+ *
+ * The driver keeps a pointer to each queued spi_transaction_t until its
+ * result is fetched, so there is one per ring slot of the device, along with
+ * the bounce buffers of that slot's transfer, if it needed any.
+ */
+typedef struct
+{
+  spi_device_handle_t handle;
+  spi_transaction_t trans[JS_SPI_QUEUE_DEPTH];
+  uint8_t *tx_bounce[JS_SPI_QUEUE_DEPTH];
+  uint8_t *rx_bounce[JS_SPI_QUEUE_DEPTH];
+} spi_master_device_t;
+
+static inline spi_host_device_t to_idf_host(int host)
+{
+  return host == 3 ? SPI3_HOST : SPI2_HOST;
+}
+
+/**
+ * @brief Whether the DMA engine can use a buffer in place.
+ *
+ * Receives are written in whole words, so their length must be a multiple of
+ * the alignment too, or the last word would run past the JS buffer.
+ */
+static bool dma_usable(const void *data, size_t len, bool rx)
+{
+  if (!esp_ptr_dma_capable(data) || ((uintptr_t)data % JS_SPI_DMA_ALIGNMENT) != 0)
+  {
+    return false;
+  }
+  return !rx || len % JS_SPI_DMA_ALIGNMENT == 0;
+}
+
+/**
+ * @brief Allocates a word-aligned DMA buffer of at least `len` bytes.
+ */
+static uint8_t *alloc_bounce(size_t len)
+{
+  size_t padded = (len + JS_SPI_DMA_ALIGNMENT - 1) & ~(size_t)(JS_SPI_DMA_ALIGNMENT - 1);
+  return (uint8_t *)heap_caps_aligned_alloc(JS_SPI_DMA_ALIGNMENT, padded, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+}
+
+static void free_bounce(spi_master_device_t *state, size_t slot)
+{
+  heap_caps_free(state->tx_bounce[slot]);
+  heap_caps_free(state->rx_bounce[slot]);
+  state->tx_bounce[slot] = NULL;
+  state->rx_bounce[slot] = NULL;
+}
+
+/**
+ * @brief Counts a completion from the driver's interrupt handler, posting an
+ * event unless one is pending already.
+ */
+static void IRAM_ATTR post_trans_cb(spi_transaction_t *trans)
+{
+  js_spi_device_t *dev = (js_spi_device_t *)trans->user;
+  if (__atomic_fetch_add(&dev->completed, 1, __ATOMIC_ACQ_REL) != 0)
+  {
+    return;
+  }
+  js_event_t ev = {
+      .type = JS_EVENT_SPI,
+      .handle_id = dev->handle_id,
+      .data = NULL,
+  };
+  BaseType_t woke = pdFALSE;
+  xQueueSendFromISR(js_event_queue, &ev, &woke); // If full, the count waits for a later dispatch
+  if (woke == pdTRUE)
+  {
+    portYIELD_FROM_ISR();
+  }
+}
+
+esp_err_t js_spi_backend_bus_open(js_spi_bus_t *bus, const js_spi_bus_config_t *config)
+{
+  spi_bus_config_t bus_config = {
+      .mosi_io_num = config->mosi,
+      .miso_io_num = config->miso,
+      .sclk_io_num = config->sclk,
+      .quadwp_io_num = -1,
+      .quadhd_io_num = -1,
+      .max_transfer_sz = (int)config->max_transfer_size,
+  };
+  esp_err_t err = spi_bus_initialize(to_idf_host(bus->host), &bus_config, SPI_DMA_CH_AUTO);
+  if (err != ESP_OK)
+  {
+    ESP_LOGE(TAG, "Failed to initialise SPI%d: %s", bus->host, esp_err_to_name(err));
+  }
+  return err;
+}
+
+void js_spi_backend_bus_close(js_spi_bus_t *bus)
+{
+  spi_bus_free(to_idf_host(bus->host));
+}
+
+esp_err_t js_spi_backend_device_open(js_spi_device_t *device)
+{
+  spi_master_device_t *state = (spi_master_device_t *)calloc(1, sizeof(spi_master_device_t));
+  if (!state)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+
+  spi_device_interface_config_t dev_config = {
+      .mode = device->config.mode,
+      .clock_speed_hz = (int)device->config.frequency_hz,
+      .spics_io_num = device->config.cs,
+      .queue_size = JS_SPI_QUEUE_DEPTH,
+      .post_cb = post_trans_cb,
+  };
+  esp_err_t err = spi_bus_add_device(to_idf_host(device->bus->host), &dev_config, &state->handle);
+  if (err != ESP_OK)
+  {
+    free(state);
+    return err;
+  }
+
+  device->backend = state;
+  return ESP_OK;
+}
+
+void js_spi_backend_device_close(js_spi_device_t *device)
+{
+  spi_master_device_t *state = (spi_master_device_t *)device->backend;
+  spi_bus_remove_device(state->handle);
+  free(state);
+  device->backend = NULL;
+}
+
+esp_err_t js_spi_backend_queue(js_spi_device_t *device, size_t slot)
+{
+  spi_master_device_t *state = (spi_master_device_t *)device->backend;
+  const js_spi_transfer_t *transfer = &device->transfers[slot];
+
+  // JS buffers live wherever the engine heap does, often PSRAM, so only
+  // those the DMA engine cannot reach in place are copied.
+  const uint8_t *tx_data = transfer->tx_data;
+  uint8_t *rx_data = transfer->rx_data;
+  if (tx_data && !dma_usable(tx_data, transfer->length, false))
+  {
+    state->tx_bounce[slot] = alloc_bounce(transfer->length);
+    if (!state->tx_bounce[slot])
+    {
+      return ESP_ERR_NO_MEM;
+    }
+    memcpy(state->tx_bounce[slot], tx_data, transfer->length);
+    tx_data = state->tx_bounce[slot];
+  }
+  if (rx_data && !dma_usable(rx_data, transfer->rx_length, true))
+  {
+    state->rx_bounce[slot] = alloc_bounce(transfer->rx_length);
+    if (!state->rx_bounce[slot])
+    {
+      free_bounce(state, slot);
+      return ESP_ERR_NO_MEM;
+    }
+    rx_data = state->rx_bounce[slot];
+  }
+
+  spi_transaction_t *trans = &state->trans[slot];
+  *trans = (spi_transaction_t){
+      .length = transfer->length * 8,
+      .rxlength = transfer->rx_length * 8,
+      .tx_buffer = tx_data,
+      .rx_buffer = rx_data,
+      .user = device,
+  };
+  // The ring never holds more than queue_size transfers, so this never waits.
+  esp_err_t err = spi_device_queue_trans(state->handle, trans, 0);
+  if (err != ESP_OK)
+  {
+    free_bounce(state, slot);
+  }
+  return err;
+}
+
+esp_err_t js_spi_backend_complete(js_spi_device_t *device)
+{
+  spi_master_device_t *state = (spi_master_device_t *)device->backend;
+  spi_transaction_t *trans;
+  // post_cb runs just before the driver queues the result, so a counted
+  // transfer's result may still be an instant away.
+  esp_err_t err = spi_device_get_trans_result(state->handle, &trans, portMAX_DELAY);
+  if (err != ESP_OK)
+  {
+    return err;
+  }
+
+  size_t slot = (size_t)(trans - state->trans);
+  if (state->rx_bounce[slot])
+  {
+    const js_spi_transfer_t *transfer = &device->transfers[slot];
+    memcpy(transfer->rx_data, state->rx_bounce[slot], transfer->rx_length);
+  }
+  free_bounce(state, slot);
+  return ESP_OK;
+}
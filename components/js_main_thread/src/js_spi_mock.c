@@ -0,0 +1,83 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+#include "js_spi_backend.h"
+#include "js_spi_mock.h"
+#include "js_main_thread.h" // For js_event_queue
+
+static js_spi_mock_responder_t responder;
+
+/**
+ * @brief Default responder: MOSI wired to MISO, idle-high when nothing is sent.
+ */
+static void loopback(int host, gpio_num_t cs, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len)
+{
+  if (!rx)
+  {
+    return;
+  }
+  size_t echoed = tx ? (tx_len < rx_len ? tx_len : rx_len) : 0;
+  if (echoed > 0)
+  {
+    memmove(rx, tx, echoed);
+  }
+  memset(rx + echoed, 0xFF, rx_len - echoed);
+}
+
+void js_spi_mock_set_responder(js_spi_mock_responder_t fn)
+{
+  responder = fn;
+}
+
+esp_err_t js_spi_backend_bus_open(js_spi_bus_t *bus, const js_spi_bus_config_t *config)
+{
+  bus->backend = NULL;
+  return ESP_OK;
+}
+
+void js_spi_backend_bus_close(js_spi_bus_t *bus)
+{
+}
+
+esp_err_t js_spi_backend_device_open(js_spi_device_t *device)
+{
+  device->backend = NULL;
+  return ESP_OK;
+}
+
+void js_spi_backend_device_close(js_spi_device_t *device)
+{
+}
+
+esp_err_t js_spi_backend_queue(js_spi_device_t *device, size_t slot)
+{
+  const js_spi_transfer_t *transfer = &device->transfers[slot];
+  js_spi_mock_responder_t fn = responder ? responder : loopback;
+
+  // This runs on the JS thread, which is also the only reader of the event
+  // queue, so completion must be posted without waiting.
+  js_event_t ev = {
+      .type = JS_EVENT_SPI,
+      .handle_id = device->handle_id,
+      .data = NULL,
+  };
+  bool post = device->completed == 0;
+  if (post && uxQueueSpacesAvailable(js_event_queue) == 0)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  fn(device->bus->host, device->config.cs, transfer->tx_data, transfer->length,
+     transfer->rx_data, transfer->rx_length);
+  device->completed++;
+  if (post)
+  {
+    xQueueSend(js_event_queue, &ev, 0);
+  }
+  return ESP_OK;
+}
+
+esp_err_t js_spi_backend_complete(js_spi_device_t *device)
+{
+  return ESP_OK;
+}
@@ -0,0 +1,634 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+
+#include "js_storage.h"
+#include "js_main_thread.h" // For js_event_queue
+
+static const char *TAG = "JS_STORAGE";
+
+/**
+ * @brief A key held in RAM. Only the JS thread touches the cache.
+ *
+ * `blob` is the type tag followed by the value, exactly as it is stored in
+ * NVS, so a commit writes it without conversion.
+ */
+typedef struct
+{
+  char key[JS_STORAGE_MAX_KEY]; /**< Empty while the slot is free. */
+  uint8_t *blob;                /**< NULL if the key is known not to exist. */
+  size_t blob_len;
+  bool dirty;         /**< Changed since it was last handed to the commit task. */
+  uint32_t batch;     /**< Sequence number of the last commit it was part of, 0 if none. */
+  uint32_t last_used; /**< For evicting the least recently used clean entry. */
+} cache_entry_t;
+
+typedef struct
+{
+  char key[JS_STORAGE_MAX_KEY];
+  uint8_t *blob; /**< NULL erases the key. */
+  size_t blob_len;
+} commit_write_t;
+
+/**
+ * @brief Writes handed to the commit task as one NVS commit.
+ *
+ * The values are copies, so the cache can change while the task writes.
+ */
+typedef struct commit_batch
+{
+  struct commit_batch *next; /**< Next finished batch waiting for the JS thread. */
+  uint32_t seq;
+  bool wait;             /**< js_storage_flush() is blocked on `flush_done` and frees the batch itself. */
+  jerry_value_t promise; /**< Settled when the batch is dispatched; undefined if nobody waits. */
+  esp_err_t err;
+  size_t count;
+  commit_write_t writes[];
+} commit_batch_t;
+
+/// @brief Values of a JS_EVENT_STORAGE event's `handle_id`.
+enum
+{
+  EVENT_FLUSH_TIMER, /**< The write-back timer expired. */
+  EVENT_COMMITTED,   /**< Finished batches are waiting in the done list. */
+};
+
+static bool ready = false;
+static nvs_handle_t nvs;
+static cache_entry_t cache[JS_STORAGE_CACHE_ENTRIES];
+static uint32_t use_clock = 0;
+static uint32_t next_seq = 1;
+
+/// @brief Sequence number of the last batch the commit task finished; written by that task.
+static uint32_t committed_seq = 0;
+
+static QueueHandle_t commit_queue = NULL;
+static SemaphoreHandle_t flush_done = NULL;
+static esp_timer_handle_t flush_timer = NULL;
+
+/// @brief Finished asynchronous batches, oldest first, guarded by `done_lock`.
+static commit_batch_t *done_head = NULL;
+static commit_batch_t *done_tail = NULL;
+static bool done_posted = false; /**< An EVENT_COMMITTED event is queued and not yet dispatched. */
+static SemaphoreHandle_t done_lock = NULL;
+
+// --- Commit task ---
+
+/**
+ * @brief Tells the JS thread that finished batches are waiting, unless it already knows.
+ *
+ * Never blocks: a synchronous flush may be holding the JS thread, so the
+ * event queue may stay full until this task has finished that flush too.
+ * @return False if the event could not be queued and must be retried.
+ */
+static bool post_done(void)
+{
+  xSemaphoreTake(done_lock, portMAX_DELAY);
+  if (done_head && !done_posted)
+  {
+    js_event_t ev = {
+        .type = JS_EVENT_STORAGE,
+        .handle_id = EVENT_COMMITTED,
+        .data = NULL,
+    };
+    done_posted = xQueueSend(js_event_queue, &ev, 0) == pdTRUE;
+  }
+  bool delivered = !done_head || done_posted;
+  xSemaphoreGive(done_lock);
+  return delivered;
+}
+
+/**
+ * @brief Writes batches to NVS in the order they were queued, one commit each.
+ */
+static void commit_task(void *params)
+{
+  commit_batch_t *batch;
+  bool delivered = true;
+  for (;;)
+  {
+    TickType_t wait = delivered ? portMAX_DELAY : pdMS_TO_TICKS(JS_STORAGE_RETRY_MS);
+    if (xQueueReceive(commit_queue, &batch, wait) != pdTRUE)
+    {
+      delivered = post_done();
+      continue;
+    }
+
+    esp_err_t err = ESP_OK;
+    for (size_t i = 0; i < batch->count && err == ESP_OK; i++)
+    {
+      commit_write_t *write = &batch->writes[i];
+      if (write->blob)
+      {
+        err = nvs_set_blob(nvs, write->key, write->blob, write->blob_len);
+      }
+      else
+      {
+        err = nvs_erase_key(nvs, write->key);
+        if (err == ESP_ERR_NVS_NOT_FOUND)
+        {
+          err = ESP_OK; // Deleting a key that never reached flash
+        }
+      }
+    }
+    if (err == ESP_OK)
+    {
+      err = nvs_commit(nvs);
+    }
+    batch->err = err;
+    __atomic_store_n(&committed_seq, batch->seq, __ATOMIC_RELEASE);
+
+    if (batch->wait)
+    {
+      xSemaphoreGive(flush_done);
+      continue;
+    }
+
+    xSemaphoreTake(done_lock, portMAX_DELAY);
+    if (done_tail)
+    {
+      done_tail->next = batch;
+    }
+    else
+    {
+      done_head = batch;
+    }
+    done_tail = batch;
+    xSemaphoreGive(done_lock);
+    delivered = post_done();
+  }
+}
+
+/**
+ * @brief Write-back timer: asks the JS thread to commit what has piled up.
+ */
+static void flush_timer_cb(void *arg)
+{
+  js_event_t ev = {
+      .type = JS_EVENT_STORAGE,
+      .handle_id = EVENT_FLUSH_TIMER,
+      .data = NULL,
+  };
+  if (xQueueSend(js_event_queue, &ev, 0) != pdTRUE)
+  {
+    esp_timer_start_once(flush_timer, JS_STORAGE_FLUSH_MS * 1000ULL); // Busy; try again later
+  }
+}
+
+esp_err_t js_storage_init(void)
+{
+  esp_err_t err = nvs_flash_init();
+  if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND)
+  {
+    ESP_LOGW(TAG, "Erasing the NVS partition (%s)", esp_err_to_name(err));
+    nvs_flash_erase();
+    err = nvs_flash_init();
+  }
+  if (err == ESP_OK)
+  {
+    err = nvs_open(JS_STORAGE_NAMESPACE, NVS_READWRITE, &nvs);
+  }
+  if (err != ESP_OK)
+  {
+    ESP_LOGE(TAG, "Failed to open NVS (%s)", esp_err_to_name(err));
+    return err;
+  }
+
+  commit_queue = xQueueCreate(JS_STORAGE_QUEUE_DEPTH, sizeof(commit_batch_t *));
+  flush_done = xSemaphoreCreateBinary();
+  done_lock = xSemaphoreCreateMutex();
+  const esp_timer_create_args_t timer_args = {
+      .callback = flush_timer_cb,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "js_storage",
+  };
+  if (!commit_queue || !flush_done || !done_lock || esp_timer_create(&timer_args, &flush_timer) != ESP_OK ||
+      xTaskCreatePinnedToCore(commit_task, "js_storage", JS_STORAGE_COMMIT_STACK, NULL, JS_STORAGE_COMMIT_PRIORITY,
+                              NULL, JS_STORAGE_COMMIT_CORE) != pdPASS)
+  {
+    ESP_LOGE(TAG, "Failed to start the storage commit task");
+    return ESP_ERR_NO_MEM;
+  }
+
+  ready = true;
+  return ESP_OK;
+}
+
+// --- Cache ---
+
+static bool valid_key(const char *key)
+{
+  size_t len = strlen(key);
+  return len > 0 && len < JS_STORAGE_MAX_KEY;
+}
+
+static cache_entry_t *find_entry(const char *key)
+{
+  for (size_t i = 0; i < JS_STORAGE_CACHE_ENTRIES; i++)
+  {
+    if (strcmp(cache[i].key, key) == 0)
+    {
+      return &cache[i];
+    }
+  }
+  return NULL;
+}
+
+static bool any_dirty(void)
+{
+  for (size_t i = 0; i < JS_STORAGE_CACHE_ENTRIES; i++)
+  {
+    if (cache[i].dirty)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief A slot for `key`: a free one, or the least recently used entry already in flash.
+ *
+ * @return NULL if every entry still has writes on their way to flash.
+ */
+static cache_entry_t *claim_entry(const char *key)
+{
+  uint32_t committed = __atomic_load_n(&committed_seq, __ATOMIC_ACQUIRE);
+  cache_entry_t *victim = NULL;
+  for (size_t i = 0; i < JS_STORAGE_CACHE_ENTRIES; i++)
+  {
+    cache_entry_t *entry = &cache[i];
+    if (entry->key[0] == '\0')
+    {
+      victim = entry;
+      break;
+    }
+    // Evicting an entry whose commit is still queued would let a read see the old value in NVS.
+    if (!entry->dirty && entry->batch <= committed && (!victim || entry->last_used < victim->last_used))
+    {
+      victim = entry;
+    }
+  }
+  if (!victim)
+  {
+    return NULL;
+  }
+
+  free(victim->blob);
+  memset(victim, 0, sizeof(*victim));
+  strcpy(victim->key, key);
+  return victim;
+}
+
+/**
+ * @brief claim_entry(), committing pending writes first if the cache is full of them.
+ */
+static esp_err_t claim_entry_or_flush(const char *key, cache_entry_t **out)
+{
+  *out = claim_entry(key);
+  if (!*out)
+  {
+    esp_err_t err = js_storage_flush();
+    if (err != ESP_OK)
+    {
+      return err;
+    }
+    *out = claim_entry(key);
+  }
+  return *out ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static void arm_flush_timer(void)
+{
+  if (!esp_timer_is_active(flush_timer))
+  {
+    esp_timer_start_once(flush_timer, JS_STORAGE_FLUSH_MS * 1000ULL);
+  }
+}
+
+/**
+ * @brief Replaces the cached blob of `key` and marks it for the next commit. Takes ownership of `blob`.
+ */
+static esp_err_t store(const char *key, uint8_t *blob, size_t blob_len)
+{
+  if (!ready)
+  {
+    free(blob);
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  // Rewriting what the cache already holds would only wear the flash.
+  cache_entry_t *entry = find_entry(key);
+  bool unchanged = entry && (blob ? entry->blob && entry->blob_len == blob_len &&
+                                        memcmp(entry->blob, blob, blob_len) == 0
+                                  : !entry->blob);
+  if (unchanged)
+  {
+    entry->last_used = ++use_clock;
+    free(blob);
+    return ESP_OK;
+  }
+
+  if (!entry)
+  {
+    esp_err_t err = claim_entry_or_flush(key, &entry);
+    if (err != ESP_OK)
+    {
+      free(blob);
+      return err;
+    }
+  }
+  entry->last_used = ++use_clock;
+  free(entry->blob);
+  entry->blob = blob;
+  entry->blob_len = blob_len;
+  entry->dirty = true;
+  arm_flush_timer();
+  return ESP_OK;
+}
+
+esp_err_t js_storage_get(const char *key, js_storage_value_t *out)
+{
+  if (!valid_key(key))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (!ready)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  cache_entry_t *entry = find_entry(key);
+  if (!entry)
+  {
+    size_t len = 0;
+    uint8_t *blob = NULL;
+    esp_err_t err = nvs_get_blob(nvs, key, NULL, &len);
+    if (err == ESP_OK)
+    {
+      blob = (uint8_t *)malloc(len ? len : 1);
+      if (!blob)
+      {
+        return ESP_ERR_NO_MEM;
+      }
+      err = nvs_get_blob(nvs, key, blob, &len);
+    }
+    if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND)
+    {
+      free(blob);
+      return err;
+    }
+
+    // Misses are cached too, so polling an unset key does not hit flash each time.
+    err = claim_entry_or_flush(key, &entry);
+    if (err != ESP_OK)
+    {
+      free(blob);
+      return err;
+    }
+    entry->blob = blob;
+    entry->blob_len = len;
+  }
+  entry->last_used = ++use_clock;
+
+  if (!entry->blob || entry->blob_len == 0)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+  out->type = (js_storage_type_t)entry->blob[0];
+  out->data = entry->blob + 1;
+  out->len = entry->blob_len - 1;
+  return ESP_OK;
+}
+
+esp_err_t js_storage_set(const char *key, js_storage_type_t type, const void *data, size_t len)
+{
+  if (!valid_key(key))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (len > JS_STORAGE_MAX_VALUE)
+  {
+    return ESP_ERR_INVALID_SIZE;
+  }
+
+  uint8_t *blob = (uint8_t *)malloc(len + 1);
+  if (!blob)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  blob[0] = (uint8_t)type;
+  if (len > 0)
+  {
+    memcpy(blob + 1, data, len);
+  }
+  return store(key, blob, len + 1);
+}
+
+esp_err_t js_storage_delete(const char *key)
+{
+  if (!valid_key(key))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  return store(key, NULL, 0);
+}
+
+// --- Commits ---
+
+static void free_batch(commit_batch_t *batch)
+{
+  for (size_t i = 0; i < batch->count; i++)
+  {
+    free(batch->writes[i].blob);
+  }
+  free(batch);
+}
+
+/**
+ * @brief Copies every dirty entry into a new batch and marks them clean.
+ */
+static commit_batch_t *take_batch(bool wait)
+{
+  size_t count = 0;
+  for (size_t i = 0; i < JS_STORAGE_CACHE_ENTRIES; i++)
+  {
+    count += cache[i].dirty;
+  }
+
+  commit_batch_t *batch = (commit_batch_t *)calloc(1, sizeof(commit_batch_t) + count * sizeof(commit_write_t));
+  if (!batch)
+  {
+    return NULL;
+  }
+  batch->seq = next_seq++;
+  batch->wait = wait;
+  batch->promise = jerry_undefined();
+
+  for (size_t i = 0; i < JS_STORAGE_CACHE_ENTRIES; i++)
+  {
+    cache_entry_t *entry = &cache[i];
+    if (!entry->dirty)
+    {
+      continue;
+    }
+    commit_write_t *write = &batch->writes[batch->count];
+    if (entry->blob)
+    {
+      write->blob = (uint8_t *)malloc(entry->blob_len);
+      if (!write->blob)
+      {
+        free_batch(batch); // Nothing has been marked clean yet
+        return NULL;
+      }
+      memcpy(write->blob, entry->blob, entry->blob_len);
+      write->blob_len = entry->blob_len;
+    }
+    strcpy(write->key, entry->key);
+    batch->count++;
+  }
+
+  for (size_t i = 0; i < JS_STORAGE_CACHE_ENTRIES; i++)
+  {
+    if (cache[i].dirty)
+    {
+      cache[i].dirty = false;
+      cache[i].batch = batch->seq;
+    }
+  }
+  return batch;
+}
+
+/**
+ * @brief Marks the writes of a batch that never made it to flash as pending again.
+ *
+ * Entries that changed since, or were evicted, are left alone.
+ */
+static void restore_batch(const commit_batch_t *batch)
+{
+  for (size_t i = 0; i < batch->count; i++)
+  {
+    cache_entry_t *entry = find_entry(batch->writes[i].key);
+    if (entry && entry->batch == batch->seq)
+    {
+      entry->dirty = true;
+    }
+  }
+}
+
+esp_err_t js_storage_flush(void)
+{
+  if (!ready)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+  commit_batch_t *batch = take_batch(true);
+  if (!batch)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+
+  // Queued behind any asynchronous commits, so those land first.
+  xQueueSend(commit_queue, &batch, portMAX_DELAY);
+  xSemaphoreTake(flush_done, portMAX_DELAY);
+
+  esp_err_t err = batch->err;
+  if (err != ESP_OK)
+  {
+    restore_batch(batch);
+  }
+  else if (!any_dirty())
+  {
+    esp_timer_stop(flush_timer);
+  }
+  free_batch(batch);
+  return err;
+}
+
+esp_err_t js_storage_flush_async(jerry_value_t promise)
+{
+  if (!ready)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+  commit_batch_t *batch = take_batch(false);
+  if (!batch)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  batch->promise = jerry_value_copy(promise);
+  if (xQueueSend(commit_queue, &batch, 0) != pdTRUE)
+  {
+    restore_batch(batch);
+    jerry_value_free(batch->promise);
+    free_batch(batch);
+    return ESP_ERR_NO_MEM;
+  }
+
+  esp_timer_stop(flush_timer);
+  return ESP_OK;
+}
+
+/**
+ * @brief Settles the promise of a finished asynchronous batch and frees it.
+ */
+static void finish_batch(commit_batch_t *batch)
+{
+  if (batch->err != ESP_OK)
+  {
+    ESP_LOGE(TAG, "Commit of %u keys failed (%s)", (unsigned)batch->count, esp_err_to_name(batch->err));
+    restore_batch(batch);
+  }
+
+  if (jerry_value_is_promise(batch->promise))
+  {
+    if (batch->err != ESP_OK)
+    {
+      jerry_value_t error = jerry_error_sz(JERRY_ERROR_COMMON, "Storage commit failed.");
+      jerry_value_free(jerry_promise_reject(batch->promise, error));
+      jerry_value_free(error);
+    }
+    else
+    {
+      jerry_value_t undefined = jerry_undefined();
+      jerry_value_free(jerry_promise_resolve(batch->promise, undefined));
+      jerry_value_free(undefined);
+    }
+  }
+  jerry_value_free(batch->promise);
+  free_batch(batch);
+}
+
+void js_storage_dispatch_event(js_event_t *event)
+{
+  if (event->handle_id == EVENT_FLUSH_TIMER)
+  {
+    if (any_dirty() && js_storage_flush_async(jerry_undefined()) != ESP_OK)
+    {
+      arm_flush_timer();
+    }
+    return;
+  }
+
+  xSemaphoreTake(done_lock, portMAX_DELAY);
+  commit_batch_t *batch = done_head;
+  done_head = NULL;
+  done_tail = NULL;
+  done_posted = false;
+  xSemaphoreGive(done_lock);
+
+  while (batch)
+  {
+    commit_batch_t *next = batch->next;
+    finish_batch(batch);
+    batch = next;
+  }
+}
@@ -6,15 +6,24 @@
 #include "esp_timer.h"
 
 #include "js_timers.h"
-#include "js_main_thread.h" // for js_event_queue and print_js_error
+#include "js_main_thread.h" // for print_js_error
+#include "js_worker.h"      // for js_context_index and js_context_queue
 
 static const char *TAG = "JS_TIMERS";
 
-/// @brief The head of the linked list of active timers.
-static js_timer_t *timers_head = NULL;
+// Handles carry the owning context in their top bits, so the ISR callback
+// knows which event queue to post to without touching the timer list.
+#define HANDLE_CONTEXT_SHIFT 28
+#define HANDLE_SEQUENCE_MASK ((1UL << HANDLE_CONTEXT_SHIFT) - 1)
 
-/// @brief The next handle to be assigned to a new timer. Starts at 1.
-static uint32_t next_handle = 1;
+/// @brief The head of each context's linked list of active timers.
+static js_timer_t *timers_head[JS_MAX_CONTEXTS];
+
+/// @brief The next handle sequence number of each context. Starts at 1.
+static uint32_t next_handle[JS_MAX_CONTEXTS];
+
+/// @brief Pending flags of paced timers, shared by every context.
+static js_timer_cell_t paced_cells[JS_TIMER_MAX_PACED];
 
 /**
  * @brief The internal callback function executed by the esp_timer service.
@@ -28,7 +37,7 @@ static void IRAM_ATTR timer_cb(void *arg)
       .data = NULL,
   };
   BaseType_t woke = pdFALSE;
-  xQueueSendFromISR(js_event_queue, &ev, &woke);
+  xQueueSendFromISR(js_context_queue(handle_id >> HANDLE_CONTEXT_SHIFT), &ev, &woke);
   if (woke)
   {
     portYIELD_FROM_ISR();
@@ -36,30 +45,90 @@ static void IRAM_ATTR timer_cb(void *arg)
 }
 
 /**
- * @brief Initializes the timer management system.
+ * @brief The interrupt callback of a paced timer: posts one event at a time.
+ *
+ * The ticks themselves are counted from the clock on dispatch, so a period
+ * that passes while an event is pending is not lost, only folded into it.
+ */
+static void IRAM_ATTR paced_timer_cb(void *arg)
+{
+  js_timer_cell_t *cell = (js_timer_cell_t *)arg;
+  uint32_t handle_id = cell->handle_id;
+  if (handle_id == 0 || cell->pending)
+  {
+    return;
+  }
+  cell->pending = true;
+
+  js_event_t ev = {
+      .type = JS_EVENT_TIMER,
+      .handle_id = handle_id,
+      .data = NULL,
+  };
+  BaseType_t woke = pdFALSE;
+  if (xQueueSendFromISR(js_context_queue(handle_id >> HANDLE_CONTEXT_SHIFT), &ev, &woke) != pdTRUE)
+  {
+    cell->pending = false; // The queue is full; the next period tries again
+  }
+  if (woke)
+  {
+    portYIELD_FROM_ISR();
+  }
+}
+
+/**
+ * @brief Claims a free paced cell for `handle_id`. Any context may call this.
+ */
+static js_timer_cell_t *claim_cell(uint32_t handle_id)
+{
+  for (int i = 0; i < JS_TIMER_MAX_PACED; i++)
+  {
+    uint32_t expected = 0;
+    if (__atomic_compare_exchange_n(&paced_cells[i].handle_id, &expected, handle_id, false, __ATOMIC_ACQ_REL,
+                                    __ATOMIC_RELAXED))
+    {
+      paced_cells[i].pending = false;
+      return &paced_cells[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Initializes the timer management system for the current context.
  */
 void js_timers_init(void)
 {
   ESP_LOGI(TAG, "Initializing timer system.");
-  timers_head = NULL;
+  uint32_t ctx = js_context_index();
+  timers_head[ctx] = NULL;
+  next_handle[ctx] = 1;
 }
 
 /**
- * @brief Creates and starts a new timer.
+ * @brief Allocates a timer of `kind`, adds it to the list and starts it.
  */
-uint32_t js_timers_set(bool is_interval, jerry_value_t callback, uint64_t delay_ms)
+static js_timer_t *timer_start(js_timer_kind_t kind, bool is_interval, jerry_value_t callback, uint64_t delay_us)
 {
   js_timer_t *new_timer = (js_timer_t *)malloc(sizeof(js_timer_t));
   if (new_timer == NULL)
   {
     ESP_LOGE(TAG, "Failed to allocate memory for a new timer.");
-    return 0;
+    return NULL;
   }
 
-  uint32_t handle = next_handle++;
+  uint32_t ctx = js_context_index();
+  uint32_t handle = (ctx << HANDLE_CONTEXT_SHIFT) | (next_handle[ctx]++ & HANDLE_SEQUENCE_MASK);
   new_timer->handle_id = handle;
   new_timer->is_interval = is_interval;
+  new_timer->kind = kind;
   new_timer->js_callback = jerry_value_copy(callback);
+  new_timer->js_value = jerry_undefined();
+  new_timer->ticks = 0;
+  new_timer->ticks_seen = 0;
+  new_timer->policy = JS_TIMER_SKIP;
+  new_timer->period_us = delay_us;
+  new_timer->cell = NULL;
 
   esp_timer_create_args_t args = {
       .callback = timer_cb,
@@ -67,40 +136,227 @@ uint32_t js_timers_set(bool is_interval, jerry_value_t callback, uint64_t delay_
       .dispatch_method = ESP_TIMER_ISR,
       .name = "js_timer",
   };
+  if (kind == JS_TIMER_PACED)
+  {
+    new_timer->cell = claim_cell(handle);
+    if (new_timer->cell == NULL)
+    {
+      ESP_LOGE(TAG, "Too many paced timers.");
+      jerry_value_free(new_timer->js_callback);
+      free(new_timer);
+      return NULL;
+    }
+    args.callback = paced_timer_cb;
+    args.arg = new_timer->cell;
+  }
   esp_err_t err = esp_timer_create(&args, &new_timer->timer);
   if (err != ESP_OK)
   {
     ESP_LOGE(TAG, "Failed to create esp_timer: %s", esp_err_to_name(err));
+    if (new_timer->cell)
+    {
+      __atomic_store_n(&new_timer->cell->handle_id, 0, __ATOMIC_RELEASE);
+    }
     jerry_value_free(new_timer->js_callback);
     free(new_timer);
-    return 0;
+    return NULL;
   }
 
   // Add the new timer to the front of the list
-  new_timer->next = timers_head;
-  timers_head = new_timer;
+  new_timer->next = timers_head[ctx];
+  timers_head[ctx] = new_timer;
 
+  new_timer->start_us = esp_timer_get_time();
   if (is_interval)
   {
-    esp_timer_start_periodic(new_timer->timer, delay_ms * 1000);
+    if (new_timer->period_us < JS_TIMER_MIN_PERIOD_US)
+    {
+      new_timer->period_us = JS_TIMER_MIN_PERIOD_US;
+    }
+    esp_timer_start_periodic(new_timer->timer, new_timer->period_us);
   }
   else
   {
-    esp_timer_start_once(new_timer->timer, delay_ms * 1000);
+    esp_timer_start_once(new_timer->timer, delay_us);
   }
+  return new_timer;
+}
 
-  // NOTE: Removed high-frequency logging from here to improve performance.
-  // ESP_LOGI(TAG, "Timer SET with handle %lu. is_interval=%d", handle, is_interval);
+/**
+ * @brief Creates and starts a new timer.
+ */
+uint32_t js_timers_set(bool is_interval, jerry_value_t callback, uint64_t delay_us)
+{
+  js_timer_t *timer = timer_start(JS_TIMER_CALLBACK, is_interval, callback, delay_us);
+  return timer ? timer->handle_id : 0;
+}
+
+uint32_t js_timers_set_paced(jerry_value_t callback, uint64_t period_us, js_timer_policy_t policy)
+{
+  js_timer_t *timer = timer_start(JS_TIMER_PACED, true, callback, period_us);
+  if (!timer)
+  {
+    return 0;
+  }
+  timer->policy = policy;
+  timer->js_value = jerry_object();
+  return timer->handle_id;
+}
+
+uint32_t js_timers_sleep(jerry_value_t promise, jerry_value_t value, uint64_t delay_us)
+{
+  js_timer_t *timer = timer_start(JS_TIMER_PROMISE, false, promise, delay_us);
+  if (!timer)
+  {
+    return 0;
+  }
+  timer->js_value = jerry_value_copy(value);
+  return timer->handle_id;
+}
+
+uint32_t js_timers_every(uint64_t period_us)
+{
+  js_timer_t *timer = timer_start(JS_TIMER_TICKS, true, jerry_undefined(), period_us);
+  if (!timer)
+  {
+    return 0;
+  }
 
-  return handle;
+  timer->js_value = jerry_object();
+  jerry_value_t done_name = jerry_string_sz("done");
+  jerry_value_free(jerry_object_set(timer->js_value, done_name, jerry_boolean(false)));
+  jerry_value_free(done_name);
+  return timer->handle_id;
+}
+
+static js_timer_t *find_timer(uint32_t handle_id)
+{
+  js_timer_t *timer = timers_head[js_context_index()];
+  while (timer != NULL && timer->handle_id != handle_id)
+  {
+    timer = timer->next;
+  }
+  return timer;
 }
 
 /**
- * @brief Stops and releases a timer.
+ * @brief Resolves `promise` with an iterator result; `result` is reused unless the iteration is done.
  */
-bool js_timers_clear(uint32_t handle_id)
+static void resolve_tick(jerry_value_t promise, jerry_value_t result, uint32_t ticks)
+{
+  jerry_value_t value_name = jerry_string_sz("value");
+  jerry_value_t value = jerry_number(ticks);
+  jerry_value_free(jerry_object_set(result, value_name, value));
+  jerry_value_free(jerry_promise_resolve(promise, result));
+  jerry_value_free(value);
+  jerry_value_free(value_name);
+}
+
+static void resolve_done(jerry_value_t promise)
+{
+  jerry_value_t result = jerry_object();
+  jerry_value_t done_name = jerry_string_sz("done");
+  jerry_value_free(jerry_object_set(result, done_name, jerry_boolean(true)));
+  jerry_value_free(jerry_promise_resolve(promise, result));
+  jerry_value_free(done_name);
+  jerry_value_free(result);
+}
+
+jerry_value_t js_timers_next_tick(uint32_t handle_id)
+{
+  jerry_value_t promise = jerry_promise();
+  js_timer_t *timer = find_timer(handle_id);
+  if (timer == NULL || timer->kind != JS_TIMER_TICKS)
+  {
+    resolve_done(promise);
+    return promise;
+  }
+
+  if (timer->ticks != timer->ticks_seen)
+  {
+    timer->ticks_seen = timer->ticks;
+    resolve_tick(promise, timer->js_value, timer->ticks);
+  }
+  else
+  {
+    // Only one next() can be waiting; an earlier one is superseded and ends.
+    if (jerry_value_is_promise(timer->js_callback))
+    {
+      resolve_done(timer->js_callback);
+    }
+    jerry_value_free(timer->js_callback);
+    timer->js_callback = jerry_value_copy(promise);
+  }
+  return promise;
+}
+
+static void set_number(jerry_value_t object, const char *name, double number)
 {
-  js_timer_t *current = timers_head;
+  jerry_value_t key = jerry_string_sz(name);
+  jerry_value_t value = jerry_number(number);
+  jerry_value_free(jerry_object_set(object, key, value));
+  jerry_value_free(value);
+  jerry_value_free(key);
+}
+
+/**
+ * @brief Runs the ticks of a paced timer that are due, according to its policy.
+ *
+ * Events are only a wake-up: the ticks to run are worked out from the
+ * clock, so ticks that fell due while the event was pending, or while the
+ * queue was full, are still seen.
+ */
+static void dispatch_paced(js_timer_t *timer)
+{
+  uint32_t handle_id = timer->handle_id;
+  timer->cell->pending = false; // Before reading the clock, so a tick due from now on posts again
+  int64_t now = esp_timer_get_time();
+  uint32_t due = (uint32_t)((uint64_t)(now - timer->start_us) / timer->period_us);
+  if (due <= timer->ticks)
+  {
+    return;
+  }
+
+  uint32_t missed = due - timer->ticks - 1;
+  if (timer->policy == JS_TIMER_CATCH_UP)
+  {
+    missed = missed >= JS_TIMER_CATCH_UP_MAX ? missed - JS_TIMER_CATCH_UP_MAX + 1 : 0;
+  }
+  timer->ticks += missed;
+
+  while (timer != NULL && timer->ticks < due)
+  {
+    uint32_t tick = ++timer->ticks;
+    jerry_value_t info = jerry_value_copy(timer->js_value);
+    jerry_value_t callback = jerry_value_copy(timer->js_callback);
+    set_number(info, "tick", tick);
+    set_number(info, "scheduled", (double)(timer->start_us + (int64_t)(tick * timer->period_us)));
+    set_number(info, "actual", (double)esp_timer_get_time());
+    set_number(info, "missed", missed);
+    missed = 0;
+
+    jerry_value_t global = jerry_current_realm();
+    jerry_value_t res = jerry_call(callback, global, &info, 1);
+    jerry_value_free(global);
+    if (jerry_value_is_exception(res))
+    {
+      print_js_error(res);
+    }
+    jerry_value_free(res);
+    jerry_value_free(callback);
+    jerry_value_free(info);
+
+    timer = find_timer(handle_id); // The callback may have cleared it
+  }
+}
+
+/**
+ * @brief Stops and releases a timer, ending a pending next() promise if `settle` is set.
+ */
+static bool remove_timer(uint32_t handle_id, bool settle)
+{
+  uint32_t ctx = js_context_index();
+  js_timer_t *current = timers_head[ctx];
   js_timer_t *prev = NULL;
 
   while (current != NULL && current->handle_id != handle_id)
@@ -118,7 +374,7 @@ bool js_timers_clear(uint32_t handle_id)
 
   if (prev == NULL)
   {
-    timers_head = current->next;
+    timers_head[ctx] = current->next;
   }
   else
   {
@@ -127,7 +383,16 @@ bool js_timers_clear(uint32_t handle_id)
 
   esp_timer_stop(current->timer);
   esp_timer_delete(current->timer);
+  if (current->cell)
+  {
+    __atomic_store_n(&current->cell->handle_id, 0, __ATOMIC_RELEASE);
+  }
+  if (settle && current->kind == JS_TIMER_TICKS && jerry_value_is_promise(current->js_callback))
+  {
+    resolve_done(current->js_callback); // Ends a `for await` loop waiting on it
+  }
   jerry_value_free(current->js_callback);
+  jerry_value_free(current->js_value);
   free(current);
 
   // NOTE: Removed high-frequency logging from here to improve performance.
@@ -135,18 +400,51 @@ bool js_timers_clear(uint32_t handle_id)
   return true;
 }
 
+/**
+ * @brief Stops and releases a timer.
+ */
+bool js_timers_clear(uint32_t handle_id)
+{
+  return remove_timer(handle_id, true);
+}
+
+/**
+ * @brief Stops and releases a timer without settling anything.
+ */
+void js_timers_release(uint32_t handle_id)
+{
+  remove_timer(handle_id, false);
+}
+
+/**
+ * @brief Stops and releases every timer of the current context.
+ */
+void js_timers_clear_all(void)
+{
+  uint32_t ctx = js_context_index();
+  while (timers_head[ctx] != NULL)
+  {
+    js_timers_clear(timers_head[ctx]->handle_id);
+  }
+}
+
 /**
  * @brief Executes the JavaScript callback for a given timer handle.
  */
 bool js_timers_dispatch(uint32_t handle_id)
 {
-  js_timer_t *timer = timers_head;
-  while (timer != NULL && timer->handle_id != handle_id)
+  js_timer_t *timer = find_timer(handle_id);
+  if (timer == NULL)
   {
-    timer = timer->next;
+    // This is not an error. It can happen if a timer is cleared
+    // after its event has been queued but before it has been dispatched.
+    ESP_LOGD(TAG, "Timer DISPATCH ignored: handle %lu already cleared.", handle_id);
+    return false;
   }
 
-  if (timer != NULL)
+  switch (timer->kind)
+  {
+  case JS_TIMER_CALLBACK:
   {
     bool is_interval = timer->is_interval;
     jerry_value_t callback = timer->js_callback;
@@ -165,11 +463,29 @@ bool js_timers_dispatch(uint32_t handle_id)
     {
       js_timers_clear(handle_id);
     }
-    return true;
+    break;
   }
 
-  // This is not an error. It can happen if a timer is cleared
-  // after its event has been queued but before it has been dispatched.
-  ESP_LOGD(TAG, "Timer DISPATCH ignored: handle %lu already cleared.", handle_id);
-  return false;
+  case JS_TIMER_PROMISE:
+    jerry_value_free(jerry_promise_resolve(timer->js_callback, timer->js_value));
+    js_timers_clear(handle_id);
+    break;
+
+  case JS_TIMER_TICKS:
+    timer->ticks++;
+    if (jerry_value_is_promise(timer->js_callback))
+    {
+      jerry_value_t promise = timer->js_callback;
+      timer->js_callback = jerry_undefined();
+      timer->ticks_seen = timer->ticks;
+      resolve_tick(promise, timer->js_value, timer->ticks);
+      jerry_value_free(promise);
+    }
+    break;
+
+  case JS_TIMER_PACED:
+    dispatch_paced(timer);
+    break;
+  }
+  return true;
 }
@@ -0,0 +1,104 @@
+#include "sdkconfig.h"
+
+#if CONFIG_JS_WATCHDOG
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "jerryscript.h"
+
+#include "js_watchdog.h"
+#include "js_worker.h" // for js_context_index
+
+static const char *TAG = "JS_WATCHDOG";
+
+/**
+ * @brief The watchdog of one context. Only that context's thread touches it.
+ */
+typedef struct
+{
+  int64_t started;  /**< When the running callback started; 0 between callbacks. */
+  int64_t deadline; /**< When it runs out of budget, or of its grace once warned; 0 if it has no budget. */
+  bool warned;      /**< The running callback has been thrown a catchable error and is in its grace. */
+  bool tripped;     /**< The running callback has overrun its grace too and is being aborted. */
+  js_watchdog_stats_t stats;
+} js_watchdog_t;
+
+static js_watchdog_t watchdogs[JS_MAX_CONTEXTS];
+
+/**
+ * @brief Called by the engine every JS_WATCHDOG_CHECK_INTERVAL halt checks.
+ *
+ * Past the deadline it first throws a RangeError, which `catch` and
+ * `finally` blocks see, and gives the callback one more budget to unwind.
+ * Past that it returns an abort, which unwinds the callback without stopping
+ * at any `catch`. The engine may call again before the callback has fully
+ * unwound, so it keeps aborting until the callback is disarmed.
+ */
+static jerry_value_t halt_cb(void *user_p)
+{
+  js_watchdog_t *watchdog = (js_watchdog_t *)user_p;
+  int64_t now = esp_timer_get_time();
+  if (watchdog->deadline == 0 || now < watchdog->deadline)
+  {
+    return jerry_undefined();
+  }
+
+  if (!watchdog->warned)
+  {
+    watchdog->warned = true;
+    watchdog->deadline = now + watchdog->stats.budget_ms * 1000LL;
+    watchdog->stats.aborted++;
+    ESP_LOGW(TAG, "Callback ran over its %lu ms budget", watchdog->stats.budget_ms);
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Callback exceeded its CPU budget.");
+  }
+  if (!watchdog->tripped)
+  {
+    watchdog->tripped = true;
+    ESP_LOGW(TAG, "Callback kept running after its budget error and was aborted");
+  }
+  return jerry_throw_abort(jerry_error_sz(JERRY_ERROR_RANGE, "Callback exceeded its CPU budget."), true);
+}
+
+void js_watchdog_init(void)
+{
+  js_watchdog_t *watchdog = &watchdogs[js_context_index()];
+  watchdog->started = 0;
+  watchdog->deadline = 0;
+  watchdog->warned = false;
+  watchdog->tripped = false;
+  watchdog->stats = (js_watchdog_stats_t){.budget_ms = CONFIG_JS_WATCHDOG_BUDGET_MS};
+  jerry_halt_handler(JS_WATCHDOG_CHECK_INTERVAL, halt_cb, watchdog);
+}
+
+void js_watchdog_arm(void)
+{
+  js_watchdog_t *watchdog = &watchdogs[js_context_index()];
+  watchdog->started = esp_timer_get_time();
+  watchdog->warned = false;
+  watchdog->tripped = false;
+  watchdog->deadline = watchdog->stats.budget_ms ? watchdog->started + watchdog->stats.budget_ms * 1000LL : 0;
+}
+
+void js_watchdog_disarm(void)
+{
+  js_watchdog_t *watchdog = &watchdogs[js_context_index()];
+  int64_t elapsed = esp_timer_get_time() - watchdog->started;
+  if (elapsed > watchdog->stats.longest_us)
+  {
+    watchdog->stats.longest_us = elapsed;
+  }
+  watchdog->started = 0;
+  watchdog->deadline = 0;
+}
+
+void js_watchdog_set_budget(uint32_t budget_ms)
+{
+  watchdogs[js_context_index()].stats.budget_ms = budget_ms;
+}
+
+js_watchdog_stats_t js_watchdog_stats(void)
+{
+  return watchdogs[js_context_index()].stats;
+}
+
+#endif /* CONFIG_JS_WATCHDOG */
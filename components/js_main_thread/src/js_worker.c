@@ -0,0 +1,333 @@
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#include "js_worker.h"
+
+#if CONFIG_JS_WORKERS
+
+#include "js_clone.h"
+#include "js_heap.h"
+#include "js_main_thread.h" // For js_event_queue, print_js_error and js_run_event_loop
+#include "js_module_resolver.h"
+#include "js_std_lib.h"
+#include "js_timers.h"
+#include "js_scheduler.h"
+#include "js_watchdog.h"
+#include "js_power.h"
+
+static const char *TAG = "JS_WORKER";
+
+#define CONTEXT_INDEX(id) ((id) & 0xFF) // Worker ids are (generation << 8) | slot
+
+/**
+ * @brief One JerryScript context and, for workers, the channel to the parent.
+ *
+ * Slots are claimed and recycled only by the main context. `callback` is a
+ * value of the worker's own context; `parent_callback` belongs to the main one.
+ */
+typedef struct
+{
+  uint32_t id; /**< 0 while a worker slot is free. */
+  char script[JS_WORKER_MAX_SCRIPT];
+  js_heap_t heap;
+  volatile bool stopping;
+  uint32_t channel_depth;
+  uint32_t to_worker;            /**< Messages posted to the worker and not yet dispatched. */
+  uint32_t to_parent;            /**< Messages posted by the worker and not yet dispatched. */
+  jerry_value_t callback;        /**< The worker's handler for its parent's messages. */
+  jerry_value_t parent_callback; /**< The main context's handler for this worker's messages. */
+} js_context_t;
+
+QueueHandle_t js_worker_queues[JS_MAX_CONTEXTS];
+
+static js_context_t contexts[JS_MAX_CONTEXTS];
+static uint32_t next_generation = 1;
+
+/// @brief The context of a worker task; NULL on the main JS task and tasks that run no JS.
+static __thread js_context_t *current_context = NULL;
+
+// --- Contexts ---
+
+uint32_t js_context_index(void)
+{
+  return current_context ? (uint32_t)(current_context - contexts) : JS_MAIN_CONTEXT;
+}
+
+static bool in_main_context(void)
+{
+  return js_context_index() == JS_MAIN_CONTEXT;
+}
+
+/**
+ * @brief The worker slot for `worker_id`, or NULL if that worker has exited.
+ */
+static js_context_t *find_worker(uint32_t worker_id)
+{
+  uint32_t index = CONTEXT_INDEX(worker_id);
+  if (index == JS_MAIN_CONTEXT || index >= JS_MAX_CONTEXTS || contexts[index].id != worker_id)
+  {
+    return NULL;
+  }
+  return &contexts[index];
+}
+
+/**
+ * @brief Body of a worker task: a complete runtime around one script.
+ *
+ * Workers get the standard globals and their own timers, run their script
+ * as a module, then handle events until they are terminated.
+ */
+static void worker_task(void *params)
+{
+  current_context = (js_context_t *)params;
+  js_heap_bind(&current_context->heap);
+  uint32_t index = js_context_index();
+
+  jerry_init(JERRY_INIT_EMPTY);
+  js_watchdog_init();
+  js_power_init();
+  js_init_std_libs();
+  js_timers_init();
+  js_scheduler_init();
+
+  ESP_LOGI(TAG, "Worker %lu running %s", current_context->id, current_context->script);
+  js_run_module(current_context->script);
+  js_run_event_loop(js_worker_queues[index], &current_context->stopping);
+
+  js_timers_clear_all();
+  js_scheduler_clear_all();
+  js_power_idle();
+  jerry_value_free(current_context->callback);
+  current_context->callback = jerry_undefined();
+  jerry_cleanup();
+
+  // The main context recycles the slot once it sees this.
+  js_event_t ev = {
+      .type = JS_EVENT_WORKER,
+      .handle_id = current_context->id,
+      .data = NULL,
+  };
+  xQueueSend(js_event_queue, &ev, portMAX_DELAY);
+  vTaskDelete(NULL);
+}
+
+esp_err_t js_worker_spawn(const char *script, const js_worker_options_t *options, uint32_t *out_id)
+{
+  uint32_t index = JS_MAIN_CONTEXT + 1;
+  while (index < JS_MAX_CONTEXTS && contexts[index].id != 0)
+  {
+    index++;
+  }
+  if (index == JS_MAX_CONTEXTS)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  js_context_t *ctx = &contexts[index];
+  if (js_heap_create(&ctx->heap, options->heap_kb) != ESP_OK)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  QueueHandle_t queue = xQueueCreate(JS_WORKER_EVENT_QUEUE_DEPTH, sizeof(js_event_t));
+  if (!queue)
+  {
+    heap_caps_free(ctx->heap.block);
+    return ESP_ERR_NO_MEM;
+  }
+
+  strncpy(ctx->script, script, sizeof(ctx->script) - 1);
+  ctx->script[sizeof(ctx->script) - 1] = '\0';
+  ctx->stopping = false;
+  ctx->channel_depth = options->channel_depth;
+  ctx->to_worker = 0;
+  ctx->to_parent = 0;
+  ctx->callback = jerry_undefined();
+  ctx->parent_callback = jerry_undefined();
+  ctx->id = ((next_generation++ & 0xFFFFFF) << 8) | index;
+  if (next_generation > 0xFFFFFF)
+  {
+    next_generation = 1; // Ids are never 0
+  }
+  js_worker_queues[index] = queue;
+
+  if (xTaskCreatePinnedToCore(worker_task, "js_worker", JS_WORKER_STACK, ctx, JS_WORKER_PRIORITY, NULL,
+                              options->core) != pdPASS)
+  {
+    ctx->id = 0;
+    js_worker_queues[index] = NULL;
+    vQueueDelete(queue);
+    heap_caps_free(ctx->heap.block);
+    return ESP_ERR_NO_MEM;
+  }
+
+  *out_id = ctx->id;
+  return ESP_OK;
+}
+
+// --- Channels ---
+
+esp_err_t js_worker_post(uint32_t worker_id, js_message_t *message)
+{
+  js_context_t *ctx;
+  uint32_t *in_flight;
+  QueueHandle_t queue;
+
+  if (in_main_context())
+  {
+    ctx = find_worker(worker_id);
+    if (!ctx || ctx->stopping)
+    {
+      return ESP_ERR_NOT_FOUND;
+    }
+    in_flight = &ctx->to_worker;
+    queue = js_worker_queues[CONTEXT_INDEX(worker_id)];
+  }
+  else
+  {
+    ctx = current_context;
+    in_flight = &ctx->to_parent;
+    queue = js_event_queue;
+  }
+
+  // The receiver decrements on dispatch, so the count bounds each direction.
+  if (__atomic_add_fetch(in_flight, 1, __ATOMIC_RELAXED) > ctx->channel_depth)
+  {
+    __atomic_sub_fetch(in_flight, 1, __ATOMIC_RELAXED);
+    return ESP_ERR_NO_MEM;
+  }
+
+  js_event_t ev = {
+      .type = JS_EVENT_WORKER,
+      .handle_id = ctx->id,
+      .data = message,
+  };
+  if (xQueueSend(queue, &ev, 0) != pdTRUE)
+  {
+    __atomic_sub_fetch(in_flight, 1, __ATOMIC_RELAXED);
+    return ESP_ERR_NO_MEM;
+  }
+  return ESP_OK;
+}
+
+esp_err_t js_worker_set_on_message(uint32_t worker_id, jerry_value_t callback)
+{
+  jerry_value_t *slot;
+  if (in_main_context())
+  {
+    js_context_t *ctx = find_worker(worker_id);
+    if (!ctx)
+    {
+      return ESP_ERR_NOT_FOUND;
+    }
+    slot = &ctx->parent_callback;
+  }
+  else
+  {
+    slot = &current_context->callback;
+  }
+
+  jerry_value_free(*slot);
+  *slot = jerry_value_copy(callback);
+  return ESP_OK;
+}
+
+esp_err_t js_worker_terminate(uint32_t worker_id)
+{
+  js_context_t *ctx = find_worker(worker_id);
+  if (!ctx)
+  {
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  ctx->stopping = true;
+  // Wakes the worker if it is idle; if its queue is full it is busy and will see the flag anyway.
+  js_event_t ev = {
+      .type = JS_EVENT_WORKER,
+      .handle_id = worker_id,
+      .data = NULL,
+  };
+  xQueueSend(js_worker_queues[CONTEXT_INDEX(worker_id)], &ev, 0);
+  return ESP_OK;
+}
+
+/**
+ * @brief Frees an exited worker's slot, dropping messages it never read.
+ */
+static void retire_worker(js_context_t *ctx)
+{
+  uint32_t index = (uint32_t)(ctx - contexts);
+  QueueHandle_t queue = js_worker_queues[index];
+  js_event_t ev;
+  while (xQueueReceive(queue, &ev, 0) == pdTRUE)
+  {
+    free(ev.data);
+  }
+  vQueueDelete(queue);
+  js_worker_queues[index] = NULL;
+
+  jerry_value_free(ctx->parent_callback);
+  ctx->parent_callback = jerry_undefined();
+  ESP_LOGI(TAG, "Worker %lu exited", ctx->id);
+  ctx->id = 0;
+}
+
+void js_worker_dispatch_event(js_event_t *event)
+{
+  js_message_t *message = (js_message_t *)event->data;
+  jerry_value_t callback;
+
+  if (in_main_context())
+  {
+    js_context_t *ctx = find_worker(event->handle_id);
+    if (!ctx)
+    {
+      free(message); // Sent just before the worker exited
+      return;
+    }
+    if (!message)
+    {
+      retire_worker(ctx);
+      return;
+    }
+    __atomic_sub_fetch(&ctx->to_parent, 1, __ATOMIC_RELAXED);
+    callback = ctx->parent_callback;
+  }
+  else
+  {
+    if (!message)
+    {
+      return; // A wake-up from js_worker_terminate()
+    }
+    __atomic_sub_fetch(&current_context->to_worker, 1, __ATOMIC_RELAXED);
+    callback = current_context->callback;
+  }
+
+  if (jerry_value_is_function(callback))
+  {
+    jerry_value_t value = js_clone_deserialize(message->bytes, message->len);
+    if (jerry_value_is_exception(value))
+    {
+      print_js_error(value);
+    }
+    else
+    {
+      jerry_value_t global = jerry_current_realm();
+      jerry_value_t res = jerry_call(callback, global, &value, 1);
+      jerry_value_free(global);
+      if (jerry_value_is_exception(res))
+      {
+        print_js_error(res);
+      }
+      jerry_value_free(res);
+    }
+    jerry_value_free(value);
+  }
+  free(message);
+}
+
+#endif /* CONFIG_JS_WORKERS */
@@ -1,6 +1,8 @@
 #ifndef JS_MODULE_RESOLVER_H
 #define JS_MODULE_RESOLVER_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include "jerryscript-ext/module.h"
 
 /**
@@ -12,4 +14,59 @@
  */
 void js_run_main_module(void);
 
+/**
+ * @brief Loads, links and evaluates the module at `path` in the script directory.
+ *
+ * Used for `main.js` and for the entry script of each worker context.
+ * Errors are logged rather than returned.
+ */
+void js_run_module(const char *path);
+
+/**
+ * @brief Sets the directory scripts are loaded from.
+ *
+ * Defaults to "/storage", where the storage partition is mounted. The string
+ * is not copied and must outlive the runtime.
+ */
+void js_module_resolver_set_root(const char *dir);
+
+/**
+ * @brief Returns the directory scripts are loaded from.
+ */
+const char *js_module_resolver_root(void);
+
+/**
+ * @brief Time spent getting scripts off the filesystem, for `perf.boot()`.
+ */
+typedef struct
+{
+  const char *filesystem; /**< Set by whoever mounted the script directory, or NULL. */
+  int64_t mount_us;       /**< How long mounting it took. */
+  uint32_t files_read;    /**< Calls to js_module_resolver_read_file() that succeeded. */
+  size_t bytes_read;
+  int64_t read_us;        /**< Total time spent in those calls. */
+} js_module_resolver_stats_t;
+
+/**
+ * @brief Records which filesystem holds the script directory and how long it took to mount.
+ *
+ * `filesystem` is not copied.
+ */
+void js_module_resolver_set_mount_info(const char *filesystem, int64_t mount_us);
+
+/**
+ * @brief Returns the mount and read timings so far.
+ */
+js_module_resolver_stats_t js_module_resolver_stats(void);
+
+/**
+ * @brief Reads a file from the script directory into a newly allocated buffer.
+ *
+ * @param path The relative path to the file within the script directory (e.g., "main.js").
+ * @param out_size Pointer to a size_t where the file size will be stored.
+ * @return A pointer to the allocated buffer with the file content, or NULL on
+ * failure. The caller is responsible for freeing this buffer.
+ */
+unsigned char *js_module_resolver_read_file(const char *path, size_t *out_size);
+
 #endif /* JS_MODULE_RESOLVER_H */
@@ -1,39 +1,70 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <sys/stat.h>
 
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "jerryscript.h"
 #include "js_main_thread.h"
 #include "js_std_lib.h" // For js_get_native_module
 #include "js_module_resolver.h"
 
 #define TAG "MODULE_RESOLVER"
-#define SPIFFS_DIR "/storage"
+#define STORAGE_DIR "/storage"
 #define MAX_PATH_LENGTH 64
 
+/// @brief Directory that module paths are resolved against.
+static const char *script_root = STORAGE_DIR;
+
+static js_module_resolver_stats_t stats;
+
+void js_module_resolver_set_root(const char *dir)
+{
+  script_root = dir;
+}
+
+const char *js_module_resolver_root(void)
+{
+  return script_root;
+}
+
+void js_module_resolver_set_mount_info(const char *filesystem, int64_t mount_us)
+{
+  stats.filesystem = filesystem;
+  stats.mount_us = mount_us;
+}
+
+js_module_resolver_stats_t js_module_resolver_stats(void)
+{
+  return stats;
+}
+
 /**
- * @brief Reads a file from the SPIFFS filesystem into a newly allocated buffer.
- *
- * @param path The relative path to the file within the SPIFFS directory (e.g., "main.js").
- * @param out_size Pointer to a size_t where the file size will be stored.
- * @return A pointer to the allocated buffer with the file content, or NULL on
- * failure. The caller is responsible for freeing this buffer.
+ * @brief Reads a file from the script directory into a newly allocated buffer.
  */
-static unsigned char *read_file_into_buffer(const char *path, size_t *out_size)
+unsigned char *js_module_resolver_read_file(const char *path, size_t *out_size)
 {
   char full_path[MAX_PATH_LENGTH];
-  snprintf(full_path, MAX_PATH_LENGTH, "%s/%s", SPIFFS_DIR, path);
+  snprintf(full_path, MAX_PATH_LENGTH, "%s/%s", script_root, path);
   ESP_LOGI(TAG, "Attempting to load module from path: %s", full_path);
+  int64_t start = esp_timer_get_time();
   FILE *file = fopen(full_path, "rb");
   if (!file)
   {
     ESP_LOGE(TAG, "File not found: %s", full_path);
     return NULL;
   }
-  fseek(file, 0, SEEK_END);
-  size_t size = ftell(file);
-  rewind(file);
+  // fstat() reads the size from the file's metadata; seeking to the end and
+  // back costs two extra page walks on SPIFFS.
+  struct stat st;
+  if (fstat(fileno(file), &st) != 0)
+  {
+    ESP_LOGE(TAG, "Cannot stat module: %s", full_path);
+    fclose(file);
+    return NULL;
+  }
+  size_t size = st.st_size;
   unsigned char *buffer = malloc(size + 1);
   if (!buffer)
   {
@@ -50,6 +81,9 @@ static unsigned char *read_file_into_buffer(const char *path, size_t *out_size)
   }
   buffer[size] = '\0';
   fclose(file);
+  stats.files_read++;
+  stats.bytes_read += size;
+  stats.read_us += esp_timer_get_time() - start;
   if (out_size)
   {
     *out_size = size;
@@ -95,7 +129,7 @@ static bool is_file_specifier(const jerry_char_t *specifier)
  * 1. Check if the specifier looks like a file path. If not, try to resolve it
  * as a native module using `js_get_native_module`.
  * 2. If it is a file path, or if native resolution fails, attempt to load the
- * corresponding file from the SPIFFS filesystem.
+ * corresponding file from the script directory.
  *
  * @param specifier The module specifier string from the import statement.
  * @param referrer The module that is doing the importing (unused).
@@ -148,7 +182,7 @@ static jerry_value_t module_resolve_callback(const jerry_value_t specifier,
   }
 
   size_t script_size = 0;
-  unsigned char *script_buffer = read_file_into_buffer(path_buf, &script_size);
+  unsigned char *script_buffer = js_module_resolver_read_file(path_buf, &script_size);
 
   if (script_buffer == NULL)
   {
@@ -166,27 +200,27 @@ static jerry_value_t module_resolve_callback(const jerry_value_t specifier,
   return new_module;
 }
 
-void js_run_main_module(void)
+void js_run_module(const char *path)
 {
-  const char *main_file_name = "main.js";
   size_t script_size = 0;
-  unsigned char *script_buffer = read_file_into_buffer("main.js", &script_size);
+  unsigned char *script_buffer = js_module_resolver_read_file(path, &script_size);
   if (script_buffer == NULL)
   {
-    ESP_LOGE(TAG, "Could not load main.js. Aborting.");
+    ESP_LOGE(TAG, "Could not load %s. Aborting.", path);
     return;
   }
 
   jerry_parse_options_t parse_options = {
       .options = JERRY_PARSE_MODULE | JERRY_PARSE_HAS_SOURCE_NAME,
-      .source_name = jerry_string_sz(main_file_name),
+      .source_name = jerry_string_sz(path),
   };
   jerry_value_t main_module = jerry_parse(script_buffer, script_size, &parse_options);
+  jerry_value_free(parse_options.source_name);
   free(script_buffer);
 
   if (jerry_value_is_exception(main_module))
   {
-    ESP_LOGE(TAG, "Failed to parse main.js.");
+    ESP_LOGE(TAG, "Failed to parse %s.", path);
     print_js_error(main_module);
     jerry_value_free(main_module);
     return;
@@ -216,3 +250,8 @@ void js_run_main_module(void)
   jerry_value_free(main_module);
   ESP_LOGI(TAG, "Module execution finished.");
 }
+
+void js_run_main_module(void)
+{
+  js_run_module("main.js");
+}
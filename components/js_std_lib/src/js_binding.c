@@ -0,0 +1,55 @@
+#include "jerryscript.h"
+
+#include "js_binding.h"
+
+/**
+ * @brief Sets every function of `table` as an export of `native_module`.
+ */
+jerry_value_t js_binding_export(jerry_value_t native_module, const js_binding_table_t *table)
+{
+  for (size_t i = 0; i < table->count; i++)
+  {
+    jerry_value_t func = jerry_function_external(table->entries[i].handler);
+    jerry_value_t name = jerry_string_sz(table->entries[i].name);
+    jerry_value_free(jerry_native_module_set(native_module, name, func));
+    jerry_value_free(name);
+    jerry_value_free(func);
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Sets every function of `table` as a property of `object`.
+ */
+void js_binding_set_properties(jerry_value_t object, const js_binding_table_t *table)
+{
+  for (size_t i = 0; i < table->count; i++)
+  {
+    jerry_value_t func = jerry_function_external(table->entries[i].handler);
+    jerry_value_t name = jerry_string_sz(table->entries[i].name);
+    jerry_value_free(jerry_object_set(object, name, func));
+    jerry_value_free(name);
+    jerry_value_free(func);
+  }
+}
+
+/**
+ * @brief Creates a native module declaring the names in `table` as its exports.
+ */
+jerry_value_t js_binding_native_module(const js_binding_table_t *table, jerry_native_module_evaluate_cb_t evaluate_cb)
+{
+  jerry_value_t exports[table->count];
+  for (size_t i = 0; i < table->count; i++)
+  {
+    exports[i] = jerry_string_sz(table->entries[i].name);
+  }
+
+  // Declaring the exports up front lets the linker resolve imports before evaluate_cb runs.
+  jerry_value_t native_module = jerry_native_module(evaluate_cb, exports, table->count);
+
+  for (size_t i = 0; i < table->count; i++)
+  {
+    jerry_value_free(exports[i]);
+  }
+  return native_module;
+}
@@ -0,0 +1,203 @@
+#ifndef JS_BINDING_H
+#define JS_BINDING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/arg.h"
+
+/**
+ * @brief One native function exposed to JavaScript under `name`.
+ */
+typedef struct
+{
+  const char *name;
+  jerry_external_handler_t handler;
+} js_binding_t;
+
+/**
+ * @brief The functions a native module exports, in export order.
+ *
+ * The same table fills the module namespace, any global binding of the
+ * module and the export list the registry declares to the linker, so the
+ * three cannot drift apart.
+ */
+typedef struct
+{
+  const js_binding_t *entries;
+  size_t count;
+} js_binding_table_t;
+
+#define JS_BINDING_ENTRY(name, handler) {name, handler},
+
+/**
+ * @brief Defines `<prefix>_bindings` from an X-macro list of functions.
+ *
+ * `LIST` is a macro taking one argument, X, and expanding to an
+ * `X("name", handler)` row per function:
+ *
+ *     #define TIMERS_BINDINGS(X)               \
+ *       X("setTimeout", js_set_timeout)        \
+ *       X("clearTimeout", js_clear_timeout)
+ *     JS_BINDING_TABLE(timers, TIMERS_BINDINGS);
+ *
+ * Rows that depend on the configuration go in a second list that expands to
+ * nothing when disabled, spliced into the first.
+ */
+#define JS_BINDING_TABLE(prefix, LIST)                                                 \
+  static const js_binding_t prefix##_binding_entries[] = {LIST(JS_BINDING_ENTRY)};     \
+  const js_binding_table_t prefix##_bindings = {                                       \
+      .entries = prefix##_binding_entries,                                             \
+      .count = sizeof(prefix##_binding_entries) / sizeof(prefix##_binding_entries[0]), \
+  }
+
+/**
+ * @brief Sets every function of `table` as an export of `native_module`.
+ *
+ * @return `jerry_undefined()`, so a module's evaluate callback can return it.
+ */
+jerry_value_t js_binding_export(jerry_value_t native_module, const js_binding_table_t *table);
+
+/**
+ * @brief Sets every function of `table` as a property of `object`, such as the global object.
+ */
+void js_binding_set_properties(jerry_value_t object, const js_binding_table_t *table);
+
+/**
+ * @brief Creates a native module declaring the names in `table` as its exports.
+ */
+jerry_value_t js_binding_native_module(const js_binding_table_t *table, jerry_native_module_evaluate_cb_t evaluate_cb);
+
+// --- Argument fast paths ---
+//
+// Each helper reads argument `index`. When it already has the expected type
+// the value is taken directly; anything else goes through jerryx_arg with the
+// same options the handler used before, so coercion and error messages are
+// unchanged.
+
+/**
+ * @brief The slow path: converts argument `index` with a single jerryx_arg `mapping`.
+ */
+static inline jerry_value_t js_binding_arg_slow(const jerry_value_t args[], jerry_length_t argc, jerry_length_t index,
+                                                const jerryx_arg_t *mapping)
+{
+  return jerryx_arg_transform_args(index < argc ? args + index : args, index < argc ? argc - index : 0, mapping, 1);
+}
+
+/**
+ * @brief A required number argument, coerced if it is not one.
+ */
+static inline jerry_value_t js_binding_arg_number(const jerry_value_t args[], jerry_length_t argc, jerry_length_t index,
+                                                  double *out)
+{
+  if (index < argc && jerry_value_is_number(args[index]))
+  {
+    *out = jerry_value_as_number(args[index]);
+    return jerry_undefined();
+  }
+  const jerryx_arg_t mapping[] = {jerryx_arg_number(out, JERRYX_ARG_COERCE, JERRYX_ARG_REQUIRED)};
+  return js_binding_arg_slow(args, argc, index, mapping);
+}
+
+/**
+ * @brief A required boolean argument, coerced if it is not one.
+ */
+static inline jerry_value_t js_binding_arg_boolean(const jerry_value_t args[], jerry_length_t argc, jerry_length_t index,
+                                                   bool *out)
+{
+  if (index < argc && jerry_value_is_boolean(args[index]))
+  {
+    *out = jerry_value_is_true(args[index]);
+    return jerry_undefined();
+  }
+  const jerryx_arg_t mapping[] = {jerryx_arg_boolean(out, JERRYX_ARG_COERCE, JERRYX_ARG_REQUIRED)};
+  return js_binding_arg_slow(args, argc, index, mapping);
+}
+
+/**
+ * @brief A required function argument. `*out` is borrowed from `args`, not copied.
+ */
+static inline jerry_value_t js_binding_arg_function(const jerry_value_t args[], jerry_length_t argc,
+                                                    jerry_length_t index, jerry_value_t *out)
+{
+  if (index < argc && jerry_value_is_function(args[index]))
+  {
+    *out = args[index];
+    return jerry_undefined();
+  }
+  const jerryx_arg_t mapping[] = {jerryx_arg_function(out, JERRYX_ARG_REQUIRED)};
+  return js_binding_arg_slow(args, argc, index, mapping);
+}
+
+/**
+ * @brief The fast path of the unsigned integer helpers: reads argument
+ * `index` if it is a number of 0..`max`, floored.
+ *
+ * @return False if the caller must fall back to jerryx_arg, which then throws
+ * for anything out of range, as jerryx_arg_uint8/16/32 with JERRYX_ARG_FLOOR
+ * and JERRYX_ARG_NO_CLAMP do.
+ */
+static inline bool js_binding_arg_uint_fast(const jerry_value_t args[], jerry_length_t argc, jerry_length_t index,
+                                            double max, uint32_t *out)
+{
+  if (index < argc && jerry_value_is_number(args[index]))
+  {
+    double value = jerry_value_as_number(args[index]);
+    if (value >= 0 && value < max + 1)
+    {
+      *out = (uint32_t)value;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief A required integer argument of 0-255, floored and not coerced.
+ */
+static inline jerry_value_t js_binding_arg_uint8(const jerry_value_t args[], jerry_length_t argc, jerry_length_t index,
+                                                 uint8_t *out)
+{
+  uint32_t value;
+  if (js_binding_arg_uint_fast(args, argc, index, UINT8_MAX, &value))
+  {
+    *out = (uint8_t)value;
+    return jerry_undefined();
+  }
+  const jerryx_arg_t mapping[] = {
+      jerryx_arg_uint8(out, JERRYX_ARG_FLOOR, JERRYX_ARG_NO_CLAMP, JERRYX_ARG_NO_COERCE, JERRYX_ARG_REQUIRED),
+  };
+  return js_binding_arg_slow(args, argc, index, mapping);
+}
+
+/**
+ * @brief A required integer argument of 0-65535, floored and not coerced.
+ */
+static inline jerry_value_t js_binding_arg_uint16(const jerry_value_t args[], jerry_length_t argc,
+                                                  jerry_length_t index, uint16_t *out)
+{
+  uint32_t value;
+  if (js_binding_arg_uint_fast(args, argc, index, UINT16_MAX, &value))
+  {
+    *out = (uint16_t)value;
+    return jerry_undefined();
+  }
+  const jerryx_arg_t mapping[] = {
+      jerryx_arg_uint16(out, JERRYX_ARG_FLOOR, JERRYX_ARG_NO_CLAMP, JERRYX_ARG_NO_COERCE, JERRYX_ARG_REQUIRED),
+  };
+  return js_binding_arg_slow(args, argc, index, mapping);
+}
+
+/**
+ * @brief An optional number argument, or `fallback` if it is missing or not a number.
+ *
+ * Never throws, so there is no slow path.
+ */
+static inline double js_binding_arg_optional_number(const jerry_value_t args[], jerry_length_t argc,
+                                                    jerry_length_t index, double fallback)
+{
+  return index < argc && jerry_value_is_number(args[index]) ? jerry_value_as_number(args[index]) : fallback;
+}
+
+#endif /* JS_BINDING_H */
@@ -1,11 +1,33 @@
+#include <stdbool.h>
 #include <string.h>
+#include "sdkconfig.h"
 #include "esp_log.h"
 #include "jerryscript.h"
 
 #include "js_std_lib.h"
+#include "js_binding.h"
 #include "module_console.h"
 #include "module_gpio.h"
 #include "module_timers.h"
+#include "module_i2c.h"
+#include "module_spi.h"
+#include "module_perf.h"
+#include "module_runtime.h"
+#include "module_storage.h"
+#include "module_fs.h"
+#include "module_net.h"
+#include "module_buffer.h"
+#include "module_dsp.h"
+#include "module_codec.h"
+#if CONFIG_JS_WORKERS
+#include "module_worker.h"
+#include "js_worker.h"
+#endif
+#if !CONFIG_IDF_TARGET_LINUX
+#include "module_rmt.h"
+#include "module_adc.h"
+#include "module_serial.h"
+#endif
 
 #define TAG "JS_STD_LIBRARY"
 
@@ -18,15 +40,10 @@ typedef struct
 {
   const char *name;                              /**< The module specifier (e.g., "gpio"). */
   jerry_native_module_evaluate_cb_t evaluate_cb; /**< The callback to populate the module's exports. */
-  const char **exports;                          /**< A NULL-terminated list of exported function/variable names. */
-  size_t export_count;                           /**< The number of exports. */
+  const js_binding_table_t *bindings;            /**< The exported functions, whose names are declared to the linker. */
+  bool in_workers;                               /**< Whether worker contexts may import it. */
 } native_module_def_t;
 
-// Define the lists of exported names for our native modules
-const char *console_exports[] = {"log", "warn", "error"};
-const char *gpio_exports[] = {"setup", /* "reset_pin", "get_level", "set_level" */};
-const char *timers_exports[] = {"setTimeout", "clearTimeout", "setInterval", "clearInterval"};
-
 /**
  * @brief A central registry of all available native C modules.
  *
@@ -34,9 +51,28 @@ const char *timers_exports[] = {"setTimeout", "clearTimeout", "setInterval", "cl
  * for a module with a matching name.
  */
 static const native_module_def_t native_module_registry[] = {
-    {.name = "console", .evaluate_cb = console_module_evaluate, .exports = console_exports, .export_count = 3},
-    {.name = "gpio", .evaluate_cb = gpio_module_evaluate, .exports = gpio_exports, .export_count = 1},
-    {.name = "timers", .evaluate_cb = timers_module_evaluate, .exports = timers_exports, .export_count = 4}
+    {.name = "console", .evaluate_cb = console_module_evaluate, .bindings = &console_bindings, .in_workers = true},
+    {.name = "gpio", .evaluate_cb = gpio_module_evaluate, .bindings = &gpio_bindings},
+    {.name = "timers", .evaluate_cb = timers_module_evaluate, .bindings = &timers_bindings, .in_workers = true},
+    {.name = "i2c", .evaluate_cb = i2c_module_evaluate, .bindings = &i2c_bindings},
+    {.name = "spi", .evaluate_cb = spi_module_evaluate, .bindings = &spi_bindings},
+    {.name = "runtime", .evaluate_cb = runtime_module_evaluate, .bindings = &runtime_bindings},
+    {.name = "perf", .evaluate_cb = perf_module_evaluate, .bindings = &perf_bindings, .in_workers = true},
+    {.name = "storage", .evaluate_cb = storage_module_evaluate, .bindings = &storage_bindings},
+    {.name = "fs", .evaluate_cb = fs_module_evaluate, .bindings = &fs_bindings},
+    {.name = "net", .evaluate_cb = net_module_evaluate, .bindings = &net_bindings},
+    {.name = "buffer", .evaluate_cb = buffer_module_evaluate, .bindings = &buffer_bindings, .in_workers = true},
+    {.name = "dsp", .evaluate_cb = dsp_module_evaluate, .bindings = &dsp_bindings, .in_workers = true},
+    {.name = "codec", .evaluate_cb = codec_module_evaluate, .bindings = &codec_bindings, .in_workers = true},
+#if CONFIG_JS_WORKERS
+    {.name = "worker", .evaluate_cb = worker_module_evaluate, .bindings = &worker_bindings, .in_workers = true},
+#endif
+#if !CONFIG_IDF_TARGET_LINUX
+    // Modules that need real peripherals; I2C and SPI have mock buses instead.
+    {.name = "rmt", .evaluate_cb = rmt_module_evaluate, .bindings = &rmt_bindings},
+    {.name = "adc", .evaluate_cb = adc_module_evaluate, .bindings = &adc_bindings},
+    {.name = "serial", .evaluate_cb = serial_module_evaluate, .bindings = &serial_bindings},
+#endif
     // Add new native modules here
 };
 
@@ -81,23 +117,15 @@ jerry_value_t js_get_native_module(const jerry_value_t specifier)
 
       const native_module_def_t *def = &native_module_registry[i];
 
-      // Create an array of jerry_value_t strings for the export names
-      jerry_value_t exports[def->export_count];
-      for (size_t j = 0; j < def->export_count; j++)
-      {
-        exports[j] = jerry_string_sz(def->exports[j]);
-      }
-
-      // Create the native module, DECLARING its exports to the linker
-      jerry_value_t native_module = jerry_native_module(def->evaluate_cb, exports, def->export_count);
-
-      // Clean up the jerry_value_t strings
-      for (size_t j = 0; j < def->export_count; j++)
+#if CONFIG_JS_WORKERS
+      // Peripheral state and event routing belong to the main context.
+      if (!def->in_workers && js_context_index() != JS_MAIN_CONTEXT)
       {
-        jerry_value_free(exports[j]);
+        return jerry_throw_sz(JERRY_ERROR_COMMON, "Module is not available in workers.");
       }
+#endif
 
-      return native_module;
+      return js_binding_native_module(def->bindings, def->evaluate_cb);
     }
   }
 
@@ -0,0 +1,278 @@
+#include <string.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+#include "jerryscript-ext/arg.h"
+#include "esp_log.h"
+
+#include "js_binding.h"
+#include "js_adc.h"
+#include "module_adc.h"
+
+#define TAG "ADC_MODULE"
+
+#define DEFAULT_SAMPLE_RATE_HZ 20000
+#define DEFAULT_DECIMATION 20
+#define DEFAULT_BLOCK_SIZE 64
+
+// Forward declaration for the native object's free callback
+static void analog_pin_native_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+
+/**
+ * @brief JerryScript native object info. Connects a JS object to our js_adc_pin_t struct.
+ */
+static const jerry_object_native_info_t analog_pin_native_info = {
+    .free_cb = analog_pin_native_free_cb,
+};
+
+/**
+ * @brief Converts an attenuation name to its driver value.
+ * @return True if the name is recognised.
+ */
+static bool parse_attenuation(const char *str, adc_atten_t *out_atten)
+{
+  if (strlen(str) == 0 || strcmp(str, "12db") == 0)
+    *out_atten = ADC_ATTEN_DB_12;
+  else if (strcmp(str, "6db") == 0)
+    *out_atten = ADC_ATTEN_DB_6;
+  else if (strcmp(str, "2.5db") == 0)
+    *out_atten = ADC_ATTEN_DB_2_5;
+  else if (strcmp(str, "0db") == 0)
+    *out_atten = ADC_ATTEN_DB_0;
+  else
+    return false;
+  return true;
+}
+
+// --- AnalogPin Object Method Implementations (Bindings) ---
+
+static jerry_value_t
+js_analog_read_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_adc_pin_t *pin = (js_adc_pin_t *)jerry_object_get_native_ptr(call_info_p->this_value, &analog_pin_native_info);
+  if (!pin)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "AnalogPin is closed or invalid.");
+  }
+
+  int raw;
+  if (js_adc_read_raw(pin, &raw) != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "ADC conversion failed.");
+  }
+  return jerry_number(raw);
+}
+
+static jerry_value_t
+js_analog_read_voltage_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_adc_pin_t *pin = (js_adc_pin_t *)jerry_object_get_native_ptr(call_info_p->this_value, &analog_pin_native_info);
+  if (!pin)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "AnalogPin is closed or invalid.");
+  }
+
+  int mv;
+  esp_err_t err = js_adc_read_mv(pin, &mv);
+  if (err == ESP_ERR_NOT_SUPPORTED)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "ADC calibration is not available on this chip.");
+  }
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "ADC conversion failed.");
+  }
+  return jerry_number(mv);
+}
+
+static jerry_value_t
+js_analog_close_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_adc_pin_t *pin = (js_adc_pin_t *)jerry_object_get_native_ptr(call_info_p->this_value, &analog_pin_native_info);
+
+  if (pin)
+  {
+    js_adc_close(pin);
+    // Remove the native pointer from the JS object to prevent use-after-free
+    jerry_object_set_native_ptr(call_info_p->this_value, NULL, NULL);
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Callback when an AnalogPin object is garbage collected.
+ */
+static void analog_pin_native_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  js_adc_pin_t *pin = (js_adc_pin_t *)native_p;
+  if (pin)
+  {
+    ESP_LOGD(TAG, "GC collecting analog pin %d, ensuring cleanup.", pin->pin_num);
+    js_adc_close(pin);
+  }
+}
+
+// --- Module Function Implementations ---
+
+/**
+ * @brief Native implementation of `adc.setup(pin, config)`.
+ */
+static jerry_value_t
+js_adc_setup_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_number(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "First argument must be a pin number.");
+
+  char atten_str[8] = "";
+  if (argc > 1 && jerry_value_is_object(args[1]))
+  {
+    const char *prop_names[] = {"attenuation"};
+    const jerryx_arg_t prop_mapping[] = {
+        jerryx_arg_string(atten_str, sizeof(atten_str), JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+    };
+    jerry_value_t result = jerryx_arg_transform_object_properties(args[1], (const jerry_char_t **)prop_names, 1,
+                                                                  prop_mapping, 1);
+    if (jerry_value_is_exception(result))
+    {
+      return result;
+    }
+    jerry_value_free(result);
+  }
+
+  adc_atten_t atten;
+  if (!parse_attenuation(atten_str, &atten))
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Unknown attenuation.");
+  }
+
+  gpio_num_t pin_num = (gpio_num_t)jerry_value_as_number(args[0]);
+  js_adc_pin_t *pin;
+  if (js_adc_open(pin_num, atten, &pin) != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to configure analog pin.");
+  }
+
+  jerry_value_t pin_obj = jerry_object();
+  jerry_object_set_native_ptr(pin_obj, &analog_pin_native_info, pin);
+
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("read", js_analog_read_handler),
+      JERRYX_PROPERTY_FUNCTION("readVoltage", js_analog_read_voltage_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_analog_close_handler),
+      JERRYX_PROPERTY_NUMBER("pin", pin_num),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(pin_obj, props);
+
+  return pin_obj;
+}
+
+/**
+ * @brief Native implementation of `adc.startStream(pin, config, callback)`.
+ */
+static jerry_value_t
+js_adc_start_stream_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 3)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected 3 arguments: pin, config object and callback.");
+  if (!jerry_value_is_number(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "First argument must be a pin number.");
+  if (!jerry_value_is_object(args[1]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Second argument must be a config object.");
+  if (!jerry_value_is_function(args[2]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Third argument must be a callback function.");
+
+  double sample_rate = DEFAULT_SAMPLE_RATE_HZ;
+  double decimation = DEFAULT_DECIMATION;
+  double block_size = DEFAULT_BLOCK_SIZE;
+  char reduce_str[16] = "";
+  char atten_str[8] = "";
+
+  const char *prop_names[] = {"sampleRate", "decimation", "blockSize", "reduce", "attenuation"};
+  const jerryx_arg_t prop_mapping[] = {
+      jerryx_arg_number(&sample_rate, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&decimation, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&block_size, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_string(reduce_str, sizeof(reduce_str), JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_string(atten_str, sizeof(atten_str), JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+  };
+  jerry_value_t result = jerryx_arg_transform_object_properties(args[1], (const jerry_char_t **)prop_names, 5,
+                                                                prop_mapping, 5);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+
+  js_adc_stream_config_t config = {
+      .pin_num = (gpio_num_t)jerry_value_as_number(args[0]),
+      .sample_rate_hz = (uint32_t)sample_rate,
+      .decimation = (uint32_t)decimation,
+      .block_size = (uint32_t)block_size,
+  };
+  if (config.block_size == 0)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "blockSize must be at least 1.");
+  if (!parse_attenuation(atten_str, &config.atten))
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Unknown attenuation.");
+
+  if (strlen(reduce_str) == 0 || strcmp(reduce_str, "average") == 0)
+    config.reduce = JS_ADC_REDUCE_AVERAGE;
+  else if (strcmp(reduce_str, "min") == 0)
+    config.reduce = JS_ADC_REDUCE_MIN;
+  else if (strcmp(reduce_str, "max") == 0)
+    config.reduce = JS_ADC_REDUCE_MAX;
+  else if (strcmp(reduce_str, "decimate") == 0)
+    config.reduce = JS_ADC_REDUCE_DECIMATE;
+  else
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Unknown reduce mode.");
+
+  esp_err_t err = js_adc_stream_start(&config, args[2]);
+  if (err == ESP_ERR_INVALID_STATE)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "An ADC stream is already running.");
+  }
+  if (err == ESP_ERR_NOT_SUPPORTED)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Continuous sampling requires an ADC1 pin.");
+  }
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to start ADC stream.");
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Native implementation of `adc.stopStream()`.
+ */
+static jerry_value_t
+js_adc_stop_stream_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_adc_stream_stop();
+  return jerry_undefined();
+}
+
+/**
+ * @brief Native implementation of `adc.streamOverruns()`.
+ */
+static jerry_value_t
+js_adc_stream_overruns_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  return jerry_number(js_adc_stream_overruns());
+}
+
+#define ADC_BINDINGS(X)                         \
+  X("setup", js_adc_setup_handler)              \
+  X("startStream", js_adc_start_stream_handler) \
+  X("stopStream", js_adc_stop_stream_handler)   \
+  X("streamOverruns", js_adc_stream_overruns_handler)
+
+JS_BINDING_TABLE(adc, ADC_BINDINGS);
+
+/**
+ * @brief The evaluation callback for the native 'adc' module.
+ */
+jerry_value_t
+adc_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &adc_bindings);
+}
@@ -0,0 +1,22 @@
+#ifndef MODULE_ADC_H
+#define MODULE_ADC_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'adc' module.
+ *
+ * This function is called by the JerryScript engine when the 'adc' module is
+ * first evaluated. It populates the module's namespace with the one-shot
+ * `setup` function and the continuous sampling functions.
+ *
+ * @param native_module The jerry_value_t representing the 'adc' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t adc_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'adc' module exports; the registry declares their names.
+extern const js_binding_table_t adc_bindings;
+
+#endif /* MODULE_ADC_H */
@@ -0,0 +1,587 @@
+#include <stdlib.h>
+#include <string.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+
+#include "js_binding.h"
+#include "js_buffer.h"
+#include "module_buffer.h"
+
+static void layout_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+
+static const jerry_object_native_info_t layout_native_info = {
+    .free_cb = layout_free_cb,
+};
+
+// --- Helpers ---
+
+/**
+ * @brief Finds the bytes of an ArrayBuffer or TypedArray without copying them.
+ *
+ * @return false if `value` is neither.
+ */
+static bool buffer_bytes(jerry_value_t value, uint8_t **data, size_t *len)
+{
+  if (jerry_value_is_arraybuffer(value))
+  {
+    *data = jerry_arraybuffer_data(value);
+    *len = jerry_arraybuffer_size(value);
+    return true;
+  }
+  if (jerry_value_is_typedarray(value))
+  {
+    jerry_length_t offset, length;
+    jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, &length);
+    uint8_t *bytes = jerry_arraybuffer_data(buffer);
+    jerry_value_free(buffer);
+    *data = bytes ? bytes + offset : NULL;
+    *len = bytes ? length : 0;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Reads the bytes argument every function of the module starts with.
+ */
+static jerry_value_t read_data(const jerry_value_t args[], jerry_length_t argc, uint8_t **data, size_t *len)
+{
+  if (argc < 1 || !buffer_bytes(args[0], data, len))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected an ArrayBuffer or TypedArray.");
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Reads an optional integer argument, such as the CRC to continue from.
+ */
+static uint32_t optional_uint32(const jerry_value_t args[], jerry_length_t argc, jerry_length_t index, uint32_t fallback)
+{
+  return (uint32_t)js_binding_arg_optional_number(args, argc, index, fallback);
+}
+
+/**
+ * @brief Wraps the first `len` bytes of a new ArrayBuffer holding `data` in a Uint8Array.
+ */
+static jerry_value_t new_uint8_array(const uint8_t *data, size_t len)
+{
+  jerry_value_t buffer = jerry_arraybuffer(len);
+  jerry_arraybuffer_write(buffer, 0, data, len);
+  jerry_value_t array = jerry_typedarray_with_buffer(JERRY_TYPEDARRAY_UINT8, buffer);
+  jerry_value_free(buffer);
+  return array;
+}
+
+// --- Checksums ---
+
+/**
+ * @brief Native implementation of `buffer.crc8(data, previous)`.
+ */
+static jerry_value_t
+js_buffer_crc8_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  uint8_t *data;
+  size_t len;
+  jerry_value_t result = read_data(args, argc, &data, &len);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  return jerry_number(js_buffer_crc8((uint8_t)optional_uint32(args, argc, 1, 0), data, len));
+}
+
+/**
+ * @brief Native implementation of `buffer.crc16(data, previous)`.
+ */
+static jerry_value_t
+js_buffer_crc16_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  uint8_t *data;
+  size_t len;
+  jerry_value_t result = read_data(args, argc, &data, &len);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  return jerry_number(js_buffer_crc16_ccitt((uint16_t)optional_uint32(args, argc, 1, 0xFFFF), data, len));
+}
+
+/**
+ * @brief Native implementation of `buffer.crc16modbus(data, previous)`.
+ */
+static jerry_value_t
+js_buffer_crc16_modbus_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                               const jerry_length_t argc)
+{
+  uint8_t *data;
+  size_t len;
+  jerry_value_t result = read_data(args, argc, &data, &len);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  return jerry_number(js_buffer_crc16_modbus((uint16_t)optional_uint32(args, argc, 1, 0xFFFF), data, len));
+}
+
+/**
+ * @brief Native implementation of `buffer.crc32(data, previous)`.
+ */
+static jerry_value_t
+js_buffer_crc32_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  uint8_t *data;
+  size_t len;
+  jerry_value_t result = read_data(args, argc, &data, &len);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  return jerry_number(js_buffer_crc32(optional_uint32(args, argc, 1, 0), data, len));
+}
+
+// --- Text encodings ---
+
+typedef void (*encode_fn)(const uint8_t *data, size_t len, char *out);
+typedef esp_err_t (*decode_fn)(const char *text, size_t len, uint8_t *out, size_t *out_len);
+
+/**
+ * @brief Encodes `args[0]` to a string, or as ASCII into the buffer `args[1]`.
+ *
+ * @return The string, or the number of bytes written to the buffer.
+ */
+static jerry_value_t encode(const jerry_value_t args[], jerry_length_t argc, encode_fn fn, size_t encoded_len(size_t))
+{
+  uint8_t *data;
+  size_t len;
+  jerry_value_t result = read_data(args, argc, &data, &len);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  size_t out_len = encoded_len(len);
+
+  uint8_t *target;
+  size_t target_len;
+  if (argc > 1 && buffer_bytes(args[1], &target, &target_len))
+  {
+    if (target_len < out_len)
+    {
+      return jerry_throw_sz(JERRY_ERROR_RANGE, "Target buffer is too small.");
+    }
+    fn(data, len, (char *)target);
+    return jerry_number(out_len);
+  }
+
+  char *out = malloc(out_len ? out_len : 1);
+  if (out == NULL)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  fn(data, len, out);
+  jerry_value_t text = jerry_string((const jerry_char_t *)out, out_len, JERRY_ENCODING_UTF8);
+  free(out);
+  return text;
+}
+
+/**
+ * @brief Decodes the string or ASCII bytes `args[0]` into a new Uint8Array, or into the buffer `args[1]`.
+ *
+ * @return The Uint8Array, or the number of bytes written to the buffer.
+ */
+static jerry_value_t decode(const jerry_value_t args[], jerry_length_t argc, decode_fn fn, const char *invalid)
+{
+  // Strings are copied out of the engine heap once; the decoders then work in place on the copy.
+  char *text = NULL;
+  char *copy = NULL;
+  size_t len = 0;
+  if (argc > 0 && jerry_value_is_string(args[0]))
+  {
+    len = jerry_string_size(args[0], JERRY_ENCODING_UTF8);
+    copy = malloc(len ? len : 1);
+    if (copy == NULL)
+    {
+      return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+    }
+    jerry_string_to_buffer(args[0], JERRY_ENCODING_UTF8, (jerry_char_t *)copy, len);
+    text = copy;
+  }
+  else if (argc < 1 || !buffer_bytes(args[0], (uint8_t **)&text, &len))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a string, ArrayBuffer or TypedArray.");
+  }
+
+  uint8_t *target;
+  size_t target_len;
+  bool into_target = argc > 1 && buffer_bytes(args[1], &target, &target_len);
+  uint8_t *out = into_target ? target : (uint8_t *)copy;
+  size_t out_len = into_target ? target_len : len;
+  if (out == NULL)
+  {
+    // Bytes decoded into a new array: they need room of their own.
+    copy = malloc(len ? len : 1);
+    out = (uint8_t *)copy;
+    if (out == NULL)
+    {
+      return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+    }
+  }
+
+  jerry_value_t result;
+  esp_err_t err = fn(text, len, out, &out_len);
+  if (err == ESP_ERR_INVALID_SIZE)
+  {
+    result = jerry_throw_sz(JERRY_ERROR_RANGE, "Target buffer is too small.");
+  }
+  else if (err != ESP_OK)
+  {
+    result = jerry_throw_sz(JERRY_ERROR_TYPE, invalid);
+  }
+  else
+  {
+    result = into_target ? jerry_number(out_len) : new_uint8_array(out, out_len);
+  }
+  free(copy);
+  return result;
+}
+
+static size_t hex_size(size_t len)
+{
+  return len * 2;
+}
+
+/**
+ * @brief Native implementation of `buffer.toHex(data, target)`.
+ */
+static jerry_value_t
+js_buffer_to_hex_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  return encode(args, argc, js_buffer_hex_encode, hex_size);
+}
+
+/**
+ * @brief Native implementation of `buffer.fromHex(text, target)`.
+ */
+static jerry_value_t
+js_buffer_from_hex_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  return decode(args, argc, js_buffer_hex_decode, "Invalid hex string.");
+}
+
+/**
+ * @brief Native implementation of `buffer.toBase64(data, target)`.
+ */
+static jerry_value_t
+js_buffer_to_base64_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  return encode(args, argc, js_buffer_base64_encode, js_buffer_base64_size);
+}
+
+/**
+ * @brief Native implementation of `buffer.fromBase64(text, target)`.
+ */
+static jerry_value_t
+js_buffer_from_base64_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                              const jerry_length_t argc)
+{
+  return decode(args, argc, js_buffer_base64_decode, "Invalid base64 string.");
+}
+
+// --- Layouts ---
+
+static void layout_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  free(native_p);
+}
+
+/**
+ * @brief Reads the layout `this` and, if it has them, its field names.
+ */
+static js_buffer_layout_t *get_layout(const jerry_call_info_t *call_info_p, jerry_value_t *names)
+{
+  js_buffer_layout_t *layout = jerry_object_get_native_ptr(call_info_p->this_value, &layout_native_info);
+  if (layout)
+  {
+    jerry_value_t key = jerry_string_sz("names");
+    *names = jerry_object_get(call_info_p->this_value, key);
+    jerry_value_free(key);
+  }
+  return layout;
+}
+
+/**
+ * @brief Reads the byte offset argument `args[index]`, checking the struct fits after it.
+ */
+static jerry_value_t read_offset(const jerry_value_t args[], jerry_length_t argc, jerry_length_t index,
+                                 const js_buffer_layout_t *layout, size_t len, size_t *offset)
+{
+  double value = js_binding_arg_optional_number(args, argc, index, 0);
+  if (!(value >= 0) || value + layout->size > len)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Buffer is too small for the layout.");
+  }
+  *offset = (size_t)value;
+  return jerry_undefined();
+}
+
+/**
+ * @brief Writes one field of a struct from a JS value.
+ */
+static jerry_value_t pack_field(const js_buffer_layout_t *layout, const js_buffer_field_t *field, uint8_t *base,
+                                jerry_value_t value)
+{
+  if (field->type == JS_BUFFER_BYTES)
+  {
+    // Shorter values are zero-padded and longer ones cut, as with struct's "s".
+    uint8_t *data;
+    size_t len;
+    memset(base + field->offset, 0, field->size);
+    if (jerry_value_is_string(value))
+    {
+      jerry_string_to_buffer(value, JERRY_ENCODING_UTF8, base + field->offset, field->size);
+    }
+    else if (buffer_bytes(value, &data, &len))
+    {
+      memcpy(base + field->offset, data, len < field->size ? len : field->size);
+    }
+    else if (!jerry_value_is_undefined(value))
+    {
+      return jerry_throw_sz(JERRY_ERROR_TYPE, "Byte fields take a string, ArrayBuffer or TypedArray.");
+    }
+    return jerry_undefined();
+  }
+
+  double number;
+  if (jerry_value_is_number(value))
+  {
+    number = jerry_value_as_number(value);
+  }
+  else
+  {
+    jerry_value_t converted = jerry_value_to_number(value);
+    if (jerry_value_is_exception(converted))
+    {
+      return converted;
+    }
+    number = jerry_value_as_number(converted);
+    jerry_value_free(converted);
+  }
+  js_buffer_write_field(layout, field, base, number);
+  return jerry_undefined();
+}
+
+/**
+ * @brief Native implementation of `layout.pack(values, target, offset)`.
+ *
+ * Takes an array of field values, or an object keyed by the layout's names.
+ * Without a target it returns a new Uint8Array; with one it writes in place
+ * and returns the offset just past the struct.
+ */
+static jerry_value_t
+js_layout_pack_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  jerry_value_t names = jerry_undefined();
+  js_buffer_layout_t *layout = get_layout(call_info_p, &names);
+  if (!layout)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Not a buffer layout.");
+  }
+  if (argc < 1 || !jerry_value_is_object(args[0]))
+  {
+    jerry_value_free(names);
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected an array or object of field values.");
+  }
+  bool by_name = jerry_value_is_array(names) && !jerry_value_is_array(args[0]);
+
+  jerry_value_t output = jerry_undefined();
+  uint8_t *data;
+  size_t len;
+  size_t offset = 0;
+  jerry_value_t result;
+  if (argc > 1 && buffer_bytes(args[1], &data, &len))
+  {
+    result = read_offset(args, argc, 2, layout, len, &offset);
+  }
+  else
+  {
+    output = jerry_arraybuffer(layout->size);
+    data = jerry_arraybuffer_data(output);
+    memset(data, 0, layout->size);
+    result = jerry_undefined();
+  }
+
+  for (uint16_t i = 0; i < layout->count && !jerry_value_is_exception(result); i++)
+  {
+    jerry_value_t value;
+    if (by_name)
+    {
+      jerry_value_t name = jerry_object_get_index(names, i);
+      value = jerry_object_get(args[0], name);
+      jerry_value_free(name);
+    }
+    else
+    {
+      value = jerry_object_get_index(args[0], i);
+    }
+    if (jerry_value_is_exception(value))
+    {
+      result = value;
+      break;
+    }
+    result = pack_field(layout, &layout->fields[i], data + offset, value);
+    jerry_value_free(value);
+  }
+  jerry_value_free(names);
+
+  if (jerry_value_is_exception(result))
+  {
+    jerry_value_free(output);
+    return result;
+  }
+  if (jerry_value_is_undefined(output))
+  {
+    return jerry_number(offset + layout->size);
+  }
+  jerry_value_t array = jerry_typedarray_with_buffer(JERRY_TYPEDARRAY_UINT8, output);
+  jerry_value_free(output);
+  return array;
+}
+
+/**
+ * @brief Native implementation of `layout.unpack(source, offset)`.
+ *
+ * Returns an array of the field values, or an object keyed by the layout's names.
+ */
+static jerry_value_t
+js_layout_unpack_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  jerry_value_t names = jerry_undefined();
+  js_buffer_layout_t *layout = get_layout(call_info_p, &names);
+  if (!layout)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Not a buffer layout.");
+  }
+
+  uint8_t *data;
+  size_t len;
+  size_t offset;
+  jerry_value_t result = read_data(args, argc, &data, &len);
+  if (!jerry_value_is_exception(result))
+  {
+    result = read_offset(args, argc, 1, layout, len, &offset);
+  }
+  if (jerry_value_is_exception(result))
+  {
+    jerry_value_free(names);
+    return result;
+  }
+
+  bool by_name = jerry_value_is_array(names);
+  jerry_value_t values = by_name ? jerry_object() : jerry_array(layout->count);
+  for (uint16_t i = 0; i < layout->count; i++)
+  {
+    const js_buffer_field_t *field = &layout->fields[i];
+    jerry_value_t value = field->type == JS_BUFFER_BYTES
+                              ? new_uint8_array(data + offset + field->offset, field->size)
+                              : jerry_number(js_buffer_read_field(layout, field, data + offset));
+    if (by_name)
+    {
+      jerry_value_t name = jerry_object_get_index(names, i);
+      jerry_value_free(jerry_object_set(values, name, value));
+      jerry_value_free(name);
+    }
+    else
+    {
+      jerry_value_free(jerry_object_set_index(values, i, value));
+    }
+    jerry_value_free(value);
+  }
+  jerry_value_free(names);
+  return values;
+}
+
+/**
+ * @brief Native implementation of `buffer.layout(format, names)`.
+ *
+ * Compiles the format once into a native field table; pack() and unpack()
+ * then walk the table without parsing anything.
+ */
+static jerry_value_t
+js_buffer_layout_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_string(args[0]))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a format string.");
+  }
+  char format[128];
+  jerry_size_t size = jerry_string_size(args[0], JERRY_ENCODING_UTF8);
+  if (size >= sizeof(format))
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Format string is too long.");
+  }
+  jerry_string_to_buffer(args[0], JERRY_ENCODING_UTF8, (jerry_char_t *)format, size);
+
+  js_buffer_layout_t *layout;
+  esp_err_t err = js_buffer_layout_compile(format, size, &layout);
+  if (err == ESP_ERR_INVALID_ARG)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Invalid layout format.");
+  }
+  if (err == ESP_ERR_INVALID_SIZE)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Layout has too many fields or bytes.");
+  }
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+
+  bool has_names = argc > 1 && jerry_value_is_array(args[1]);
+  if (has_names && jerry_array_length(args[1]) != layout->count)
+  {
+    free(layout);
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected one name per field.");
+  }
+
+  jerry_value_t object = jerry_object();
+  jerry_object_set_native_ptr(object, &layout_native_info, layout);
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("pack", js_layout_pack_handler),
+      JERRYX_PROPERTY_FUNCTION("unpack", js_layout_unpack_handler),
+      JERRYX_PROPERTY_NUMBER("size", layout->size),
+      JERRYX_PROPERTY_NUMBER("count", layout->count),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(object, props);
+  if (has_names)
+  {
+    jerry_value_t key = jerry_string_sz("names");
+    jerry_value_free(jerry_object_set(object, key, args[1]));
+    jerry_value_free(key);
+  }
+  return object;
+}
+
+#define BUFFER_BINDINGS(X)                         \
+  X("crc8", js_buffer_crc8_handler)                \
+  X("crc16", js_buffer_crc16_handler)              \
+  X("crc16modbus", js_buffer_crc16_modbus_handler) \
+  X("crc32", js_buffer_crc32_handler)              \
+  X("toHex", js_buffer_to_hex_handler)             \
+  X("fromHex", js_buffer_from_hex_handler)         \
+  X("toBase64", js_buffer_to_base64_handler)       \
+  X("fromBase64", js_buffer_from_base64_handler)   \
+  X("layout", js_buffer_layout_handler)
+
+JS_BINDING_TABLE(buffer, BUFFER_BINDINGS);
+
+/**
+ * @brief Populates the exports for the 'buffer' native module.
+ *
+ * @param native_module The `jerry_value_t` for the module being built.
+ * @return `jerry_undefined()` on success.
+ */
+jerry_value_t buffer_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &buffer_bindings);
+}
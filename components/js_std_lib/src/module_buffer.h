@@ -0,0 +1,23 @@
+#ifndef MODULE_BUFFER_H
+#define MODULE_BUFFER_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'buffer' module.
+ *
+ * This function is called by the JerryScript engine when the 'buffer' module
+ * is first evaluated. It populates the module's namespace with table-driven
+ * CRCs, hex and base64 conversions and compiled struct layouts, all of which
+ * work directly on the bytes of ArrayBuffers and typed arrays.
+ *
+ * @param native_module The jerry_value_t representing the 'buffer' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t buffer_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'buffer' module exports; the registry declares their names.
+extern const js_binding_table_t buffer_bindings;
+
+#endif /* MODULE_BUFFER_H */
@@ -0,0 +1,305 @@
+#include <stdlib.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+
+#include "js_binding.h"
+#include "js_codec.h"
+#include "module_codec.h"
+
+static void schema_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+
+static const jerry_object_native_info_t schema_native_info = {
+    .free_cb = schema_free_cb,
+};
+
+// --- Helpers ---
+
+/**
+ * @brief Finds the bytes of an ArrayBuffer or TypedArray without copying them.
+ *
+ * @return false if `value` is neither.
+ */
+static bool buffer_bytes(jerry_value_t value, uint8_t **data, size_t *len)
+{
+  if (jerry_value_is_arraybuffer(value))
+  {
+    *data = jerry_arraybuffer_data(value);
+    *len = jerry_arraybuffer_size(value);
+    return true;
+  }
+  if (jerry_value_is_typedarray(value))
+  {
+    jerry_length_t offset, length;
+    jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, &length);
+    uint8_t *bytes = jerry_arraybuffer_data(buffer);
+    jerry_value_free(buffer);
+    *data = bytes ? bytes + offset : NULL;
+    *len = bytes ? length : 0;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Encodes `value` into `target`, returning the byte count, or into
+ * a new ArrayBuffer of exactly the right size when there is no target.
+ *
+ * Without a target the value is walked twice, once to measure it, so that
+ * no growing buffer is ever copied.
+ */
+static jerry_value_t encode(js_codec_format_t format, jerry_value_t value, jerry_value_t target,
+                            const js_codec_schema_t *schema, jerry_value_t keys)
+{
+  static uint8_t empty; // Stands in for the data of an empty target, which may be NULL
+  uint8_t *out;
+  size_t cap, len;
+  if (buffer_bytes(target, &out, &cap))
+  {
+    jerry_value_t result = js_codec_encode(format, value, schema, keys, out ? out : &empty, cap, &len);
+    if (jerry_value_is_exception(result))
+    {
+      return result;
+    }
+    return jerry_number((double)len);
+  }
+  if (!jerry_value_is_undefined(target))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected an ArrayBuffer or TypedArray to encode into.");
+  }
+
+  jerry_value_t result = js_codec_encode(format, value, schema, keys, NULL, 0, &len);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_t buffer = jerry_arraybuffer((jerry_length_t)len);
+  out = jerry_arraybuffer_data(buffer);
+  if (len > 0 && !out)
+  {
+    jerry_value_free(buffer);
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  result = js_codec_encode(format, value, schema, keys, out, len, &len);
+  if (jerry_value_is_exception(result))
+  {
+    jerry_value_free(buffer);
+    return result;
+  }
+  return buffer;
+}
+
+static jerry_value_t decode(js_codec_format_t format, const jerry_value_t args[], jerry_length_t argc,
+                            const js_codec_schema_t *schema, jerry_value_t keys)
+{
+  uint8_t *data;
+  size_t len;
+  if (argc < 1 || !buffer_bytes(args[0], &data, &len))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected an ArrayBuffer or TypedArray to decode.");
+  }
+  return js_codec_decode(format, data, len, schema, keys);
+}
+
+static jerry_value_t optional_arg(const jerry_value_t args[], jerry_length_t argc, jerry_length_t index)
+{
+  return index < argc ? args[index] : jerry_undefined();
+}
+
+/**
+ * @brief Native implementation of `codec.encodeCbor(value, target)`.
+ */
+static jerry_value_t
+js_codec_encode_cbor_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                             const jerry_length_t argc)
+{
+  return encode(JS_CODEC_CBOR, optional_arg(args, argc, 0), optional_arg(args, argc, 1), NULL, 0);
+}
+
+/**
+ * @brief Native implementation of `codec.encodeJson(value, target)`.
+ */
+static jerry_value_t
+js_codec_encode_json_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                             const jerry_length_t argc)
+{
+  return encode(JS_CODEC_JSON, optional_arg(args, argc, 0), optional_arg(args, argc, 1), NULL, 0);
+}
+
+/**
+ * @brief Native implementation of `codec.decodeCbor(source)`.
+ */
+static jerry_value_t
+js_codec_decode_cbor_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                             const jerry_length_t argc)
+{
+  return decode(JS_CODEC_CBOR, args, argc, NULL, 0);
+}
+
+/**
+ * @brief Native implementation of `codec.decodeJson(source)`.
+ */
+static jerry_value_t
+js_codec_decode_json_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                             const jerry_length_t argc)
+{
+  return decode(JS_CODEC_JSON, args, argc, NULL, 0);
+}
+
+// --- Schemas ---
+
+static void schema_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  free(native_p);
+}
+
+/**
+ * @brief Reads the schema `this` and the array of keys it was compiled from.
+ */
+static js_codec_schema_t *get_schema(const jerry_call_info_t *call_info_p, jerry_value_t *keys)
+{
+  js_codec_schema_t *schema = jerry_object_get_native_ptr(call_info_p->this_value, &schema_native_info);
+  if (schema)
+  {
+    jerry_value_t key = jerry_string_sz("keys");
+    *keys = jerry_object_get(call_info_p->this_value, key);
+    jerry_value_free(key);
+  }
+  return schema;
+}
+
+/**
+ * @brief Runs a schema method with `this` resolved, releasing the keys after.
+ */
+static jerry_value_t with_schema(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                                 jerry_length_t argc, js_codec_format_t format, bool encoding)
+{
+  jerry_value_t keys = jerry_undefined();
+  js_codec_schema_t *schema = get_schema(call_info_p, &keys);
+  if (!schema)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Not a codec schema.");
+  }
+  jerry_value_t result = encoding
+                             ? encode(format, optional_arg(args, argc, 0), optional_arg(args, argc, 1), schema, keys)
+                             : decode(format, args, argc, schema, keys);
+  jerry_value_free(keys);
+  return result;
+}
+
+/**
+ * @brief Native implementation of `schema.encodeCbor(object, target)`.
+ */
+static jerry_value_t
+js_schema_encode_cbor_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                              const jerry_length_t argc)
+{
+  return with_schema(call_info_p, args, argc, JS_CODEC_CBOR, true);
+}
+
+/**
+ * @brief Native implementation of `schema.encodeJson(object, target)`.
+ */
+static jerry_value_t
+js_schema_encode_json_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                              const jerry_length_t argc)
+{
+  return with_schema(call_info_p, args, argc, JS_CODEC_JSON, true);
+}
+
+/**
+ * @brief Native implementation of `schema.decodeCbor(source)`.
+ */
+static jerry_value_t
+js_schema_decode_cbor_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                              const jerry_length_t argc)
+{
+  return with_schema(call_info_p, args, argc, JS_CODEC_CBOR, false);
+}
+
+/**
+ * @brief Native implementation of `schema.decodeJson(source)`.
+ */
+static jerry_value_t
+js_schema_decode_json_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                              const jerry_length_t argc)
+{
+  return with_schema(call_info_p, args, argc, JS_CODEC_JSON, false);
+}
+
+/**
+ * @brief Native implementation of `codec.schema(keys)`.
+ *
+ * Compiles the keys once, pre-encoded in both formats, so encoding an
+ * object copies its keys instead of listing and converting them, and
+ * decoding reuses the key strings instead of creating new ones.
+ */
+static jerry_value_t
+js_codec_schema_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_array(args[0]))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected an array of keys.");
+  }
+
+  js_codec_schema_t *schema;
+  esp_err_t err = js_codec_schema_compile(args[0], &schema);
+  if (err == ESP_ERR_INVALID_ARG)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Schema keys must be strings.");
+  }
+  if (err == ESP_ERR_INVALID_SIZE)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Schema has too many keys, or a key is too long.");
+  }
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+
+  jerry_value_t object = jerry_object();
+  jerry_object_set_native_ptr(object, &schema_native_info, schema);
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("encodeCbor", js_schema_encode_cbor_handler),
+      JERRYX_PROPERTY_FUNCTION("encodeJson", js_schema_encode_json_handler),
+      JERRYX_PROPERTY_FUNCTION("decodeCbor", js_schema_decode_cbor_handler),
+      JERRYX_PROPERTY_FUNCTION("decodeJson", js_schema_decode_json_handler),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(object, props);
+
+  // Keys are copied so that later changes to the caller's array cannot
+  // make them disagree with the compiled schema.
+  uint32_t count = jerry_array_length(args[0]);
+  jerry_value_t keys = jerry_array(count);
+  for (uint32_t i = 0; i < count; i++)
+  {
+    jerry_value_t key = jerry_object_get_index(args[0], i);
+    jerry_value_free(jerry_object_set_index(keys, i, key));
+    jerry_value_free(key);
+  }
+  jerry_value_t name = jerry_string_sz("keys");
+  jerry_value_free(jerry_object_set(object, name, keys));
+  jerry_value_free(name);
+  jerry_value_free(keys);
+  return object;
+}
+
+#define CODEC_BINDINGS(X)                       \
+  X("encodeCbor", js_codec_encode_cbor_handler) \
+  X("encodeJson", js_codec_encode_json_handler) \
+  X("decodeCbor", js_codec_decode_cbor_handler) \
+  X("decodeJson", js_codec_decode_json_handler) \
+  X("schema", js_codec_schema_handler)
+
+JS_BINDING_TABLE(codec, CODEC_BINDINGS);
+
+/**
+ * @brief Populates the exports for the 'codec' native module.
+ *
+ * @param native_module The `jerry_value_t` for the module being built.
+ * @return `jerry_undefined()` on success.
+ */
+jerry_value_t codec_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &codec_bindings);
+}
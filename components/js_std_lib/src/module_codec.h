@@ -0,0 +1,23 @@
+#ifndef MODULE_CODEC_H
+#define MODULE_CODEC_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'codec' module.
+ *
+ * This function is called by the JerryScript engine when the 'codec' module
+ * is first evaluated. It populates the module's namespace with CBOR and
+ * compact JSON encoders that write straight into ArrayBuffers, decoders
+ * that read from them, and compiled schemas for objects of a known shape.
+ *
+ * @param native_module The jerry_value_t representing the 'codec' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t codec_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'codec' module exports; the registry declares their names.
+extern const js_binding_table_t codec_bindings;
+
+#endif /* MODULE_CODEC_H */
@@ -1,6 +1,6 @@
 #include "jerryscript.h"
-#include "jerryscript-ext/properties.h"
 #include "esp_log.h"
+#include "js_binding.h"
 #include "module_console.h"
 
 #define LOG_BUFFER_SIZE 256
@@ -121,6 +121,13 @@ static jerry_value_t js_console_error_handler(const jerry_call_info_t *call_info
   return jerry_undefined();
 }
 
+#define CONSOLE_BINDINGS(X)          \
+  X("log", js_console_log_handler)   \
+  X("warn", js_console_warn_handler) \
+  X("error", js_console_error_handler)
+
+JS_BINDING_TABLE(console, CONSOLE_BINDINGS);
+
 // --- Public Functions ---
 
 /**
@@ -131,14 +138,7 @@ void console_bind_global(jerry_value_t global)
 {
   // Create console object
   jerry_value_t console_obj = jerry_object();
-
-  jerryx_property_entry props[] = {
-      JERRYX_PROPERTY_FUNCTION("log", js_console_log_handler),
-      JERRYX_PROPERTY_FUNCTION("warn", js_console_warn_handler),
-      JERRYX_PROPERTY_FUNCTION("error", js_console_error_handler),
-      JERRYX_PROPERTY_LIST_END()};
-
-  jerryx_set_properties(console_obj, props);
+  js_binding_set_properties(console_obj, &console_bindings);
 
   // Attach it to the global object
   jerry_value_t name = jerry_string_sz("console");
@@ -154,8 +154,7 @@ void console_bind_global(jerry_value_t global)
  * When a script executes `import { log } from 'console'`, the JerryScript
  * engine calls this function during the evaluation phase. Its job is to
  * populate the module's exports by binding the C handler functions to the
- * `log`, `warn`, and `error` names that were declared as exports in the
- * `js_std_lib.c` registry.
+ * names in `console_bindings`, which the registry also declares as exports.
  *
  * @param native_module The `jerry_value_t` representing the module's
  * namespace object. This is the object that will contain
@@ -164,26 +163,5 @@ void console_bind_global(jerry_value_t global)
  */
 jerry_value_t console_module_evaluate(const jerry_value_t native_module)
 {
-  // Create function and name values
-  jerry_value_t log_func = jerry_function_external(js_console_log_handler);
-  jerry_value_t warn_func = jerry_function_external(js_console_warn_handler);
-  jerry_value_t error_func = jerry_function_external(js_console_error_handler);
-  jerry_value_t log_name = jerry_string_sz("log");
-  jerry_value_t warn_name = jerry_string_sz("warn");
-  jerry_value_t error_name = jerry_string_sz("error");
-
-  // Set the exports on the module
-  jerry_native_module_set(native_module, log_name, log_func);
-  jerry_native_module_set(native_module, warn_name, warn_func);
-  jerry_native_module_set(native_module, error_name, error_func);
-
-  // Clean up
-  jerry_value_free(log_func);
-  jerry_value_free(warn_func);
-  jerry_value_free(error_func);
-  jerry_value_free(log_name);
-  jerry_value_free(warn_name);
-  jerry_value_free(error_name);
-
-  return jerry_undefined();
+  return js_binding_export(native_module, &console_bindings);
 }
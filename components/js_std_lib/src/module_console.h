@@ -2,6 +2,7 @@
 #define MODULE_CONSOLE_H
 
 #include "jerryscript.h"
+#include "js_binding.h"
 
 /**
  * @brief Creates a complete JavaScript `console` object and binds it to the
@@ -20,4 +21,7 @@ void console_bind_global(jerry_value_t);
  */
 jerry_value_t console_module_evaluate(const jerry_value_t);
 
+/// @brief The functions the 'console' module exports; the registry declares their names.
+extern const js_binding_table_t console_bindings;
+
 #endif /* MODULE_CONSOLE_H */
@@ -0,0 +1,533 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+
+#include "js_binding.h"
+#include "js_dsp.h"
+#include "module_dsp.h"
+
+#define MAX_PEAKS 64
+
+static void filter_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+
+static const jerry_object_native_info_t filter_native_info = {
+    .free_cb = filter_free_cb,
+};
+
+// --- Helpers ---
+
+/**
+ * @brief Finds the samples of a Float32Array without copying them.
+ *
+ * @return false if `value` is not a Float32Array.
+ */
+static bool float_samples(jerry_value_t value, float **data, size_t *len)
+{
+  if (!jerry_value_is_typedarray(value) || jerry_typedarray_type(value) != JERRY_TYPEDARRAY_FLOAT32)
+  {
+    return false;
+  }
+  jerry_length_t offset, length;
+  jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, &length);
+  uint8_t *bytes = jerry_arraybuffer_data(buffer);
+  jerry_value_free(buffer);
+  *data = bytes ? (float *)(bytes + offset) : NULL;
+  *len = bytes ? length / sizeof(float) : 0;
+  return true;
+}
+
+/**
+ * @brief Reads the Float32Array argument `args[index]`, which must not be empty.
+ */
+static jerry_value_t read_samples(const jerry_value_t args[], jerry_length_t argc, jerry_length_t index, float **data,
+                                  size_t *len)
+{
+  if (index >= argc || !float_samples(args[index], data, len) || *len == 0)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a non-empty Float32Array.");
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Copies coefficients from a Float32Array or an array of numbers into `out`.
+ */
+static jerry_value_t read_coeffs(jerry_value_t value, float *out, size_t max, size_t *count)
+{
+  float *data;
+  size_t len;
+  if (float_samples(value, &data, &len))
+  {
+    if (len > max)
+    {
+      return jerry_throw_sz(JERRY_ERROR_RANGE, "Too many coefficients.");
+    }
+    memcpy(out, data, len * sizeof(float));
+    *count = len;
+    return jerry_undefined();
+  }
+  if (!jerry_value_is_array(value))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected coefficients as an array or Float32Array.");
+  }
+  len = jerry_array_length(value);
+  if (len > max)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Too many coefficients.");
+  }
+  for (size_t i = 0; i < len; i++)
+  {
+    jerry_value_t item = jerry_object_get_index(value, (uint32_t)i);
+    out[i] = (float)jerry_value_as_number(item);
+    jerry_value_free(item);
+  }
+  *count = len;
+  return jerry_undefined();
+}
+
+
+// --- Filter objects ---
+
+static void filter_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  js_dsp_filter_free((js_dsp_filter_t *)native_p);
+}
+
+/**
+ * @brief Native implementation of `filter.process(input, output)`.
+ *
+ * A number is filtered as one sample and the result returned. A
+ * Float32Array is filtered as a block, into `output` if given or else in
+ * place, and the array written is returned.
+ */
+static jerry_value_t
+js_filter_process_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_dsp_filter_t *filter = jerry_object_get_native_ptr(call_info_p->this_value, &filter_native_info);
+  if (!filter)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Not a dsp filter.");
+  }
+  if (argc > 0 && jerry_value_is_number(args[0]))
+  {
+    return jerry_number(js_dsp_filter_step(filter, (float)jerry_value_as_number(args[0])));
+  }
+
+  float *in;
+  size_t len;
+  jerry_value_t result = read_samples(args, argc, 0, &in, &len);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  float *out = in;
+  size_t out_len = len;
+  jerry_value_t target = args[0];
+  if (argc > 1 && float_samples(args[1], &out, &out_len))
+  {
+    if (out_len < len)
+    {
+      return jerry_throw_sz(JERRY_ERROR_RANGE, "Output is shorter than the input.");
+    }
+    target = args[1];
+  }
+  js_dsp_filter_run(filter, in, out, len);
+  return jerry_value_copy(target);
+}
+
+/**
+ * @brief Native implementation of `filter.reset()`.
+ */
+static jerry_value_t
+js_filter_reset_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_dsp_filter_t *filter = jerry_object_get_native_ptr(call_info_p->this_value, &filter_native_info);
+  if (filter)
+  {
+    js_dsp_filter_reset(filter);
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Wraps a new filter in a JS object that frees it when collected.
+ */
+static jerry_value_t new_filter_object(js_dsp_filter_t *filter)
+{
+  if (!filter)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  jerry_value_t object = jerry_object();
+  jerry_object_set_native_ptr(object, &filter_native_info, filter);
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("process", js_filter_process_handler),
+      JERRYX_PROPERTY_FUNCTION("reset", js_filter_reset_handler),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(object, props);
+  return object;
+}
+
+/**
+ * @brief Reads the window length argument of movingAverage() and median().
+ */
+static jerry_value_t read_window(const jerry_value_t args[], jerry_length_t argc, size_t *window)
+{
+  double value = js_binding_arg_optional_number(args, argc, 0, 0);
+  if (!(value >= 1 && value <= JS_DSP_MAX_WINDOW))
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Window must be between 1 and 1024 samples.");
+  }
+  *window = (size_t)value;
+  return jerry_undefined();
+}
+
+/**
+ * @brief Native implementation of `dsp.iir(sections)`.
+ *
+ * Takes the five coefficients of each biquad section, flat or as one array
+ * per section.
+ */
+static jerry_value_t
+js_dsp_iir_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  float coeffs[5 * JS_DSP_MAX_SECTIONS];
+  size_t count = 0;
+  if (argc < 1)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected biquad coefficients.");
+  }
+
+  jerry_value_t first = jerry_value_is_array(args[0]) ? jerry_object_get_index(args[0], 0) : jerry_undefined();
+  bool nested = jerry_value_is_object(first);
+  jerry_value_free(first);
+
+  jerry_value_t result;
+  if (nested)
+  {
+    uint32_t sections = jerry_array_length(args[0]);
+    if (sections > JS_DSP_MAX_SECTIONS)
+    {
+      return jerry_throw_sz(JERRY_ERROR_RANGE, "At most 8 biquad sections.");
+    }
+    result = jerry_undefined();
+    for (uint32_t s = 0; s < sections && !jerry_value_is_exception(result); s++)
+    {
+      jerry_value_t section = jerry_object_get_index(args[0], s);
+      size_t section_count = 0;
+      result = read_coeffs(section, coeffs + count, 5, &section_count);
+      if (!jerry_value_is_exception(result) && section_count != 5)
+      {
+        result = jerry_throw_sz(JERRY_ERROR_TYPE, "Each biquad section has five coefficients.");
+      }
+      count += section_count;
+      jerry_value_free(section);
+    }
+  }
+  else
+  {
+    result = read_coeffs(args[0], coeffs, sizeof(coeffs) / sizeof(coeffs[0]), &count);
+  }
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  if (count == 0 || count % 5 != 0)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Each biquad section has five coefficients.");
+  }
+  return new_filter_object(js_dsp_iir_new(coeffs, count / 5));
+}
+
+/**
+ * @brief Native implementation of `dsp.fir(coefficients)`.
+ */
+static jerry_value_t
+js_dsp_fir_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  float *coeffs = malloc(JS_DSP_MAX_TAPS * sizeof(float));
+  if (!coeffs)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  size_t taps = 0;
+  jerry_value_t result = argc > 0 ? read_coeffs(args[0], coeffs, JS_DSP_MAX_TAPS, &taps)
+                                  : jerry_throw_sz(JERRY_ERROR_TYPE, "Expected FIR coefficients.");
+  if (!jerry_value_is_exception(result) && taps == 0)
+  {
+    result = jerry_throw_sz(JERRY_ERROR_TYPE, "Expected FIR coefficients.");
+  }
+  if (!jerry_value_is_exception(result))
+  {
+    result = new_filter_object(js_dsp_fir_new(coeffs, taps));
+  }
+  free(coeffs);
+  return result;
+}
+
+/**
+ * @brief Native implementation of `dsp.movingAverage(window)`.
+ */
+static jerry_value_t
+js_dsp_moving_average_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[],
+                              const jerry_length_t argc)
+{
+  size_t window;
+  jerry_value_t result = read_window(args, argc, &window);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  return new_filter_object(js_dsp_moving_average_new(window));
+}
+
+/**
+ * @brief Native implementation of `dsp.median(window)`.
+ */
+static jerry_value_t
+js_dsp_median_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  size_t window;
+  jerry_value_t result = read_window(args, argc, &window);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  return new_filter_object(js_dsp_median_new(window));
+}
+
+/**
+ * @brief Native implementation of `dsp.biquad(type, cutoff, sampleRate, q)`.
+ */
+static jerry_value_t
+js_dsp_biquad_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  char type[16] = "";
+  if (argc > 0 && jerry_value_is_string(args[0]))
+  {
+    jerry_size_t size = jerry_string_to_buffer(args[0], JERRY_ENCODING_UTF8, (jerry_char_t *)type, sizeof(type) - 1);
+    type[size] = '\0';
+  }
+  float coeffs[5];
+  esp_err_t err = js_dsp_biquad_design(type, (float)js_binding_arg_optional_number(args, argc, 1, 0),
+                                       (float)js_binding_arg_optional_number(args, argc, 2, 0),
+                                       (float)js_binding_arg_optional_number(args, argc, 3, 0.70710678), coeffs);
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE,
+                          "Expected lowpass, highpass, bandpass or notch, below half the sample rate.");
+  }
+
+  jerry_value_t array = jerry_array(5);
+  for (uint32_t i = 0; i < 5; i++)
+  {
+    jerry_value_t value = jerry_number(coeffs[i]);
+    jerry_value_free(jerry_object_set_index(array, i, value));
+    jerry_value_free(value);
+  }
+  return array;
+}
+
+// --- Block functions ---
+
+/**
+ * @brief Native implementation of `dsp.stats(samples)`.
+ */
+static jerry_value_t
+js_dsp_stats_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  float *data;
+  size_t len;
+  jerry_value_t result = read_samples(args, argc, 0, &data, &len);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  js_dsp_stats_t stats;
+  js_dsp_stats(data, len, &stats);
+
+  result = jerry_object();
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_NUMBER("min", stats.min),
+      JERRYX_PROPERTY_NUMBER("max", stats.max),
+      JERRYX_PROPERTY_NUMBER("minIndex", stats.min_index),
+      JERRYX_PROPERTY_NUMBER("maxIndex", stats.max_index),
+      JERRYX_PROPERTY_NUMBER("mean", stats.mean),
+      JERRYX_PROPERTY_NUMBER("rms", stats.rms),
+      JERRYX_PROPERTY_NUMBER("std", stats.std),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(result, props);
+  return result;
+}
+
+/**
+ * @brief Native implementation of `dsp.peaks(samples, threshold, minDistance)`.
+ */
+static jerry_value_t
+js_dsp_peaks_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  float *data;
+  size_t len;
+  jerry_value_t result = read_samples(args, argc, 0, &data, &len);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  double threshold = js_binding_arg_optional_number(args, argc, 1, -INFINITY);
+  double min_distance = js_binding_arg_optional_number(args, argc, 2, 1);
+
+  uint32_t peaks[MAX_PEAKS];
+  size_t found = js_dsp_peaks(data, len, (float)threshold, min_distance > 1 ? (size_t)min_distance : 1, peaks,
+                              MAX_PEAKS);
+  jerry_value_t array = jerry_array((jerry_length_t)found);
+  for (size_t i = 0; i < found; i++)
+  {
+    jerry_value_t value = jerry_number(peaks[i]);
+    jerry_value_free(jerry_object_set_index(array, (uint32_t)i, value));
+    jerry_value_free(value);
+  }
+  return array;
+}
+
+/**
+ * @brief Native implementation of `dsp.fft(re, im)`: an in-place complex FFT.
+ */
+static jerry_value_t
+js_dsp_fft_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  float *re, *im;
+  size_t n, im_len;
+  jerry_value_t result = read_samples(args, argc, 0, &re, &n);
+  if (!jerry_value_is_exception(result))
+  {
+    result = read_samples(args, argc, 1, &im, &im_len);
+  }
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  if (im_len != n || n > JS_DSP_MAX_FFT || (n & (n - 1)) != 0)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Expected two arrays of the same power-of-two length, up to 4096.");
+  }
+
+  // The kernels take interleaved complex numbers, as ESP-DSP does.
+  float *work = malloc(2 * n * sizeof(float));
+  if (!work)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  for (size_t i = 0; i < n; i++)
+  {
+    work[2 * i] = re[i];
+    work[2 * i + 1] = im[i];
+  }
+  js_dsp_fft(work, n);
+  for (size_t i = 0; i < n; i++)
+  {
+    re[i] = work[2 * i];
+    im[i] = work[2 * i + 1];
+  }
+  free(work);
+  return jerry_undefined();
+}
+
+/**
+ * @brief Native implementation of `dsp.spectrum(samples, options)`.
+ *
+ * Returns the amplitude spectrum as a new Float32Array of n / 2 bins, or
+ * writes it to `options.output`.
+ */
+static jerry_value_t
+js_dsp_spectrum_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  float *samples;
+  size_t n;
+  jerry_value_t result = read_samples(args, argc, 0, &samples, &n);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  if (n < 2 || n > JS_DSP_MAX_FFT || (n & (n - 1)) != 0)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Expected a power-of-two number of samples, up to 4096.");
+  }
+
+  bool hann = true;
+  jerry_value_t output = jerry_undefined();
+  if (argc > 1 && jerry_value_is_object(args[1]))
+  {
+    jerry_value_t key = jerry_string_sz("window");
+    jerry_value_t window = jerry_object_get(args[1], key);
+    jerry_value_free(key);
+    if (jerry_value_is_string(window))
+    {
+      char name[8] = "";
+      jerry_size_t size = jerry_string_to_buffer(window, JERRY_ENCODING_UTF8, (jerry_char_t *)name, sizeof(name) - 1);
+      name[size] = '\0';
+      hann = strcmp(name, "none") != 0;
+    }
+    jerry_value_free(window);
+
+    key = jerry_string_sz("output");
+    output = jerry_object_get(args[1], key);
+    jerry_value_free(key);
+  }
+
+  float *out;
+  size_t out_len;
+  if (float_samples(output, &out, &out_len))
+  {
+    if (out_len < n / 2)
+    {
+      jerry_value_free(output);
+      return jerry_throw_sz(JERRY_ERROR_RANGE, "Output is shorter than half the input.");
+    }
+  }
+  else
+  {
+    jerry_value_free(output);
+    jerry_value_t buffer = jerry_arraybuffer((jerry_length_t)(n / 2 * sizeof(float)));
+    output = jerry_typedarray_with_buffer(JERRY_TYPEDARRAY_FLOAT32, buffer);
+    jerry_value_free(buffer);
+    float_samples(output, &out, &out_len);
+  }
+
+  float *work = malloc(2 * n * sizeof(float));
+  if (!work)
+  {
+    jerry_value_free(output);
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  js_dsp_spectrum(samples, n, hann, work, out);
+  free(work);
+  return output;
+}
+
+#define DSP_BINDINGS(X)                             \
+  X("iir", js_dsp_iir_handler)                      \
+  X("fir", js_dsp_fir_handler)                      \
+  X("movingAverage", js_dsp_moving_average_handler) \
+  X("median", js_dsp_median_handler)                \
+  X("biquad", js_dsp_biquad_handler)                \
+  X("stats", js_dsp_stats_handler)                  \
+  X("peaks", js_dsp_peaks_handler)                  \
+  X("fft", js_dsp_fft_handler)                      \
+  X("spectrum", js_dsp_spectrum_handler)
+
+JS_BINDING_TABLE(dsp, DSP_BINDINGS);
+
+/**
+ * @brief Populates the exports for the 'dsp' native module.
+ *
+ * @param native_module The `jerry_value_t` for the module being built.
+ * @return `jerry_undefined()` on success.
+ */
+jerry_value_t dsp_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &dsp_bindings);
+}
@@ -0,0 +1,23 @@
+#ifndef MODULE_DSP_H
+#define MODULE_DSP_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'dsp' module.
+ *
+ * This function is called by the JerryScript engine when the 'dsp' module
+ * is first evaluated. It populates the module's namespace with stateful
+ * IIR, FIR, moving average and median filters, block statistics, peak
+ * detection and a radix-2 FFT, all of which work on Float32Arrays in place.
+ *
+ * @param native_module The jerry_value_t representing the 'dsp' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t dsp_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'dsp' module exports; the registry declares their names.
+extern const js_binding_table_t dsp_bindings;
+
+#endif /* MODULE_DSP_H */
@@ -0,0 +1,637 @@
+#include <stdlib.h>
+#include <string.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+#include "jerryscript-ext/arg.h"
+#include "esp_log.h"
+
+#include "js_binding.h"
+#include "js_fs.h"
+#include "js_module_resolver.h"
+#include "module_fs.h"
+
+#define TAG "FS_MODULE"
+
+#define LOG_STACK_COPY 128 // Log lines up to this size are converted without malloc
+
+/**
+ * @brief A file opened with `fs.open()`. `file` is NULL once close() has been submitted.
+ */
+typedef struct
+{
+  FILE *file;
+} fs_reader_t;
+
+static void reader_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+static void log_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+
+static const jerry_object_native_info_t reader_native_info = {
+    .free_cb = reader_free_cb,
+};
+
+/**
+ * @brief JerryScript native object info. The native pointer is the log id, not memory.
+ */
+static const jerry_object_native_info_t log_native_info = {
+    .free_cb = log_free_cb,
+};
+
+// --- Helpers ---
+
+/**
+ * @brief Resolves a path argument against the script directory into `out`.
+ *
+ * A leading "/" is ignored, so "/data/log.txt" and "data/log.txt" name the
+ * same file. An empty path names the script directory itself.
+ */
+static jerry_value_t read_path(jerry_value_t value, char out[JS_FS_MAX_PATH])
+{
+  if (!jerry_value_is_string(value))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a path string.");
+  }
+
+  char relative[JS_FS_MAX_PATH];
+  jerry_size_t size = jerry_string_size(value, JERRY_ENCODING_UTF8);
+  if (size >= sizeof(relative))
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Path is too long.");
+  }
+  jerry_string_to_buffer(value, JERRY_ENCODING_UTF8, (jerry_char_t *)relative, size);
+  relative[size] = '\0';
+
+  const char *name = relative[0] == '/' ? relative + 1 : relative;
+  int len = name[0] ? snprintf(out, JS_FS_MAX_PATH, "%s/%s", js_module_resolver_root(), name)
+                    : snprintf(out, JS_FS_MAX_PATH, "%s", js_module_resolver_root());
+  if (len >= JS_FS_MAX_PATH)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Path is too long.");
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Finds the bytes of an ArrayBuffer or TypedArray without copying them.
+ *
+ * @return false if `value` is neither.
+ */
+static bool buffer_bytes(jerry_value_t value, uint8_t **data, size_t *len)
+{
+  if (jerry_value_is_arraybuffer(value))
+  {
+    *data = jerry_arraybuffer_data(value);
+    *len = jerry_arraybuffer_size(value);
+    return true;
+  }
+  if (jerry_value_is_typedarray(value))
+  {
+    jerry_length_t offset, length;
+    jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, &length);
+    uint8_t *bytes = jerry_arraybuffer_data(buffer);
+    jerry_value_free(buffer);
+    *data = bytes ? bytes + offset : NULL;
+    *len = bytes ? length : 0;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Copies a string, ArrayBuffer or TypedArray into a new malloc'd buffer for the I/O task.
+ */
+static jerry_value_t copy_data(jerry_value_t value, uint8_t **out, size_t *out_len)
+{
+  uint8_t *bytes = NULL;
+  size_t len = 0;
+  bool is_string = jerry_value_is_string(value);
+  if (is_string)
+  {
+    len = jerry_string_size(value, JERRY_ENCODING_UTF8);
+  }
+  else if (!buffer_bytes(value, &bytes, &len))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Data must be a string, ArrayBuffer or TypedArray.");
+  }
+
+  *out = (uint8_t *)malloc(len ? len : 1);
+  if (!*out)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  if (is_string)
+  {
+    jerry_string_to_buffer(value, JERRY_ENCODING_UTF8, *out, len);
+  }
+  else if (len)
+  {
+    memcpy(*out, bytes, len);
+  }
+  *out_len = len;
+  return jerry_undefined();
+}
+
+/**
+ * @brief Gives `request` a promise, submits it, and returns the promise.
+ *
+ * Frees the request and throws if the I/O queue is full.
+ */
+static jerry_value_t submit(js_fs_request_t *request)
+{
+  jerry_value_t promise = jerry_promise();
+  request->promise = jerry_value_copy(promise);
+  if (js_fs_submit(request) != ESP_OK)
+  {
+    js_fs_request_free(request);
+    jerry_value_free(promise);
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "File I/O queue is full.");
+  }
+  return promise;
+}
+
+/**
+ * @brief Allocates a request for `op` on the path in `args[0]`.
+ */
+static jerry_value_t path_request(js_fs_op_t op, const jerry_value_t args[], jerry_length_t argc,
+                                  js_fs_request_t **out)
+{
+  js_fs_request_t *request = js_fs_request_new(op);
+  if (!request)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  jerry_value_t result = read_path(argc > 0 ? args[0] : jerry_undefined(), request->path);
+  if (jerry_value_is_exception(result))
+  {
+    js_fs_request_free(request);
+    return result;
+  }
+  *out = request;
+  return result;
+}
+
+// --- Reader object methods ---
+
+static void reader_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  fs_reader_t *reader = (fs_reader_t *)native_p;
+  if (reader->file)
+  {
+    // Garbage collected while open: close it behind any reads still queued.
+    js_fs_request_t *request = js_fs_request_new(JS_FS_CLOSE);
+    if (request)
+    {
+      request->file = reader->file;
+    }
+    if (!request || js_fs_submit(request) != ESP_OK)
+    {
+      ESP_LOGW(TAG, "I/O queue full, closing a reader on the JS thread");
+      if (request)
+      {
+        js_fs_request_free(request);
+      }
+      fclose(reader->file);
+    }
+  }
+  free(reader);
+}
+
+static fs_reader_t *get_reader(const jerry_call_info_t *call_info_p)
+{
+  return (fs_reader_t *)jerry_object_get_native_ptr(call_info_p->this_value, &reader_native_info);
+}
+
+/**
+ * @brief Native implementation of `reader.read(buffer, position)`.
+ *
+ * Reads straight into the caller's buffer, so a stream of chunks can reuse
+ * one ArrayBuffer instead of allocating each time.
+ */
+static jerry_value_t
+js_reader_read_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  fs_reader_t *reader = get_reader(call_info_p);
+  if (!reader)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Not a file reader.");
+  }
+  if (!reader->file)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "File is closed.");
+  }
+
+  uint8_t *data;
+  size_t len;
+  if (argc < 1 || !buffer_bytes(args[0], &data, &len))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected an ArrayBuffer or TypedArray to read into.");
+  }
+
+  long position = -1;
+  if (argc > 1 && !jerry_value_is_undefined(args[1]))
+  {
+    double value = jerry_value_as_number(args[1]);
+    if (!(value >= 0))
+    {
+      return jerry_throw_sz(JERRY_ERROR_RANGE, "position must be a non-negative number.");
+    }
+    position = (long)value;
+  }
+
+  js_fs_request_t *request = js_fs_request_new(JS_FS_READ);
+  if (!request)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  request->file = reader->file;
+  request->data = data;
+  request->len = len;
+  request->position = position;
+  request->target = jerry_value_copy(args[0]);
+  request->owner = jerry_value_copy(call_info_p->this_value);
+  return submit(request);
+}
+
+/**
+ * @brief Native implementation of `reader.close()`. Queued reads finish first.
+ */
+static jerry_value_t
+js_reader_close_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  fs_reader_t *reader = get_reader(call_info_p);
+  if (!reader)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Not a file reader.");
+  }
+  if (!reader->file)
+  {
+    jerry_value_t promise = jerry_promise(); // Closing twice is harmless
+    jerry_value_free(jerry_promise_resolve(promise, jerry_undefined()));
+    return promise;
+  }
+
+  js_fs_request_t *request = js_fs_request_new(JS_FS_CLOSE);
+  if (!request)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  request->file = reader->file;
+  jerry_value_t promise = submit(request);
+  if (!jerry_value_is_exception(promise))
+  {
+    reader->file = NULL;
+  }
+  return promise;
+}
+
+/**
+ * @brief Wraps a file opened on the I/O task in a reader object.
+ */
+static jerry_value_t create_reader(FILE *file, const char *path)
+{
+  fs_reader_t *reader = (fs_reader_t *)malloc(sizeof(fs_reader_t));
+  if (!reader)
+  {
+    fclose(file);
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  reader->file = file;
+
+  jerry_value_t reader_obj = jerry_object();
+  jerry_object_set_native_ptr(reader_obj, &reader_native_info, reader);
+
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("read", js_reader_read_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_reader_close_handler),
+      JERRYX_PROPERTY_STRING_SZ("path", path),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(reader_obj, props);
+
+  return reader_obj;
+}
+
+// --- Log object methods ---
+
+static void log_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  js_fs_log_release((uint32_t)(uintptr_t)native_p); // Already closed is harmless
+}
+
+static uint32_t get_log_id(const jerry_call_info_t *call_info_p)
+{
+  return (uint32_t)(uintptr_t)jerry_object_get_native_ptr(call_info_p->this_value, &log_native_info);
+}
+
+/**
+ * @brief Native implementation of `log.write(data)`.
+ *
+ * @return true if the data was buffered, false if it was dropped because the
+ * buffer is full and the previous flush has not finished.
+ */
+static jerry_value_t
+js_log_write_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  uint32_t id = get_log_id(call_info_p);
+  if (!id)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Not a log writer.");
+  }
+
+  jerry_value_t value = argc > 0 ? args[0] : jerry_undefined();
+  uint8_t stack_copy[LOG_STACK_COPY];
+  uint8_t *data;
+  size_t len;
+  uint8_t *heap_copy = NULL;
+  if (jerry_value_is_string(value))
+  {
+    len = jerry_string_size(value, JERRY_ENCODING_UTF8);
+    data = len <= sizeof(stack_copy) ? stack_copy : (heap_copy = (uint8_t *)malloc(len));
+    if (!data)
+    {
+      return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+    }
+    jerry_string_to_buffer(value, JERRY_ENCODING_UTF8, data, len);
+  }
+  else if (!buffer_bytes(value, &data, &len))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Data must be a string, ArrayBuffer or TypedArray.");
+  }
+
+  esp_err_t err = js_fs_log_write(id, data, len);
+  free(heap_copy);
+  switch (err)
+  {
+  case ESP_OK:
+    return jerry_boolean(true);
+  case ESP_ERR_NO_MEM:
+    return jerry_boolean(false);
+  case ESP_ERR_INVALID_SIZE:
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Data is larger than the log buffer.");
+  default:
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Log is closed.");
+  }
+}
+
+/**
+ * @brief Runs `op` (flush or close) with a new promise for when the bytes are in the file.
+ */
+static jerry_value_t log_settle(uint32_t id, esp_err_t (*op)(uint32_t, jerry_value_t))
+{
+  if (!id)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Not a log writer.");
+  }
+  jerry_value_t promise = jerry_promise();
+  esp_err_t err = op(id, promise);
+  if (err == ESP_OK)
+  {
+    return promise;
+  }
+  jerry_value_free(promise);
+  if (err == ESP_ERR_NOT_FOUND)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Log is closed.");
+  }
+  return jerry_throw_sz(JERRY_ERROR_RANGE, "File I/O queue is full.");
+}
+
+/**
+ * @brief Native implementation of `log.flush()`.
+ */
+static jerry_value_t
+js_log_flush_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  return log_settle(get_log_id(call_info_p), js_fs_log_flush);
+}
+
+/**
+ * @brief Native implementation of `log.close()`.
+ */
+static jerry_value_t
+js_log_close_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  return log_settle(get_log_id(call_info_p), js_fs_log_close);
+}
+
+/**
+ * @brief Native implementation of `log.stats()`.
+ */
+static jerry_value_t
+js_log_stats_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_fs_log_stats_t stats;
+  if (js_fs_log_stats(get_log_id(call_info_p), &stats) != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Log is closed.");
+  }
+
+  jerry_value_t result = jerry_object();
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_NUMBER("buffered", stats.buffered),
+      JERRYX_PROPERTY_NUMBER("written", stats.written),
+      JERRYX_PROPERTY_NUMBER("dropped", stats.dropped),
+      JERRYX_PROPERTY_NUMBER("flushes", stats.flushes),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(result, props);
+  return result;
+}
+
+// --- Module Function Implementations ---
+
+/**
+ * @brief Native implementation of `fs.readFile(path, encoding)`.
+ *
+ * Resolves with an ArrayBuffer, or a string when `encoding` is "utf8" (or
+ * `{ encoding: "utf8" }`).
+ */
+static jerry_value_t
+js_read_file_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_fs_request_t *request;
+  jerry_value_t result = path_request(JS_FS_READ_FILE, args, argc, &request);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+
+  if (argc > 1)
+  {
+    jerry_value_t encoding = jerry_value_copy(args[1]);
+    if (jerry_value_is_object(encoding))
+    {
+      jerry_value_t name = jerry_string_sz("encoding");
+      jerry_value_free(encoding);
+      encoding = jerry_object_get(args[1], name);
+      jerry_value_free(name);
+    }
+    if (jerry_value_is_string(encoding))
+    {
+      char text[8] = {0};
+      jerry_string_to_buffer(encoding, JERRY_ENCODING_UTF8, (jerry_char_t *)text, sizeof(text) - 1);
+      request->as_text = strcmp(text, "utf8") == 0 || strcmp(text, "utf-8") == 0;
+    }
+    jerry_value_free(encoding);
+  }
+  return submit(request);
+}
+
+static jerry_value_t write_request(js_fs_op_t op, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_fs_request_t *request;
+  jerry_value_t result = path_request(op, args, argc, &request);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  result = copy_data(argc > 1 ? args[1] : jerry_undefined(), &request->data, &request->len);
+  if (jerry_value_is_exception(result))
+  {
+    js_fs_request_free(request);
+    return result;
+  }
+  request->owns_data = true;
+  return submit(request);
+}
+
+/**
+ * @brief Native implementation of `fs.writeFile(path, data)`.
+ */
+static jerry_value_t
+js_write_file_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  return write_request(JS_FS_WRITE_FILE, args, argc);
+}
+
+/**
+ * @brief Native implementation of `fs.append(path, data)`.
+ */
+static jerry_value_t
+js_append_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  return write_request(JS_FS_APPEND, args, argc);
+}
+
+/**
+ * @brief Native implementation of `fs.stat(path)`.
+ */
+static jerry_value_t
+js_stat_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_fs_request_t *request;
+  jerry_value_t result = path_request(JS_FS_STAT, args, argc, &request);
+  return jerry_value_is_exception(result) ? result : submit(request);
+}
+
+/**
+ * @brief Native implementation of `fs.readdir(path)`. Lists the script directory by default.
+ */
+static jerry_value_t
+js_readdir_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  jerry_value_t root = jerry_string_sz("");
+  jerry_value_t path = argc > 0 && !jerry_value_is_undefined(args[0]) ? args[0] : root;
+  js_fs_request_t *request;
+  jerry_value_t result = path_request(JS_FS_READDIR, &path, 1, &request);
+  jerry_value_free(root);
+  return jerry_value_is_exception(result) ? result : submit(request);
+}
+
+/**
+ * @brief Native implementation of `fs.open(path)`. Resolves with a reader for chunked reads.
+ */
+static jerry_value_t
+js_open_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_fs_request_t *request;
+  jerry_value_t result = path_request(JS_FS_OPEN, args, argc, &request);
+  return jerry_value_is_exception(result) ? result : submit(request);
+}
+
+/**
+ * @brief Native implementation of `fs.createLog(path, options)`.
+ */
+static jerry_value_t
+js_create_log_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  char path[JS_FS_MAX_PATH];
+  jerry_value_t result = read_path(argc > 0 ? args[0] : jerry_undefined(), path);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+
+  double buffer_size = JS_FS_LOG_DEFAULT_BUFFER;
+  double flush_ms = JS_FS_LOG_DEFAULT_FLUSH_MS;
+  if (argc > 1 && jerry_value_is_object(args[1]))
+  {
+    const char *prop_names[] = {"bufferSize", "flushMs"};
+    const jerryx_arg_t prop_mapping[] = {
+        jerryx_arg_number(&buffer_size, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+        jerryx_arg_number(&flush_ms, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+    };
+    result = jerryx_arg_transform_object_properties(args[1], (const jerry_char_t **)prop_names, 2,
+                                                    prop_mapping, 2);
+    if (jerry_value_is_exception(result))
+    {
+      return result;
+    }
+    jerry_value_free(result);
+  }
+
+  if (buffer_size < 64 || buffer_size > JS_FS_LOG_MAX_BUFFER)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "bufferSize must be between 64 and 16384.");
+  }
+  if (flush_ms < 1 || flush_ms > 3600000)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "flushMs must be between 1 and 3600000.");
+  }
+
+  uint32_t id;
+  esp_err_t err = js_fs_log_open(path, (size_t)buffer_size, (uint32_t)flush_ms, &id);
+  if (err == ESP_ERR_NOT_FOUND)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Too many open logs.");
+  }
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Not enough memory for the log.");
+  }
+
+  jerry_value_t log_obj = jerry_object();
+  jerry_object_set_native_ptr(log_obj, &log_native_info, (void *)(uintptr_t)id);
+
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("write", js_log_write_handler),
+      JERRYX_PROPERTY_FUNCTION("flush", js_log_flush_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_log_close_handler),
+      JERRYX_PROPERTY_FUNCTION("stats", js_log_stats_handler),
+      JERRYX_PROPERTY_STRING_SZ("path", path),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(log_obj, props);
+
+  return log_obj;
+}
+
+#define FS_BINDINGS(X)                  \
+  X("readFile", js_read_file_handler)   \
+  X("writeFile", js_write_file_handler) \
+  X("append", js_append_handler)        \
+  X("stat", js_stat_handler)            \
+  X("readdir", js_readdir_handler)      \
+  X("open", js_open_handler)            \
+  X("createLog", js_create_log_handler)
+
+JS_BINDING_TABLE(fs, FS_BINDINGS);
+
+/**
+ * @brief Populates the exports for the 'fs' native module.
+ */
+jerry_value_t
+fs_module_evaluate(const jerry_value_t native_module)
+{
+  js_fs_set_reader_factory(create_reader);
+  return js_binding_export(native_module, &fs_bindings);
+}
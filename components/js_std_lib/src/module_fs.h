@@ -0,0 +1,24 @@
+#ifndef MODULE_FS_H
+#define MODULE_FS_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'fs' module.
+ *
+ * This function is called by the JerryScript engine when the 'fs' module is
+ * first evaluated. It populates the module's namespace with Promise-based
+ * file functions that run on the I/O task, `open` for chunked reads into
+ * reusable buffers, and `createLog` for buffered append-only logs. Paths are
+ * relative to the script directory.
+ *
+ * @param native_module The jerry_value_t representing the 'fs' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t fs_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'fs' module exports; the registry declares their names.
+extern const js_binding_table_t fs_bindings;
+
+#endif /* MODULE_FS_H */
@@ -5,6 +5,7 @@
 #include "driver/gpio.h"
 #include "esp_log.h"
 
+#include "js_binding.h"
 #include "js_gpio.h"
 #include "module_gpio.h"
 
@@ -44,10 +45,7 @@ js_pin_write_handler(const jerry_call_info_t *call_info_p, const jerry_value_t a
   }
 
   bool level;
-  const jerryx_arg_t mapping[] = {
-      jerryx_arg_boolean(&level, JERRYX_ARG_COERCE, JERRYX_ARG_REQUIRED)};
-
-  jerry_value_t result = jerryx_arg_transform_args(args, argc, mapping, 1);
+  jerry_value_t result = js_binding_arg_boolean(args, argc, 0, &level);
   if (jerry_value_is_exception(result))
   {
     return result;
@@ -69,16 +67,12 @@ js_pin_attach_isr_handler(const jerry_call_info_t *call_info_p, const jerry_valu
   }
 
   jerry_value_t callback;
-  const jerryx_arg_t mapping[] = {
-      jerryx_arg_function(&callback, JERRYX_ARG_REQUIRED)};
-
-  jerry_value_t result = jerryx_arg_transform_args(args, argc, mapping, 1);
+  jerry_value_t result = js_binding_arg_function(args, argc, 0, &callback);
   if (jerry_value_is_exception(result))
   {
     return result;
   }
-  // The transform function does not copy the value, so we don't free the result.
-  // We will copy it in js_gpio_attach_isr.
+  // The callback is borrowed from args; js_gpio_attach_isr copies it.
   esp_err_t err = js_gpio_attach_isr(state->pin_num, callback);
   jerry_value_free(result); // result is undefined, but good practice to free.
   if (err != ESP_OK)
@@ -319,17 +313,137 @@ js_gpio_setup_handler(const jerry_call_info_t *call_info_p, const jerry_value_t
   }
 }
 
+#if CONFIG_JS_LATENCY_TRACE
+/**
+ * @brief Converts a latency histogram to `{ count, minUs, meanUs, maxUs, p50Us, p99Us, buckets }`.
+ *
+ * Percentiles are the upper bound of the log2 bucket they fall in.
+ */
+static jerry_value_t histogram_to_object(const js_latency_histogram_t *h)
+{
+  uint32_t p50 = 0, p99 = 0, seen = 0;
+  jerry_value_t buckets = jerry_array(JS_LATENCY_BUCKETS);
+  for (uint32_t i = 0; i < JS_LATENCY_BUCKETS; i++)
+  {
+    jerry_value_t n = jerry_number(h->buckets[i]);
+    jerry_value_free(jerry_object_set_index(buckets, i, n));
+    jerry_value_free(n);
+
+    uint32_t upper = i + 1 < JS_LATENCY_BUCKETS ? (2u << i) : h->max_us;
+    seen += h->buckets[i];
+    if (!p50 && seen * 2 >= h->count)
+    {
+      p50 = upper;
+    }
+    if (!p99 && seen * 100 >= h->count * 99)
+    {
+      p99 = upper;
+    }
+  }
+
+  jerry_value_t result = jerry_object();
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_NUMBER("count", h->count),
+      JERRYX_PROPERTY_NUMBER("minUs", h->min_us),
+      JERRYX_PROPERTY_NUMBER("meanUs", h->count ? (double)h->total_us / h->count : 0),
+      JERRYX_PROPERTY_NUMBER("maxUs", h->max_us),
+      JERRYX_PROPERTY_NUMBER("p50Us", p50 < h->max_us ? p50 : h->max_us),
+      JERRYX_PROPERTY_NUMBER("p99Us", p99 < h->max_us ? p99 : h->max_us),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(result, props);
+
+  jerry_value_t name = jerry_string_sz("buckets");
+  jerry_value_free(jerry_object_set(result, name, buckets));
+  jerry_value_free(name);
+  jerry_value_free(buckets);
+  return result;
+}
+
+/**
+ * @brief Native implementation of `gpio.latency(pin)`.
+ */
+static jerry_value_t
+js_gpio_latency_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  double pin;
+  jerry_value_t arg = js_binding_arg_number(args, argc, 0, &pin);
+  if (jerry_value_is_exception(arg))
+  {
+    return arg;
+  }
+  jerry_value_free(arg);
+  const js_gpio_latency_t *latency = js_gpio_get_latency((gpio_num_t)pin);
+  if (!latency)
+  {
+    return jerry_undefined();
+  }
+
+  jerry_value_t result = jerry_object();
+  jerry_value_t dispatch = histogram_to_object(&latency->dispatch);
+  jerry_value_t callback = histogram_to_object(&latency->callback);
+  jerry_value_t dispatch_name = jerry_string_sz("dispatch");
+  jerry_value_t callback_name = jerry_string_sz("callback");
+  jerry_value_free(jerry_object_set(result, dispatch_name, dispatch));
+  jerry_value_free(jerry_object_set(result, callback_name, callback));
+  jerry_value_free(dispatch_name);
+  jerry_value_free(callback_name);
+  jerry_value_free(dispatch);
+  jerry_value_free(callback);
+  return result;
+}
+
+/**
+ * @brief Native implementation of `gpio.resetLatency(pin?)`. Clears every pin if none is given.
+ */
+static jerry_value_t
+js_gpio_reset_latency_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc > 0 && jerry_value_is_number(args[0]))
+  {
+    js_gpio_reset_latency((gpio_num_t)jerry_value_as_number(args[0]));
+  }
+  else
+  {
+    for (int i = 0; i < MAX_GPIO_PINS; i++)
+    {
+      js_gpio_reset_latency(i);
+    }
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Native implementation of `gpio.logLatency(enabled)`.
+ */
+static jerry_value_t
+js_gpio_log_latency_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_gpio_set_latency_logging(argc > 0 && jerry_value_to_boolean(args[0]));
+  return jerry_undefined();
+}
+#endif
+
+#if CONFIG_JS_LATENCY_TRACE
+#define GPIO_LATENCY_BINDINGS(X)                   \
+  X("latency", js_gpio_latency_handler)            \
+  X("resetLatency", js_gpio_reset_latency_handler) \
+  X("logLatency", js_gpio_log_latency_handler)
+#else
+#define GPIO_LATENCY_BINDINGS(X)
+#endif
+
+#define GPIO_BINDINGS(X)            \
+  X("setup", js_gpio_setup_handler) \
+  GPIO_LATENCY_BINDINGS(X)
+
+JS_BINDING_TABLE(gpio, GPIO_BINDINGS);
+
 /**
  * @brief The evaluation callback for the native 'gpio' module.
  */
 jerry_value_t
 gpio_module_evaluate(const jerry_value_t native_module)
 {
-  jerry_value_t setup_func = jerry_function_external(js_gpio_setup_handler);
-  jerry_value_t setup_name = jerry_string_sz("setup");
-  jerry_native_module_set(native_module, setup_name, setup_func);
-  jerry_value_free(setup_func);
-  jerry_value_free(setup_name);
-
-  return jerry_undefined();
+  return js_binding_export(native_module, &gpio_bindings);
 }
@@ -2,6 +2,7 @@
 #define MODULE_GPIO_H
 
 #include "jerryscript.h"
+#include "js_binding.h"
 
 /**
  * @brief The evaluate callback for the native 'gpio' module.
@@ -15,4 +16,7 @@
  */
 jerry_value_t gpio_module_evaluate(const jerry_value_t native_module);
 
+/// @brief The functions the 'gpio' module exports; the registry declares their names.
+extern const js_binding_table_t gpio_bindings;
+
 #endif /* MODULE_GPIO_H */
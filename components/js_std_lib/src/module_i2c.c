@@ -0,0 +1,402 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+#include "jerryscript-ext/arg.h"
+#include "esp_log.h"
+
+#include "js_binding.h"
+#include "js_i2c.h"
+#include "module_i2c.h"
+
+#define TAG "I2C_MODULE"
+
+#define DEFAULT_FREQUENCY_HZ 100000
+#define DEFAULT_TIMEOUT_MS 50
+#define MAX_ADDRESS 0x3FF // 10-bit addressing
+
+// Forward declaration for the native object's free callback
+static void bus_native_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+
+/**
+ * @brief JerryScript native object info. Connects a JS object to our js_i2c_bus_t struct.
+ */
+static const jerry_object_native_info_t bus_native_info = {
+    .free_cb = bus_native_free_cb,
+};
+
+// --- Argument Helpers ---
+
+/**
+ * @brief Gets the number of bytes in a Uint8Array, ArrayBuffer or array of numbers.
+ * @return False if the value is none of these.
+ */
+static bool get_byte_length(jerry_value_t value, size_t *out_len)
+{
+  if (jerry_value_is_typedarray(value))
+  {
+    if (jerry_typedarray_type(value) != JERRY_TYPEDARRAY_UINT8)
+      return false;
+    *out_len = jerry_typedarray_length(value);
+    return true;
+  }
+  if (jerry_value_is_arraybuffer(value))
+  {
+    *out_len = jerry_arraybuffer_size(value);
+    return true;
+  }
+  if (jerry_value_is_array(value))
+  {
+    *out_len = jerry_array_length(value);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Copies bytes from a value already checked with `get_byte_length`.
+ */
+static void copy_bytes(jerry_value_t value, uint8_t *dst, size_t len)
+{
+  if (jerry_value_is_typedarray(value))
+  {
+    jerry_length_t offset, length;
+    jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, &length);
+    jerry_arraybuffer_read(buffer, offset, dst, len);
+    jerry_value_free(buffer);
+  }
+  else if (jerry_value_is_arraybuffer(value))
+  {
+    jerry_arraybuffer_read(value, 0, dst, len);
+  }
+  else
+  {
+    for (size_t i = 0; i < len; i++)
+    {
+      jerry_value_t item = jerry_object_get_index(value, i);
+      dst[i] = (uint8_t)jerry_value_as_uint32(item);
+      jerry_value_free(item);
+    }
+  }
+}
+
+/**
+ * @brief Validates an address argument.
+ */
+static bool get_address(jerry_value_t value, uint16_t *out_address)
+{
+  if (!jerry_value_is_number(value))
+    return false;
+  double address = jerry_value_as_number(value);
+  if (address < 0 || address > MAX_ADDRESS)
+    return false;
+  *out_address = (uint16_t)address;
+  return true;
+}
+
+/**
+ * @brief Queues a filled-in request and returns the promise it will settle.
+ *
+ * Takes ownership of the request in every case.
+ */
+static jerry_value_t submit_request(js_i2c_bus_t *bus, js_i2c_request_t *request)
+{
+  jerry_value_t promise = jerry_promise();
+  request->promise = jerry_value_copy(promise);
+
+  if (js_i2c_submit(bus, request) != ESP_OK)
+  {
+    jerry_value_free(request->promise);
+    free(request);
+    jerry_value_free(promise);
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Too many I2C transactions in flight.");
+  }
+  return promise;
+}
+
+/**
+ * @brief Builds and submits a request holding a single operation.
+ */
+static jerry_value_t submit_single(js_i2c_bus_t *bus, uint16_t address, jerry_value_t data, size_t read_len)
+{
+  size_t write_len = 0;
+  if (!jerry_value_is_undefined(data) && !get_byte_length(data, &write_len))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Data must be a Uint8Array, ArrayBuffer or array of numbers.");
+  if (write_len > UINT16_MAX || read_len > UINT16_MAX)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "I2C transfers are limited to 65535 bytes.");
+  if (write_len == 0 && read_len == 0)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Nothing to write or read.");
+
+  js_i2c_request_t *request = js_i2c_request_new(1, write_len, read_len);
+  if (!request)
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory for I2C request.");
+
+  request->ops[0] = (js_i2c_op_t){.address = address, .write_len = write_len, .read_len = read_len};
+  if (write_len > 0)
+    copy_bytes(data, request->write_data, write_len);
+
+  return submit_request(bus, request);
+}
+
+// --- Bus Object Method Implementations (Bindings) ---
+
+/**
+ * @brief Gets the bus behind `this`, or NULL if it has been closed.
+ */
+static js_i2c_bus_t *get_bus(const jerry_call_info_t *call_info_p)
+{
+  return (js_i2c_bus_t *)jerry_object_get_native_ptr(call_info_p->this_value, &bus_native_info);
+}
+
+static jerry_value_t
+js_bus_write_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_i2c_bus_t *bus = get_bus(call_info_p);
+  if (!bus)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "I2C bus is closed or invalid.");
+
+  uint16_t address;
+  if (argc < 2 || !get_address(args[0], &address))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a device address and data to write.");
+
+  return submit_single(bus, address, args[1], 0);
+}
+
+static jerry_value_t
+js_bus_read_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_i2c_bus_t *bus = get_bus(call_info_p);
+  if (!bus)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "I2C bus is closed or invalid.");
+
+  uint16_t address;
+  if (argc < 2 || !get_address(args[0], &address) || !jerry_value_is_number(args[1]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a device address and a byte count.");
+
+  return submit_single(bus, address, jerry_undefined(), jerry_value_as_uint32(args[1]));
+}
+
+static jerry_value_t
+js_bus_write_read_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_i2c_bus_t *bus = get_bus(call_info_p);
+  if (!bus)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "I2C bus is closed or invalid.");
+
+  uint16_t address;
+  if (argc < 3 || !get_address(args[0], &address) || !jerry_value_is_number(args[2]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a device address, data to write and a byte count.");
+
+  return submit_single(bus, address, args[1], jerry_value_as_uint32(args[2]));
+}
+
+/**
+ * @brief Native implementation of `bus.transaction(ops)`.
+ *
+ * All operations are validated and packed into one request up front, so the
+ * worker runs the batch without returning to the JS thread in between.
+ */
+static jerry_value_t
+js_bus_transaction_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_i2c_bus_t *bus = get_bus(call_info_p);
+  if (!bus)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "I2C bus is closed or invalid.");
+  if (argc < 1 || !jerry_value_is_array(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected an array of operations.");
+
+  jerry_value_t ops = args[0];
+  size_t op_count = jerry_array_length(ops);
+  if (op_count == 0)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "A transaction needs at least one operation.");
+
+  jerry_value_t address_name = jerry_string_sz("address");
+  jerry_value_t write_name = jerry_string_sz("write");
+  jerry_value_t read_name = jerry_string_sz("read");
+  jerry_value_t result = jerry_undefined();
+  js_i2c_request_t *request = NULL;
+
+  // Pass 0 measures and validates, pass 1 fills the single allocation.
+  size_t write_total = 0, read_total = 0;
+  for (int pass = 0; pass < 2 && jerry_value_is_undefined(result); pass++)
+  {
+    size_t write_offset = 0, read_offset = 0;
+    for (size_t i = 0; i < op_count && jerry_value_is_undefined(result); i++)
+    {
+      jerry_value_t op = jerry_object_get_index(ops, i);
+      jerry_value_t address_value = jerry_value_is_object(op) ? jerry_object_get(op, address_name) : jerry_undefined();
+      jerry_value_t write_value = jerry_value_is_object(op) ? jerry_object_get(op, write_name) : jerry_undefined();
+      jerry_value_t read_value = jerry_value_is_object(op) ? jerry_object_get(op, read_name) : jerry_undefined();
+
+      uint16_t address;
+      size_t write_len = 0;
+      size_t read_len = jerry_value_is_number(read_value) ? jerry_value_as_uint32(read_value) : 0;
+
+      if (!get_address(address_value, &address))
+        result = jerry_throw_sz(JERRY_ERROR_TYPE, "Each operation needs a valid address.");
+      else if (!jerry_value_is_undefined(write_value) && !get_byte_length(write_value, &write_len))
+        result = jerry_throw_sz(JERRY_ERROR_TYPE, "Operation data must be a Uint8Array, ArrayBuffer or array of numbers.");
+      else if (write_len == 0 && read_len == 0)
+        result = jerry_throw_sz(JERRY_ERROR_RANGE, "Each operation must write or read something.");
+      else if (pass == 1 && (write_offset + write_len > write_total || read_offset + read_len > read_total))
+        result = jerry_throw_sz(JERRY_ERROR_COMMON, "Operations changed while the transaction was built.");
+      else if (pass == 1)
+      {
+        request->ops[i] = (js_i2c_op_t){
+            .address = address,
+            .write_offset = write_offset,
+            .write_len = write_len,
+            .read_offset = read_offset,
+            .read_len = read_len,
+        };
+        copy_bytes(write_value, request->write_data + write_offset, write_len);
+      }
+
+      write_offset += write_len;
+      read_offset += read_len;
+      jerry_value_free(read_value);
+      jerry_value_free(write_value);
+      jerry_value_free(address_value);
+      jerry_value_free(op);
+    }
+
+    if (pass == 0 && jerry_value_is_undefined(result))
+    {
+      write_total = write_offset;
+      read_total = read_offset;
+      if (write_total > UINT16_MAX || read_total > UINT16_MAX)
+        result = jerry_throw_sz(JERRY_ERROR_RANGE, "I2C transactions are limited to 65535 bytes each way.");
+      else if (!(request = js_i2c_request_new(op_count, write_total, read_total)))
+        result = jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory for I2C request.");
+    }
+  }
+
+  jerry_value_free(read_name);
+  jerry_value_free(write_name);
+  jerry_value_free(address_name);
+
+  if (jerry_value_is_exception(result))
+  {
+    free(request);
+    return result;
+  }
+
+  request->batch = true;
+  return submit_request(bus, request);
+}
+
+static jerry_value_t
+js_bus_close_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_i2c_bus_t *bus = get_bus(call_info_p);
+
+  if (bus)
+  {
+    js_i2c_close(bus);
+    // Remove the native pointer from the JS object to prevent use-after-free
+    jerry_object_set_native_ptr(call_info_p->this_value, NULL, NULL);
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Callback when a bus object is garbage collected.
+ *
+ * Pending requests keep their own promise references, so they still settle.
+ */
+static void bus_native_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  js_i2c_bus_t *bus = (js_i2c_bus_t *)native_p;
+  if (bus)
+  {
+    ESP_LOGD(TAG, "GC collecting I2C bus %d, ensuring cleanup.", bus->config.port);
+    js_i2c_close(bus);
+  }
+}
+
+// --- Module Function Implementations ---
+
+/**
+ * @brief Native implementation of `i2c.open(config)`.
+ */
+static jerry_value_t
+js_i2c_open_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_object(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Argument must be a config object.");
+
+  double port = 0;
+  double sda = -1;
+  double scl = -1;
+  double frequency = DEFAULT_FREQUENCY_HZ;
+  double timeout = DEFAULT_TIMEOUT_MS;
+
+  const char *prop_names[] = {"port", "sda", "scl", "frequency", "timeout"};
+  const jerryx_arg_t prop_mapping[] = {
+      jerryx_arg_number(&port, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&sda, JERRYX_ARG_COERCE, JERRYX_ARG_REQUIRED),
+      jerryx_arg_number(&scl, JERRYX_ARG_COERCE, JERRYX_ARG_REQUIRED),
+      jerryx_arg_number(&frequency, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&timeout, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+  };
+  jerry_value_t result = jerryx_arg_transform_object_properties(args[0], (const jerry_char_t **)prop_names, 5,
+                                                                prop_mapping, 5);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+
+  js_i2c_bus_config_t config = {
+      .port = (int)port,
+      .sda = (gpio_num_t)sda,
+      .scl = (gpio_num_t)scl,
+      .frequency_hz = (uint32_t)frequency,
+      .timeout_ms = (uint32_t)timeout,
+  };
+
+  js_i2c_bus_t *bus;
+  esp_err_t err = js_i2c_open(&config, &bus);
+  if (err == ESP_ERR_INVALID_ARG)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Invalid I2C port.");
+  }
+  if (err == ESP_ERR_INVALID_STATE)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "I2C port is already open.");
+  }
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to open I2C bus.");
+  }
+
+  jerry_value_t bus_obj = jerry_object();
+  jerry_object_set_native_ptr(bus_obj, &bus_native_info, bus);
+
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("write", js_bus_write_handler),
+      JERRYX_PROPERTY_FUNCTION("read", js_bus_read_handler),
+      JERRYX_PROPERTY_FUNCTION("writeRead", js_bus_write_read_handler),
+      JERRYX_PROPERTY_FUNCTION("transaction", js_bus_transaction_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_bus_close_handler),
+      JERRYX_PROPERTY_NUMBER("port", config.port),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(bus_obj, props);
+
+  return bus_obj;
+}
+
+#define I2C_BINDINGS(X) \
+  X("open", js_i2c_open_handler)
+
+JS_BINDING_TABLE(i2c, I2C_BINDINGS);
+
+/**
+ * @brief The evaluation callback for the native 'i2c' module.
+ */
+jerry_value_t
+i2c_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &i2c_bindings);
+}
@@ -0,0 +1,22 @@
+#ifndef MODULE_I2C_H
+#define MODULE_I2C_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'i2c' module.
+ *
+ * This function is called by the JerryScript engine when the 'i2c' module is
+ * first evaluated. It populates the module's namespace with the `open`
+ * function, which returns bus objects whose transfers resolve as Promises.
+ *
+ * @param native_module The jerry_value_t representing the 'i2c' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t i2c_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'i2c' module exports; the registry declares their names.
+extern const js_binding_table_t i2c_bindings;
+
+#endif /* MODULE_I2C_H */
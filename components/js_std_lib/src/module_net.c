@@ -0,0 +1,442 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+#include "jerryscript-ext/arg.h"
+#include "esp_log.h"
+
+#include "js_binding.h"
+#include "js_net.h"
+#include "module_net.h"
+
+#define TAG "NET_MODULE"
+
+#define MAX_HOST 64
+#define DEFAULT_BACKLOG 4
+#define STRING_STACK_BUFFER 128 // Strings up to this size are encoded without a malloc
+
+// Forward declaration for the native object's free callback
+static void socket_native_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+
+/**
+ * @brief JerryScript native object info. The native pointer is the socket's
+ * handle rather than its slot, so an object outliving its socket finds
+ * nothing instead of whatever reused the slot.
+ */
+static const jerry_object_native_info_t socket_native_info = {
+    .free_cb = socket_native_free_cb,
+};
+
+// --- Helpers ---
+
+static js_net_socket_t *get_socket(jerry_value_t object)
+{
+  void *handle = jerry_object_get_native_ptr(object, &socket_native_info);
+  return handle ? js_net_find((uint32_t)(uintptr_t)handle) : NULL;
+}
+
+static void socket_native_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  js_net_socket_t *sock = js_net_find((uint32_t)(uintptr_t)native_p);
+  if (sock)
+  {
+    ESP_LOGD(TAG, "GC collecting an open socket, closing it.");
+    js_net_release(sock);
+  }
+}
+
+/**
+ * @brief Bytes to send, borrowed from a buffer or encoded from a string.
+ */
+typedef struct
+{
+  const uint8_t *data;
+  size_t len;
+  uint8_t *heap; /**< Set when a long string needed a malloc. */
+  uint8_t stack[STRING_STACK_BUFFER];
+} send_bytes_t;
+
+/**
+ * @brief Finds the bytes of a string, TypedArray or ArrayBuffer; strings are encoded as UTF-8.
+ *
+ * @return undefined, or an exception to return.
+ */
+static jerry_value_t get_bytes(jerry_value_t value, send_bytes_t *bytes)
+{
+  bytes->heap = NULL;
+  if (jerry_value_is_string(value))
+  {
+    jerry_size_t size = jerry_string_size(value, JERRY_ENCODING_UTF8);
+    uint8_t *out = size <= sizeof(bytes->stack) ? bytes->stack : (bytes->heap = (uint8_t *)malloc(size));
+    if (!out)
+      return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory for socket write.");
+    jerry_string_to_buffer(value, JERRY_ENCODING_UTF8, out, size);
+    bytes->data = out;
+    bytes->len = size;
+  }
+  else if (jerry_value_is_typedarray(value))
+  {
+    jerry_length_t offset, length;
+    jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, &length);
+    uint8_t *data = jerry_arraybuffer_data(buffer);
+    jerry_value_free(buffer);
+    bytes->data = data ? data + offset : bytes->stack;
+    bytes->len = data ? length : 0;
+  }
+  else if (jerry_value_is_arraybuffer(value))
+  {
+    uint8_t *data = jerry_arraybuffer_data(value);
+    bytes->data = data ? data : bytes->stack;
+    bytes->len = data ? jerry_arraybuffer_size(value) : 0;
+  }
+  else
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Data must be a string, TypedArray or ArrayBuffer.");
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Reads `{host, port, backlog}` from an options object.
+ */
+static jerry_value_t get_options(jerry_value_t options, char host[MAX_HOST], double *port, double *backlog)
+{
+  const char *prop_names[] = {"host", "port", "backlog"};
+  const jerryx_arg_t prop_mapping[] = {
+      jerryx_arg_string(host, MAX_HOST, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(port, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(backlog, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+  };
+  jerry_value_t result =
+      jerryx_arg_transform_object_properties(options, (const jerry_char_t **)prop_names, 3, prop_mapping, 3);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+  if (*port < 0 || *port > 65535 || *port != (double)(int)*port)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "port must be an integer from 0 to 65535.");
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Describes a failed open, as an error value for the caller to throw or reject with.
+ */
+static jerry_value_t open_error(esp_err_t err)
+{
+  if (err == ESP_ERR_NOT_FOUND)
+  {
+    return jerry_error_sz(JERRY_ERROR_COMMON, "Host not found.");
+  }
+  if (err == ESP_ERR_NO_MEM)
+  {
+    return jerry_error_sz(JERRY_ERROR_COMMON, "All sockets are in use.");
+  }
+  if (err == ESP_ERR_INVALID_STATE)
+  {
+    return jerry_error_sz(JERRY_ERROR_COMMON, "Address is already in use.");
+  }
+  char message[80];
+  snprintf(message, sizeof(message), "Failed to open socket: %s", strerror(errno));
+  return jerry_error_sz(JERRY_ERROR_COMMON, message);
+}
+
+static void set_number(jerry_value_t object, const char *name, double number)
+{
+  jerry_value_t key = jerry_string_sz(name);
+  jerry_value_t value = jerry_number(number);
+  jerry_value_free(jerry_object_set(object, key, value));
+  jerry_value_free(value);
+  jerry_value_free(key);
+}
+
+/**
+ * @brief Sets the `port` a listener or UDP socket is bound to, which is
+ * only known after binding to port 0.
+ */
+static void set_local_port(js_net_socket_t *sock, jerry_value_t object)
+{
+  char address[16];
+  uint16_t port;
+  if (js_net_address(sock, false, address, &port) == ESP_OK)
+  {
+    set_number(object, "port", port);
+  }
+}
+
+// --- Socket Object Method Implementations (Bindings) ---
+
+/**
+ * @brief Native implementation of `socket.write(data)`.
+ *
+ * @return The number of bytes accepted; fewer than given when the send
+ * buffer is full, in which case `drain()` says when to write the rest.
+ */
+static jerry_value_t
+js_socket_write_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_net_socket_t *sock = get_socket(call_info_p->this_value);
+  if (!sock)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Socket is closed or invalid.");
+  if (argc < 1)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected data to write.");
+
+  send_bytes_t bytes;
+  jerry_value_t error = get_bytes(args[0], &bytes);
+  if (jerry_value_is_exception(error))
+    return error;
+
+  int accepted = js_net_write(sock, bytes.data, bytes.len);
+  int write_errno = errno;
+  free(bytes.heap);
+  if (accepted < 0)
+  {
+    char message[80];
+    snprintf(message, sizeof(message), "Write failed: %s", strerror(write_errno));
+    return jerry_throw_sz(JERRY_ERROR_COMMON, message);
+  }
+  return jerry_number(accepted);
+}
+
+static jerry_value_t
+js_socket_drain_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_net_socket_t *sock = get_socket(call_info_p->this_value);
+  if (!sock)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Socket is closed or invalid.");
+
+  return js_net_drain(sock);
+}
+
+/**
+ * @brief Native implementation of `socket.onData(callback)`.
+ *
+ * Reading starts with the first callback, so a socket nobody reads from
+ * pushes back on its sender instead of filling the JS heap.
+ */
+static jerry_value_t
+js_socket_on_data_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_net_socket_t *sock = get_socket(call_info_p->this_value);
+  if (!sock)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Socket is closed or invalid.");
+  if (argc < 1 || !jerry_value_is_function(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a callback function.");
+
+  js_net_set_callback(sock, args[0]);
+  return jerry_undefined();
+}
+
+/**
+ * @brief Native implementation of `udp.send(data, host, port)`.
+ *
+ * @return false if the datagram was dropped because the send buffer was full.
+ */
+static jerry_value_t
+js_udp_send_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_net_socket_t *sock = get_socket(call_info_p->this_value);
+  if (!sock)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Socket is closed or invalid.");
+  if (argc < 3 || !jerry_value_is_string(args[1]) || !jerry_value_is_number(args[2]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected data, a host string and a port.");
+
+  char host[MAX_HOST];
+  jerry_size_t host_len = jerry_string_to_buffer(args[1], JERRY_ENCODING_UTF8, (jerry_char_t *)host, MAX_HOST - 1);
+  host[host_len] = '\0';
+  double port = jerry_value_as_number(args[2]);
+  if (port < 1 || port > 65535)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "port must be from 1 to 65535.");
+
+  send_bytes_t bytes;
+  jerry_value_t error = get_bytes(args[0], &bytes);
+  if (jerry_value_is_exception(error))
+    return error;
+
+  esp_err_t err = js_net_send_to(sock, bytes.data, bytes.len, host, (uint16_t)port);
+  int send_errno = errno;
+  free(bytes.heap);
+  if (err == ESP_ERR_NOT_FOUND)
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Host not found.");
+  if (err != ESP_OK && send_errno != EAGAIN && send_errno != EWOULDBLOCK)
+  {
+    char message[80];
+    snprintf(message, sizeof(message), "Send failed: %s", strerror(send_errno));
+    return jerry_throw_sz(JERRY_ERROR_COMMON, message);
+  }
+  return jerry_boolean(err == ESP_OK);
+}
+
+static jerry_value_t
+js_socket_close_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_net_socket_t *sock = get_socket(call_info_p->this_value);
+
+  if (sock)
+  {
+    js_net_close(sock);
+  }
+  // Remove the handle from the JS object, so a later GC does not look it up
+  jerry_object_delete_native_ptr(call_info_p->this_value, &socket_native_info);
+  return jerry_undefined();
+}
+
+/**
+ * @brief Makes the object of a TCP socket, connected or accepted.
+ */
+static jerry_value_t wrap_stream(js_net_socket_t *sock)
+{
+  jerry_value_t object = jerry_object();
+  jerry_object_set_native_ptr(object, &socket_native_info, (void *)(uintptr_t)sock->handle_id);
+
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("write", js_socket_write_handler),
+      JERRYX_PROPERTY_FUNCTION("drain", js_socket_drain_handler),
+      JERRYX_PROPERTY_FUNCTION("onData", js_socket_on_data_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_socket_close_handler),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(object, props);
+  return object;
+}
+
+// --- Module Function Implementations ---
+
+/**
+ * @brief Native implementation of `net.connect(options, onData)`.
+ *
+ * @return A promise for the socket, rejected if the host does not resolve
+ * or the connection is refused.
+ */
+static jerry_value_t
+js_net_connect_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_object(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "First argument must be an options object.");
+  if (argc > 1 && !jerry_value_is_function(args[1]) && !jerry_value_is_undefined(args[1]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Second argument must be a callback function.");
+
+  char host[MAX_HOST] = "localhost";
+  double port = 0;
+  double backlog = 0;
+  jerry_value_t result = get_options(args[0], host, &port, &backlog);
+  if (jerry_value_is_exception(result))
+    return result;
+  if (port == 0)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "port is required.");
+
+  js_net_socket_t *sock;
+  esp_err_t err = js_net_connect(host, (uint16_t)port, &sock);
+  if (err != ESP_OK)
+  {
+    jerry_value_t promise = jerry_promise();
+    jerry_value_t error = open_error(err);
+    jerry_value_free(jerry_promise_reject(promise, error));
+    jerry_value_free(error);
+    return promise;
+  }
+
+  jerry_value_t object = wrap_stream(sock);
+  if (argc > 1 && jerry_value_is_function(args[1]))
+  {
+    js_net_set_callback(sock, args[1]);
+  }
+  jerry_value_t promise = js_net_connect_promise(sock, object);
+  jerry_value_free(object);
+  return promise;
+}
+
+/**
+ * @brief Native implementation of `net.listen(options, onConnection)`.
+ */
+static jerry_value_t
+js_net_listen_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 2)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected 2 arguments: options object and connection callback.");
+  if (!jerry_value_is_object(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "First argument must be an options object.");
+  if (!jerry_value_is_function(args[1]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Second argument must be a callback function.");
+
+  char host[MAX_HOST] = "";
+  double port = 0;
+  double backlog = DEFAULT_BACKLOG;
+  jerry_value_t result = get_options(args[0], host, &port, &backlog);
+  if (jerry_value_is_exception(result))
+    return result;
+  if (backlog < 1 || backlog > JS_NET_MAX_SOCKETS)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "backlog must be from 1 to the socket limit.");
+
+  js_net_socket_t *sock;
+  esp_err_t err = js_net_listen(host, (uint16_t)port, (int)backlog, args[1], wrap_stream, &sock);
+  if (err != ESP_OK)
+    return jerry_throw_value(open_error(err), true);
+
+  jerry_value_t object = jerry_object();
+  jerry_object_set_native_ptr(object, &socket_native_info, (void *)(uintptr_t)sock->handle_id);
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("close", js_socket_close_handler),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(object, props);
+  set_local_port(sock, object);
+  return object;
+}
+
+/**
+ * @brief Native implementation of `net.udp(options, onMessage)`.
+ */
+static jerry_value_t
+js_net_udp_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 2)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected 2 arguments: options object and message callback.");
+  if (!jerry_value_is_object(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "First argument must be an options object.");
+  if (!jerry_value_is_function(args[1]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Second argument must be a callback function.");
+
+  char host[MAX_HOST] = "";
+  double port = 0;
+  double backlog = 0;
+  jerry_value_t result = get_options(args[0], host, &port, &backlog);
+  if (jerry_value_is_exception(result))
+    return result;
+
+  js_net_socket_t *sock;
+  esp_err_t err = js_net_udp(host, (uint16_t)port, args[1], &sock);
+  if (err != ESP_OK)
+    return jerry_throw_value(open_error(err), true);
+
+  jerry_value_t object = jerry_object();
+  jerry_object_set_native_ptr(object, &socket_native_info, (void *)(uintptr_t)sock->handle_id);
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("send", js_udp_send_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_socket_close_handler),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(object, props);
+  set_local_port(sock, object);
+  return object;
+}
+
+#define NET_BINDINGS(X)                \
+  X("connect", js_net_connect_handler) \
+  X("listen", js_net_listen_handler)   \
+  X("udp", js_net_udp_handler)
+
+JS_BINDING_TABLE(net, NET_BINDINGS);
+
+/**
+ * @brief The evaluation callback for the native 'net' module.
+ */
+jerry_value_t
+net_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &net_bindings);
+}
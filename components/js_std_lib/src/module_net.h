@@ -0,0 +1,23 @@
+#ifndef MODULE_NET_H
+#define MODULE_NET_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'net' module.
+ *
+ * This function is called by the JerryScript engine when the 'net' module
+ * is first evaluated. It populates the module's namespace with functions
+ * to connect, listen and bind UDP sockets, all served by one I/O task that
+ * waits on every socket at once and wakes the event loop when one is ready.
+ *
+ * @param native_module The jerry_value_t representing the 'net' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t net_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'net' module exports; the registry declares their names.
+extern const js_binding_table_t net_bindings;
+
+#endif /* MODULE_NET_H */
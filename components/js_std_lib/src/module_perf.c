@@ -0,0 +1,237 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#include "js_binding.h"
+#include "js_std_lib.h"
+#include "js_module_resolver.h"
+#include "js_heap.h"
+#include "js_power.h"
+#include "module_perf.h"
+
+#define TAG "PERF_MODULE"
+#define MAX_PATH_LENGTH 64
+
+/**
+ * @brief Native implementation of `perf.now()`: microseconds since boot.
+ */
+static jerry_value_t
+js_perf_now_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  return jerry_number((double)esp_timer_get_time());
+}
+
+/**
+ * @brief Native implementation of `perf.heap()`.
+ *
+ * Returns undefined when the engine was built without JERRY_MEM_STATS.
+ */
+static jerry_value_t
+js_perf_heap_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  jerry_heap_stats_t stats = {0};
+  if (!jerry_heap_stats(&stats))
+  {
+    return jerry_undefined();
+  }
+
+  jerry_value_t result = jerry_object();
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_NUMBER("size", stats.size),
+      JERRYX_PROPERTY_NUMBER("allocated", stats.allocated_bytes),
+      JERRYX_PROPERTY_NUMBER("peak", stats.peak_allocated_bytes),
+      JERRYX_PROPERTY_STRING_SZ("placement", JS_HEAP_PLACEMENT),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(result, props);
+  return result;
+}
+
+/**
+ * @brief Native implementation of `perf.gc()`.
+ */
+static jerry_value_t
+js_perf_gc_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  jerry_heap_gc(JERRY_GC_PRESSURE_HIGH);
+  return jerry_undefined();
+}
+
+/**
+ * @brief Native implementation of `perf.importNative(name)`.
+ *
+ * Builds, links and evaluates a fresh instance of a native module, which is
+ * the work an `import` of it does, and returns the time taken in microseconds.
+ */
+static jerry_value_t
+js_perf_import_native_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_string(args[0]))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a module name.");
+  }
+
+  int64_t start = esp_timer_get_time();
+  jerry_value_t module = js_get_native_module(args[0]);
+  if (jerry_value_is_exception(module))
+  {
+    return module;
+  }
+
+  jerry_value_t result = jerry_module_link(module, NULL, NULL);
+  if (!jerry_value_is_exception(result))
+  {
+    jerry_value_free(result);
+    result = jerry_module_evaluate(module);
+  }
+  int64_t elapsed = esp_timer_get_time() - start;
+  jerry_value_free(module);
+
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+  return jerry_number((double)elapsed);
+}
+
+/**
+ * @brief Native implementation of `perf.parseModule(path)`.
+ *
+ * Reads and parses a module from the script directory without linking or
+ * running it. Returns `{ bytes, readUs, parseUs }`.
+ */
+static jerry_value_t
+js_perf_parse_module_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_string(args[0]))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a module path.");
+  }
+
+  char path[MAX_PATH_LENGTH];
+  jerry_size_t len = jerry_string_to_buffer(args[0], JERRY_ENCODING_UTF8, (jerry_char_t *)path, sizeof(path) - 1);
+  path[len] = '\0';
+
+  int64_t start = esp_timer_get_time();
+  size_t size = 0;
+  unsigned char *source = js_module_resolver_read_file(path, &size);
+  if (!source)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Module not found");
+  }
+  int64_t read_done = esp_timer_get_time();
+
+  jerry_parse_options_t parse_options = {
+      .options = JERRY_PARSE_MODULE,
+  };
+  jerry_value_t module = jerry_parse(source, size, &parse_options);
+  int64_t parse_done = esp_timer_get_time();
+  free(source);
+
+  if (jerry_value_is_exception(module))
+  {
+    return module;
+  }
+  jerry_value_free(module);
+
+  jerry_value_t result = jerry_object();
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_NUMBER("bytes", size),
+      JERRYX_PROPERTY_NUMBER("readUs", (double)(read_done - start)),
+      JERRYX_PROPERTY_NUMBER("parseUs", (double)(parse_done - read_done)),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(result, props);
+  return result;
+}
+
+/**
+ * @brief Native implementation of `perf.boot()`.
+ *
+ * Returns the script filesystem, how long it took to mount, and the time
+ * spent reading module files so far.
+ */
+static jerry_value_t
+js_perf_boot_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_module_resolver_stats_t stats = js_module_resolver_stats();
+
+  jerry_value_t result = jerry_object();
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_STRING_SZ("filesystem", stats.filesystem ? stats.filesystem : "none"),
+      JERRYX_PROPERTY_NUMBER("mountUs", (double)stats.mount_us),
+      JERRYX_PROPERTY_NUMBER("filesRead", stats.files_read),
+      JERRYX_PROPERTY_NUMBER("bytesRead", stats.bytes_read),
+      JERRYX_PROPERTY_NUMBER("readUs", (double)stats.read_us),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(result, props);
+  return result;
+}
+
+/**
+ * @brief Native implementation of `perf.power()`.
+ *
+ * Returns how long the calling context has been running JS and waiting for
+ * events, and how long the chip has been in light sleep.
+ */
+static jerry_value_t
+js_perf_power_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_power_stats_t stats = js_power_stats();
+
+  jerry_value_t result = jerry_object();
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_NUMBER("activeUs", (double)stats.active_us),
+      JERRYX_PROPERTY_NUMBER("idleUs", (double)stats.idle_us),
+      JERRYX_PROPERTY_NUMBER("sleepUs", (double)stats.sleep_us),
+      JERRYX_PROPERTY_NUMBER("lightSleeps", stats.light_sleeps),
+      JERRYX_PROPERTY_NUMBER("wakeups", stats.wakeups),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(result, props);
+  return result;
+}
+
+/**
+ * @brief Native implementation of `perf.exit(code)`.
+ *
+ * Ends the process on the host build so a benchmark run terminates; firmware
+ * has nowhere to exit to, so this does nothing there.
+ */
+static jerry_value_t
+js_perf_exit_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+#if CONFIG_IDF_TARGET_LINUX
+  int code = (int)js_binding_arg_optional_number(args, argc, 0, 0);
+  fflush(stdout);
+  exit(code);
+#endif
+  return jerry_undefined();
+}
+
+#define PERF_BINDINGS(X)                           \
+  X("now", js_perf_now_handler)                    \
+  X("heap", js_perf_heap_handler)                  \
+  X("gc", js_perf_gc_handler)                      \
+  X("importNative", js_perf_import_native_handler) \
+  X("parseModule", js_perf_parse_module_handler)   \
+  X("boot", js_perf_boot_handler)                  \
+  X("power", js_perf_power_handler)                \
+  X("exit", js_perf_exit_handler)
+
+JS_BINDING_TABLE(perf, PERF_BINDINGS);
+
+/**
+ * @brief Populates the exports for the 'perf' native module.
+ */
+jerry_value_t
+perf_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &perf_bindings);
+}
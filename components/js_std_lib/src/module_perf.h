@@ -0,0 +1,22 @@
+#ifndef MODULE_PERF_H
+#define MODULE_PERF_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'perf' module.
+ *
+ * This function is called by the JerryScript engine when the 'perf' module is
+ * first evaluated. It populates the module's namespace with the timing and
+ * heap helpers the benchmark suite is built on.
+ *
+ * @param native_module The jerry_value_t representing the 'perf' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t perf_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'perf' module exports; the registry declares their names.
+extern const js_binding_table_t perf_bindings;
+
+#endif /* MODULE_PERF_H */
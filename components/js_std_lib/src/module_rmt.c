@@ -0,0 +1,457 @@
+#include <string.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+#include "jerryscript-ext/arg.h"
+#include "esp_log.h"
+#include "soc/soc_caps.h"
+
+#include "js_binding.h"
+#include "js_rmt.h"
+#include "module_rmt.h"
+
+#define TAG "RMT_MODULE"
+
+#define DEFAULT_RESOLUTION_HZ 1000000 // 1 tick = 1us
+#define DEFAULT_MAX_SYMBOLS 64
+#define DEFAULT_MIN_PULSE_NS 1250
+#define DEFAULT_MAX_PULSE_NS 12000000
+
+// Forward declaration for the native object's free callback
+static void channel_native_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+
+/**
+ * @brief JerryScript native object info. Connects a JS object to our js_rmt_channel_t struct.
+ */
+static const jerry_object_native_info_t channel_native_info = {
+    .free_cb = channel_native_free_cb,
+};
+
+/**
+ * @brief Gets the backing store of a typed array of the expected element type.
+ *
+ * No data is copied; the returned pointer stays valid for as long as the
+ * typed array's buffer is referenced.
+ *
+ * @return True if `value` is a typed array of `type`.
+ */
+static bool get_typedarray_data(jerry_value_t value, jerry_typedarray_type_t type,
+                                uint8_t **out_data, jerry_length_t *out_length)
+{
+  if (!jerry_value_is_typedarray(value) || jerry_typedarray_type(value) != type)
+  {
+    return false;
+  }
+  jerry_length_t offset = 0;
+  jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, out_length);
+  *out_data = jerry_arraybuffer_data(buffer) + offset;
+  jerry_value_free(buffer);
+  return true;
+}
+
+/**
+ * @brief Gets the channel behind `this`, or NULL if it is closed.
+ */
+static js_rmt_channel_t *get_channel(const jerry_call_info_t *call_info_p, js_rmt_kind_t kind)
+{
+  js_rmt_channel_t *ch = (js_rmt_channel_t *)jerry_object_get_native_ptr(call_info_p->this_value, &channel_native_info);
+  if (!ch || ch->kind != kind)
+  {
+    return NULL;
+  }
+  return ch;
+}
+
+/**
+ * @brief Turns the result of a queued transmission into the promise returned to JS.
+ */
+static jerry_value_t finish_transmit(esp_err_t err, jerry_value_t promise)
+{
+  if (err == ESP_ERR_INVALID_STATE)
+  {
+    jerry_value_free(promise);
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Too many transmissions in flight.");
+  }
+  if (err != ESP_OK)
+  {
+    jerry_value_free(promise);
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to start RMT transmission.");
+  }
+  return promise;
+}
+
+// --- Transmitter Method Implementations (Bindings) ---
+
+static jerry_value_t
+js_tx_send_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_rmt_channel_t *ch = get_channel(call_info_p, JS_RMT_TX);
+  if (!ch)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Transmitter is closed or invalid.");
+  }
+
+  uint8_t *data;
+  jerry_length_t length;
+  if (argc < 1 || !get_typedarray_data(args[0], JERRY_TYPEDARRAY_UINT32, &data, &length))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a Uint32Array of RMT symbols.");
+  }
+
+  jerry_value_t promise = jerry_promise();
+  esp_err_t err = js_rmt_transmit_symbols(ch, args[0], (const rmt_symbol_word_t *)data,
+                                          length / sizeof(rmt_symbol_word_t), promise);
+  return finish_transmit(err, promise);
+}
+
+static jerry_value_t
+js_tx_send_ws2812_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_rmt_channel_t *ch = get_channel(call_info_p, JS_RMT_TX);
+  if (!ch)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Transmitter is closed or invalid.");
+  }
+
+  uint8_t *data;
+  jerry_length_t length;
+  if (argc < 1 || !get_typedarray_data(args[0], JERRY_TYPEDARRAY_UINT8, &data, &length))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a Uint8Array of GRB pixel bytes.");
+  }
+
+  jerry_value_t promise = jerry_promise();
+  esp_err_t err = js_rmt_transmit_ws2812(ch, args[0], data, length, promise);
+  return finish_transmit(err, promise);
+}
+
+static jerry_value_t
+js_tx_send_nec_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_rmt_channel_t *ch = get_channel(call_info_p, JS_RMT_TX);
+  if (!ch)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Transmitter is closed or invalid.");
+  }
+
+  uint16_t address;
+  uint8_t command;
+  jerry_value_t result = js_binding_arg_uint16(args, argc, 0, &address);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+  result = js_binding_arg_uint8(args, argc, 1, &command);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+
+  jerry_value_t promise = jerry_promise();
+  esp_err_t err = js_rmt_transmit_nec(ch, address, command, promise);
+  return finish_transmit(err, promise);
+}
+
+// --- Receiver Method Implementations (Bindings) ---
+
+static jerry_value_t
+js_rx_start_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_rmt_channel_t *ch = get_channel(call_info_p, JS_RMT_RX);
+  if (!ch)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Receiver is closed or invalid.");
+  }
+
+  jerry_value_t callback;
+  jerry_value_t result = js_binding_arg_function(args, argc, 0, &callback);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+
+  if (js_rmt_start_receive(ch, callback) != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to start RMT receiver.");
+  }
+  return jerry_undefined();
+}
+
+static jerry_value_t
+js_rx_stop_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_rmt_channel_t *ch = get_channel(call_info_p, JS_RMT_RX);
+  if (!ch)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Receiver is closed or invalid.");
+  }
+  js_rmt_stop_receive(ch);
+  return jerry_undefined();
+}
+
+static jerry_value_t
+js_channel_close_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_rmt_channel_t *ch = (js_rmt_channel_t *)jerry_object_get_native_ptr(call_info_p->this_value, &channel_native_info);
+
+  if (ch)
+  {
+    js_rmt_close(ch);
+    // Remove the native pointer from the JS object to prevent use-after-free
+    jerry_object_set_native_ptr(call_info_p->this_value, NULL, NULL);
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Callback when a Transmitter or Receiver object is garbage collected.
+ *
+ * Only native resources are released: settling promises is not allowed
+ * while the collector runs.
+ */
+static void channel_native_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  js_rmt_channel_t *ch = (js_rmt_channel_t *)native_p;
+  if (ch && ch->kind != JS_RMT_UNUSED)
+  {
+    ESP_LOGD(TAG, "GC collecting RMT channel on pin %d, ensuring cleanup.", ch->pin_num);
+    js_rmt_release(ch);
+  }
+}
+
+/**
+ * @brief Creates a JS channel object with the given methods and links it to its native state.
+ */
+static jerry_value_t create_channel_object(js_rmt_channel_t *ch, const jerryx_property_entry *methods)
+{
+  jerry_value_t obj = jerry_object();
+  jerry_object_set_native_ptr(obj, &channel_native_info, ch);
+  jerryx_set_properties(obj, methods);
+
+  jerry_value_t pin_name = jerry_string_sz("pin");
+  jerry_value_t pin_value = jerry_number(ch->pin_num);
+  jerry_value_free(jerry_object_set(obj, pin_name, pin_value));
+  jerry_value_free(pin_value);
+  jerry_value_free(pin_name);
+
+  jerry_value_t resolution_name = jerry_string_sz("resolution");
+  jerry_value_t resolution_value = jerry_number(ch->resolution_hz);
+  jerry_value_free(jerry_object_set(obj, resolution_name, resolution_value));
+  jerry_value_free(resolution_value);
+  jerry_value_free(resolution_name);
+
+  return obj;
+}
+
+// --- Module Function Implementations ---
+
+/**
+ * @brief Native implementation of `rmt.transmitter(pin, options)`.
+ */
+static jerry_value_t
+js_rmt_transmitter_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_number(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "First argument must be a pin number.");
+
+  double resolution = DEFAULT_RESOLUTION_HZ;
+  double mem_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL;
+  double carrier = 0;
+  bool open_drain = false;
+  bool dma = false;
+
+  if (argc > 1 && jerry_value_is_object(args[1]))
+  {
+    const char *prop_names[] = {"resolution", "memSymbols", "carrier", "openDrain", "dma"};
+    const jerryx_arg_t prop_mapping[] = {
+        jerryx_arg_number(&resolution, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+        jerryx_arg_number(&mem_symbols, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+        jerryx_arg_number(&carrier, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+        jerryx_arg_boolean(&open_drain, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+        jerryx_arg_boolean(&dma, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+    };
+    jerry_value_t result = jerryx_arg_transform_object_properties(args[1], (const jerry_char_t **)prop_names, 5,
+                                                                  prop_mapping, 5);
+    if (jerry_value_is_exception(result))
+    {
+      return result;
+    }
+    jerry_value_free(result);
+  }
+
+  js_rmt_tx_config_t config = {
+      .pin_num = (gpio_num_t)jerry_value_as_number(args[0]),
+      .resolution_hz = (uint32_t)resolution,
+      .mem_block_symbols = (size_t)mem_symbols,
+      .carrier_hz = (uint32_t)carrier,
+      .open_drain = open_drain,
+      .with_dma = dma,
+  };
+  js_rmt_channel_t *ch;
+  if (js_rmt_new_tx(&config, &ch) != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to open RMT transmitter.");
+  }
+
+  jerryx_property_entry methods[] = {
+      JERRYX_PROPERTY_FUNCTION("send", js_tx_send_handler),
+      JERRYX_PROPERTY_FUNCTION("sendWS2812", js_tx_send_ws2812_handler),
+      JERRYX_PROPERTY_FUNCTION("sendNEC", js_tx_send_nec_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_channel_close_handler),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  return create_channel_object(ch, methods);
+}
+
+/**
+ * @brief Native implementation of `rmt.receiver(pin, options)`.
+ */
+static jerry_value_t
+js_rmt_receiver_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_number(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "First argument must be a pin number.");
+
+  double resolution = DEFAULT_RESOLUTION_HZ;
+  double max_symbols = DEFAULT_MAX_SYMBOLS;
+  double min_pulse_ns = DEFAULT_MIN_PULSE_NS;
+  double max_pulse_ns = DEFAULT_MAX_PULSE_NS;
+
+  if (argc > 1 && jerry_value_is_object(args[1]))
+  {
+    const char *prop_names[] = {"resolution", "maxSymbols", "minPulseNs", "maxPulseNs"};
+    const jerryx_arg_t prop_mapping[] = {
+        jerryx_arg_number(&resolution, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+        jerryx_arg_number(&max_symbols, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+        jerryx_arg_number(&min_pulse_ns, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+        jerryx_arg_number(&max_pulse_ns, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+    };
+    jerry_value_t result = jerryx_arg_transform_object_properties(args[1], (const jerry_char_t **)prop_names, 4,
+                                                                  prop_mapping, 4);
+    if (jerry_value_is_exception(result))
+    {
+      return result;
+    }
+    jerry_value_free(result);
+  }
+
+  js_rmt_rx_config_t config = {
+      .pin_num = (gpio_num_t)jerry_value_as_number(args[0]),
+      .resolution_hz = (uint32_t)resolution,
+      .max_symbols = (size_t)max_symbols,
+      .min_pulse_ns = (uint32_t)min_pulse_ns,
+      .max_pulse_ns = (uint32_t)max_pulse_ns,
+  };
+  js_rmt_channel_t *ch;
+  if (js_rmt_new_rx(&config, &ch) != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to open RMT receiver.");
+  }
+
+  jerryx_property_entry methods[] = {
+      JERRYX_PROPERTY_FUNCTION("start", js_rx_start_handler),
+      JERRYX_PROPERTY_FUNCTION("stop", js_rx_stop_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_channel_close_handler),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  return create_channel_object(ch, methods);
+}
+
+/**
+ * @brief Parses the `(symbols, resolution)` arguments shared by the decoders.
+ */
+static bool parse_decode_args(const jerry_value_t args[], const jerry_length_t argc,
+                              const rmt_symbol_word_t **out_symbols, size_t *out_count, uint32_t *out_resolution)
+{
+  uint8_t *data;
+  jerry_length_t length;
+  if (argc < 1 || !get_typedarray_data(args[0], JERRY_TYPEDARRAY_UINT32, &data, &length))
+  {
+    return false;
+  }
+  *out_symbols = (const rmt_symbol_word_t *)data;
+  *out_count = length / sizeof(rmt_symbol_word_t);
+  *out_resolution = (uint32_t)js_binding_arg_optional_number(args, argc, 1, DEFAULT_RESOLUTION_HZ);
+  return *out_resolution > 0;
+}
+
+/**
+ * @brief Native implementation of `rmt.decodeNEC(symbols, resolution)`.
+ */
+static jerry_value_t
+js_rmt_decode_nec_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  const rmt_symbol_word_t *symbols;
+  size_t count;
+  uint32_t resolution;
+  if (!parse_decode_args(args, argc, &symbols, &count, &resolution))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a Uint32Array of RMT symbols.");
+  }
+
+  js_rmt_nec_frame_t frame;
+  if (!js_rmt_decode_nec(symbols, count, resolution, &frame))
+  {
+    return jerry_null();
+  }
+
+  jerry_value_t obj = jerry_object();
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_NUMBER("address", frame.address),
+      JERRYX_PROPERTY_NUMBER("command", frame.command),
+      JERRYX_PROPERTY_BOOLEAN("repeat", frame.repeat),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(obj, props);
+  return obj;
+}
+
+/**
+ * @brief Native implementation of `rmt.decodeDHT22(symbols, resolution)`.
+ */
+static jerry_value_t
+js_rmt_decode_dht22_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  const rmt_symbol_word_t *symbols;
+  size_t count;
+  uint32_t resolution;
+  if (!parse_decode_args(args, argc, &symbols, &count, &resolution))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a Uint32Array of RMT symbols.");
+  }
+
+  int16_t humidity_x10;
+  int16_t temperature_x10;
+  if (!js_rmt_decode_dht22(symbols, count, resolution, &humidity_x10, &temperature_x10))
+  {
+    return jerry_null();
+  }
+
+  jerry_value_t obj = jerry_object();
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_NUMBER("humidity", humidity_x10 / 10.0),
+      JERRYX_PROPERTY_NUMBER("temperature", temperature_x10 / 10.0),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(obj, props);
+  return obj;
+}
+
+#define RMT_BINDINGS(X)                        \
+  X("transmitter", js_rmt_transmitter_handler) \
+  X("receiver", js_rmt_receiver_handler)       \
+  X("decodeNEC", js_rmt_decode_nec_handler)    \
+  X("decodeDHT22", js_rmt_decode_dht22_handler)
+
+JS_BINDING_TABLE(rmt, RMT_BINDINGS);
+
+/**
+ * @brief The evaluation callback for the native 'rmt' module.
+ */
+jerry_value_t
+rmt_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &rmt_bindings);
+}
@@ -0,0 +1,22 @@
+#ifndef MODULE_RMT_H
+#define MODULE_RMT_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'rmt' module.
+ *
+ * This function is called by the JerryScript engine when the 'rmt' module is
+ * first evaluated. It populates the module's namespace with the transmitter
+ * and receiver factories and the native protocol decoders.
+ *
+ * @param native_module The jerry_value_t representing the 'rmt' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t rmt_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'rmt' module exports; the registry declares their names.
+extern const js_binding_table_t rmt_bindings;
+
+#endif /* MODULE_RMT_H */
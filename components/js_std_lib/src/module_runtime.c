@@ -0,0 +1,187 @@
+#include <stdlib.h>
+#include <string.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#include "js_binding.h"
+#include "js_offload.h"
+#include "js_watchdog.h"
+#include "module_runtime.h"
+
+#define TAG "RUNTIME_MODULE"
+#define MAX_OP_NAME 32
+
+/**
+ * @brief Points a job's input at the bytes of an ArrayBuffer or TypedArray, or copies a string.
+ *
+ * Buffers are not copied; the job holds a reference to them until it settles.
+ * @return False if the value is none of these, or its buffer has been detached.
+ */
+static bool capture_input(js_offload_job_t *job, jerry_value_t value)
+{
+  if (jerry_value_is_undefined(value))
+  {
+    return true;
+  }
+  if (jerry_value_is_string(value))
+  {
+    jerry_size_t size = jerry_string_size(value, JERRY_ENCODING_UTF8);
+    job->input_copy = (uint8_t *)malloc(size ? size : 1);
+    if (!job->input_copy)
+    {
+      return false;
+    }
+    jerry_string_to_buffer(value, JERRY_ENCODING_UTF8, job->input_copy, size);
+    job->input.data = job->input_copy;
+    job->input.len = size;
+    return true;
+  }
+
+  uint8_t *data = NULL;
+  size_t len = 0;
+  if (jerry_value_is_arraybuffer(value))
+  {
+    data = jerry_arraybuffer_data(value);
+    len = jerry_arraybuffer_size(value);
+  }
+  else if (jerry_value_is_typedarray(value))
+  {
+    jerry_length_t offset, length;
+    jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, &length);
+    data = jerry_arraybuffer_data(buffer);
+    jerry_value_free(buffer);
+    data = data ? data + offset : NULL;
+    len = length;
+  }
+  else
+  {
+    return false;
+  }
+  if (!data && len > 0)
+  {
+    return false; // Detached
+  }
+
+  job->input_value = jerry_value_copy(value);
+  job->input.data = data;
+  job->input.len = len;
+  return true;
+}
+
+/**
+ * @brief Native implementation of `runtime.offload(name, data?, ...params)`.
+ */
+static jerry_value_t
+js_runtime_offload_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_string(args[0]))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected an operation name.");
+  }
+
+  char name[MAX_OP_NAME];
+  jerry_size_t name_len = jerry_string_to_buffer(args[0], JERRY_ENCODING_UTF8, (jerry_char_t *)name, sizeof(name) - 1);
+  name[name_len] = '\0';
+  js_offload_fn_t fn = js_offload_find(name);
+  if (!fn)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Unknown offload operation.");
+  }
+
+  js_offload_job_t *job = (js_offload_job_t *)calloc(1, sizeof(js_offload_job_t));
+  if (!job)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+  }
+  job->fn = fn;
+  job->input_value = jerry_undefined();
+
+  if (!capture_input(job, argc > 1 ? args[1] : jerry_undefined()))
+  {
+    free(job->input_copy);
+    free(job);
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Data must be an ArrayBuffer, TypedArray or string.");
+  }
+
+  for (jerry_length_t i = 2; i < argc && job->input.param_count < JS_OFFLOAD_MAX_PARAMS; i++)
+  {
+    job->input.params[job->input.param_count++] = jerry_value_as_number(args[i]);
+  }
+
+  job->promise = jerry_promise();
+  if (js_offload_submit(job) != ESP_OK)
+  {
+    jerry_value_free(job->promise);
+    jerry_value_free(job->input_value);
+    free(job->input_copy);
+    free(job);
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Offload queue is full.");
+  }
+
+  // The job keeps its own reference until the worker's result is dispatched.
+  return jerry_value_copy(job->promise);
+}
+
+#if CONFIG_JS_WATCHDOG
+/**
+ * @brief Native implementation of `runtime.watchdog()`.
+ */
+static jerry_value_t
+js_runtime_watchdog_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_watchdog_stats_t stats = js_watchdog_stats();
+
+  jerry_value_t result = jerry_object();
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_NUMBER("budgetMs", stats.budget_ms),
+      JERRYX_PROPERTY_NUMBER("aborted", stats.aborted),
+      JERRYX_PROPERTY_NUMBER("longestUs", (double)stats.longest_us),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(result, props);
+  return result;
+}
+
+/**
+ * @brief Native implementation of `runtime.setWatchdog(budgetMs)`.
+ */
+static jerry_value_t
+js_runtime_set_watchdog_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  double budget_ms;
+  jerry_value_t result = js_binding_arg_number(args, argc, 0, &budget_ms);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  if (!(budget_ms >= 0 && budget_ms <= 60000))
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "budgetMs must be between 0 and 60000.");
+  }
+  js_watchdog_set_budget((uint32_t)budget_ms);
+  return jerry_undefined();
+}
+
+#define WATCHDOG_BINDINGS(X)                 \
+  X("watchdog", js_runtime_watchdog_handler) \
+  X("setWatchdog", js_runtime_set_watchdog_handler)
+#else
+#define WATCHDOG_BINDINGS(X)
+#endif
+
+#define RUNTIME_BINDINGS(X)                \
+  X("offload", js_runtime_offload_handler) \
+  WATCHDOG_BINDINGS(X)
+
+JS_BINDING_TABLE(runtime, RUNTIME_BINDINGS);
+
+/**
+ * @brief Populates the exports for the 'runtime' native module.
+ */
+jerry_value_t
+runtime_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &runtime_bindings);
+}
@@ -0,0 +1,22 @@
+#ifndef MODULE_RUNTIME_H
+#define MODULE_RUNTIME_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'runtime' module.
+ *
+ * This function is called by the JerryScript engine when the 'runtime' module
+ * is first evaluated. It populates the module's namespace with `offload`,
+ * which runs registered native operations on worker tasks and returns Promises.
+ *
+ * @param native_module The jerry_value_t representing the 'runtime' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t runtime_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'runtime' module exports; the registry declares their names.
+extern const js_binding_table_t runtime_bindings;
+
+#endif /* MODULE_RUNTIME_H */
@@ -0,0 +1,285 @@
+#include <stdlib.h>
+#include <string.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+#include "jerryscript-ext/arg.h"
+#include "esp_log.h"
+
+#include "js_binding.h"
+#include "js_serial.h"
+#include "module_serial.h"
+
+#define TAG "SERIAL_MODULE"
+
+#define DEFAULT_BAUD_RATE 115200
+#define DEFAULT_MAX_FRAME 256
+#define STRING_STACK_BUFFER 128 // Strings up to this size are encoded without a malloc
+
+// Forward declaration for the native object's free callback
+static void port_native_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+
+/**
+ * @brief JerryScript native object info. Connects a JS object to our js_serial_port_t struct.
+ */
+static const jerry_object_native_info_t port_native_info = {
+    .free_cb = port_native_free_cb,
+};
+
+// --- Port Object Method Implementations (Bindings) ---
+
+/**
+ * @brief Native implementation of `port.write(data)`.
+ *
+ * Typed arrays and ArrayBuffers are written from their backing store; strings
+ * are encoded as UTF-8 first.
+ */
+static jerry_value_t
+js_port_write_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_serial_port_t *port = (js_serial_port_t *)jerry_object_get_native_ptr(call_info_p->this_value, &port_native_info);
+  if (!port)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Serial port is closed or invalid.");
+  if (argc < 1)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected data to write.");
+
+  jerry_value_t data = args[0];
+  size_t accepted;
+
+  if (jerry_value_is_string(data))
+  {
+    uint8_t stack_buffer[STRING_STACK_BUFFER];
+    jerry_size_t size = jerry_string_size(data, JERRY_ENCODING_UTF8);
+    uint8_t *bytes = size <= sizeof(stack_buffer) ? stack_buffer : (uint8_t *)malloc(size);
+    if (!bytes)
+      return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory for serial write.");
+    jerry_string_to_buffer(data, JERRY_ENCODING_UTF8, bytes, size);
+    accepted = js_serial_write(port, bytes, size);
+    if (bytes != stack_buffer)
+      free(bytes);
+  }
+  else if (jerry_value_is_typedarray(data))
+  {
+    jerry_length_t offset, length;
+    jerry_value_t buffer = jerry_typedarray_buffer(data, &offset, &length);
+    uint8_t *bytes = jerry_arraybuffer_data(buffer);
+    accepted = bytes ? js_serial_write(port, bytes + offset, length) : 0;
+    jerry_value_free(buffer);
+  }
+  else if (jerry_value_is_arraybuffer(data))
+  {
+    uint8_t *bytes = jerry_arraybuffer_data(data);
+    accepted = bytes ? js_serial_write(port, bytes, jerry_arraybuffer_size(data)) : 0;
+  }
+  else
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Data must be a string, TypedArray or ArrayBuffer.");
+  }
+
+  return jerry_number(accepted);
+}
+
+static jerry_value_t
+js_port_drain_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_serial_port_t *port = (js_serial_port_t *)jerry_object_get_native_ptr(call_info_p->this_value, &port_native_info);
+  if (!port)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Serial port is closed or invalid.");
+
+  return js_serial_drain(port);
+}
+
+static jerry_value_t
+js_port_overruns_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_serial_port_t *port = (js_serial_port_t *)jerry_object_get_native_ptr(call_info_p->this_value, &port_native_info);
+  if (!port)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Serial port is closed or invalid.");
+
+  return jerry_number(port->overruns);
+}
+
+static jerry_value_t
+js_port_close_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_serial_port_t *port = (js_serial_port_t *)jerry_object_get_native_ptr(call_info_p->this_value, &port_native_info);
+
+  if (port)
+  {
+    js_serial_close(port);
+    // Remove the native pointer from the JS object to prevent use-after-free
+    jerry_object_set_native_ptr(call_info_p->this_value, NULL, NULL);
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Callback when a port object is garbage collected.
+ *
+ * An open port holds its data callback, which usually closes over the port
+ * object, so this mostly runs for ports that were never read from.
+ */
+static void port_native_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  js_serial_port_t *port = (js_serial_port_t *)native_p;
+  if (port)
+  {
+    ESP_LOGD(TAG, "GC collecting UART%d, ensuring cleanup.", port->config.port);
+    js_serial_release(port);
+  }
+}
+
+// --- Module Function Implementations ---
+
+/**
+ * @brief Native implementation of `serial.open(config, onData)`.
+ */
+static jerry_value_t
+js_serial_open_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 2)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected 2 arguments: config object and data callback.");
+  if (!jerry_value_is_object(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "First argument must be a config object.");
+  if (!jerry_value_is_function(args[1]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Second argument must be a callback function.");
+
+  double port_num = -1;
+  double tx = UART_PIN_NO_CHANGE;
+  double rx = UART_PIN_NO_CHANGE;
+  double rts = UART_PIN_NO_CHANGE;
+  double cts = UART_PIN_NO_CHANGE;
+  double baud_rate = DEFAULT_BAUD_RATE;
+  double data_bits = 8;
+  double stop_bits = 1;
+  double max_frame = DEFAULT_MAX_FRAME;
+  char parity_str[8] = "";
+  char delimiter_str[JS_SERIAL_MAX_DELIMITER + 1] = "";
+  char encoding_str[8] = "";
+
+  const char *prop_names[] = {"port", "tx", "rx", "rts", "cts", "baudRate", "dataBits", "stopBits",
+                              "maxFrame", "parity", "delimiter", "encoding"};
+  const jerryx_arg_t prop_mapping[] = {
+      jerryx_arg_number(&port_num, JERRYX_ARG_COERCE, JERRYX_ARG_REQUIRED),
+      jerryx_arg_number(&tx, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&rx, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&rts, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&cts, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&baud_rate, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&data_bits, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&stop_bits, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&max_frame, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_string(parity_str, sizeof(parity_str), JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_string(delimiter_str, sizeof(delimiter_str), JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_string(encoding_str, sizeof(encoding_str), JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+  };
+  jerry_value_t result = jerryx_arg_transform_object_properties(args[0], (const jerry_char_t **)prop_names, 12,
+                                                                prop_mapping, 12);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+
+  // The frame buffer is allocated up front; keep it no larger than the
+  // driver's own RX buffer.
+  if (!(max_frame >= 1 && max_frame <= JS_SERIAL_RX_BUFFER))
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "maxFrame must be 1-2048.");
+
+  js_serial_config_t config = {
+      .port = (uart_port_t)port_num,
+      .tx = (gpio_num_t)tx,
+      .rx = (gpio_num_t)rx,
+      .rts = (gpio_num_t)rts,
+      .cts = (gpio_num_t)cts,
+      .uart = {
+          .baud_rate = (int)baud_rate,
+          .source_clk = UART_SCLK_DEFAULT,
+      },
+      .max_frame = (size_t)max_frame,
+  };
+
+  if (data_bits < 5 || data_bits > 8)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "dataBits must be 5-8.");
+  config.uart.data_bits = (uart_word_length_t)(UART_DATA_5_BITS + (int)data_bits - 5);
+
+  if (stop_bits == 1)
+    config.uart.stop_bits = UART_STOP_BITS_1;
+  else if (stop_bits == 1.5)
+    config.uart.stop_bits = UART_STOP_BITS_1_5;
+  else if (stop_bits == 2)
+    config.uart.stop_bits = UART_STOP_BITS_2;
+  else
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "stopBits must be 1, 1.5 or 2.");
+
+  if (strlen(parity_str) == 0 || strcmp(parity_str, "none") == 0)
+    config.uart.parity = UART_PARITY_DISABLE;
+  else if (strcmp(parity_str, "even") == 0)
+    config.uart.parity = UART_PARITY_EVEN;
+  else if (strcmp(parity_str, "odd") == 0)
+    config.uart.parity = UART_PARITY_ODD;
+  else
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Unknown parity.");
+
+  if (config.rts >= 0 && config.cts >= 0)
+    config.uart.flow_ctrl = UART_HW_FLOWCTRL_CTS_RTS;
+  else if (config.rts >= 0)
+    config.uart.flow_ctrl = UART_HW_FLOWCTRL_RTS;
+  else if (config.cts >= 0)
+    config.uart.flow_ctrl = UART_HW_FLOWCTRL_CTS;
+  // Assert RTS when the driver's RX FIFO is most of the way full.
+  config.uart.rx_flow_ctrl_thresh = 100;
+
+  config.delimiter_len = strlen(delimiter_str);
+  memcpy(config.delimiter, delimiter_str, config.delimiter_len);
+  if (config.delimiter_len > 0 && config.max_frame <= config.delimiter_len)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "maxFrame must be longer than the delimiter.");
+
+  if (strcmp(encoding_str, "utf8") == 0)
+    config.as_string = true;
+  else if (strlen(encoding_str) > 0)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Only \"utf8\" encoding is supported.");
+
+  js_serial_port_t *port;
+  esp_err_t err = js_serial_open(&config, args[1], &port);
+  if (err == ESP_ERR_INVALID_ARG)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Invalid UART port; UART0 is reserved for the console.");
+  }
+  if (err == ESP_ERR_INVALID_STATE)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "UART port is already open.");
+  }
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to open UART port.");
+  }
+
+  jerry_value_t port_obj = jerry_object();
+  jerry_object_set_native_ptr(port_obj, &port_native_info, port);
+
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("write", js_port_write_handler),
+      JERRYX_PROPERTY_FUNCTION("drain", js_port_drain_handler),
+      JERRYX_PROPERTY_FUNCTION("overruns", js_port_overruns_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_port_close_handler),
+      JERRYX_PROPERTY_NUMBER("port", config.port),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(port_obj, props);
+
+  return port_obj;
+}
+
+#define SERIAL_BINDINGS(X) \
+  X("open", js_serial_open_handler)
+
+JS_BINDING_TABLE(serial, SERIAL_BINDINGS);
+
+/**
+ * @brief The evaluation callback for the native 'serial' module.
+ */
+jerry_value_t
+serial_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &serial_bindings);
+}
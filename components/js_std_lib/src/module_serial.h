@@ -0,0 +1,22 @@
+#ifndef MODULE_SERIAL_H
+#define MODULE_SERIAL_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'serial' module.
+ *
+ * This function is called by the JerryScript engine when the 'serial' module
+ * is first evaluated. It populates the module's namespace with the `open`
+ * function, which returns port objects with non-blocking writes.
+ *
+ * @param native_module The jerry_value_t representing the 'serial' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t serial_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'serial' module exports; the registry declares their names.
+extern const js_binding_table_t serial_bindings;
+
+#endif /* MODULE_SERIAL_H */
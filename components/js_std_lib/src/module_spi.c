@@ -0,0 +1,348 @@
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+#include "jerryscript-ext/arg.h"
+#include "esp_log.h"
+
+#include "js_binding.h"
+#include "js_spi.h"
+#include "module_spi.h"
+
+#define TAG "SPI_MODULE"
+
+#define DEFAULT_HOST 2
+#define DEFAULT_FREQUENCY_HZ 1000000
+
+// Forward declarations for the native objects' free callbacks
+static void bus_native_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+static void device_native_free_cb(void *native_p, jerry_object_native_info_t *info_p);
+
+/**
+ * @brief JerryScript native object info. Connects a JS object to our js_spi_bus_t struct.
+ */
+static const jerry_object_native_info_t bus_native_info = {
+    .free_cb = bus_native_free_cb,
+};
+
+/**
+ * @brief JerryScript native object info. Connects a JS object to our js_spi_device_t struct.
+ */
+static const jerry_object_native_info_t device_native_info = {
+    .free_cb = device_native_free_cb,
+};
+
+/**
+ * @brief Finds the backing store of an ArrayBuffer or TypedArray.
+ *
+ * No bytes are copied here; the backend decides whether DMA can use the
+ * pointer in place.
+ * @return False if the value is neither, or its buffer has been detached.
+ */
+static bool get_backing_store(jerry_value_t value, uint8_t **out_data, size_t *out_len)
+{
+  if (jerry_value_is_arraybuffer(value))
+  {
+    *out_data = jerry_arraybuffer_data(value);
+    *out_len = jerry_arraybuffer_size(value);
+    return *out_data != NULL;
+  }
+  if (jerry_value_is_typedarray(value))
+  {
+    jerry_length_t offset, length;
+    jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, &length);
+    uint8_t *data = jerry_arraybuffer_data(buffer);
+    jerry_value_free(buffer);
+    if (!data)
+    {
+      return false;
+    }
+    *out_data = data + offset;
+    *out_len = length;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Queues a transfer and returns the promise it will settle.
+ */
+static jerry_value_t queue_transfer(js_spi_device_t *dev, jerry_value_t tx, jerry_value_t rx)
+{
+  js_spi_transfer_t transfer = {
+      .tx = jerry_undefined(),
+      .rx = jerry_undefined(),
+  };
+
+  if (!jerry_value_is_undefined(tx))
+  {
+    if (!get_backing_store(tx, (uint8_t **)&transfer.tx_data, &transfer.length))
+      return jerry_throw_sz(JERRY_ERROR_TYPE, "Data to send must be an ArrayBuffer or TypedArray.");
+  }
+  if (!jerry_value_is_undefined(rx))
+  {
+    if (!get_backing_store(rx, &transfer.rx_data, &transfer.rx_length))
+      return jerry_throw_sz(JERRY_ERROR_TYPE, "Receive buffer must be an ArrayBuffer or TypedArray.");
+    if (transfer.tx_data && transfer.rx_length < transfer.length)
+      return jerry_throw_sz(JERRY_ERROR_RANGE, "Receive buffer is smaller than the data sent.");
+    if (!transfer.tx_data)
+      transfer.length = transfer.rx_length;
+    else
+      transfer.rx_length = transfer.length;
+  }
+  if (transfer.length == 0)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Nothing to transfer.");
+
+  jerry_value_t promise = jerry_promise();
+  transfer.promise = jerry_value_copy(promise);
+  transfer.tx = jerry_value_copy(tx);
+  transfer.rx = jerry_value_copy(rx);
+
+  esp_err_t err = js_spi_device_transfer(dev, &transfer);
+  if (err != ESP_OK)
+  {
+    jerry_value_free(transfer.promise);
+    jerry_value_free(transfer.tx);
+    jerry_value_free(transfer.rx);
+    jerry_value_free(promise);
+    if (err == ESP_ERR_NO_MEM)
+      return jerry_throw_sz(JERRY_ERROR_COMMON, "Too many SPI transfers in flight.");
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to queue SPI transfer.");
+  }
+  return promise;
+}
+
+// --- Device Object Method Implementations (Bindings) ---
+
+static jerry_value_t
+js_device_transfer_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_spi_device_t *dev = (js_spi_device_t *)jerry_object_get_native_ptr(call_info_p->this_value, &device_native_info);
+  if (!dev)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "SPI device is closed or invalid.");
+  if (argc < 1)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a buffer to send.");
+
+  return queue_transfer(dev, args[0], argc > 1 ? args[1] : jerry_undefined());
+}
+
+static jerry_value_t
+js_device_read_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_spi_device_t *dev = (js_spi_device_t *)jerry_object_get_native_ptr(call_info_p->this_value, &device_native_info);
+  if (!dev)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "SPI device is closed or invalid.");
+  if (argc < 1)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a buffer to receive into.");
+
+  return queue_transfer(dev, jerry_undefined(), args[0]);
+}
+
+static jerry_value_t
+js_device_close_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_spi_device_t *dev = (js_spi_device_t *)jerry_object_get_native_ptr(call_info_p->this_value, &device_native_info);
+
+  if (dev)
+  {
+    js_spi_device_close(dev);
+    // Remove the native pointer from the JS object to prevent use-after-free
+    jerry_object_set_native_ptr(call_info_p->this_value, NULL, NULL);
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Callback when a device object is garbage collected.
+ *
+ * In-flight transfers hold their own references, so they still settle.
+ */
+static void device_native_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  js_spi_device_t *dev = (js_spi_device_t *)native_p;
+  if (dev)
+  {
+    ESP_LOGD(TAG, "GC collecting SPI device on CS %d, ensuring cleanup.", dev->config.cs);
+    js_spi_device_close(dev);
+  }
+}
+
+// --- Bus Object Method Implementations (Bindings) ---
+
+/**
+ * @brief Native implementation of `bus.device(config)`.
+ */
+static jerry_value_t
+js_bus_device_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_spi_bus_t *bus = (js_spi_bus_t *)jerry_object_get_native_ptr(call_info_p->this_value, &bus_native_info);
+  if (!bus)
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "SPI bus is closed or invalid.");
+  if (argc < 1 || !jerry_value_is_object(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Argument must be a config object.");
+
+  double cs = -1;
+  double frequency = DEFAULT_FREQUENCY_HZ;
+  double mode = 0;
+
+  const char *prop_names[] = {"cs", "frequency", "mode"};
+  const jerryx_arg_t prop_mapping[] = {
+      jerryx_arg_number(&cs, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&frequency, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&mode, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+  };
+  jerry_value_t result = jerryx_arg_transform_object_properties(args[0], (const jerry_char_t **)prop_names, 3,
+                                                                prop_mapping, 3);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+
+  if (mode < 0 || mode > 3)
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "SPI mode must be 0-3.");
+
+  js_spi_device_config_t config = {
+      .cs = (gpio_num_t)cs,
+      .frequency_hz = (uint32_t)frequency,
+      .mode = (uint8_t)mode,
+  };
+  js_spi_device_t *dev;
+  esp_err_t err = js_spi_device_open(bus, &config, &dev);
+  if (err == ESP_ERR_NOT_FOUND)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "No free SPI device slots.");
+  }
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to add SPI device.");
+  }
+
+  jerry_value_t dev_obj = jerry_object();
+  jerry_object_set_native_ptr(dev_obj, &device_native_info, dev);
+
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("transfer", js_device_transfer_handler),
+      JERRYX_PROPERTY_FUNCTION("read", js_device_read_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_device_close_handler),
+      JERRYX_PROPERTY_NUMBER("cs", config.cs),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(dev_obj, props);
+
+  // Keep the bus object alive for as long as the device object is.
+  jerry_value_t bus_name = jerry_string_sz("bus");
+  jerry_value_free(jerry_object_set(dev_obj, bus_name, call_info_p->this_value));
+  jerry_value_free(bus_name);
+
+  return dev_obj;
+}
+
+static jerry_value_t
+js_bus_close_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  js_spi_bus_t *bus = (js_spi_bus_t *)jerry_object_get_native_ptr(call_info_p->this_value, &bus_native_info);
+
+  if (bus)
+  {
+    js_spi_bus_close(bus);
+    // Remove the native pointer from the JS object to prevent use-after-free
+    jerry_object_set_native_ptr(call_info_p->this_value, NULL, NULL);
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Callback when a bus object is garbage collected.
+ */
+static void bus_native_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  js_spi_bus_t *bus = (js_spi_bus_t *)native_p;
+  if (bus)
+  {
+    ESP_LOGD(TAG, "GC collecting SPI%d, ensuring cleanup.", bus->host);
+    js_spi_bus_close(bus);
+  }
+}
+
+// --- Module Function Implementations ---
+
+/**
+ * @brief Native implementation of `spi.open(config)`.
+ */
+static jerry_value_t
+js_spi_open_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_object(args[0]))
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Argument must be a config object.");
+
+  double host = DEFAULT_HOST;
+  double mosi = -1;
+  double miso = -1;
+  double sclk = -1;
+  double max_transfer_size = 0;
+
+  const char *prop_names[] = {"host", "mosi", "miso", "sclk", "maxTransferSize"};
+  const jerryx_arg_t prop_mapping[] = {
+      jerryx_arg_number(&host, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&mosi, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&miso, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+      jerryx_arg_number(&sclk, JERRYX_ARG_COERCE, JERRYX_ARG_REQUIRED),
+      jerryx_arg_number(&max_transfer_size, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+  };
+  jerry_value_t result = jerryx_arg_transform_object_properties(args[0], (const jerry_char_t **)prop_names, 5,
+                                                                prop_mapping, 5);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+
+  js_spi_bus_config_t config = {
+      .host = (int)host,
+      .mosi = (gpio_num_t)mosi,
+      .miso = (gpio_num_t)miso,
+      .sclk = (gpio_num_t)sclk,
+      .max_transfer_size = (size_t)max_transfer_size,
+  };
+
+  js_spi_bus_t *bus;
+  esp_err_t err = js_spi_bus_open(&config, &bus);
+  if (err == ESP_ERR_INVALID_ARG)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "SPI host must be 2 or 3.");
+  }
+  if (err == ESP_ERR_INVALID_STATE)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "SPI host is already open.");
+  }
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to initialise SPI bus.");
+  }
+
+  jerry_value_t bus_obj = jerry_object();
+  jerry_object_set_native_ptr(bus_obj, &bus_native_info, bus);
+
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("device", js_bus_device_handler),
+      JERRYX_PROPERTY_FUNCTION("close", js_bus_close_handler),
+      JERRYX_PROPERTY_NUMBER("host", config.host),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(bus_obj, props);
+
+  return bus_obj;
+}
+
+#define SPI_BINDINGS(X) \
+  X("open", js_spi_open_handler)
+
+JS_BINDING_TABLE(spi, SPI_BINDINGS);
+
+/**
+ * @brief The evaluation callback for the native 'spi' module.
+ */
+jerry_value_t
+spi_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &spi_bindings);
+}
@@ -0,0 +1,22 @@
+#ifndef MODULE_SPI_H
+#define MODULE_SPI_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'spi' module.
+ *
+ * This function is called by the JerryScript engine when the 'spi' module is
+ * first evaluated. It populates the module's namespace with the `open`
+ * function, which returns bus objects that devices are added to.
+ *
+ * @param native_module The jerry_value_t representing the 'spi' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t spi_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'spi' module exports; the registry declares their names.
+extern const js_binding_table_t spi_bindings;
+
+#endif /* MODULE_SPI_H */
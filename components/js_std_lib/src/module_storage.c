@@ -0,0 +1,254 @@
+#include <stdlib.h>
+#include <string.h>
+#include "jerryscript.h"
+#include "esp_log.h"
+
+#include "js_binding.h"
+#include "js_storage.h"
+#include "module_storage.h"
+
+#define TAG "STORAGE_MODULE"
+
+/**
+ * @brief Copies a key argument into `key`.
+ *
+ * @return undefined, or a thrown error if it is not a string of 1 to 15 bytes.
+ */
+static jerry_value_t read_key(const jerry_value_t args[], jerry_length_t argc, char key[JS_STORAGE_MAX_KEY])
+{
+  if (argc < 1 || !jerry_value_is_string(args[0]))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a key string.");
+  }
+  jerry_size_t size = jerry_string_size(args[0], JERRY_ENCODING_UTF8);
+  if (size == 0 || size >= JS_STORAGE_MAX_KEY)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Keys must be 1 to 15 bytes long.");
+  }
+  jerry_string_to_buffer(args[0], JERRY_ENCODING_UTF8, (jerry_char_t *)key, size);
+  key[size] = '\0';
+  return jerry_undefined();
+}
+
+/**
+ * @brief Converts a storage error into a thrown JS error.
+ */
+static jerry_value_t throw_storage_error(esp_err_t err)
+{
+  switch (err)
+  {
+  case ESP_ERR_INVALID_SIZE:
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Value is larger than 4000 bytes.");
+  case ESP_ERR_INVALID_STATE:
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Storage is not available.");
+  case ESP_ERR_NO_MEM:
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Storage commit queue is full.");
+  default:
+    ESP_LOGE(TAG, "Storage error: %s", esp_err_to_name(err));
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Storage commit failed.");
+  }
+}
+
+/**
+ * @brief Stores a string, number, ArrayBuffer or view under `key`.
+ */
+static jerry_value_t store_value(const char *key, jerry_value_t value)
+{
+  esp_err_t err;
+  if (jerry_value_is_number(value))
+  {
+    double number = jerry_value_as_number(value);
+    err = js_storage_set(key, JS_STORAGE_NUMBER, &number, sizeof(number));
+  }
+  else if (jerry_value_is_string(value))
+  {
+    jerry_size_t size = jerry_string_size(value, JERRY_ENCODING_UTF8);
+    if (size > JS_STORAGE_MAX_VALUE)
+    {
+      return throw_storage_error(ESP_ERR_INVALID_SIZE);
+    }
+    uint8_t *text = (uint8_t *)malloc(size ? size : 1);
+    if (!text)
+    {
+      return jerry_throw_sz(JERRY_ERROR_COMMON, "Out of memory.");
+    }
+    jerry_string_to_buffer(value, JERRY_ENCODING_UTF8, text, size);
+    err = js_storage_set(key, JS_STORAGE_STRING, text, size);
+    free(text);
+  }
+  else if (jerry_value_is_arraybuffer(value))
+  {
+    err = js_storage_set(key, JS_STORAGE_BYTES, jerry_arraybuffer_data(value), jerry_arraybuffer_size(value));
+  }
+  else if (jerry_value_is_typedarray(value))
+  {
+    jerry_length_t offset, length;
+    jerry_value_t buffer = jerry_typedarray_buffer(value, &offset, &length);
+    uint8_t *data = jerry_arraybuffer_data(buffer);
+    jerry_value_free(buffer);
+    err = js_storage_set(key, JS_STORAGE_BYTES, data ? data + offset : NULL, data ? length : 0);
+  }
+  else
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Value must be a string, number, ArrayBuffer or TypedArray.");
+  }
+  return err == ESP_OK ? jerry_undefined() : throw_storage_error(err);
+}
+
+/**
+ * @brief Hands pending writes to the commit task and returns a Promise for the commit.
+ */
+static jerry_value_t commit_async(void)
+{
+  jerry_value_t promise = jerry_promise();
+  esp_err_t err = js_storage_flush_async(promise);
+  if (err != ESP_OK)
+  {
+    jerry_value_free(promise);
+    return throw_storage_error(err);
+  }
+  return promise;
+}
+
+/**
+ * @brief Native implementation of `storage.get(key)`.
+ */
+static jerry_value_t
+js_storage_get_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  char key[JS_STORAGE_MAX_KEY];
+  jerry_value_t result = read_key(args, argc, key);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+
+  js_storage_value_t value;
+  esp_err_t err = js_storage_get(key, &value);
+  if (err == ESP_ERR_NOT_FOUND)
+  {
+    return jerry_undefined();
+  }
+  if (err != ESP_OK)
+  {
+    return throw_storage_error(err);
+  }
+
+  switch (value.type)
+  {
+  case JS_STORAGE_NUMBER:
+  {
+    double number = 0;
+    memcpy(&number, value.data, value.len < sizeof(number) ? value.len : sizeof(number));
+    return jerry_number(number);
+  }
+  case JS_STORAGE_STRING:
+    return jerry_string(value.data, value.len, JERRY_ENCODING_UTF8);
+  case JS_STORAGE_BYTES:
+  {
+    jerry_value_t buffer = jerry_arraybuffer(value.len);
+    jerry_arraybuffer_write(buffer, 0, value.data, value.len);
+    return buffer;
+  }
+  default:
+    return jerry_undefined(); // Written by something other than this module
+  }
+}
+
+/**
+ * @brief Native implementation of `storage.set(key, value)`.
+ */
+static jerry_value_t
+js_storage_set_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  char key[JS_STORAGE_MAX_KEY];
+  jerry_value_t result = read_key(args, argc, key);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  return store_value(key, argc > 1 ? args[1] : jerry_undefined());
+}
+
+/**
+ * @brief Native implementation of `storage.delete(key)`.
+ */
+static jerry_value_t
+js_storage_delete_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  char key[JS_STORAGE_MAX_KEY];
+  jerry_value_t result = read_key(args, argc, key);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  esp_err_t err = js_storage_delete(key);
+  return err == ESP_OK ? jerry_undefined() : throw_storage_error(err);
+}
+
+/**
+ * @brief Native implementation of `storage.flush()`. Blocks until the writes are in flash.
+ */
+static jerry_value_t
+js_storage_flush_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  esp_err_t err = js_storage_flush();
+  return err == ESP_OK ? jerry_undefined() : throw_storage_error(err);
+}
+
+/**
+ * @brief Native implementation of `storage.flushAsync()`.
+ */
+static jerry_value_t
+js_storage_flush_async_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  return commit_async();
+}
+
+/**
+ * @brief Native implementation of `storage.setAsync(key, value)`: set() followed by flushAsync().
+ */
+static jerry_value_t
+js_storage_set_async_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  jerry_value_t result = js_storage_set_handler(call_info_p, args, argc);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  return commit_async();
+}
+
+/**
+ * @brief Native implementation of `storage.deleteAsync(key)`: delete() followed by flushAsync().
+ */
+static jerry_value_t
+js_storage_delete_async_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  jerry_value_t result = js_storage_delete_handler(call_info_p, args, argc);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  return commit_async();
+}
+
+#define STORAGE_BINDINGS(X)                         \
+  X("get", js_storage_get_handler)                  \
+  X("set", js_storage_set_handler)                  \
+  X("delete", js_storage_delete_handler)            \
+  X("flush", js_storage_flush_handler)              \
+  X("setAsync", js_storage_set_async_handler)       \
+  X("deleteAsync", js_storage_delete_async_handler) \
+  X("flushAsync", js_storage_flush_async_handler)
+
+JS_BINDING_TABLE(storage, STORAGE_BINDINGS);
+
+/**
+ * @brief Populates the exports for the 'storage' native module.
+ */
+jerry_value_t
+storage_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &storage_bindings);
+}
@@ -0,0 +1,23 @@
+#ifndef MODULE_STORAGE_H
+#define MODULE_STORAGE_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'storage' module.
+ *
+ * This function is called by the JerryScript engine when the 'storage' module
+ * is first evaluated. It populates the module's namespace with `get`, `set`
+ * and `delete` over the NVS partition, which go through a write-back cache,
+ * and with the `flush` functions that commit it.
+ *
+ * @param native_module The jerry_value_t representing the 'storage' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t storage_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'storage' module exports; the registry declares their names.
+extern const js_binding_table_t storage_bindings;
+
+#endif /* MODULE_STORAGE_H */
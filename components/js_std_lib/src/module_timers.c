@@ -1,34 +1,99 @@
+#include <string.h>
 #include "jerryscript.h"
 #include "jerryscript-ext/properties.h"
+#include "jerryscript-ext/arg.h"
 
+#include "js_binding.h"
+#include "js_scheduler.h"
 #include "js_timers.h"
 #include "module_timers.h"
 
 /**
- * @brief A simple helper to convert a jerry_value_t to a uint64_t.
- * @param v The JerryScript value, expected to be a number.
- * @return The number as a uint64_t.
+ * @brief Converts a delay in milliseconds, possibly fractional, to microseconds.
+ * @return The delay in microseconds; 0 for negative or NaN delays, and at
+ * most JS_TIMER_MAX_DELAY_MS, so Infinity is a valid delay.
  */
-static uint64_t to_uint64(const jerry_value_t v)
+static uint64_t ms_to_us(double ms)
 {
-  return (uint64_t)jerry_value_as_number(v);
+  if (!(ms > 0))
+  {
+    return 0;
+  }
+  return (uint64_t)((ms < JS_TIMER_MAX_DELAY_MS ? ms : JS_TIMER_MAX_DELAY_MS) * 1000.0);
+}
+
+/**
+ * @brief Reads the callback and delay arguments of `setTimeout` and `setInterval`.
+ */
+static jerry_value_t read_callback_and_delay(const jerry_value_t args[], jerry_length_t argc,
+                                             jerry_value_t *callback, uint64_t *delay_us)
+{
+  double delay_ms = 0;
+  jerry_value_t result = js_binding_arg_function(args, argc, 0, callback);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+  result = js_binding_arg_number(args, argc, 1, &delay_ms);
+  *delay_us = ms_to_us(delay_ms);
+  return result;
+}
+
+/**
+ * @brief Callback when an `every()` iterator is garbage collected: stops its timer.
+ */
+static void ticks_native_free_cb(void *native_p, jerry_object_native_info_t *info_p)
+{
+  js_timers_release((uint32_t)(uintptr_t)native_p);
+}
+
+/**
+ * @brief JerryScript native object info. The native pointer is the timer handle, not memory.
+ */
+static const jerry_object_native_info_t ticks_native_info = {
+    .free_cb = ticks_native_free_cb,
+};
+
+/**
+ * @brief Returns a promise that a timer resolves with `value` after `delay` ms.
+ */
+static jerry_value_t sleep_promise(double delay_ms, jerry_value_t value)
+{
+  jerry_value_t promise = jerry_promise();
+  if (js_timers_sleep(promise, value, ms_to_us(delay_ms)) == 0)
+  {
+    jerry_value_free(promise);
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to create a timer.");
+  }
+  return promise;
 }
 
 /**
  * @brief Native C implementation of the JavaScript `setTimeout(callback, delay)` function.
+ *
+ * Called as `setTimeout(delay, value)`, without a callback, it returns a
+ * Promise like `sleep()` instead of a handle.
  */
 static jerry_value_t js_set_timeout(const jerry_call_info_t *call_info_p,
                                     const jerry_value_t args[],
                                     const jerry_length_t argc)
 {
-  if (argc < 2 || !jerry_value_is_function(args[0]) ||
-      !jerry_value_is_number(args[1]))
+  if (argc >= 1 && jerry_value_is_number(args[0]))
   {
-    return jerry_error_sz(JERRY_ERROR_TYPE, "setTimeout: invalid args");
+    return sleep_promise(jerry_value_as_number(args[0]), argc > 1 ? args[1] : jerry_undefined());
   }
 
-  uint64_t ms = to_uint64(args[1]);
-  uint32_t handle = js_timers_set(false, args[0], ms);
+  jerry_value_t callback;
+  uint64_t delay_us;
+  jerry_value_t result = read_callback_and_delay(args, argc, &callback, &delay_us);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+
+  uint32_t handle = js_timers_set(false, callback, delay_us);
   return jerry_number(handle);
 }
 
@@ -49,20 +114,66 @@ static jerry_value_t js_clear_timeout(const jerry_call_info_t *call_info_p,
 }
 
 /**
- * @brief Native C implementation of the JavaScript `setInterval(callback, delay)` function.
+ * @brief Starts a paced interval from the `{ policy }` options of setInterval().
+ */
+static jerry_value_t set_paced_interval(jerry_value_t callback, uint64_t period_us, jerry_value_t options)
+{
+  char policy_str[16] = "skip";
+  const char *prop_names[] = {"policy"};
+  const jerryx_arg_t prop_mapping[] = {
+      jerryx_arg_string(policy_str, sizeof(policy_str), JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+  };
+  jerry_value_t result = jerryx_arg_transform_object_properties(options,
+                                                                (const jerry_char_t **)prop_names,
+                                                                1,
+                                                                prop_mapping,
+                                                                1);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+
+  js_timer_policy_t policy;
+  if (strcmp(policy_str, "skip") == 0)
+    policy = JS_TIMER_SKIP;
+  else if (strcmp(policy_str, "catch-up") == 0)
+    policy = JS_TIMER_CATCH_UP;
+  else
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "policy must be 'skip' or 'catch-up'.");
+
+  uint32_t handle = js_timers_set_paced(callback, period_us, policy);
+  if (handle == 0)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to create a timer.");
+  }
+  return jerry_number(handle);
+}
+
+/**
+ * @brief Native C implementation of the JavaScript `setInterval(callback, delay, options)` function.
+ *
+ * With an options object the interval is paced: it keeps to its start
+ * phase and the callback gets the timing of each tick.
  */
 static jerry_value_t js_set_interval(const jerry_call_info_t *call_info_p,
                                      const jerry_value_t args[],
                                      const jerry_length_t argc)
 {
-  if (argc < 2 || !jerry_value_is_function(args[0]) ||
-      !jerry_value_is_number(args[1]))
+  jerry_value_t callback;
+  uint64_t period_us;
+  jerry_value_t result = read_callback_and_delay(args, argc, &callback, &period_us);
+  if (jerry_value_is_exception(result))
   {
-    return jerry_error_sz(JERRY_ERROR_TYPE, "setInterval: invalid args");
+    return result;
   }
+  jerry_value_free(result);
 
-  uint64_t ms = to_uint64(args[1]);
-  uint32_t handle = js_timers_set(true, args[0], ms);
+  if (argc > 2 && jerry_value_is_object(args[2]))
+  {
+    return set_paced_interval(callback, period_us, args[2]);
+  }
+  uint32_t handle = js_timers_set(true, callback, period_us);
   return jerry_number(handle);
 }
 
@@ -78,25 +189,227 @@ static jerry_value_t js_clear_interval(const jerry_call_info_t *call_info_p,
   return js_clear_timeout(call_info_p, args, argc);
 }
 
+/**
+ * @brief Native C implementation of the JavaScript `sleep(delay, value)` function.
+ */
+static jerry_value_t js_sleep(const jerry_call_info_t *call_info_p,
+                              const jerry_value_t args[],
+                              const jerry_length_t argc)
+{
+  double delay_ms;
+  jerry_value_t result = js_binding_arg_number(args, argc, 0, &delay_ms);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+  return sleep_promise(delay_ms, argc > 1 ? args[1] : jerry_undefined());
+}
+
+static uint32_t get_ticks_handle(const jerry_call_info_t *call_info_p)
+{
+  return (uint32_t)(uintptr_t)jerry_object_get_native_ptr(call_info_p->this_value, &ticks_native_info);
+}
+
+/**
+ * @brief Native implementation of `ticks.next()`.
+ */
+static jerry_value_t js_ticks_next(const jerry_call_info_t *call_info_p,
+                                   const jerry_value_t args[],
+                                   const jerry_length_t argc)
+{
+  return js_timers_next_tick(get_ticks_handle(call_info_p));
+}
+
+/**
+ * @brief Native implementation of `ticks.return()`, which `break` out of a `for await` calls.
+ */
+static jerry_value_t js_ticks_return(const jerry_call_info_t *call_info_p,
+                                     const jerry_value_t args[],
+                                     const jerry_length_t argc)
+{
+  js_timers_clear(get_ticks_handle(call_info_p));
+  // Later next() calls, and the GC callback, then see no timer at all.
+  jerry_object_delete_native_ptr(call_info_p->this_value, &ticks_native_info);
+  return js_timers_next_tick(0); // Resolved with `done` set
+}
+
+/**
+ * @brief Native implementation of `ticks[Symbol.asyncIterator]()`.
+ */
+static jerry_value_t js_ticks_iterator(const jerry_call_info_t *call_info_p,
+                                       const jerry_value_t args[],
+                                       const jerry_length_t argc)
+{
+  return jerry_value_copy(call_info_p->this_value);
+}
+
+/**
+ * @brief Native C implementation of the JavaScript `every(period)` function.
+ *
+ * Returns an async iterator over the ticks of a periodic timer. The timer
+ * runs until the loop ends with `break` or `return()` is called.
+ */
+static jerry_value_t js_every(const jerry_call_info_t *call_info_p,
+                              const jerry_value_t args[],
+                              const jerry_length_t argc)
+{
+  double period_ms;
+  jerry_value_t result = js_binding_arg_number(args, argc, 0, &period_ms);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+  if (!(period_ms >= 1))
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "every: expected a period of at least 1 ms.");
+  }
+  uint32_t handle = js_timers_every(ms_to_us(period_ms));
+  if (handle == 0)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to create a timer.");
+  }
+
+  jerry_value_t ticks = jerry_object();
+  jerry_object_set_native_ptr(ticks, &ticks_native_info, (void *)(uintptr_t)handle);
+
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("next", js_ticks_next),
+      JERRYX_PROPERTY_FUNCTION("return", js_ticks_return),
+      JERRYX_PROPERTY_NUMBER("id", handle),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(ticks, props);
+
+  jerry_value_t symbol = jerry_symbol(JERRY_SYMBOL_ASYNC_ITERATOR);
+  jerry_value_t iterator = jerry_function_external(js_ticks_iterator);
+  jerry_value_free(jerry_object_set(ticks, symbol, iterator));
+  jerry_value_free(iterator);
+  jerry_value_free(symbol);
+  return ticks;
+}
+
+/**
+ * @brief Native C implementation of the JavaScript `setImmediate(callback)` function.
+ *
+ * The callback runs after the events already waiting have been dispatched,
+ * without an esp_timer or any allocation outside the engine heap.
+ */
+static jerry_value_t js_set_immediate(const jerry_call_info_t *call_info_p,
+                                      const jerry_value_t args[],
+                                      const jerry_length_t argc)
+{
+  jerry_value_t callback;
+  jerry_value_t result = js_binding_arg_function(args, argc, 0, &callback);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+  uint32_t id = js_scheduler_set_immediate(callback);
+  if (id == 0)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Immediate queue is full.");
+  }
+  return jerry_number(id);
+}
+
+/**
+ * @brief Native C implementation of the JavaScript `clearImmediate(id)` function.
+ */
+static jerry_value_t js_clear_immediate(const jerry_call_info_t *call_info_p,
+                                        const jerry_value_t args[],
+                                        const jerry_length_t argc)
+{
+  if (argc >= 1 && jerry_value_is_number(args[0]))
+  {
+    js_scheduler_clear_immediate((uint32_t)jerry_value_as_number(args[0]));
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Native C implementation of the JavaScript `queueMicrotask(callback)` function.
+ */
+static jerry_value_t js_queue_microtask(const jerry_call_info_t *call_info_p,
+                                        const jerry_value_t args[],
+                                        const jerry_length_t argc)
+{
+  if (argc < 1 || !jerry_value_is_function(args[0]))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "queueMicrotask: expected a callback function.");
+  }
+  if (js_scheduler_queue_microtask(args[0]) != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Failed to queue a microtask.");
+  }
+  return jerry_undefined();
+}
+
+/**
+ * @brief Native C implementation of `scheduler.yield()`.
+ *
+ * Returns a Promise that resolves in the immediate phase, so awaiting it
+ * lets every waiting event be dispatched first.
+ */
+static jerry_value_t js_yield(const jerry_call_info_t *call_info_p,
+                              const jerry_value_t args[],
+                              const jerry_length_t argc)
+{
+  jerry_value_t promise = jerry_promise();
+  if (js_scheduler_yield(promise) != ESP_OK)
+  {
+    jerry_value_free(promise);
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Immediate queue is full.");
+  }
+  return promise;
+}
+
+// The callback API is also bound to the global object, and yield() as
+// `scheduler.yield()`; sleep() and every() are only exported by the module.
+#define TIMERS_GLOBAL_BINDINGS(X)         \
+  X("setTimeout", js_set_timeout)         \
+  X("clearTimeout", js_clear_timeout)     \
+  X("setInterval", js_set_interval)       \
+  X("clearInterval", js_clear_interval)   \
+  X("setImmediate", js_set_immediate)     \
+  X("clearImmediate", js_clear_immediate) \
+  X("queueMicrotask", js_queue_microtask)
+
+#define TIMERS_BINDINGS(X)  \
+  TIMERS_GLOBAL_BINDINGS(X) \
+  X("sleep", js_sleep)      \
+  X("every", js_every)      \
+  X("yield", js_yield)
+
+#define SCHEDULER_BINDINGS(X) \
+  X("yield", js_yield)
+
+JS_BINDING_TABLE(timers_global, TIMERS_GLOBAL_BINDINGS);
+JS_BINDING_TABLE(timers, TIMERS_BINDINGS);
+JS_BINDING_TABLE(scheduler, SCHEDULER_BINDINGS);
+
 /**
  * @brief Binds timer functions to the JavaScript global object.
  *
- * This uses the `jerryx_set_properties` helper to efficiently add `setTimeout`,
- * `clearTimeout`, `setInterval`, and `clearInterval` to a given object,
- * typically the global object.
+ * Adds `setTimeout`, `clearTimeout`, `setInterval`, `clearInterval`,
+ * `setImmediate`, `clearImmediate`, `queueMicrotask` and a `scheduler`
+ * object with `yield` to a given object, typically the global object, from
+ * the same rows the 'timers' module exports.
  *
  * @param global The JavaScript global object.
  */
 void timers_bind_global(jerry_value_t global)
 {
-  jerryx_property_entry props[] = {
-      JERRYX_PROPERTY_FUNCTION("setTimeout", js_set_timeout),
-      JERRYX_PROPERTY_FUNCTION("clearTimeout", js_clear_timeout),
-      JERRYX_PROPERTY_FUNCTION("setInterval", js_set_interval),
-      JERRYX_PROPERTY_FUNCTION("clearInterval", js_clear_interval),
-      JERRYX_PROPERTY_LIST_END()};
+  js_binding_set_properties(global, &timers_global_bindings);
 
-  jerryx_set_properties(global, props);
+  jerry_value_t scheduler = jerry_object();
+  js_binding_set_properties(scheduler, &scheduler_bindings);
+  jerry_value_t name = jerry_string_sz("scheduler");
+  jerry_value_free(jerry_object_set(global, name, scheduler));
+  jerry_value_free(name);
+  jerry_value_free(scheduler);
 }
 
 /**
@@ -110,31 +423,5 @@ void timers_bind_global(jerry_value_t global)
  */
 jerry_value_t timers_module_evaluate(const jerry_value_t native_module)
 {
-  // Create function and name values
-  jerry_value_t set_timeout_func = jerry_function_external(js_set_timeout);
-  jerry_value_t clear_timeout_func = jerry_function_external(js_clear_timeout);
-  jerry_value_t set_interval_func = jerry_function_external(js_set_interval);
-  jerry_value_t clear_interval_func = jerry_function_external(js_clear_interval);
-  jerry_value_t set_timeout_name = jerry_string_sz("setTimeout");
-  jerry_value_t clear_timeout_name = jerry_string_sz("clearTimeout");
-  jerry_value_t set_interval_name = jerry_string_sz("setInterval");
-  jerry_value_t clear_interval_name = jerry_string_sz("clearInterval");
-
-  // Set the exports on the module
-  jerry_native_module_set(native_module, set_timeout_name, set_timeout_func);
-  jerry_native_module_set(native_module, clear_timeout_name, clear_timeout_func);
-  jerry_native_module_set(native_module, set_interval_name, set_interval_func);
-  jerry_native_module_set(native_module, clear_interval_name, clear_interval_func);
-
-  // Clean up
-  jerry_value_free(set_timeout_func);
-  jerry_value_free(clear_timeout_func);
-  jerry_value_free(set_interval_func);
-  jerry_value_free(clear_interval_func);
-  jerry_value_free(set_timeout_name);
-  jerry_value_free(clear_timeout_name);
-  jerry_value_free(set_interval_name);
-  jerry_value_free(clear_interval_name);
-
-  return jerry_undefined();
+  return js_binding_export(native_module, &timers_bindings);
 }
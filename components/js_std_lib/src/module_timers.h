@@ -1,12 +1,16 @@
 #ifndef MODULE_TIMERS_H
 #define MODULE_TIMERS_H
 
+#include "jerryscript.h"
+#include "js_binding.h"
+
 /**
  * @brief Binds timer functions to the JavaScript global object.
  *
- * This uses the `jerryx_set_properties` helper to efficiently add `setTimeout`,
- * `clearTimeout`, `setInterval`, and `clearInterval` to a given object,
- * typically the global object.
+ * Adds `setTimeout`, `clearTimeout`, `setInterval`, `clearInterval`,
+ * `setImmediate`, `clearImmediate`, `queueMicrotask` and a `scheduler`
+ * object with `yield` to a given object, typically the global object, from
+ * the same rows the 'timers' module exports.
  *
  * @param global The JavaScript global object.
  */
@@ -23,4 +27,7 @@ void timers_bind_global(jerry_value_t);
  */
 jerry_value_t timers_module_evaluate(const jerry_value_t);
 
+/// @brief The functions the 'timers' module exports; the registry declares their names.
+extern const js_binding_table_t timers_bindings;
+
 #endif /* MODULE_TIMERS_H */
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include <stdlib.h>
+#include "jerryscript.h"
+#include "jerryscript-ext/properties.h"
+#include "jerryscript-ext/arg.h"
+#include "esp_log.h"
+
+#include "js_binding.h"
+#include "js_clone.h"
+#include "js_worker.h"
+#include "module_worker.h"
+
+#define TAG "WORKER_MODULE"
+
+#define MIN_HEAP_KB 8
+#define MAX_HEAP_KB 512
+
+/**
+ * @brief JerryScript native object info. The native pointer is the worker id, not memory.
+ */
+static const jerry_object_native_info_t worker_native_info = {
+    .free_cb = NULL,
+};
+
+/**
+ * @brief Clones `value` and posts it across the channel of `worker_id`.
+ *
+ * @return true if it was queued, false if the channel is full, or an exception.
+ */
+static jerry_value_t post_value(uint32_t worker_id, jerry_value_t value)
+{
+  uint8_t *buffer;
+  size_t len;
+  jerry_value_t result = js_clone_serialize(value, sizeof(js_message_t), &buffer, &len);
+  if (jerry_value_is_exception(result))
+  {
+    return result;
+  }
+  jerry_value_free(result);
+
+  js_message_t *message = (js_message_t *)buffer;
+  message->len = len;
+  esp_err_t err = js_worker_post(worker_id, message);
+  if (err != ESP_OK)
+  {
+    free(message);
+  }
+  if (err == ESP_ERR_NOT_FOUND)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Worker has exited.");
+  }
+  return jerry_boolean(err == ESP_OK);
+}
+
+static jerry_value_t set_on_message(uint32_t worker_id, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (argc < 1 || !(jerry_value_is_function(args[0]) || jerry_value_is_undefined(args[0])))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a callback function.");
+  }
+  if (js_worker_set_on_message(worker_id, args[0]) != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Worker has exited.");
+  }
+  return jerry_undefined();
+}
+
+// --- Worker object methods (main context) ---
+
+static uint32_t get_worker_id(const jerry_call_info_t *call_info_p)
+{
+  return (uint32_t)(uintptr_t)jerry_object_get_native_ptr(call_info_p->this_value, &worker_native_info);
+}
+
+/**
+ * @brief Native implementation of `worker.postMessage(value)`.
+ */
+static jerry_value_t
+js_worker_post_message_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  uint32_t id = get_worker_id(call_info_p);
+  if (!id)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Not a worker object.");
+  }
+  return post_value(id, argc > 0 ? args[0] : jerry_undefined());
+}
+
+/**
+ * @brief Native implementation of `worker.onMessage(callback)`.
+ */
+static jerry_value_t
+js_worker_on_message_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  uint32_t id = get_worker_id(call_info_p);
+  if (!id)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Not a worker object.");
+  }
+  return set_on_message(id, args, argc);
+}
+
+/**
+ * @brief Native implementation of `worker.terminate()`.
+ */
+static jerry_value_t
+js_worker_terminate_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  uint32_t id = get_worker_id(call_info_p);
+  if (id)
+  {
+    js_worker_terminate(id); // Terminating an exited worker is harmless
+  }
+  return jerry_undefined();
+}
+
+// --- Module Function Implementations ---
+
+/**
+ * @brief Native implementation of `worker.spawn(script, options)`.
+ */
+static jerry_value_t
+js_spawn_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (js_context_index() != JS_MAIN_CONTEXT)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Workers cannot spawn workers.");
+  }
+  if (argc < 1 || !jerry_value_is_string(args[0]))
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "Expected a script path.");
+  }
+
+  char script[JS_WORKER_MAX_SCRIPT];
+  jerry_size_t script_len = jerry_string_size(args[0], JERRY_ENCODING_UTF8);
+  if (script_len >= sizeof(script))
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Script path is too long.");
+  }
+  jerry_string_to_buffer(args[0], JERRY_ENCODING_UTF8, (jerry_char_t *)script, script_len);
+  script[script_len] = '\0';
+
+  double heap_kb = JS_WORKER_HEAP_KB;
+  double queue_depth = JS_CHANNEL_DEFAULT_DEPTH;
+  double core = 0;
+  if (argc > 1 && jerry_value_is_object(args[1]))
+  {
+    const char *prop_names[] = {"heapKB", "queueDepth", "core"};
+    const jerryx_arg_t prop_mapping[] = {
+        jerryx_arg_number(&heap_kb, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+        jerryx_arg_number(&queue_depth, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+        jerryx_arg_number(&core, JERRYX_ARG_COERCE, JERRYX_ARG_OPTIONAL),
+    };
+    jerry_value_t result = jerryx_arg_transform_object_properties(args[1], (const jerry_char_t **)prop_names, 3,
+                                                                  prop_mapping, 3);
+    if (jerry_value_is_exception(result))
+    {
+      return result;
+    }
+    jerry_value_free(result);
+  }
+
+  if (heap_kb < MIN_HEAP_KB || heap_kb > MAX_HEAP_KB)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "heapKB must be between 8 and 512.");
+  }
+  if (queue_depth < 1 || queue_depth > JS_WORKER_EVENT_QUEUE_DEPTH)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "queueDepth must be between 1 and 8.");
+  }
+  if (core != 0 && core != 1)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "core must be 0 or 1.");
+  }
+
+  js_worker_options_t options = {
+      .heap_kb = (size_t)heap_kb,
+      .channel_depth = (uint32_t)queue_depth,
+      .core = (int)core,
+  };
+  uint32_t id;
+  esp_err_t err = js_worker_spawn(script, &options, &id);
+  if (err == ESP_ERR_NOT_FOUND)
+  {
+    return jerry_throw_sz(JERRY_ERROR_RANGE, "Too many workers.");
+  }
+  if (err != ESP_OK)
+  {
+    return jerry_throw_sz(JERRY_ERROR_COMMON, "Not enough memory for the worker.");
+  }
+
+  jerry_value_t worker_obj = jerry_object();
+  jerry_object_set_native_ptr(worker_obj, &worker_native_info, (void *)(uintptr_t)id);
+
+  jerryx_property_entry props[] = {
+      JERRYX_PROPERTY_FUNCTION("postMessage", js_worker_post_message_handler),
+      JERRYX_PROPERTY_FUNCTION("onMessage", js_worker_on_message_handler),
+      JERRYX_PROPERTY_FUNCTION("terminate", js_worker_terminate_handler),
+      JERRYX_PROPERTY_STRING_SZ("script", script),
+      JERRYX_PROPERTY_LIST_END(),
+  };
+  jerryx_set_properties(worker_obj, props);
+
+  return worker_obj;
+}
+
+/**
+ * @brief Native implementation of `postMessage(value)` inside a worker.
+ */
+static jerry_value_t
+js_post_message_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (js_context_index() == JS_MAIN_CONTEXT)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "postMessage() is only available inside a worker.");
+  }
+  return post_value(0, argc > 0 ? args[0] : jerry_undefined());
+}
+
+/**
+ * @brief Native implementation of `onMessage(callback)` inside a worker.
+ */
+static jerry_value_t
+js_on_message_handler(const jerry_call_info_t *call_info_p, const jerry_value_t args[], const jerry_length_t argc)
+{
+  if (js_context_index() == JS_MAIN_CONTEXT)
+  {
+    return jerry_throw_sz(JERRY_ERROR_TYPE, "onMessage() is only available inside a worker.");
+  }
+  return set_on_message(0, args, argc);
+}
+
+#define WORKER_BINDINGS(X)                  \
+  X("spawn", js_spawn_handler)              \
+  X("postMessage", js_post_message_handler) \
+  X("onMessage", js_on_message_handler)
+
+JS_BINDING_TABLE(worker, WORKER_BINDINGS);
+
+/**
+ * @brief Populates the exports for the 'worker' native module.
+ */
+jerry_value_t
+worker_module_evaluate(const jerry_value_t native_module)
+{
+  return js_binding_export(native_module, &worker_bindings);
+}
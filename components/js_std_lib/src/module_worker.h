@@ -0,0 +1,23 @@
+#ifndef MODULE_WORKER_H
+#define MODULE_WORKER_H
+
+#include "jerryscript.h"
+#include "js_binding.h"
+
+/**
+ * @brief The evaluate callback for the native 'worker' module.
+ *
+ * This function is called by the JerryScript engine when the 'worker' module
+ * is first evaluated. It populates the module's namespace with `spawn`, which
+ * starts a script in a context of its own on another task, and with the
+ * `postMessage`/`onMessage` pair a worker uses to talk to its parent.
+ *
+ * @param native_module The jerry_value_t representing the 'worker' module object.
+ * @return A jerry_value_t which is undefined on success, or an error.
+ */
+jerry_value_t worker_module_evaluate(const jerry_value_t native_module);
+
+/// @brief The functions the 'worker' module exports; the registry declares their names.
+extern const js_binding_table_t worker_bindings;
+
+#endif /* MODULE_WORKER_H */
@@ -0,0 +1,36 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+/**
+ * @brief The subset of FreeRTOS used by the runtime, implemented on pthreads.
+ *
+ * Ticks are milliseconds. There are no interrupts on the host, so the
+ * `FromISR` variants are plain thread-safe calls and yielding is a no-op.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_attr.h" // Pulled in by portmacro.h on the device
+
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS 1
+#define configTICK_RATE_HZ 1000
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define pdTICKS_TO_MS(ticks) ((uint32_t)(ticks))
+
+#define portYIELD_FROM_ISR(...) \
+  do                            \
+  {                             \
+  } while (0)
+
+#endif /* HOST_FREERTOS_H */
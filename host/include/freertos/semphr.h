@@ -0,0 +1,25 @@
+#ifndef HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "freertos/queue.h"
+
+/**
+ * @brief Semaphores are zero-size queues, as in FreeRTOS itself.
+ */
+typedef QueueHandle_t SemaphoreHandle_t;
+
+typedef struct
+{
+  int unused;
+} StaticSemaphore_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+
+#define xSemaphoreCreateMutexStatic(buffer) xSemaphoreCreateMutex()
+#define xSemaphoreTake(sem, ticks) xQueueReceive((sem), NULL, (ticks))
+#define xSemaphoreGive(sem) xQueueSend((sem), NULL, 0)
+#define xSemaphoreGiveFromISR(sem, woken) xQueueSendFromISR((sem), NULL, (woken))
+#define vSemaphoreDelete(sem) vQueueDelete(sem)
+
+#endif /* HOST_FREERTOS_SEMPHR_H */
@@ -0,0 +1,28 @@
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+/**
+ * @brief Starts a task as a detached thread. Stack size, priority and core are ignored.
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *params,
+                                   UBaseType_t priority, TaskHandle_t *out_handle, BaseType_t core_id);
+
+#define xTaskCreate(fn, name, stack, params, priority, handle) \
+  xTaskCreatePinnedToCore((fn), (name), (stack), (params), (priority), (handle), tskNO_AFFINITY)
+
+/**
+ * @brief Ends the calling task. Deleting another task is not supported on the host.
+ */
+void vTaskDelete(TaskHandle_t task);
+
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
+
+#endif /* HOST_FREERTOS_TASK_H */
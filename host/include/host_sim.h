@@ -0,0 +1,68 @@
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include <stdint.h>
+#include "driver/gpio.h"
+
+/**
+ * @brief Input injection and output observation for the host build.
+ *
+ * Everything here is callable from any thread while js_task() runs, which is
+ * how the scripted runner and C benchmarks drive the runtime.
+ */
+
+/**
+ * @brief Called whenever a pin configured as an output changes level.
+ */
+typedef void (*host_sim_output_cb_t)(gpio_num_t pin, int level, int64_t time_us);
+
+/**
+ * @brief Drives the level seen on a simulated input pin.
+ *
+ * If the change matches the pin's interrupt type, its ISR handler runs on the
+ * calling thread before this returns, as a real interrupt would preempt.
+ */
+void host_sim_gpio_input(gpio_num_t pin, int level);
+
+/**
+ * @brief Returns the level last written to a pin.
+ */
+int host_sim_gpio_output(gpio_num_t pin);
+
+/**
+ * @brief Wires an output pin to an input pin, like a jumper on a board.
+ *
+ * Every level written to `output` is then driven onto `input`, so a script
+ * can trigger its own interrupts. Pass GPIO_NUM_NC as `input` to disconnect.
+ */
+void host_sim_gpio_connect(gpio_num_t output, gpio_num_t input);
+
+/**
+ * @brief Registers a callback for output changes, or removes it with NULL.
+ */
+void host_sim_on_gpio_output(host_sim_output_cb_t callback);
+
+/**
+ * @brief Returns how many NVS commits the runtime has made, e.g. to check write batching.
+ */
+uint32_t host_sim_nvs_commits(void);
+
+/**
+ * @brief Runs an injection script, blocking until it finishes.
+ *
+ * Each line is `<time_ms> <command> [args...]`, with times measured from the
+ * call. Blank lines and lines starting with '#' are ignored. Numbers for the
+ * I2C commands may be 0x-prefixed hex. Commands:
+ *
+ *   gpio <pin> <level>                 drive an input pin
+ *   pulse <pin> <count> <period_us>    drive `count` high-then-low pulses
+ *   connect <output> <input>           wire an output pin to an input pin
+ *   i2c <port> <address> [bytes...]    attach a mock I2C device, registers from 0
+ *   i2creg <port> <address> <reg> <v>  set a register of a mock I2C device
+ *   exit [code]                        end the process
+ *
+ * @return 0 on success, -1 if the file cannot be read or has an invalid line.
+ */
+int host_sim_run_script(const char *path);
+
+#endif /* HOST_SIM_H */
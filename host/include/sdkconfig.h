@@ -0,0 +1,27 @@
+#ifndef HOST_SDKCONFIG_H
+#define HOST_SDKCONFIG_H
+
+/**
+ * @brief Configuration for the host build, standing in for the generated sdkconfig.h.
+ *
+ * Modules that need real peripherals check CONFIG_IDF_TARGET_LINUX and are
+ * left out; I2C and SPI run against their mock buses.
+ */
+
+#define CONFIG_IDF_TARGET "linux"
+#define CONFIG_IDF_TARGET_LINUX 1
+#define CONFIG_FREERTOS_HZ 1000
+#define CONFIG_LOG_DEFAULT_LEVEL 3
+#define CONFIG_ESP_CONSOLE_UART_NUM 0
+
+#define CONFIG_JS_I2C_MOCK_BUS 1
+#define CONFIG_JS_SPI_MOCK_BUS 1
+#define CONFIG_JS_LATENCY_TRACE 1
+#define CONFIG_JS_HEAP_KB 64
+#define CONFIG_JS_HEAP_INTERNAL 1
+#define CONFIG_JS_WORKERS 1
+#define CONFIG_JS_WORKER_HEAP_KB 32
+#define CONFIG_JS_WATCHDOG 1
+#define CONFIG_JS_WATCHDOG_BUDGET_MS 1000
+
+#endif /* HOST_SDKCONFIG_H */
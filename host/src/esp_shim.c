@@ -0,0 +1,96 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+// --- Errors ---
+
+const char *esp_err_to_name(esp_err_t code)
+{
+  switch (code)
+  {
+  case ESP_OK:
+    return "ESP_OK";
+  case ESP_FAIL:
+    return "ESP_FAIL";
+  case ESP_ERR_NO_MEM:
+    return "ESP_ERR_NO_MEM";
+  case ESP_ERR_INVALID_ARG:
+    return "ESP_ERR_INVALID_ARG";
+  case ESP_ERR_INVALID_STATE:
+    return "ESP_ERR_INVALID_STATE";
+  case ESP_ERR_INVALID_SIZE:
+    return "ESP_ERR_INVALID_SIZE";
+  case ESP_ERR_NOT_FOUND:
+    return "ESP_ERR_NOT_FOUND";
+  case ESP_ERR_NOT_SUPPORTED:
+    return "ESP_ERR_NOT_SUPPORTED";
+  case ESP_ERR_TIMEOUT:
+    return "ESP_ERR_TIMEOUT";
+  default:
+    return "UNKNOWN ERROR";
+  }
+}
+
+// --- Logging ---
+
+static esp_log_level_t log_level = (esp_log_level_t)CONFIG_LOG_DEFAULT_LEVEL;
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+  if (level > log_level)
+  {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+}
+
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+  if (strcmp(tag, "*") == 0)
+  {
+    log_level = level;
+  }
+}
+
+uint32_t esp_log_timestamp(void)
+{
+  return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+// --- Heap ---
+
+void *heap_caps_malloc(size_t size, uint32_t caps)
+{
+  return malloc(size);
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps)
+{
+  return calloc(n, size);
+}
+
+void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps)
+{
+  if (alignment < sizeof(void *))
+  {
+    alignment = sizeof(void *);
+  }
+  // aligned_alloc() wants the size to be a multiple of the alignment.
+  size = (size + alignment - 1) & ~(alignment - 1);
+  return aligned_alloc(alignment, size);
+}
+
+void heap_caps_free(void *ptr)
+{
+  free(ptr);
+}
@@ -0,0 +1,194 @@
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_timer.h"
+
+#define HOST_MAX_TIMERS 64
+
+/**
+ * @brief A timer slot. Slots are never freed, so a notification that races
+ *        with esp_timer_delete() finds a stale generation instead of freed memory.
+ */
+struct host_esp_timer
+{
+  bool in_use;
+  bool active;
+  bool periodic;
+  uint16_t generation;
+  timer_t timer;
+  esp_timer_cb_t callback;
+  void *arg;
+};
+
+static struct host_esp_timer slots[HOST_MAX_TIMERS];
+static pthread_mutex_t slots_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int64_t start_time_us;
+static pthread_once_t start_once = PTHREAD_ONCE_INIT;
+
+static int64_t monotonic_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void record_start_time(void)
+{
+  start_time_us = monotonic_us();
+}
+
+/**
+ * @brief Runs on a thread started by the C library for every expiry.
+ */
+static void timer_notify(union sigval value)
+{
+  uint32_t index = (uint32_t)value.sival_int & 0xFFFF;
+  uint16_t generation = (uint32_t)value.sival_int >> 16;
+
+  pthread_mutex_lock(&slots_lock);
+  struct host_esp_timer *t = &slots[index];
+  if (!t->in_use || t->generation != generation || !t->active)
+  {
+    pthread_mutex_unlock(&slots_lock);
+    return;
+  }
+  esp_timer_cb_t callback = t->callback;
+  void *arg = t->arg;
+  if (!t->periodic)
+  {
+    t->active = false;
+  }
+  pthread_mutex_unlock(&slots_lock);
+
+  callback(arg);
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out_handle)
+{
+  if (!args || !args->callback || !out_handle)
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  pthread_once(&start_once, record_start_time);
+
+  pthread_mutex_lock(&slots_lock);
+  int index = 0;
+  while (index < HOST_MAX_TIMERS && slots[index].in_use)
+  {
+    index++;
+  }
+  if (index == HOST_MAX_TIMERS)
+  {
+    pthread_mutex_unlock(&slots_lock);
+    return ESP_ERR_NO_MEM;
+  }
+
+  struct host_esp_timer *t = &slots[index];
+  t->generation++;
+
+  struct sigevent sev;
+  memset(&sev, 0, sizeof(sev));
+  sev.sigev_notify = SIGEV_THREAD;
+  sev.sigev_notify_function = timer_notify;
+  sev.sigev_value.sival_int = (int)(((uint32_t)t->generation << 16) | (uint32_t)index);
+  if (timer_create(CLOCK_MONOTONIC, &sev, &t->timer) != 0)
+  {
+    pthread_mutex_unlock(&slots_lock);
+    return ESP_ERR_NO_MEM;
+  }
+
+  t->in_use = true;
+  t->active = false;
+  t->callback = args->callback;
+  t->arg = args->arg;
+  pthread_mutex_unlock(&slots_lock);
+
+  *out_handle = t;
+  return ESP_OK;
+}
+
+/**
+ * @brief Arms a timer. A zero timeout would disarm it, so it becomes 1 µs.
+ */
+static esp_err_t arm(esp_timer_handle_t t, uint64_t first_us, uint64_t period_us)
+{
+  struct itimerspec spec;
+  memset(&spec, 0, sizeof(spec));
+  first_us = first_us > 0 ? first_us : 1;
+  spec.it_value.tv_sec = first_us / 1000000;
+  spec.it_value.tv_nsec = (first_us % 1000000) * 1000;
+  spec.it_interval.tv_sec = period_us / 1000000;
+  spec.it_interval.tv_nsec = (period_us % 1000000) * 1000;
+
+  pthread_mutex_lock(&slots_lock);
+  if (!t->in_use || t->active)
+  {
+    pthread_mutex_unlock(&slots_lock);
+    return ESP_ERR_INVALID_STATE;
+  }
+  t->active = true;
+  t->periodic = period_us > 0;
+  timer_settime(t->timer, 0, &spec, NULL);
+  pthread_mutex_unlock(&slots_lock);
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+  return arm(timer, timeout_us, 0);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us)
+{
+  return arm(timer, period_us, period_us > 0 ? period_us : 1);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t t)
+{
+  struct itimerspec disarm;
+  memset(&disarm, 0, sizeof(disarm));
+
+  pthread_mutex_lock(&slots_lock);
+  if (!t->in_use || !t->active)
+  {
+    pthread_mutex_unlock(&slots_lock);
+    return ESP_ERR_INVALID_STATE;
+  }
+  t->active = false;
+  timer_settime(t->timer, 0, &disarm, NULL);
+  pthread_mutex_unlock(&slots_lock);
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t t)
+{
+  pthread_mutex_lock(&slots_lock);
+  if (!t->in_use || t->active)
+  {
+    pthread_mutex_unlock(&slots_lock);
+    return ESP_ERR_INVALID_STATE;
+  }
+  timer_delete(t->timer);
+  t->in_use = false;
+  pthread_mutex_unlock(&slots_lock);
+  return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t t)
+{
+  pthread_mutex_lock(&slots_lock);
+  bool active = t->in_use && t->active;
+  pthread_mutex_unlock(&slots_lock);
+  return active;
+}
+
+int64_t esp_timer_get_time(void)
+{
+  pthread_once(&start_once, record_start_time);
+  return monotonic_us() - start_time_us;
+}
@@ -0,0 +1,262 @@
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+/**
+ * @brief A bounded FIFO of fixed-size items guarded by one mutex.
+ *
+ * Zero-size items give counting semantics, which is all a semaphore needs.
+ */
+struct host_queue
+{
+  pthread_mutex_t lock;
+  pthread_cond_t not_empty;
+  pthread_cond_t not_full;
+  size_t item_size;
+  size_t length;
+  size_t head;
+  size_t count;
+  uint8_t storage[];
+};
+
+/**
+ * @brief Converts a relative tick timeout to an absolute CLOCK_MONOTONIC deadline.
+ */
+static struct timespec deadline_after(TickType_t ticks)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  ts.tv_sec += ticks / 1000;
+  ts.tv_nsec += (long)(ticks % 1000) * 1000000L;
+  if (ts.tv_nsec >= 1000000000L)
+  {
+    ts.tv_sec++;
+    ts.tv_nsec -= 1000000000L;
+  }
+  return ts;
+}
+
+/**
+ * @brief Waits on a condition until signalled or the timeout expires.
+ * @return False on timeout. Must be called with the queue locked.
+ */
+static bool wait_on(struct host_queue *q, pthread_cond_t *cond, TickType_t ticks, const struct timespec *deadline)
+{
+  if (ticks == 0)
+  {
+    return false;
+  }
+  if (ticks == portMAX_DELAY)
+  {
+    pthread_cond_wait(cond, &q->lock);
+    return true;
+  }
+  return pthread_cond_timedwait(cond, &q->lock, deadline) != ETIMEDOUT;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+  struct host_queue *q = calloc(1, sizeof(struct host_queue) + (size_t)length * item_size);
+  if (!q)
+  {
+    return NULL;
+  }
+
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_mutex_init(&q->lock, NULL);
+  pthread_cond_init(&q->not_empty, &attr);
+  pthread_cond_init(&q->not_full, &attr);
+  pthread_condattr_destroy(&attr);
+
+  q->item_size = item_size;
+  q->length = length;
+  return q;
+}
+
+void vQueueDelete(QueueHandle_t q)
+{
+  pthread_cond_destroy(&q->not_full);
+  pthread_cond_destroy(&q->not_empty);
+  pthread_mutex_destroy(&q->lock);
+  free(q);
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks_to_wait)
+{
+  struct timespec deadline = deadline_after(ticks_to_wait == portMAX_DELAY ? 0 : ticks_to_wait);
+
+  pthread_mutex_lock(&q->lock);
+  while (q->count == q->length)
+  {
+    if (!wait_on(q, &q->not_full, ticks_to_wait, &deadline))
+    {
+      pthread_mutex_unlock(&q->lock);
+      return pdFALSE;
+    }
+  }
+  if (q->item_size > 0)
+  {
+    size_t tail = (q->head + q->count) % q->length;
+    memcpy(q->storage + tail * q->item_size, item, q->item_size);
+  }
+  q->count++;
+  pthread_cond_signal(&q->not_empty);
+  pthread_mutex_unlock(&q->lock);
+  return pdTRUE;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *higher_priority_task_woken)
+{
+  if (higher_priority_task_woken)
+  {
+    *higher_priority_task_woken = pdFALSE;
+  }
+  return xQueueSend(q, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks_to_wait)
+{
+  struct timespec deadline = deadline_after(ticks_to_wait == portMAX_DELAY ? 0 : ticks_to_wait);
+
+  pthread_mutex_lock(&q->lock);
+  while (q->count == 0)
+  {
+    if (!wait_on(q, &q->not_empty, ticks_to_wait, &deadline))
+    {
+      pthread_mutex_unlock(&q->lock);
+      return pdFALSE;
+    }
+  }
+  if (q->item_size > 0)
+  {
+    memcpy(item, q->storage + q->head * q->item_size, q->item_size);
+  }
+  q->head = (q->head + 1) % q->length;
+  q->count--;
+  pthread_cond_signal(&q->not_full);
+  pthread_mutex_unlock(&q->lock);
+  return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t q)
+{
+  pthread_mutex_lock(&q->lock);
+  q->head = 0;
+  q->count = 0;
+  pthread_cond_broadcast(&q->not_full);
+  pthread_mutex_unlock(&q->lock);
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q)
+{
+  pthread_mutex_lock(&q->lock);
+  UBaseType_t count = q->count;
+  pthread_mutex_unlock(&q->lock);
+  return count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q)
+{
+  pthread_mutex_lock(&q->lock);
+  UBaseType_t spaces = q->length - q->count;
+  pthread_mutex_unlock(&q->lock);
+  return spaces;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+  SemaphoreHandle_t sem = xQueueCreate(1, 0);
+  if (sem)
+  {
+    xSemaphoreGive(sem); // Mutexes start out available
+  }
+  return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+  return xQueueCreate(1, 0);
+}
+
+// --- Tasks ---
+
+typedef struct
+{
+  TaskFunction_t fn;
+  void *params;
+} task_start_t;
+
+static void *task_trampoline(void *arg)
+{
+  task_start_t start = *(task_start_t *)arg;
+  free(arg);
+  start.fn(start.params);
+  return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *params,
+                                   UBaseType_t priority, TaskHandle_t *out_handle, BaseType_t core_id)
+{
+  task_start_t *start = malloc(sizeof(task_start_t));
+  if (!start)
+  {
+    return pdFAIL;
+  }
+  start->fn = fn;
+  start->params = params;
+
+  pthread_t thread;
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  int err = pthread_create(&thread, &attr, task_trampoline, start);
+  pthread_attr_destroy(&attr);
+  if (err != 0)
+  {
+    free(start);
+    return pdFAIL;
+  }
+
+  if (out_handle)
+  {
+    *out_handle = (TaskHandle_t)(uintptr_t)thread;
+  }
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+  if (task == NULL)
+  {
+    pthread_exit(NULL);
+  }
+  // Only self-deletion is used by the runtime.
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+  struct timespec ts = {
+      .tv_sec = ticks / 1000,
+      .tv_nsec = (long)(ticks % 1000) * 1000000L,
+  };
+  while (nanosleep(&ts, &ts) == -1 && errno == EINTR)
+  {
+  }
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (TickType_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
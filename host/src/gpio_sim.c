@@ -0,0 +1,272 @@
+#include <pthread.h>
+#include <stdbool.h>
+
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "host_sim.h"
+
+/**
+ * @brief Simulated state of one pin.
+ */
+typedef struct
+{
+  gpio_mode_t mode;
+  gpio_int_type_t intr_type;
+  int level;
+  gpio_isr_t handler;
+  void *handler_arg;
+  gpio_num_t wired_to; /**< Input driven by this pin's output, or GPIO_NUM_NC. */
+} sim_pin_t;
+
+static sim_pin_t pins[GPIO_NUM_MAX];
+static pthread_mutex_t pins_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool isr_service_installed = false;
+static host_sim_output_cb_t output_callback = NULL;
+
+static void init_pins(void)
+{
+  for (int i = 0; i < GPIO_NUM_MAX; i++)
+  {
+    pins[i].wired_to = GPIO_NUM_NC;
+  }
+}
+
+static pthread_once_t pins_once = PTHREAD_ONCE_INIT;
+
+static bool valid_pin(gpio_num_t pin)
+{
+  return pin >= 0 && pin < GPIO_NUM_MAX;
+}
+
+/**
+ * @brief Whether a level change should fire an interrupt of the given type.
+ */
+static bool edge_matches(gpio_int_type_t type, int old_level, int new_level)
+{
+  switch (type)
+  {
+  case GPIO_INTR_POSEDGE:
+    return !old_level && new_level;
+  case GPIO_INTR_NEGEDGE:
+    return old_level && !new_level;
+  case GPIO_INTR_ANYEDGE:
+    return old_level != new_level;
+  case GPIO_INTR_LOW_LEVEL:
+    return !new_level;
+  case GPIO_INTR_HIGH_LEVEL:
+    return new_level;
+  default:
+    return false;
+  }
+}
+
+esp_err_t gpio_config(const gpio_config_t *config)
+{
+  if (config->pin_bit_mask >> GPIO_NUM_MAX)
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  pthread_mutex_lock(&pins_lock);
+  for (int i = 0; i < GPIO_NUM_MAX; i++)
+  {
+    if ((config->pin_bit_mask >> i) & 1)
+    {
+      pins[i].mode = config->mode;
+      pins[i].intr_type = config->intr_type;
+      // Pulls settle the level of an undriven input.
+      if (!(config->mode & GPIO_MODE_OUTPUT))
+      {
+        pins[i].level = config->pull_up_en ? 1 : 0;
+      }
+    }
+  }
+  pthread_mutex_unlock(&pins_lock);
+  return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num)
+{
+  if (!valid_pin(gpio_num))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  pthread_once(&pins_once, init_pins);
+  pthread_mutex_lock(&pins_lock);
+  gpio_num_t wired_to = pins[gpio_num].wired_to; // Wiring belongs to the board, not the pin config
+  pins[gpio_num] = (sim_pin_t){.wired_to = wired_to};
+  pthread_mutex_unlock(&pins_lock);
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+  if (!valid_pin(gpio_num))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  pthread_once(&pins_once, init_pins);
+  pthread_mutex_lock(&pins_lock);
+  sim_pin_t *pin = &pins[gpio_num];
+  int old_level = pin->level;
+  bool is_output = pin->mode & GPIO_MODE_OUTPUT;
+  if (is_output)
+  {
+    pin->level = level ? 1 : 0;
+  }
+  host_sim_output_cb_t callback = output_callback;
+  gpio_num_t wired_to = pin->wired_to;
+  pthread_mutex_unlock(&pins_lock);
+
+  if (!is_output)
+  {
+    return ESP_OK;
+  }
+  if (callback && old_level != (level ? 1 : 0))
+  {
+    callback(gpio_num, level ? 1 : 0, esp_timer_get_time());
+  }
+  if (wired_to != GPIO_NUM_NC)
+  {
+    host_sim_gpio_input(wired_to, level);
+  }
+  return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+  if (!valid_pin(gpio_num))
+  {
+    return 0;
+  }
+  pthread_mutex_lock(&pins_lock);
+  int level = pins[gpio_num].level;
+  pthread_mutex_unlock(&pins_lock);
+  return level;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+  if (!valid_pin(gpio_num))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  pthread_mutex_lock(&pins_lock);
+  pins[gpio_num].intr_type = intr_type;
+  pthread_mutex_unlock(&pins_lock);
+  return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+  if (isr_service_installed)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+  isr_service_installed = true;
+  return ESP_OK;
+}
+
+void gpio_uninstall_isr_service(void)
+{
+  isr_service_installed = false;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
+{
+  if (!valid_pin(gpio_num))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (!isr_service_installed)
+  {
+    return ESP_ERR_INVALID_STATE;
+  }
+  pthread_mutex_lock(&pins_lock);
+  pins[gpio_num].handler = isr_handler;
+  pins[gpio_num].handler_arg = args;
+  pthread_mutex_unlock(&pins_lock);
+  return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
+{
+  if (!valid_pin(gpio_num))
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  pthread_mutex_lock(&pins_lock);
+  pins[gpio_num].handler = NULL;
+  pins[gpio_num].handler_arg = NULL;
+  pthread_mutex_unlock(&pins_lock);
+  return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+  return valid_pin(gpio_num) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t gpio_num)
+{
+  return valid_pin(gpio_num) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+// --- Simulation hooks ---
+
+void host_sim_gpio_input(gpio_num_t pin_num, int level)
+{
+  if (!valid_pin(pin_num))
+  {
+    return;
+  }
+  level = level ? 1 : 0;
+
+  pthread_mutex_lock(&pins_lock);
+  sim_pin_t *pin = &pins[pin_num];
+  if (pin->mode & GPIO_MODE_OUTPUT)
+  {
+    pthread_mutex_unlock(&pins_lock); // Driven by the runtime, not the outside world
+    return;
+  }
+  int old_level = pin->level;
+  pin->level = level;
+  gpio_isr_t handler = NULL;
+  void *arg = NULL;
+  if (isr_service_installed && edge_matches(pin->intr_type, old_level, level))
+  {
+    handler = pin->handler;
+    arg = pin->handler_arg;
+  }
+  pthread_mutex_unlock(&pins_lock);
+
+  if (handler)
+  {
+    handler(arg);
+  }
+}
+
+int host_sim_gpio_output(gpio_num_t pin)
+{
+  return gpio_get_level(pin);
+}
+
+void host_sim_gpio_connect(gpio_num_t output, gpio_num_t input)
+{
+  if (!valid_pin(output) || (input != GPIO_NUM_NC && !valid_pin(input)))
+  {
+    return;
+  }
+  pthread_once(&pins_once, init_pins);
+  pthread_mutex_lock(&pins_lock);
+  pins[output].wired_to = input;
+  pthread_mutex_unlock(&pins_lock);
+}
+
+void host_sim_on_gpio_output(host_sim_output_cb_t callback)
+{
+  pthread_mutex_lock(&pins_lock);
+  output_callback = callback;
+  pthread_mutex_unlock(&pins_lock);
+}
@@ -0,0 +1,108 @@
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "host_sim.h"
+#include "js_i2c_mock.h"
+#include "js_main_thread.h"
+#include "js_module_resolver.h"
+
+static const char *TAG = "HOST";
+
+static void usage(const char *argv0)
+{
+  fprintf(stderr,
+          "Usage: %s <script_dir> [--inject <file>] [--timeout <ms>]\n"
+          "\n"
+          "Runs <script_dir>/main.js on the runtime with simulated peripherals.\n"
+          "  --inject <file>   drive inputs from an injection script (see host_sim.h)\n"
+          "  --timeout <ms>    exit with status 0 after this long\n",
+          argv0);
+}
+
+int main(int argc, char **argv)
+{
+  const char *script_dir = NULL;
+  const char *inject_path = NULL;
+  long timeout_ms = 0;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--inject") == 0 && i + 1 < argc)
+    {
+      inject_path = argv[++i];
+    }
+    else if (strcmp(argv[i], "--timeout") == 0 && i + 1 < argc)
+    {
+      timeout_ms = strtol(argv[++i], NULL, 10);
+    }
+    else if (argv[i][0] != '-' && !script_dir)
+    {
+      script_dir = argv[i];
+    }
+    else
+    {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (!script_dir)
+  {
+    usage(argv[0]);
+    return 2;
+  }
+
+  // The injection script is named relative to where we were started.
+  char inject_abs[PATH_MAX];
+  if (inject_path)
+  {
+    if (!realpath(inject_path, inject_abs))
+    {
+      ESP_LOGE(TAG, "Cannot find injection script %s", inject_path);
+      return 1;
+    }
+    inject_path = inject_abs;
+  }
+
+  // Relative paths keep module paths inside the resolver's fixed-size buffer.
+  if (chdir(script_dir) != 0)
+  {
+    ESP_LOGE(TAG, "Cannot enter script directory %s", script_dir);
+    return 1;
+  }
+  js_module_resolver_set_root(".");
+  js_module_resolver_set_mount_info("host", 0);
+
+  // Before any thread can reach the mock bus, including the injection script.
+  js_i2c_mock_init();
+
+  xTaskCreatePinnedToCore(js_task, "js_main_thread", 16 * 1024, NULL, 10, NULL, 1);
+
+  int64_t start_ms = xTaskGetTickCount();
+  if (inject_path && host_sim_run_script(inject_path) != 0)
+  {
+    return 1;
+  }
+
+  if (timeout_ms > 0)
+  {
+    int64_t elapsed_ms = (int64_t)xTaskGetTickCount() - start_ms;
+    if (elapsed_ms < timeout_ms)
+    {
+      vTaskDelay(pdMS_TO_TICKS(timeout_ms - elapsed_ms));
+    }
+    fflush(stdout);
+    return 0;
+  }
+
+  // Without a timeout the runtime runs until it is killed, as on the device.
+  while (1)
+  {
+    pause();
+  }
+}
@@ -0,0 +1,179 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "host_sim.h"
+#include "js_i2c_mock.h"
+
+static const char *TAG = "HOST_SIM";
+
+/**
+ * @brief Sleeps until `deadline_us` on the esp_timer clock.
+ */
+static void sleep_until(int64_t deadline_us)
+{
+  int64_t remaining = deadline_us - esp_timer_get_time();
+  if (remaining <= 0)
+  {
+    return;
+  }
+  struct timespec ts = {
+      .tv_sec = remaining / 1000000,
+      .tv_nsec = (remaining % 1000000) * 1000,
+  };
+  while (nanosleep(&ts, &ts) == -1 && errno == EINTR)
+  {
+  }
+}
+
+/**
+ * @brief Drives `count` high-then-low pulses with a 50% duty cycle.
+ *
+ * Each edge is scheduled from `start_us`, so slow handlers don't stretch the train.
+ */
+static void run_pulses(gpio_num_t pin, long count, long period_us, int64_t start_us)
+{
+  for (long i = 0; i < count; i++)
+  {
+    sleep_until(start_us + i * period_us);
+    host_sim_gpio_input(pin, 1);
+    sleep_until(start_us + i * period_us + period_us / 2);
+    host_sim_gpio_input(pin, 0);
+  }
+}
+
+/**
+ * @brief Attaches a mock I2C device from `<port> <address> [register bytes...]`.
+ *
+ * Numbers may be decimal or 0x-prefixed hex; the bytes fill registers from 0.
+ */
+static int add_i2c_device(const char *args)
+{
+  char *end;
+  long port = strtol(args, &end, 0);
+  if (end == args)
+  {
+    return -1;
+  }
+  args = end;
+  long address = strtol(args, &end, 0);
+  if (end == args)
+  {
+    return -1;
+  }
+
+  uint8_t registers[JS_I2C_MOCK_REGISTER_COUNT];
+  size_t len = 0;
+  for (args = end; len < sizeof(registers); args = end)
+  {
+    long value = strtol(args, &end, 0);
+    if (end == args)
+    {
+      break;
+    }
+    registers[len++] = (uint8_t)value;
+  }
+  return js_i2c_mock_add_device((int)port, (uint16_t)address, registers, len) == ESP_OK ? 0 : -1;
+}
+
+/**
+ * @brief Runs an injection script, blocking until it finishes.
+ */
+int host_sim_run_script(const char *path)
+{
+  FILE *file = fopen(path, "r");
+  if (!file)
+  {
+    ESP_LOGE(TAG, "Cannot open injection script %s", path);
+    return -1;
+  }
+
+  int64_t start_us = esp_timer_get_time();
+  char line[128];
+  int line_no = 0;
+  int result = 0;
+
+  while (fgets(line, sizeof(line), file))
+  {
+    line_no++;
+    char *comment = strchr(line, '#');
+    if (comment)
+    {
+      *comment = '\0';
+    }
+
+    long time_ms;
+    char command[16];
+    int consumed = 0;
+    int fields = sscanf(line, " %ld %15s %n", &time_ms, command, &consumed);
+    if (fields <= 0)
+    {
+      continue; // Blank line
+    }
+    if (fields != 2)
+    {
+      ESP_LOGE(TAG, "%s:%d: expected '<time_ms> <command>'", path, line_no);
+      result = -1;
+      break;
+    }
+
+    int64_t at_us = start_us + (int64_t)time_ms * 1000;
+    const char *args = line + consumed;
+    long a = 0, b = 0, c = 0, d = 0;
+
+    if (strcmp(command, "gpio") == 0 && sscanf(args, "%ld %ld", &a, &b) == 2)
+    {
+      sleep_until(at_us);
+      host_sim_gpio_input((gpio_num_t)a, (int)b);
+    }
+    else if (strcmp(command, "pulse") == 0 && sscanf(args, "%ld %ld %ld", &a, &b, &c) == 3 && c > 0)
+    {
+      run_pulses((gpio_num_t)a, b, c, at_us);
+    }
+    else if (strcmp(command, "connect") == 0 && sscanf(args, "%ld %ld", &a, &b) == 2)
+    {
+      sleep_until(at_us);
+      host_sim_gpio_connect((gpio_num_t)a, (gpio_num_t)b);
+    }
+    else if (strcmp(command, "i2c") == 0)
+    {
+      sleep_until(at_us);
+      if (add_i2c_device(args) != 0)
+      {
+        ESP_LOGE(TAG, "%s:%d: cannot add I2C device", path, line_no);
+        result = -1;
+        break;
+      }
+    }
+    else if (strcmp(command, "i2creg") == 0 && sscanf(args, "%li %li %li %li", &a, &b, &c, &d) == 4)
+    {
+      sleep_until(at_us);
+      if (js_i2c_mock_set_register((int)a, (uint16_t)b, (uint8_t)c, (uint8_t)d) != ESP_OK)
+      {
+        ESP_LOGE(TAG, "%s:%d: no I2C device at %#lx on port %ld", path, line_no, b, a);
+        result = -1;
+        break;
+      }
+    }
+    else if (strcmp(command, "exit") == 0)
+    {
+      sleep_until(at_us);
+      fclose(file);
+      fflush(stdout);
+      exit(sscanf(args, "%ld", &a) == 1 ? (int)a : 0);
+    }
+    else
+    {
+      ESP_LOGE(TAG, "%s:%d: invalid command '%s'", path, line_no, command);
+      result = -1;
+      break;
+    }
+  }
+
+  fclose(file);
+  return result;
+}
@@ -0,0 +1,148 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_sim.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+
+#define NVS_KEY_MAX 16
+
+/**
+ * @brief One stored key. Namespaces are not separated; the runtime only opens one.
+ */
+typedef struct nvs_entry
+{
+  char key[NVS_KEY_MAX];
+  uint8_t *value;
+  size_t length;
+  struct nvs_entry *next;
+} nvs_entry_t;
+
+static nvs_entry_t *entries = NULL;
+static pthread_mutex_t nvs_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t commit_count = 0;
+
+static nvs_entry_t **find(const char *key)
+{
+  nvs_entry_t **link = &entries;
+  while (*link && strcmp((*link)->key, key) != 0)
+  {
+    link = &(*link)->next;
+  }
+  return link;
+}
+
+esp_err_t nvs_flash_init(void)
+{
+  return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+  pthread_mutex_lock(&nvs_lock);
+  while (entries)
+  {
+    nvs_entry_t *entry = entries;
+    entries = entry->next;
+    free(entry->value);
+    free(entry);
+  }
+  pthread_mutex_unlock(&nvs_lock);
+  return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle)
+{
+  *out_handle = 1;
+  return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length)
+{
+  if (strlen(key) >= NVS_KEY_MAX)
+  {
+    return ESP_ERR_INVALID_ARG;
+  }
+  uint8_t *copy = (uint8_t *)malloc(length ? length : 1);
+  if (!copy)
+  {
+    return ESP_ERR_NO_MEM;
+  }
+  memcpy(copy, value, length);
+
+  pthread_mutex_lock(&nvs_lock);
+  nvs_entry_t **link = find(key);
+  if (!*link)
+  {
+    *link = (nvs_entry_t *)calloc(1, sizeof(nvs_entry_t));
+    if (!*link)
+    {
+      pthread_mutex_unlock(&nvs_lock);
+      free(copy);
+      return ESP_ERR_NO_MEM;
+    }
+    strcpy((*link)->key, key);
+  }
+  free((*link)->value);
+  (*link)->value = copy;
+  (*link)->length = length;
+  pthread_mutex_unlock(&nvs_lock);
+  return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+  esp_err_t err = ESP_OK;
+  pthread_mutex_lock(&nvs_lock);
+  nvs_entry_t *entry = *find(key);
+  if (!entry)
+  {
+    err = ESP_ERR_NVS_NOT_FOUND;
+  }
+  else if (!out_value)
+  {
+    *length = entry->length;
+  }
+  else if (*length < entry->length)
+  {
+    err = ESP_ERR_INVALID_SIZE;
+  }
+  else
+  {
+    memcpy(out_value, entry->value, entry->length);
+    *length = entry->length;
+  }
+  pthread_mutex_unlock(&nvs_lock);
+  return err;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key)
+{
+  pthread_mutex_lock(&nvs_lock);
+  nvs_entry_t **link = find(key);
+  nvs_entry_t *entry = *link;
+  if (entry)
+  {
+    *link = entry->next;
+    free(entry->value);
+    free(entry);
+  }
+  pthread_mutex_unlock(&nvs_lock);
+  return entry ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle)
+{
+  __atomic_add_fetch(&commit_count, 1, __ATOMIC_RELAXED);
+  return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle)
+{
+}
+
+uint32_t host_sim_nvs_commits(void)
+{
+  return __atomic_load_n(&commit_count, __ATOMIC_RELAXED);
+}
@@ -5,37 +5,77 @@
 
 #include "esp_err.h"
 #include "esp_log.h"
-#include "esp_spiffs.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
 #include "js_main_thread.h"
+#include "js_module_resolver.h"
+#if CONFIG_JS_SCRIPT_FS_LITTLEFS
+#include "esp_littlefs.h"
+#define FS_NAME "LittleFS"
+#else
+#include "esp_spiffs.h"
+#define FS_NAME "SPIFFS"
+#endif
 
-static void mount_file_system()
+#define STORAGE_LABEL "storage" // Use the label from partitions.csv
+
+#if CONFIG_JS_SCRIPT_FS_LITTLEFS
+static esp_err_t register_file_system(void)
 {
-  ESP_LOGI("FS", "Initialising SPIFFS");
+  esp_vfs_littlefs_conf_t config = {
+      .base_path = "/storage",
+      .partition_label = STORAGE_LABEL,
+      .format_if_mount_failed = true,
+  };
+  return esp_vfs_littlefs_register(&config);
+}
 
+static esp_err_t file_system_info(size_t *total, size_t *used)
+{
+  return esp_littlefs_info(STORAGE_LABEL, total, used);
+}
+#else
+static esp_err_t register_file_system(void)
+{
   esp_vfs_spiffs_conf_t config = {
       .base_path = "/storage",
-      .partition_label = "storage", // Use the label from partitions.csv
-      .max_files = 5,
+      .partition_label = STORAGE_LABEL,
+      .max_files = 8, // The fs module keeps readers and log appends open alongside module loads
       .format_if_mount_failed = true};
+  return esp_vfs_spiffs_register(&config);
+}
+
+static esp_err_t file_system_info(size_t *total, size_t *used)
+{
+  return esp_spiffs_info(STORAGE_LABEL, total, used);
+}
+#endif
+
+static void mount_file_system()
+{
+  ESP_LOGI("FS", "Initialising " FS_NAME);
 
-  esp_err_t result = esp_vfs_spiffs_register(&config);
+  int64_t start = esp_timer_get_time();
+  esp_err_t result = register_file_system();
+  int64_t mount_us = esp_timer_get_time() - start;
 
   if (result != ESP_OK)
   {
-    ESP_LOGE("FS", "Failed to initialise SPIFFS (%s)", esp_err_to_name(result));
+    ESP_LOGE("FS", "Failed to initialise " FS_NAME " (%s)", esp_err_to_name(result));
     return;
   }
+  js_module_resolver_set_mount_info(FS_NAME, mount_us);
 
   size_t total = 0, used = 0;
-  result = esp_spiffs_info(config.partition_label, &total, &used);
+  result = file_system_info(&total, &used);
   if (result != ESP_OK)
   {
-    ESP_LOGE("FS", "Failed to get SPIFFS partition information (%s).", esp_err_to_name(result));
+    ESP_LOGE("FS", "Failed to get " FS_NAME " partition information (%s).", esp_err_to_name(result));
   }
   else
   {
-    ESP_LOGI("FS", "Partition size: total: %d, used: %d", total, used);
+    ESP_LOGI("FS", "Partition size: total: %d, used: %d, mounted in %lld us", total, used, mount_us);
   }
 }
 
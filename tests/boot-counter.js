@@ -0,0 +1,28 @@
+// Counts boots and button presses across resets. Presses are written on
+// every edge but only reach flash once they stop for a second.
+import * as storage from "storage";
+import { setup } from "gpio";
+const BUTTON_PIN = 5;
+
+const boots = (storage.get("boots") ?? 0) + 1;
+let presses = storage.get("presses") ?? 0;
+
+async function main() {
+  // Make the boot count durable before anything else can reset the board.
+  await storage.setAsync("boots", boots);
+  console.log(`Boot ${boots}; ${presses} presses so far`);
+
+  const button = setup(BUTTON_PIN, {
+    mode: "input",
+    pullMode: "pullup",
+    interrupt: "falling",
+    debounce: 50,
+  });
+  button.attachISR(() => {
+    presses++;
+    storage.set("presses", presses);
+    console.log(`Presses: ${presses}`);
+  });
+}
+
+main();
@@ -0,0 +1,33 @@
+// Sums a large range in chunks while a button stays responsive. Every chunk
+// ends with `await scheduler.yield()`, which lets waiting GPIO events run
+// without the cost of a hardware timer per chunk.
+import { setup } from "gpio";
+const BUTTON_PIN = 5;
+const TOTAL = 2000000;
+const CHUNK = 5000;
+
+let presses = 0;
+const button = setup(BUTTON_PIN, {
+  mode: "input",
+  pullMode: "pullup",
+  interrupt: "falling",
+  debounce: 50,
+});
+button.attachISR(() => {
+  presses++;
+  queueMicrotask(() => console.log(`Press ${presses} handled mid-computation`));
+});
+
+async function sumRange() {
+  let sum = 0;
+  for (let start = 0; start < TOTAL; start += CHUNK) {
+    const end = Math.min(start + CHUNK, TOTAL);
+    for (let i = start; i < end; i++) {
+      sum += i % 7;
+    }
+    await scheduler.yield();
+  }
+  return sum;
+}
+
+sumRange().then((sum) => console.log(`Sum: ${sum}, ${presses} presses during the run`));
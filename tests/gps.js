@@ -0,0 +1,35 @@
+import { open } from "serial";
+const GPS_PORT = 2;
+const GPS_TX_PIN = 17;
+const GPS_RX_PIN = 16;
+
+// NMEA sentences arrive as text lines; the driver splits them natively.
+const gps = open(
+  { port: GPS_PORT, tx: GPS_TX_PIN, rx: GPS_RX_PIN, baudRate: 9600, delimiter: "\r\n", encoding: "utf8" },
+  (sentence) => {
+    if (!sentence.startsWith("$GPGGA") && !sentence.startsWith("$GNGGA")) {
+      return;
+    }
+    const fields = sentence.split(",");
+    if (fields[6] === "0") {
+      console.log("GPS: waiting for a fix...");
+      return;
+    }
+    console.log(`GPS fix: ${fields[2]}${fields[3]} ${fields[4]}${fields[5]}, ${fields[7]} satellites`);
+  }
+);
+
+// Ask the receiver for GGA sentences only, at 1 Hz (MTK command set).
+async function configure(command) {
+  let remaining = command;
+  while (remaining.length > 0) {
+    const accepted = gps.write(remaining);
+    remaining = remaining.slice(accepted);
+    if (remaining.length > 0) {
+      await gps.drain();
+    }
+  }
+}
+
+configure("$PMTK314,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0*29\r\n");
+console.log("GPS logger initialised.");
@@ -0,0 +1,50 @@
+// Reads and writes a simulated temperature sensor on the mock I2C bus.
+// On the host: run this as main.js with --inject tests/i2c-mock.inject,
+// which attaches the sensor and later changes its reading.
+import { open } from "i2c";
+import { setTimeout } from "timers";
+const SENSOR = 0x48;
+const MISSING = 0x49;
+const TEMPERATURE_REG = 0x00;
+const CONFIG_REG = 0x02; // Mock registers are one byte wide; the reading takes 0 and 1
+
+const bus = open({ port: 0, sda: 21, scl: 22 });
+
+// 12-bit two's complement, 0.0625 degrees per step, left-aligned in 2 bytes.
+function toCelsius(bytes) {
+  const raw = ((bytes[0] << 8) | bytes[1]) >> 4;
+  return (raw & 0x800 ? raw - 0x1000 : raw) * 0.0625;
+}
+
+async function readTemperature() {
+  return toCelsius(await bus.writeRead(SENSOR, [TEMPERATURE_REG], 2));
+}
+
+async function run() {
+  console.log(`Temperature: ${await readTemperature()} C`);
+
+  // Write the config register, then read it back in one transaction.
+  const [, config] = await bus.transaction([
+    { address: SENSOR, write: [CONFIG_REG, 0x60, 0xa0] },
+    { address: SENSOR, write: [CONFIG_REG], read: 2 },
+  ]);
+  console.log(`Config: 0x${config[0].toString(16)} 0x${config[1].toString(16)}`);
+
+  try {
+    await bus.read(MISSING, 1);
+    console.log("Missing device answered!");
+  } catch (error) {
+    console.log(`Missing device: ${error.message}`);
+  }
+
+  // The injection script changes the reading meanwhile.
+  setTimeout(async () => {
+    console.log(`Temperature later: ${await readTemperature()} C`);
+    bus.close();
+  }, 1000);
+}
+
+// The injection script attaches the sensor 100 ms in.
+setTimeout(() => {
+  run().catch((error) => console.log(`I2C test failed: ${error.message}`));
+}, 200);
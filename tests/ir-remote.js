@@ -0,0 +1,40 @@
+import { receiver, transmitter, decodeNEC } from "rmt";
+const IR_RECEIVER_PIN = 15;
+const LED_STRIP_PIN = 18;
+const PIXEL_COUNT = 8;
+
+// NEC command codes of a common 21-key remote.
+const COLOURS = {
+  0x0c: [0, 255, 0], // "1": red (GRB order)
+  0x18: [255, 0, 0], // "2": green
+  0x5e: [0, 0, 255], // "3": blue
+  0x08: [0, 0, 0], //   "4": off
+};
+
+const ir = receiver(IR_RECEIVER_PIN, { maxSymbols: 64 });
+const strip = transmitter(LED_STRIP_PIN, { resolution: 10000000 });
+const pixels = new Uint8Array(PIXEL_COUNT * 3);
+
+function fill(grb) {
+  for (let i = 0; i < pixels.length; i += 3) {
+    pixels[i] = grb[0];
+    pixels[i + 1] = grb[1];
+    pixels[i + 2] = grb[2];
+  }
+  return strip.sendWS2812(pixels);
+}
+
+ir.start((symbols) => {
+  const frame = decodeNEC(symbols);
+  if (!frame || frame.repeat) {
+    return;
+  }
+  console.log(`IR address=${frame.address} command=${frame.command}`);
+  const colour = COLOURS[frame.command];
+  if (colour) {
+    fill(colour).then(() => console.log("Strip updated."));
+  }
+});
+
+console.log("IR remote LED controller initialised.");
+fill(COLOURS[0x08]);
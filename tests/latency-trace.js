@@ -0,0 +1,27 @@
+// Reports interrupt-to-callback latency for a safety interlock input.
+// Needs CONFIG_JS_LATENCY_TRACE.
+import { setup, latency, resetLatency } from "gpio";
+import { setInterval } from "timers";
+const INTERLOCK_PIN = 34;
+const RELAY_PIN = 26;
+const REPORT_INTERVAL_MS = 10000;
+
+const relay = setup(RELAY_PIN, { mode: "output" });
+const interlock = setup(INTERLOCK_PIN, { mode: "input", interrupt: "falling" });
+
+interlock.attachISR(() => {
+  relay.write(false);
+});
+
+setInterval(() => {
+  const stats = latency(INTERLOCK_PIN);
+  if (!stats) {
+    return;
+  }
+  const { dispatch, callback } = stats;
+  console.log(
+    `interlock: ${callback.count} trips, dispatch mean ${dispatch.meanUs.toFixed(1)} us max ${dispatch.maxUs} us, ` +
+      `callback p99 <= ${callback.p99Us} us max ${callback.maxUs} us`
+  );
+  resetLatency(INTERLOCK_PIN);
+}, REPORT_INTERVAL_MS);
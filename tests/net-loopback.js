@@ -0,0 +1,62 @@
+import { connect, listen, udp } from "net";
+
+// An echo server and its client on 127.0.0.1, so this runs without Wi-Fi.
+const BLOCK = 4096;
+const TOTAL = 64 * BLOCK;
+
+async function send(socket, bytes) {
+  let remaining = bytes;
+  while (remaining.length > 0) {
+    const accepted = socket.write(remaining);
+    remaining = remaining.subarray(accepted);
+    if (remaining.length > 0) {
+      await socket.drain();
+    }
+  }
+}
+
+const server = listen({ host: "127.0.0.1", port: 0 }, (socket) => {
+  console.log(`Server: connection from ${socket.remoteAddress}:${socket.remotePort}`);
+  // Each chunk is echoed after the last one is fully written, keeping their order.
+  let echoed = Promise.resolve();
+  socket.onData((data) => {
+    if (data === null) {
+      console.log("Server: client hung up.");
+      return;
+    }
+    echoed = echoed.then(() => send(socket, data));
+  });
+});
+
+async function run() {
+  let received = 0;
+  let callbacks = 0;
+  const start = Date.now();
+  const socket = await connect({ host: "127.0.0.1", port: server.port }, (data) => {
+    if (data === null) {
+      return;
+    }
+    received += data.length;
+    callbacks++;
+    if (received === TOTAL) {
+      console.log(`Client: ${TOTAL} bytes echoed in ${Date.now() - start} ms, ${callbacks} callbacks.`);
+      socket.close();
+      server.close();
+    }
+  });
+
+  const block = new Uint8Array(BLOCK);
+  for (let i = 0; i < TOTAL / BLOCK; i++) {
+    block.fill(i);
+    await send(socket, block);
+  }
+}
+
+run().catch((error) => console.log(`Echo failed: ${error.message}`));
+
+// UDP ping to itself.
+const pinger = udp({ host: "127.0.0.1" }, (data, from) => {
+  console.log(`UDP: ${data.length} bytes from ${from.address}:${from.port}`);
+  pinger.close();
+});
+pinger.send("ping", "127.0.0.1", pinger.port);
@@ -0,0 +1,19 @@
+// Checksums a large buffer on core 0 while a timer keeps ticking on the JS thread.
+import { offload } from "runtime";
+import { setInterval, clearInterval } from "timers";
+const BLOCK_SIZE = 64 * 1024;
+
+const block = new Uint8Array(BLOCK_SIZE).map((_, i) => i & 0xff);
+let ticks = 0;
+const ticker = setInterval(() => ticks++, 10);
+
+async function main() {
+  const start = Date.now();
+  const crc = await offload("crc32", block);
+  const header = await offload("hex", block.subarray(0, 8));
+  clearInterval(ticker);
+  console.log(`crc32 ${crc.toString(16)} of ${BLOCK_SIZE} bytes in ${Date.now() - start} ms`);
+  console.log(`header ${header}; the event loop ran ${ticks} ticks meanwhile`);
+}
+
+main();
@@ -0,0 +1,30 @@
+// A timer callback that never returns is thrown a RangeError after its
+// budget; this loop swallows it, so a budget later it is aborted, and the
+// blinking LED keeps going. Aborts skip `catch`, so the loop cannot swallow that.
+import { setup } from "gpio";
+import { setInterval, setTimeout } from "timers";
+import { watchdog, setWatchdog } from "runtime";
+const LED_PIN = 2;
+
+setWatchdog(200);
+
+const led = setup(LED_PIN, { mode: "output" });
+let on = false;
+setInterval(() => {
+  on = !on;
+  led.write(on);
+}, 250);
+
+setTimeout(() => {
+  console.log("Starting a runaway loop");
+  for (;;) {
+    try {
+      JSON.parse("{}");
+    } catch (e) {}
+  }
+}, 1000);
+
+setTimeout(() => {
+  const { aborted, longestUs } = watchdog();
+  console.log(`Aborted callbacks: ${aborted}, longest ran ${longestUs} us`);
+}, 2000);
@@ -0,0 +1,40 @@
+// Logs a sensor reading every 100 ms without ever waiting on flash,
+// then streams the log back in 256-byte chunks through one reused buffer.
+import { createLog, open, stat, readdir } from "fs";
+import { setInterval, clearInterval } from "timers";
+import { setup } from "adc";
+const SENSOR_PIN = 34;
+const SAMPLES = 100;
+
+const sensor = setup(SENSOR_PIN);
+const log = createLog("sensor.csv", { bufferSize: 2048, flushMs: 2000 });
+
+async function replay() {
+  const info = await stat("sensor.csv");
+  console.log(`sensor.csv: ${info.size} bytes`);
+
+  const reader = await open("sensor.csv");
+  const chunk = new Uint8Array(256);
+  let lines = 0;
+  for (let n = await reader.read(chunk); n > 0; n = await reader.read(chunk)) {
+    for (let i = 0; i < n; i++) {
+      if (chunk[i] === 10) lines++;
+    }
+  }
+  await reader.close();
+  console.log(`Read back ${lines} lines; files: ${(await readdir()).join(", ")}`);
+}
+
+let count = 0;
+const timer = setInterval(async () => {
+  if (!log.write(`${Date.now()},${sensor.readVoltage()}\n`)) {
+    console.log("Log buffer full, sample dropped");
+  }
+  if (++count === SAMPLES) {
+    clearInterval(timer);
+    const { written, dropped, flushes } = log.stats();
+    await log.close();
+    console.log(`Logged ${written} bytes in ${flushes} flushes, dropped ${dropped}`);
+    await replay();
+  }
+}, 100);
@@ -1,15 +1,17 @@
 import { setup } from "gpio";
+import * as adc from "adc";
 import { setTimeout, clearTimeout } from "timers";
 const PIR_PIN = 13;
 const LDR_PIN = 12;
 const BUTTON_PIN = 5;
 const RELAY_PIN = 4;
+const DARK_THRESHOLD_MV = 800;
 let lightOn = false;
 let autoMode = true;
 let autoOffTimer = null;
 
 const pir = setup(PIR_PIN, { mode: "input" });
-const ldr = setup(LDR_PIN, { mode: "input" });
+const ldr = adc.setup(LDR_PIN, { attenuation: "12db" });
 const button = setup(BUTTON_PIN, {
   mode: "input",
   pullMode: "pullup",
@@ -28,7 +30,7 @@ function handleMotion() {
     clearTimeout(autoOffTimer);
   }
   if (!lightOn) {
-    const isDark = !ldr.read();
+    const isDark = ldr.readVoltage() < DARK_THRESHOLD_MV;
     if (isDark) {
       console.log("Motion detected in the dark, turning light on.");
       setLight(true);
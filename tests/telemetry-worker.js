@@ -0,0 +1,24 @@
+// Worker half of worker-telemetry.js: aggregates sample batches and reports once a second.
+import { onMessage, postMessage } from "worker";
+import { setInterval } from "timers";
+
+let count = 0;
+let sum = 0;
+let max = -Infinity;
+
+onMessage((batch) => {
+  for (const sample of batch) {
+    count++;
+    sum += sample;
+    max = Math.max(max, sample);
+  }
+});
+
+setInterval(() => {
+  if (count > 0) {
+    postMessage({ count, mean: sum / count, max: Math.round(max * 100) / 100 });
+    count = 0;
+    sum = 0;
+    max = -Infinity;
+  }
+}, 1000);
@@ -0,0 +1,18 @@
+// Delays and periods too long to represent, Infinity included, are shortened
+// to 2^31-1 ms (about 24.8 days), so none of these may fire during the run.
+import { sleep, every } from "timers";
+
+let fired = 0;
+setTimeout(() => fired++, Infinity);
+setTimeout(() => fired++, 1e300);
+setInterval(() => fired++, Infinity);
+sleep(Infinity).then(() => fired++);
+sleep(1e300).then(() => fired++);
+
+const ticks = every(Infinity);
+ticks.next().then(() => fired++);
+
+setTimeout(() => {
+  console.log(fired === 0 ? "PASS: no overlong timer fired" : `FAIL: ${fired} overlong timers fired`);
+  ticks.return();
+}, 1000);
@@ -1,5 +1,5 @@
 import * as gpio from "gpio";
-import { setTimeout, clearTimeout, setInterval, clearInterval } from "timers";
+import { setInterval, clearInterval, sleep } from "timers";
 
 const BUZZER_PIN = 4;
 const TEMPO_MULTIPLIER = 1.5;
@@ -78,9 +78,9 @@ const playlist = [
   { name: "Ode to Joy", melody: odeToJoy },
 ];
 
-function playNote(pin, freq, duration, callback) {
+async function playNote(pin, freq, duration) {
   if (freq <= 0) {
-    setTimeout(callback, duration);
+    await sleep(duration);
     return;
   }
   const halfPeriodMs = 1000 / freq / 2;
@@ -89,45 +89,27 @@ function playNote(pin, freq, duration, callback) {
     state = !state;
     pin.write(state);
   };
-  const interval = setInterval(toggle, halfPeriodMs);
-  setTimeout(() => {
-    clearInterval(interval);
-    pin.write(false);
-    callback();
-  }, duration);
+  // Paced, so a late toggle does not shift the phase of the ones after it.
+  const interval = setInterval(toggle, halfPeriodMs, { policy: "skip" });
+  await sleep(duration);
+  clearInterval(interval);
+  pin.write(false);
 }
 
-function playContinuously(pinNum) {
+async function playContinuously(pinNum) {
   console.log(`--- Starting Continuous Melody Player on GPIO ${pinNum} ---`);
   const buzzer = gpio.setup(pinNum, { mode: "output" });
-  let playlistIndex = 0;
 
-  const playNextMelody = () => {
-    if (playlistIndex >= playlist.length) {
-      playlistIndex = 0;
-    }
-    const currentSong = playlist[playlistIndex];
-    console.log(`Now playing: ${currentSong.name}`);
-    let noteIndex = 0;
-
-    const playNextNote = () => {
-      if (noteIndex >= currentSong.melody.length) {
-        console.log("Melody finished. Pausing before next song...");
-        setTimeout(() => {
-          playlistIndex++;
-          playNextMelody();
-        }, 1500);
-        return;
+  for (;;) {
+    for (const song of playlist) {
+      console.log(`Now playing: ${song.name}`);
+      for (const [noteName, baseDuration] of song.melody) {
+        await playNote(buzzer, NOTES[noteName], baseDuration * TEMPO_MULTIPLIER);
       }
-      const [noteName, baseDuration] = currentSong.melody[noteIndex];
-      const duration = baseDuration * TEMPO_MULTIPLIER;
-      const freq = NOTES[noteName];
-      noteIndex++;
-      playNote(buzzer, freq, duration, playNextNote);
-    };
-    playNextNote();
-  };
-  playNextMelody();
+      console.log("Melody finished. Pausing before next song...");
+      await sleep(1500);
+    }
+  }
 }
 
 playContinuously(BUZZER_PIN);
@@ -0,0 +1,30 @@
+// Keeps a fast control loop in main.js while a worker on core 0 summarises its samples.
+// Flash tests/telemetry-worker.js alongside this file.
+import { spawn } from "worker";
+import { setInterval } from "timers";
+const BATCH_SIZE = 50;
+
+const telemetry = spawn("telemetry-worker.js", { heapKB: 32, queueDepth: 4 });
+telemetry.onMessage((report) => {
+  console.log(`telemetry: ${report.count} samples, mean ${report.mean.toFixed(2)}, max ${report.max}`);
+});
+
+let batch = new Float32Array(BATCH_SIZE);
+let filled = 0;
+let dropped = 0;
+
+setInterval(() => {
+  // Stand-in for reading a sensor and driving an actuator.
+  const sample = 20 + Math.sin(Date.now() / 1000) * 5;
+  batch[filled++] = sample;
+
+  if (filled === BATCH_SIZE) {
+    if (!telemetry.postMessage(batch)) {
+      dropped++; // The worker is behind; control must not wait for it
+    }
+    batch = new Float32Array(BATCH_SIZE);
+    filled = 0;
+  }
+}, 2);
+
+setInterval(() => console.log(`control: ${dropped} batches dropped`), 10000);
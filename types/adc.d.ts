@@ -0,0 +1,96 @@
+/**
+ * @module adc
+ * @description A module for reading analog voltages, either one conversion at
+ * a time or as a continuous DMA stream that is reduced natively and delivered
+ * in blocks.
+ */
+
+declare module "adc" {
+  /**
+   * Input attenuation. Higher attenuation widens the measurable voltage range
+   * (roughly 0-950mV at "0db" up to 0-3100mV at "12db").
+   */
+  export type Attenuation = "0db" | "2.5db" | "6db" | "12db";
+
+  /**
+   * How each group of `decimation` raw samples is reduced to one output sample.
+   */
+  export type ReduceMode = "average" | "min" | "max" | "decimate";
+
+  /**
+   * Configuration object for a one-shot analog pin.
+   */
+  export interface AnalogConfig {
+    /** Defaults to "12db". */
+    attenuation?: Attenuation;
+  }
+
+  /**
+   * Configuration object for continuous sampling.
+   */
+  export interface StreamConfig {
+    /**
+     * Hardware conversion rate in Hz. Defaults to 20000. Values outside the
+     * chip's supported range (20kHz-2MHz on the ESP32) are clamped; use
+     * `decimation` to get lower output rates.
+     */
+    sampleRate?: number;
+    /** Raw samples reduced into each output sample. Defaults to 20. */
+    decimation?: number;
+    /** Defaults to "average". */
+    reduce?: ReduceMode;
+    /** Output samples delivered per callback. Defaults to 64. */
+    blockSize?: number;
+    /** Defaults to "12db". */
+    attenuation?: Attenuation;
+  }
+
+  /**
+   * Represents a pin configured for one-shot analog reads.
+   */
+  export interface AnalogPin {
+    /** The GPIO pin number. */
+    readonly pin: number;
+
+    /**
+     * Performs a conversion.
+     * @returns {number} The raw reading (0-4095 at 12-bit resolution).
+     */
+    read(): number;
+
+    /**
+     * Performs a conversion and applies the chip's factory calibration.
+     * @returns {number} The voltage in millivolts.
+     * @throws {Error} If no calibration scheme is available.
+     */
+    readVoltage(): number;
+
+    /**
+     * Releases the pin.
+     */
+    close(): void;
+  }
+
+  /**
+   * Configures a pin for one-shot analog reads.
+   */
+  export function setup(pin: number, config?: AnalogConfig): AnalogPin;
+
+  /**
+   * Starts sampling a pin continuously via DMA. The callback receives each
+   * block of reduced samples as raw readings. Only one stream can run at a
+   * time, and on the ESP32 it must use an ADC1 pin (GPIO 32-39).
+   */
+  export function startStream(pin: number, config: StreamConfig, callback: (samples: Uint16Array) => void): void;
+
+  /**
+   * Stops the running stream, if any.
+   */
+  export function stopStream(): void;
+
+  /**
+   * Returns how many times samples were dropped because the callback could
+   * not keep up with the DMA engine, since the stream started.
+   */
+  export function streamOverruns(): number;
+}
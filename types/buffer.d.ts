@@ -0,0 +1,132 @@
+/**
+ * @module buffer
+ * @description Byte work done natively: checksums, hex and base64, and
+ * struct layouts for building and parsing protocol frames. Every function
+ * reads and writes the bytes of ArrayBuffers and typed arrays in place,
+ * so a frame can be assembled without building JS strings or arrays of
+ * numbers along the way. Available to workers.
+ */
+
+declare module "buffer" {
+  /** Bytes to read: an ArrayBuffer, or the bytes a typed array or DataView covers. */
+  export type Bytes = ArrayBuffer | ArrayBufferView;
+
+  /**
+   * CRC-8, polynomial 0x07 (CRC-8/SMBUS).
+   * @param previous The CRC of the preceding bytes, to checksum a frame in parts. Default 0.
+   */
+  export function crc8(data: Bytes, previous?: number): number;
+
+  /**
+   * CRC-16/CCITT-FALSE: polynomial 0x1021, starting at 0xFFFF.
+   * @param previous The CRC of the preceding bytes. Default 0xFFFF.
+   */
+  export function crc16(data: Bytes, previous?: number): number;
+
+  /**
+   * CRC-16/MODBUS: polynomial 0x8005 reflected, starting at 0xFFFF. Append
+   * it to a Modbus RTU frame low byte first.
+   * @param previous The CRC of the preceding bytes. Default 0xFFFF.
+   */
+  export function crc16modbus(data: Bytes, previous?: number): number;
+
+  /**
+   * The CRC-32 of zlib, PNG and Ethernet.
+   * @param previous The CRC of the preceding bytes. Default 0.
+   */
+  export function crc32(data: Bytes, previous?: number): number;
+
+  /**
+   * Encodes bytes as lowercase hex. With a target, writes the ASCII digits
+   * into it and returns how many bytes were written.
+   * @throws {RangeError} If the target is too small.
+   */
+  export function toHex(data: Bytes): string;
+  export function toHex(data: Bytes, target: Bytes): number;
+
+  /**
+   * Decodes hex digits of either case, from a string or ASCII bytes. With a
+   * target, writes the bytes into it (which may be the source itself) and
+   * returns how many were written.
+   * @throws {TypeError} On an odd length or a character that is not a hex digit.
+   * @throws {RangeError} If the target is too small.
+   */
+  export function fromHex(text: string | Bytes): Uint8Array;
+  export function fromHex(text: string | Bytes, target: Bytes): number;
+
+  /**
+   * Encodes bytes as padded base64. With a target, writes the ASCII
+   * characters into it and returns how many were written.
+   * @throws {RangeError} If the target is too small.
+   */
+  export function toBase64(data: Bytes): string;
+  export function toBase64(data: Bytes, target: Bytes): number;
+
+  /**
+   * Decodes base64, padded or not, standard or URL-safe alphabet; whitespace
+   * is skipped. With a target, writes the bytes into it (which may be the
+   * source itself) and returns how many were written.
+   * @throws {TypeError} On a character outside the alphabet, or misplaced or
+   * incomplete padding.
+   * @throws {RangeError} If the target is too small.
+   */
+  export function fromBase64(text: string | Bytes): Uint8Array;
+  export function fromBase64(text: string | Bytes, target: Bytes): number;
+
+  /** A field value: a number, or the bytes of an `s` field. */
+  export type FieldValue = number | boolean | string | Bytes;
+
+  export interface Layout {
+    /** Bytes one struct takes. */
+    readonly size: number;
+    /** Fields, not counting padding. */
+    readonly count: number;
+    /** The names given to layout(), if any. */
+    readonly names?: string[];
+
+    /**
+     * Packs field values, in order or keyed by name, into a new Uint8Array.
+     * Integers wrap like typed array elements; `s` fields are zero-padded
+     * or cut to their size.
+     */
+    pack(values: FieldValue[] | Record<string, FieldValue>): Uint8Array;
+    /**
+     * Packs into `target` at `offset` and returns the offset just past the
+     * struct, so consecutive structs can be written in a row.
+     * @throws {RangeError} If the struct does not fit.
+     */
+    pack(values: FieldValue[] | Record<string, FieldValue>, target: Bytes, offset?: number): number;
+
+    /**
+     * Reads one struct at `offset`. Returns the values in order, or keyed by
+     * name when the layout has names. `s` fields are copied into new
+     * Uint8Arrays.
+     * @throws {RangeError} If the struct does not fit.
+     */
+    unpack(source: Bytes, offset?: number): any;
+  }
+
+  /**
+   * Compiles a struct layout, in the format notation of Python's `struct`
+   * module, into a native field table. Compile it once and reuse it.
+   *
+   * The first character may set the byte order: `<` little-endian (the
+   * default) or `>`/`!` big-endian. Field codes, each optionally preceded by
+   * a repeat count: `x` pad byte, `b`/`B` int8/uint8, `?` bool, `h`/`H`
+   * int16/uint16, `i`/`I` (or `l`/`L`) int32/uint32, `q`/`Q` int64/uint64
+   * (read as numbers, so exact up to 2^53), `f` float32, `d` float64. `Ns`
+   * is a single field of N bytes. There is no alignment padding.
+   *
+   * @param names One name per field, for packing from and unpacking to objects.
+   * @throws {TypeError} On an unknown code, or a name count that does not match.
+   * @throws {RangeError} Past 64 fields or 65535 bytes.
+   * @example
+   *   const header = layout(">BBHI", ["type", "flags", "length", "seq"]);
+   *   const frame = new Uint8Array(header.size + payload.length + 4);
+   *   let end = header.pack({ type: 1, flags: 0, length: payload.length, seq }, frame);
+   *   frame.set(payload, end);
+   *   end += payload.length;
+   *   new DataView(frame.buffer).setUint32(end, crc32(frame.subarray(0, end)));
+   */
+  export function layout(format: string, names?: string[]): Layout;
+}
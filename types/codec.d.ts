@@ -0,0 +1,81 @@
+/**
+ * @module codec
+ * @description CBOR and compact JSON written straight into ArrayBuffers.
+ * Unlike JSON.stringify, encoding builds no intermediate strings on the JS
+ * heap: a telemetry message goes from object to bytes in a buffer the
+ * caller reuses. Decoding reads from bytes, so a received frame does not
+ * have to become a string first. Available to workers.
+ *
+ * Values may be undefined, null, booleans, numbers, strings, ArrayBuffers,
+ * typed arrays, arrays and plain objects, nested up to 16 deep. JSON
+ * follows JSON.stringify: undefined properties are left out, and undefined
+ * array elements, NaN and Infinity become null. Typed arrays become arrays
+ * of numbers in JSON, and RFC 8746 tagged arrays in CBOR.
+ */
+
+declare module "codec" {
+  /** Bytes to read or write: an ArrayBuffer, or the bytes a typed array or DataView covers. */
+  export type Bytes = ArrayBuffer | ArrayBufferView;
+
+  /**
+   * Encodes a value as CBOR (RFC 8949). Integers take the shortest form and
+   * other numbers float32 when that is exact, else float64. Without a
+   * target, returns a new ArrayBuffer of exactly the encoded size; with
+   * one, writes into it and returns the number of bytes written.
+   * @throws {RangeError} If the target is too small or the value is nested too deeply.
+   * @throws {TypeError} For functions and symbols.
+   */
+  export function encodeCbor(value: unknown): ArrayBuffer;
+  export function encodeCbor(value: unknown, target: Bytes): number;
+
+  /**
+   * Encodes a value as UTF-8 JSON without whitespace, as JSON.stringify
+   * would print it. Returns a new ArrayBuffer, or the bytes written into `target`.
+   * @throws {RangeError} If the target is too small or the value is nested too deeply.
+   */
+  export function encodeJson(value: unknown): ArrayBuffer;
+  export function encodeJson(value: unknown, target: Bytes): number;
+
+  /**
+   * Decodes one CBOR item, which must fill `source`. Byte strings become
+   * ArrayBuffers and typed array tags typed arrays; other tags are dropped.
+   * Map keys must be strings or integers.
+   * @throws {SyntaxError} If the input is malformed, has trailing bytes or
+   *   holds a text string that is not valid UTF-8.
+   */
+  export function decodeCbor(source: Bytes): unknown;
+
+  /**
+   * Decodes UTF-8 JSON, which must fill `source` apart from whitespace.
+   * @throws {SyntaxError} If the input is malformed or not valid UTF-8.
+   */
+  export function decodeJson(source: Bytes): unknown;
+
+  /**
+   * The keys of an object of known shape, compiled once.
+   *
+   * Encoding writes exactly these keys, in this order, copying each key
+   * pre-encoded instead of listing the object's keys; missing properties
+   * are left out of JSON and written as undefined in CBOR. Decoding reuses
+   * the schema's key strings for keys it lists instead of creating new
+   * ones, and decodes any other keys as usual.
+   */
+  export interface Schema {
+    /** The schema's keys; treat as read-only. */
+    readonly keys: string[];
+    /** @throws {TypeError} Unless `object` is a plain object. */
+    encodeCbor(object: object): ArrayBuffer;
+    encodeCbor(object: object, target: Bytes): number;
+    encodeJson(object: object): ArrayBuffer;
+    encodeJson(object: object, target: Bytes): number;
+    decodeCbor(source: Bytes): unknown;
+    decodeJson(source: Bytes): unknown;
+  }
+
+  /**
+   * Compiles a schema from up to 64 keys of up to 255 bytes each.
+   * @throws {TypeError} If a key is not a string.
+   * @throws {RangeError} If there are too many keys or one is too long.
+   */
+  export function schema(keys: string[]): Schema;
+}
@@ -0,0 +1,105 @@
+/**
+ * @module dsp
+ * @description Signal processing done natively on Float32Arrays: stateful
+ * filters that carry their history from one block of samples to the next,
+ * block statistics, peak detection and a radix-2 FFT. Blocks are processed
+ * in place, so a sampling loop can reuse the same arrays without
+ * allocating. Builds with "Use ESP-DSP kernels" run the IIR filters and
+ * FFTs on Espressif's optimised kernels. Available to workers.
+ */
+
+declare module "dsp" {
+  /** A filter with its own state; each sample depends on the ones before it. */
+  export interface Filter {
+    /** Filters one sample and returns the output. */
+    process(sample: number): number;
+    /**
+     * Filters a block of samples, into `output` if given and otherwise in
+     * place, and returns the array written.
+     * @throws {RangeError} If `output` is shorter than `input`.
+     */
+    process(input: Float32Array, output?: Float32Array): Float32Array;
+    /** Forgets every sample seen so far. */
+    reset(): void;
+  }
+
+  /**
+   * A cascade of up to 8 biquad sections. Each section is five coefficients
+   * `b0, b1, b2, a1, a2` with a0 normalised to 1, given flat or as one array
+   * per section.
+   * @throws {TypeError} If a section does not have five coefficients.
+   * @throws {RangeError} If there are more than 8 sections.
+   */
+  export function iir(sections: ArrayLike<number> | ArrayLike<number>[]): Filter;
+
+  /**
+   * Designs one biquad section from the Audio EQ Cookbook, ready for iir().
+   * @param q Quality factor. Default 0.7071 (Butterworth).
+   * @throws {RangeError} For an unknown type or a cutoff not below half the sample rate.
+   */
+  export function biquad(
+    type: "lowpass" | "highpass" | "bandpass" | "notch",
+    cutoff: number,
+    sampleRate: number,
+    q?: number
+  ): number[];
+
+  /**
+   * A FIR filter of up to 256 taps; `coefficients[0]` weighs the newest sample.
+   */
+  export function fir(coefficients: ArrayLike<number>): Filter;
+
+  /**
+   * The mean of the last `window` samples (1 to 1024), or of all of them
+   * until that many have been seen.
+   */
+  export function movingAverage(window: number): Filter;
+
+  /**
+   * The median of the last `window` samples (1 to 1024), or of all of them
+   * until that many have been seen. Removes spikes that a moving average
+   * would smear.
+   */
+  export function median(window: number): Filter;
+
+  export interface Stats {
+    min: number;
+    max: number;
+    minIndex: number;
+    maxIndex: number;
+    mean: number;
+    rms: number;
+    /** Population standard deviation. */
+    std: number;
+  }
+
+  /** Computes the statistics of a block in one pass. */
+  export function stats(samples: Float32Array): Stats;
+
+  /**
+   * Finds the indices of local maxima above `threshold`, at least
+   * `minDistance` samples apart; of two closer peaks the higher is kept.
+   * Returns at most 64 peaks.
+   */
+  export function peaks(samples: Float32Array, threshold?: number, minDistance?: number): number[];
+
+  /**
+   * In-place complex FFT. Both arrays must have the same power-of-two
+   * length, up to 4096. The output is in natural order.
+   */
+  export function fft(re: Float32Array, im: Float32Array): void;
+
+  export interface SpectrumOptions {
+    /** Window applied before the FFT. Default "hann". */
+    window?: "hann" | "none";
+    /** Receives the bins instead of a new array. */
+    output?: Float32Array;
+  }
+
+  /**
+   * The amplitude spectrum of a power-of-two number of real samples, up to
+   * 4096: n / 2 bins, bin k being the amplitude at k * sampleRate / n. A
+   * sine of amplitude A reads A in its bin.
+   */
+  export function spectrum(samples: Float32Array, options?: SpectrumOptions): Float32Array;
+}
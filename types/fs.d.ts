@@ -0,0 +1,106 @@
+/**
+ * @module fs
+ * @description Promise-based file access on the storage partition. Every
+ * call runs on a background I/O task, in the order it was made, so flash
+ * latency never blocks the JS thread. Paths are relative to the script
+ * directory ("/storage" on the device); a leading "/" is ignored. Only
+ * available to the main context.
+ */
+
+declare module "fs" {
+  /** Data that can be written. Strings are written as UTF-8. */
+  export type Writable = string | ArrayBuffer | ArrayBufferView;
+
+  export interface Stats {
+    size: number;
+    isDirectory: boolean;
+    /** Last modification time in milliseconds since the epoch. */
+    mtimeMs: number;
+  }
+
+  /**
+   * Reads a whole file.
+   * @param encoding "utf8" (or `{ encoding: "utf8" }`) to get a string.
+   * @returns {Promise} Resolves with the contents; rejects if the file cannot be read.
+   * @throws {RangeError} If the path is longer than the 64-byte limit or 8 requests are queued.
+   */
+  export function readFile(path: string): Promise<ArrayBuffer>;
+  export function readFile(path: string, encoding: "utf8" | { encoding: "utf8" }): Promise<string>;
+
+  /** Replaces a file's contents, creating it if needed. The data is copied first. */
+  export function writeFile(path: string, data: Writable): Promise<void>;
+
+  /** Appends to a file, creating it if needed. The data is copied first. */
+  export function append(path: string, data: Writable): Promise<void>;
+
+  export function stat(path: string): Promise<Stats>;
+
+  /**
+   * Lists the names in a directory.
+   * @param path Defaults to the script directory.
+   */
+  export function readdir(path?: string): Promise<string[]>;
+
+  /**
+   * A file open for chunked reads. Reads and close() run in the order they
+   * were made. The file is closed when the reader is garbage collected.
+   */
+  export interface Reader {
+    readonly path: string;
+    /**
+     * Reads into `buffer`, which must not be resized or detached until the
+     * promise settles. Reusing one buffer per stream avoids an allocation
+     * per chunk.
+     * @param position Byte offset to read from; by default reading continues where the last read ended.
+     * @returns {Promise} Resolves with the number of bytes read, 0 at the end of the file.
+     */
+    read(buffer: ArrayBuffer | ArrayBufferView, position?: number): Promise<number>;
+    close(): Promise<void>;
+  }
+
+  /** Opens a file for chunked reads. */
+  export function open(path: string): Promise<Reader>;
+
+  export interface LogOptions {
+    /** RAM buffered before an append, 64 to 16384 bytes. Default 1024. */
+    bufferSize?: number;
+    /** Longest a write waits in RAM before it is appended. Default 1000. */
+    flushMs?: number;
+  }
+
+  export interface LogStats {
+    /** Bytes waiting in RAM. */
+    buffered: number;
+    /** Bytes appended to the file so far. */
+    written: number;
+    /** Bytes refused by write() because the buffer was full during a flush. */
+    dropped: number;
+    flushes: number;
+  }
+
+  /**
+   * An append-only log. Writes are buffered in RAM and appended as one
+   * write when the buffer fills or `flushMs` after the first buffered write.
+   * The log is closed when it is garbage collected.
+   */
+  export interface Log {
+    readonly path: string;
+    /**
+     * Buffers data without blocking.
+     * @returns false if it was dropped because the buffer is full while the previous flush is still being written.
+     * @throws {RangeError} If the data is larger than the buffer.
+     */
+    write(data: Writable): boolean;
+    /** Appends what is buffered now. Resolves once it is in the file. */
+    flush(): Promise<void>;
+    /** Flushes and closes the log; later writes throw. */
+    close(): Promise<void>;
+    stats(): LogStats;
+  }
+
+  /**
+   * Opens an append-only log on `path`.
+   * @throws {RangeError} If 2 logs are already open, or an option is out of range.
+   */
+  export function createLog(path: string, options?: LogOptions): Log;
+}
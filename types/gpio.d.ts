@@ -93,4 +93,49 @@ declare module "gpio" {
    */
   export function setup(pin: number, config: PinConfig): Pin;
   export function setup(pins: number[], config: PinConfig): Pin[];
+
+  /**
+   * A histogram of latency samples in microseconds. Bucket `i` counts samples
+   * in [2^i, 2^(i+1)); the last bucket also holds everything larger.
+   */
+  export interface LatencyHistogram {
+    count: number;
+    minUs: number;
+    meanUs: number;
+    maxUs: number;
+    /** Upper bound of the bucket holding the median. */
+    p50Us: number;
+    /** Upper bound of the bucket holding the 99th percentile. */
+    p99Us: number;
+    buckets: number[];
+  }
+
+  /**
+   * Latency of a pin's interrupts, measured from entry to the GPIO ISR.
+   */
+  export interface PinLatency {
+    /** Time until the event loop picked up the event. */
+    dispatch: LatencyHistogram;
+    /** Time until the JS callback returned. */
+    callback: LatencyHistogram;
+  }
+
+  /**
+   * Returns the latency histograms for a pin, or undefined if none of its
+   * interrupts have been handled yet.
+   * @note Only available when built with CONFIG_JS_LATENCY_TRACE.
+   */
+  export function latency(pin: number): PinLatency | undefined;
+
+  /**
+   * Clears the latency histograms of a pin, or of every pin if none is given.
+   * @note Only available when built with CONFIG_JS_LATENCY_TRACE.
+   */
+  export function resetLatency(pin?: number): void;
+
+  /**
+   * Logs every latency sample as it is recorded.
+   * @note Only available when built with CONFIG_JS_LATENCY_TRACE.
+   */
+  export function logLatency(enabled: boolean): void;
 }
@@ -0,0 +1,82 @@
+/**
+ * @module i2c
+ * @description A module for talking to I2C devices. Transfers run on a
+ * dedicated worker task per bus and return Promises, so a slow or
+ * clock-stretching device never blocks the event loop.
+ */
+
+declare module "i2c" {
+  /**
+   * Bytes to write: a Uint8Array, an ArrayBuffer or an array of byte values.
+   */
+  export type Bytes = Uint8Array | ArrayBuffer | number[];
+
+  /**
+   * Configuration object for opening a bus.
+   */
+  export interface BusConfig {
+    /** The I2C controller to use, 0 or 1. Defaults to 0. */
+    port?: number;
+    /** The GPIO pin used for SDA. */
+    sda: number;
+    /** The GPIO pin used for SCL. */
+    scl: number;
+    /** Clock frequency in Hz. Defaults to 100000. */
+    frequency?: number;
+    /** Timeout for each operation in milliseconds. Defaults to 50. */
+    timeout?: number;
+  }
+
+  /**
+   * One step of a transaction. An operation with both `write` and `read`
+   * writes then reads with a repeated start, as register reads require.
+   */
+  export interface Operation {
+    address: number;
+    write?: Bytes;
+    /** Number of bytes to read. */
+    read?: number;
+  }
+
+  /**
+   * Represents an open bus.
+   */
+  export interface Bus {
+    /** The I2C controller this bus uses. */
+    readonly port: number;
+
+    /**
+     * Writes bytes to a device.
+     */
+    write(address: number, data: Bytes): Promise<void>;
+
+    /**
+     * Reads bytes from a device.
+     */
+    read(address: number, length: number): Promise<Uint8Array>;
+
+    /**
+     * Writes bytes, typically a register number, then reads the reply.
+     */
+    writeRead(address: number, data: Bytes, length: number): Promise<Uint8Array>;
+
+    /**
+     * Runs several operations back to back on the worker task with a single
+     * round-trip to the event loop. Stops at the first failing operation and
+     * rejects. Resolves with one entry per operation: the bytes read, or
+     * `undefined` for write-only operations.
+     */
+    transaction(ops: Operation[]): Promise<(Uint8Array | undefined)[]>;
+
+    /**
+     * Closes the bus. Transfers already started still settle.
+     */
+    close(): void;
+  }
+
+  /**
+   * Opens a bus.
+   * @throws {Error} If the port is invalid or already open.
+   */
+  export function open(config: BusConfig): Bus;
+}
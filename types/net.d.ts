@@ -0,0 +1,99 @@
+/**
+ * @module net
+ * @description Non-blocking TCP and UDP sockets over lwIP, or the host's
+ * sockets in the host build. One I/O task waits on every socket at once and
+ * wakes the event loop when one is ready; received bytes are read straight
+ * into the Uint8Arrays the callbacks get, up to 8 KiB at a time. IPv4 only,
+ * at most 6 sockets open, and main context only.
+ *
+ * Without Wi-Fi or Ethernet up, only 127.0.0.1 is reachable, which is
+ * enough to test a protocol against itself.
+ */
+
+declare module "net" {
+  /** Bytes to send. Strings are sent as UTF-8. */
+  export type Data = string | ArrayBuffer | ArrayBufferView;
+
+  export interface Options {
+    /**
+     * An IPv4 address, "localhost" or a host name. Names are looked up with
+     * a DNS query that blocks the event loop until it is answered. Defaults
+     * to "localhost" for `connect` and every interface otherwise.
+     */
+    host?: string;
+    /** Required for `connect`. 0, the default elsewhere, picks a free port. */
+    port?: number;
+    /** For `listen`: connections waiting to be accepted, 1-6. Defaults to 4. */
+    backlog?: number;
+  }
+
+  /**
+   * A connected TCP socket.
+   */
+  export interface Socket {
+    readonly remoteAddress: string;
+    readonly remotePort: number;
+
+    /**
+     * Sends data without blocking.
+     * @returns {number} How many bytes were accepted. Fewer than given means
+     * the send buffer is full: wait for `drain()` and write the rest.
+     * @throws {Error} If the connection was reset.
+     */
+    write(data: Data): number;
+
+    /**
+     * Resolves once the send buffer has room again after a short write.
+     * Already resolved if the last write was accepted in full.
+     */
+    drain(): Promise<void>;
+
+    /**
+     * Sets the callback for received bytes; null means the peer closed the
+     * connection, after which the socket is closed. Nothing is read until a
+     * callback is set, so the peer waits rather than filling the heap.
+     */
+    onData(callback: (data: Uint8Array | null) => void): void;
+
+    close(): void;
+  }
+
+  export interface Listener {
+    /** The port listened on, useful after asking for port 0. */
+    readonly port: number;
+    close(): void;
+  }
+
+  export interface UdpSocket {
+    /** The port bound, useful after asking for port 0. */
+    readonly port: number;
+
+    /**
+     * Sends one datagram without blocking.
+     * @returns {boolean} false if the datagram was dropped because the send buffer was full.
+     */
+    send(data: Data, host: string, port: number): boolean;
+
+    close(): void;
+  }
+
+  /**
+   * Connects to a TCP server. `onData` may be given here or later with `socket.onData`.
+   * @returns A promise for the socket, rejected if the host is not found or
+   * the connection is refused.
+   */
+  export function connect(options: Options, onData?: (data: Uint8Array | null) => void): Promise<Socket>;
+
+  /**
+   * Listens for TCP connections. Each accepted socket is passed to the callback.
+   * @throws {Error} If the address is in use or every socket is taken.
+   */
+  export function listen(options: Options, onConnection: (socket: Socket) => void): Listener;
+
+  /**
+   * Binds a UDP socket. Datagrams of up to 1472 bytes are passed to the
+   * callback with their sender.
+   * @throws {Error} If the address is in use or every socket is taken.
+   */
+  export function udp(options: Options, onMessage: (data: Uint8Array, from: { address: string; port: number }) => void): UdpSocket;
+}
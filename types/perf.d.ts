@@ -0,0 +1,112 @@
+/**
+ * @module perf
+ * @description Timing and heap helpers for measuring the runtime, used by the
+ * benchmark suite in bench/.
+ */
+
+declare module "perf" {
+  /**
+   * JavaScript heap usage, from the engine's allocator.
+   */
+  export interface HeapStats {
+    /** Total heap size in bytes. */
+    size: number;
+    /** Bytes currently allocated. */
+    allocated: number;
+    /** Most bytes ever allocated at once. */
+    peak: number;
+    /** Where the heap lives: "internal" RAM or "psram". */
+    placement: "internal" | "psram";
+  }
+
+  /**
+   * Timing of one read and parse of a file module.
+   */
+  export interface ParseResult {
+    /** Size of the source in bytes. */
+    bytes: number;
+    /** Microseconds spent reading the file. */
+    readUs: number;
+    /** Microseconds spent parsing it. */
+    parseUs: number;
+  }
+
+  /**
+   * How long it took to get scripts off the filesystem.
+   */
+  export interface BootStats {
+    /** "SPIFFS" or "LittleFS" on a device, "host" on the host build. */
+    filesystem: string;
+    /** Microseconds spent mounting the storage partition. */
+    mountUs: number;
+    /** Module files read so far, including through parseModule(). */
+    filesRead: number;
+    bytesRead: number;
+    /** Microseconds spent reading them. */
+    readUs: number;
+  }
+
+  export interface PowerStats {
+    /** Microseconds this context has spent running callbacks, promise jobs and immediates. */
+    activeUs: number;
+    /** Microseconds it has spent waiting for events. */
+    idleUs: number;
+    /**
+     * Microseconds the whole chip has spent in light sleep. Always 0 unless
+     * the firmware is built with CONFIG_JS_POWER_SAVE.
+     */
+    sleepUs: number;
+    /** Light sleeps the chip has entered. */
+    lightSleeps: number;
+    /** Waits for events that an event ended. */
+    wakeups: number;
+  }
+
+  /**
+   * Returns microseconds since boot, with the resolution of the system timer.
+   */
+  export function now(): number;
+
+  /**
+   * Returns the JavaScript heap usage, or undefined if the engine was built
+   * without memory statistics.
+   */
+  export function heap(): HeapStats | undefined;
+
+  /**
+   * Runs a full garbage collection.
+   */
+  export function gc(): void;
+
+  /**
+   * Creates, links and evaluates a fresh instance of a native module, as an
+   * `import` of it does.
+   * @param name The module name, e.g. "gpio".
+   * @returns {number} Microseconds taken.
+   */
+  export function importNative(name: string): number;
+
+  /**
+   * Reads and parses a module from the script directory without running it.
+   * @param path The path within the script directory, e.g. "main.js".
+   */
+  export function parseModule(path: string): ParseResult;
+
+  /**
+   * Returns the filesystem and module read timings, for comparing the
+   * script filesystems.
+   */
+  export function boot(): BootStats;
+
+  /**
+   * Returns the split between running and waiting of the calling context,
+   * and the time the chip spent in light sleep.
+   */
+  export function power(): PowerStats;
+
+  /**
+   * Ends the process with the given status on the host build. Does nothing
+   * on a device.
+   */
+  export function exit(code?: number): void;
+}
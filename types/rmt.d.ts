@@ -0,0 +1,148 @@
+/**
+ * @module rmt
+ * @description A module for capturing and generating pulse trains with the
+ * RMT (Remote Control Transceiver) peripheral. Whole frames are handed between
+ * JavaScript and the hardware as typed arrays, so protocols such as IR remotes,
+ * WS2812 LEDs and DHT22 sensors cost one callback per frame instead of one per edge.
+ *
+ * Symbols are 32-bit words in the hardware layout:
+ * bits 0-14 `duration0`, bit 15 `level0`, bits 16-30 `duration1`, bit 31 `level1`.
+ * Durations are in channel ticks (see `resolution`).
+ */
+
+declare module "rmt" {
+  /**
+   * Configuration object for a transmit channel.
+   */
+  export interface TransmitterConfig {
+    /** Tick frequency in Hz. Defaults to 1000000 (1 tick = 1us). Use 10000000 for WS2812. */
+    resolution?: number;
+    /** Size of the channel's symbol memory. Defaults to 64; larger values borrow neighbouring channels. */
+    memSymbols?: number;
+    /** Carrier frequency in Hz (e.g. 38000 for IR). Omit to disable modulation. */
+    carrier?: number;
+    /** Drive the pin open-drain with loopback so a receiver can share it (e.g. DHT22). */
+    openDrain?: boolean;
+    /** Stream symbols via DMA on targets that support it. Ignored elsewhere. */
+    dma?: boolean;
+  }
+
+  /**
+   * Configuration object for a receive channel.
+   */
+  export interface ReceiverConfig {
+    /** Tick frequency in Hz. Defaults to 1000000 (1 tick = 1us). */
+    resolution?: number;
+    /** Largest frame, in symbols, that can be captured. Defaults to 64. */
+    maxSymbols?: number;
+    /** Pulses shorter than this are filtered out as glitches. Defaults to 1250. */
+    minPulseNs?: number;
+    /** A level held longer than this ends the frame. Defaults to 12000000. */
+    maxPulseNs?: number;
+  }
+
+  /**
+   * A channel opened for transmitting.
+   */
+  export interface Transmitter {
+    /** The GPIO pin number. */
+    readonly pin: number;
+    /** The tick frequency in Hz. */
+    readonly resolution: number;
+
+    /**
+     * Transmits prebuilt symbols. The array is handed to the hardware without
+     * copying, so it must not be modified until the returned promise resolves.
+     * @throws {RangeError} If four transmissions are already in flight.
+     */
+    send(symbols: Uint32Array): Promise<void>;
+
+    /**
+     * Transmits pixel data to a WS2812 strip, 3 bytes per pixel in GRB order.
+     * The bits are encoded natively; the array is not copied.
+     */
+    sendWS2812(pixels: Uint8Array): Promise<void>;
+
+    /**
+     * Encodes and transmits a NEC infrared frame.
+     * @param {number} address 8-bit address, or a 16-bit extended address.
+     * @param {number} command 8-bit command.
+     */
+    sendNEC(address: number, command: number): Promise<void>;
+
+    /**
+     * Releases the channel. Pending transmissions are completed first.
+     */
+    close(): void;
+  }
+
+  /**
+   * A channel opened for receiving.
+   */
+  export interface Receiver {
+    /** The GPIO pin number. */
+    readonly pin: number;
+    /** The tick frequency in Hz. */
+    readonly resolution: number;
+
+    /**
+     * Starts capturing frames continuously. The callback receives each frame
+     * as a newly allocated array of symbols.
+     */
+    start(callback: (symbols: Uint32Array) => void): void;
+
+    /**
+     * Stops delivering frames.
+     */
+    stop(): void;
+
+    /**
+     * Releases the channel.
+     */
+    close(): void;
+  }
+
+  /**
+   * A decoded NEC infrared frame.
+   */
+  export interface NecFrame {
+    address: number;
+    command: number;
+    /** True for the repeat code sent while a button is held; address and command are then 0. */
+    repeat: boolean;
+  }
+
+  /**
+   * A decoded DHT22 reading.
+   */
+  export interface Dht22Reading {
+    /** Relative humidity in percent. */
+    humidity: number;
+    /** Temperature in degrees Celsius. */
+    temperature: number;
+  }
+
+  /**
+   * Opens a transmit channel on a pin.
+   */
+  export function transmitter(pin: number, config?: TransmitterConfig): Transmitter;
+
+  /**
+   * Opens a receive channel on a pin.
+   */
+  export function receiver(pin: number, config?: ReceiverConfig): Receiver;
+
+  /**
+   * Decodes a captured NEC frame.
+   * @param {number} resolution The receiver's tick frequency. Defaults to 1000000.
+   * @returns {NecFrame | null} The frame, or null if the symbols are not valid NEC.
+   */
+  export function decodeNEC(symbols: Uint32Array, resolution?: number): NecFrame | null;
+
+  /**
+   * Decodes a captured DHT22 response. The host start pulse may be included in the capture.
+   * @param {number} resolution The receiver's tick frequency. Defaults to 1000000.
+   * @returns {Dht22Reading | null} The reading, or null if the frame or checksum is invalid.
+   */
+  export function decodeDHT22(symbols: Uint32Array, resolution?: number): Dht22Reading | null;
+}
@@ -0,0 +1,61 @@
+/**
+ * @module runtime
+ * @description Access to the runtime itself. Native operations registered
+ * from C with js_offload_register() can be run on worker tasks pinned to
+ * core 0, leaving the JS thread on core 1 free to handle events.
+ */
+
+declare module "runtime" {
+  /**
+   * Input for an offloaded operation. Buffers are read in place, so they
+   * must not be modified until the returned Promise settles; strings are
+   * copied as UTF-8.
+   */
+  export type OffloadData = ArrayBuffer | ArrayBufferView | string;
+
+  /**
+   * Runs a registered native operation on a worker task.
+   *
+   * Built-in operations:
+   * - `"crc32"`: resolves with the IEEE 802.3 CRC-32 of `data`.
+   * - `"hex"`: resolves with `data` formatted as a lowercase hex string.
+   *
+   * @param name The registered operation name.
+   * @param data The bytes the operation works on.
+   * @param params Up to 4 numeric parameters for the operation.
+   * @returns {Promise} Resolves with the operation's result: a number,
+   * string or Uint8Array, depending on the operation.
+   * @throws {RangeError} If the operation is unknown or 8 jobs are already waiting.
+   */
+  export function offload(name: string, data?: OffloadData, ...params: number[]): Promise<any>;
+
+  /**
+   * Counters of the callback watchdog (CONFIG_JS_WATCHDOG).
+   */
+  export interface WatchdogStats {
+    /** Longest a callback may run, in ms; 0 when disabled. */
+    budgetMs: number;
+    /** Callbacks interrupted for running over budget. */
+    aborted: number;
+    /** Longest callback so far, in microseconds. */
+    longestUs: number;
+  }
+
+  /**
+   * Returns the watchdog counters of the main context. Only present when the
+   * firmware is built with the watchdog.
+   */
+  export function watchdog(): WatchdogStats;
+
+  /**
+   * Sets the time budget of each callback of the main context: an event
+   * handler with the promise jobs it triggers, or one immediate. A callback
+   * still running when its budget is spent is thrown a RangeError, which
+   * `catch` and `finally` see. If it is still running a budget later, it is
+   * aborted; the abort cannot be caught, the error is logged, and the next
+   * event is handled as usual.
+   * Top-level code of main.js has no budget.
+   * @param budgetMs 0 to 60000; 0 disables the watchdog.
+   */
+  export function setWatchdog(budgetMs: number): void;
+}
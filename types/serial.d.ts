@@ -0,0 +1,86 @@
+/**
+ * @module serial
+ * @description A module for UART devices such as GPS receivers and modems.
+ * Incoming bytes are read in batches on the native side, optionally split into
+ * frames at a delimiter, and writes never block the event loop.
+ */
+
+declare module "serial" {
+  /**
+   * Configuration object for opening a port.
+   */
+  export interface PortConfig {
+    /** The UART to use, 1 or 2. UART0 is reserved for the console. */
+    port: number;
+    /** The GPIO pin used for TX. Defaults to the UART's IOMUX pin. */
+    tx?: number;
+    /** The GPIO pin used for RX. Defaults to the UART's IOMUX pin. */
+    rx?: number;
+    /** The GPIO pin used for RTS. Enables hardware flow control when set. */
+    rts?: number;
+    /** The GPIO pin used for CTS. Enables hardware flow control when set. */
+    cts?: number;
+    /** Defaults to 115200. */
+    baudRate?: number;
+    /** 5-8. Defaults to 8. */
+    dataBits?: number;
+    /** 1, 1.5 or 2. Defaults to 1. */
+    stopBits?: number;
+    /** Defaults to "none". */
+    parity?: "none" | "even" | "odd";
+    /**
+     * Split incoming data into frames ending with this sequence of up to 4
+     * bytes, e.g. "\r\n". The delimiter is not included in the frames.
+     * Without a delimiter, data is delivered in chunks as it arrives.
+     */
+    delimiter?: string;
+    /**
+     * Longest frame in bytes. A frame this long without a delimiter is
+     * delivered as is. 1-2048, defaults to 256.
+     */
+    maxFrame?: number;
+    /**
+     * Deliver data as strings decoded from UTF-8 instead of Uint8Arrays.
+     * Unframed chunks may split multi-byte characters.
+     */
+    encoding?: "utf8";
+  }
+
+  /**
+   * Represents an open port.
+   */
+  export interface Port {
+    /** The UART this port uses. */
+    readonly port: number;
+
+    /**
+     * Queues data for transmission without blocking.
+     * @returns {number} How many bytes were accepted. Fewer than requested
+     * means the transmit buffer is full: wait for `drain()` and write the rest.
+     */
+    write(data: string | ArrayBuffer | ArrayBufferView): number;
+
+    /**
+     * Resolves once the transmit buffer has room again after a short write.
+     * Already resolved if the last write was accepted in full.
+     */
+    drain(): Promise<void>;
+
+    /**
+     * Returns how many times received data was dropped because the callback
+     * could not keep up, since the port was opened.
+     */
+    overruns(): number;
+
+    /**
+     * Closes the port.
+     */
+    close(): void;
+  }
+
+  /**
+   * Opens a port. The callback receives each chunk or frame of incoming data.
+   * @throws {Error} If the port is invalid or already open.
+   */
+  export function open(config: PortConfig, onData: (data: Uint8Array | string) => void): Port;
+}
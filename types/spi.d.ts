@@ -0,0 +1,99 @@
+/**
+ * @module spi
+ * @description A module for SPI devices such as displays and fast ADCs.
+ * Transfers are queued to the DMA engine from the backing store of JS
+ * buffers and return Promises.
+ */
+
+declare module "spi" {
+  /**
+   * A buffer whose bytes are sent or received in place.
+   */
+  export type Buffer = ArrayBuffer | ArrayBufferView;
+
+  /**
+   * Configuration object for opening a bus.
+   */
+  export interface BusConfig {
+    /** The SPI controller to use, 2 (HSPI) or 3 (VSPI). Defaults to 2. */
+    host?: number;
+    /** The GPIO pin used for MOSI. Omit for receive-only buses. */
+    mosi?: number;
+    /** The GPIO pin used for MISO. Omit for transmit-only buses. */
+    miso?: number;
+    /** The GPIO pin used for the clock. */
+    sclk: number;
+    /** Largest single transfer in bytes. Defaults to 4092. */
+    maxTransferSize?: number;
+  }
+
+  /**
+   * Configuration object for adding a device.
+   */
+  export interface DeviceConfig {
+    /** The GPIO pin used for chip select. Omit if the device has none. */
+    cs?: number;
+    /** Clock frequency in Hz. Defaults to 1000000. */
+    frequency?: number;
+    /** SPI mode 0-3. Defaults to 0. */
+    mode?: number;
+  }
+
+  /**
+   * Represents a device on a bus.
+   *
+   * Up to 4 transfers can be in flight per device; they complete in order.
+   * Buffers must not be modified until their transfer has settled, since
+   * the DMA engine may read and write them directly. Buffers outside
+   * DMA-capable memory, such as those in PSRAM, are copied through a
+   * temporary DMA buffer for the length of the transfer.
+   */
+  export interface Device {
+    /** The chip select pin. */
+    readonly cs: number;
+    /** The bus this device belongs to. */
+    readonly bus: Bus;
+
+    /**
+     * Sends `tx` and, if `rx` is given, receives the same number of bytes into
+     * it at the same time.
+     * @returns {Promise} Resolves with `rx`, or undefined if it was omitted.
+     */
+    transfer<T extends Buffer>(tx: Buffer, rx?: T): Promise<T | undefined>;
+
+    /**
+     * Fills `rx` with bytes clocked in from the device.
+     * @returns {Promise} Resolves with `rx`.
+     */
+    read<T extends Buffer>(rx: T): Promise<T>;
+
+    /**
+     * Removes the device from the bus. Transfers already queued still complete.
+     */
+    close(): void;
+  }
+
+  /**
+   * Represents an initialised bus.
+   */
+  export interface Bus {
+    /** The SPI controller this bus uses. */
+    readonly host: number;
+
+    /**
+     * Adds a device to the bus.
+     */
+    device(config: DeviceConfig): Device;
+
+    /**
+     * Closes the bus. It is released once all of its devices are closed.
+     */
+    close(): void;
+  }
+
+  /**
+   * Initialises a bus.
+   * @throws {Error} If the host is invalid or already open.
+   */
+  export function open(config: BusConfig): Bus;
+}
@@ -0,0 +1,64 @@
+/**
+ * @module storage
+ * @description Persistent key-value storage in the NVS partition. Writes
+ * land in a RAM cache and are committed on a background task
+ * CONFIG_JS_STORAGE_FLUSH_MS after the first one, so rapid writes to a key
+ * cost one flash write. Only available to the main context.
+ *
+ * `delete` is a reserved word, so import the module as a namespace:
+ *
+ *     import * as storage from "storage";
+ */
+
+declare module "storage" {
+  /**
+   * A storable value. Views are stored as their bytes and read back as an
+   * ArrayBuffer. Strings are stored as UTF-8; values may be up to 4000 bytes.
+   */
+  export type Storable = string | number | ArrayBuffer | ArrayBufferView;
+
+  /**
+   * Reads a key, from the cache or from flash.
+   * @param key 1 to 15 bytes.
+   * @returns The stored value, or undefined if the key does not exist.
+   * @throws {RangeError} If the key is empty or too long.
+   */
+  export function get(key: string): string | number | ArrayBuffer | undefined;
+
+  /**
+   * Stores a value. It reaches flash with the next commit; until then a
+   * reset loses it. Storing the value a key already has writes nothing.
+   * @throws {RangeError} If the key or value is too long.
+   * @throws {TypeError} If the value is not a Storable.
+   */
+  export function set(key: string, value: Storable): void;
+
+  /**
+   * Deletes a key. Like `set()`, it reaches flash with the next commit.
+   */
+  function _delete(key: string): void;
+  export { _delete as delete };
+
+  /**
+   * Commits every pending write, blocking the JS thread until it is in flash.
+   * @throws {Error} If NVS reports an error, e.g. because the partition is full.
+   */
+  export function flush(): void;
+
+  /**
+   * Commits every pending write on the background task.
+   * @returns {Promise} Resolves once the writes are in flash; rejects if the commit fails.
+   * @throws {RangeError} If 4 commits are already waiting.
+   */
+  export function flushAsync(): Promise<void>;
+
+  /**
+   * `set()` followed by `flushAsync()`.
+   */
+  export function setAsync(key: string, value: Storable): Promise<void>;
+
+  /**
+   * `delete()` followed by `flushAsync()`.
+   */
+  export function deleteAsync(key: string): Promise<void>;
+}
@@ -0,0 +1,115 @@
+/**
+ * @module timers
+ * @description Timers on the event loop. The callback functions are also
+ * globals, and `yield` is global as `scheduler.yield()`; `sleep` and
+ * `every` are only exported by the module.
+ *
+ * Each turn of the event loop runs promise jobs and microtasks, dispatches
+ * the events that are waiting (GPIO, timers, I/O), then runs the immediates
+ * queued before the turn began. Immediates and yields need no hardware
+ * timer, so splitting long work with them costs far less than setTimeout(0).
+ */
+
+declare module "timers" {
+  /**
+   * Calls `callback` once after `delay` ms. Delays may be fractional; timers
+   * are kept in microseconds. Delays and periods longer than 2^31-1 ms
+   * (about 24.8 days), Infinity included, are shortened to it.
+   * @returns A handle for clearTimeout().
+   */
+  export function setTimeout(callback: () => void, delay: number): number;
+  /**
+   * Without a callback: resolves with `value` after `delay` ms, like sleep().
+   */
+  export function setTimeout<T = void>(delay: number, value?: T): Promise<T>;
+  export function clearTimeout(handle: number): void;
+
+  /**
+   * Calls `callback` every `delay` ms until cleared. Periods under 0.05 ms
+   * are raised to it.
+   * @returns A handle for clearInterval().
+   */
+  export function setInterval(callback: () => void, delay: number): number;
+
+  /**
+   * The timing of one tick of a paced interval. Times are in microseconds,
+   * on the same clock as perf.now(). The object is reused for every tick.
+   */
+  export interface IntervalTick {
+    /** The number of the tick; tick n is due n periods after the start. */
+    tick: number;
+    /** When the tick was due. */
+    scheduled: number;
+    /** When the callback started; `actual - scheduled` is its lateness. */
+    actual: number;
+    /** Ticks before this one that were not run. */
+    missed: number;
+  }
+
+  export interface IntervalOptions {
+    /**
+     * What to do with ticks that fell due while the event loop was busy:
+     * - "skip" (default): run only the latest, reporting the others in `missed`.
+     * - "catch-up": run each of them back to back, at most 8 per wake-up;
+     *   older ones are reported in `missed`.
+     */
+    policy?: "skip" | "catch-up";
+  }
+
+  /**
+   * Calls `callback` every `delay` ms, phase-locked to when it started: a
+   * late tick never pushes the later ones back. However short the period,
+   * at most one wake-up per interval waits in the event queue.
+   * @throws {TypeError} If the policy is not recognised.
+   * @throws {Error} If 8 phase-locked intervals are already running.
+   */
+  export function setInterval(callback: (tick: IntervalTick) => void, delay: number, options: IntervalOptions): number;
+  export function clearInterval(handle: number): void;
+
+  /**
+   * Runs `callback` once the events waiting now have been dispatched.
+   * Immediates queued by an immediate run in the next turn.
+   * @returns A handle for clearImmediate().
+   * @throws {RangeError} If 32 immediates and yields are already waiting.
+   */
+  export function setImmediate(callback: () => void): number;
+  export function clearImmediate(handle: number): void;
+
+  /**
+   * Runs `callback` after the current job, in order with the promise jobs.
+   */
+  export function queueMicrotask(callback: () => void): void;
+
+  /**
+   * Resolves once the events waiting now have been dispatched, like an
+   * immediate. `await yield()` inside a long loop keeps GPIO callbacks
+   * responsive. Also available as the global `scheduler.yield()`.
+   */
+  function _yield(): Promise<void>;
+  export { _yield as yield };
+
+  /**
+   * Resolves with `value` after `delay` ms. The timer resolves the promise
+   * directly, so no closure is allocated per wait.
+   */
+  export function sleep<T = void>(delay: number, value?: T): Promise<T>;
+
+  /**
+   * The ticks of a periodic timer, for `for await (const tick of every(ms))`.
+   * Each tick yields the number of ticks so far. Ticks that fire while the
+   * loop body is still running are coalesced: the next iteration starts at
+   * once and the count jumps. The timer stops when the loop exits through
+   * `break`, `return` or an exception, or when `id` is cleared.
+   *
+   * The same result object is reused for every tick.
+   */
+  export interface Ticks extends AsyncIterableIterator<number> {
+    /** A handle for clearInterval(). */
+    readonly id: number;
+  }
+
+  /**
+   * Starts a periodic timer with a period of `period` ms (at least 1).
+   */
+  export function every(period: number): Ticks;
+}
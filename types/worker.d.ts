@@ -0,0 +1,85 @@
+/**
+ * @module worker
+ * @description Runs scripts in separate JerryScript contexts, each on its
+ * own FreeRTOS task with its own heap and timers. Contexts share no values:
+ * they exchange cloned messages over bounded channels. Only available when
+ * the firmware is built with CONFIG_JS_WORKERS.
+ *
+ * Workers can import `console`, `timers`, `perf` and `worker`; peripheral
+ * modules stay with the main context.
+ */
+
+declare module "worker" {
+  /**
+   * A value that can be posted between contexts: primitives other than
+   * symbols and bigints, ArrayBuffers, typed arrays, arrays and plain objects,
+   * nested up to 8 levels. Buffers are copied, and functions, prototypes and
+   * repeated references are not preserved.
+   */
+  export type Cloneable =
+    | undefined
+    | null
+    | boolean
+    | number
+    | string
+    | ArrayBuffer
+    | ArrayBufferView
+    | Cloneable[]
+    | { [key: string]: Cloneable };
+
+  /**
+   * Options for `spawn()`.
+   */
+  export interface SpawnOptions {
+    /** Engine heap for the worker, 8 to 512 KB. Defaults to CONFIG_JS_WORKER_HEAP_KB. */
+    heapKB?: number;
+    /** Messages that may be waiting in each direction, 1 to 8. Defaults to 4. */
+    queueDepth?: number;
+    /** The core the worker task is pinned to. Defaults to 0; main.js runs on core 1. */
+    core?: 0 | 1;
+  }
+
+  /**
+   * The main context's handle on a running worker.
+   */
+  export interface Worker {
+    /** The script the worker was started with. */
+    readonly script: string;
+    /**
+     * Clones a value and queues it for the worker.
+     * @returns {boolean} False if `queueDepth` messages are already waiting.
+     * @throws {TypeError} If the value cannot be cloned.
+     * @throws {Error} If the worker has exited.
+     */
+    postMessage(value: Cloneable): boolean;
+    /**
+     * Sets the handler for messages from the worker. Messages that arrive
+     * with no handler set are dropped.
+     */
+    onMessage(callback: ((value: any) => void) | undefined): void;
+    /**
+     * Stops the worker once it finishes the event it is handling. Its
+     * timers are cleared and its heap is freed.
+     */
+    terminate(): void;
+  }
+
+  /**
+   * Starts `script` from the script directory in a new context. Only the
+   * main context can spawn workers; up to three run at a time.
+   * @throws {RangeError} If an option is out of range or three workers are running.
+   * @throws {Error} If there is not enough memory for the worker's heap.
+   */
+  export function spawn(script: string, options?: SpawnOptions): Worker;
+
+  /**
+   * Inside a worker: clones a value and queues it for the main context.
+   * @returns {boolean} False if the channel to the parent is full.
+   */
+  export function postMessage(value: Cloneable): boolean;
+
+  /**
+   * Inside a worker: sets the handler for messages from the main context.
+   */
+  export function onMessage(callback: ((value: any) => void) | undefined): void;
+}